@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised fixed-point functions for zscilib using ARM Thumb2.
+ *
+ * This file contains optimised Q15 functions for ARM Thumb2 (ARMv7-M and
+ * above). ARMv6-M (Thumb) has no saturating instructions, and uses the
+ * generic C versions.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/arm/asm_arm.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_ARM_FIXEDPOINT_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_ARM_FIXEDPOINT_H_
+
+#if CONFIG_ZSL_PLATFORM_OPT == 2
+/* Saturates a 32-bit value to Q15 with a single SSAT. */
+static inline zsl_q15_t zsl_arm_ssat16(int32_t x)
+{
+	int32_t r;
+
+	__asm__ ("ssat %0, #16, %1" : "=r" (r) : "r" (x));
+
+	return (zsl_q15_t)r;
+}
+#endif
+
+#if !asm_vec_q15_add
+#if CONFIG_ZSL_PLATFORM_OPT == 2
+int zsl_vec_q15_add(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_arm_ssat16((int32_t)v->data[i] + w->data[i]);
+	}
+
+	return 0;
+}
+#define asm_vec_q15_add 1
+#endif
+#endif
+
+#if !asm_vec_q15_sub
+#if CONFIG_ZSL_PLATFORM_OPT == 2
+int zsl_vec_q15_sub(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_arm_ssat16((int32_t)v->data[i] - w->data[i]);
+	}
+
+	return 0;
+}
+#define asm_vec_q15_sub 1
+#endif
+#endif
+
+#if !asm_vec_q15_scalar_mult
+#if CONFIG_ZSL_PLATFORM_OPT == 2
+int zsl_vec_q15_scalar_mult(struct zsl_vec_q15 *v, zsl_q15_t s)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_arm_ssat16(
+			(((int32_t)v->data[i] * s) + (1 << 14)) >> 15);
+	}
+
+	return 0;
+}
+#define asm_vec_q15_scalar_mult 1
+#endif
+#endif
+
+#if !asm_vec_q15_dot
+#if CONFIG_ZSL_PLATFORM_OPT == 2
+int zsl_vec_q15_dot(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    zsl_q15_t *d)
+{
+	int64_t acc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Accumulate the full Q30 products in a 64-bit register pair. */
+	for (size_t i = 0; i < v->sz; i++) {
+		__asm__ ("smlal %Q0, %R0, %1, %2"
+			 : "+r" (acc)
+			 : "r" ((int32_t)v->data[i]), "r" ((int32_t)w->data[i]));
+	}
+
+	acc = (acc + (1 << 14)) >> 15;
+	*d = acc > INT16_MAX ? INT16_MAX : (acc < INT16_MIN ? INT16_MIN : acc);
+
+	return 0;
+}
+#define asm_vec_q15_dot 1
+#endif
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_ARM_FIXEDPOINT_H_ */
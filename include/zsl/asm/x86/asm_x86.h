@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised functions for zscilib using x86-64 SIMD extensions.
+ *
+ * This file contains SIMD helpers for SSE2, AVX2 and AVX-512. The widest
+ * instruction set enabled in the compiler flags is selected at build time
+ * (for example with '-mavx2 -mfma' or '-march=native'), falling back to
+ * SSE2, which every x86-64 CPU supports.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_H_
+
+#include <stddef.h>
+#include <zsl/zsl.h>
+
+#if !defined(__SSE2__)
+#error "CONFIG_ZSL_PLATFORM_OPT=3 requires an x86 target with SSE2 or better."
+#endif
+
+#include <immintrin.h>
+
+/*
+ * Each instruction set and precision maps to the same set of macros, so that
+ * the kernels below only need to be written once:
+ *
+ * ZSL_X86_LANES        Number of zsl_real_t values in a register.
+ * ZSL_X86_LOAD/STORE   Unaligned load/store.
+ * ZSL_X86_SET1         Broadcast a scalar to every lane.
+ * ZSL_X86_ZERO         All lanes set to zero.
+ * ZSL_X86_ADD/SUB/MUL/DIV  Lane-wise arithmetic.
+ * ZSL_X86_FMADD(a,b,c) a * b + c, fused when FMA is available.
+ */
+#if defined(__AVX512F__)
+#define ZSL_X86_ISA "AVX-512"
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+typedef __m512 zsl_x86_vec_t;
+#define ZSL_X86_LANES           (16)
+#define ZSL_X86_LOAD(p)         _mm512_loadu_ps(p)
+#define ZSL_X86_STORE(p, a)     _mm512_storeu_ps(p, a)
+#define ZSL_X86_SET1(s)         _mm512_set1_ps(s)
+#define ZSL_X86_ZERO()          _mm512_setzero_ps()
+#define ZSL_X86_ADD(a, b)       _mm512_add_ps(a, b)
+#define ZSL_X86_SUB(a, b)       _mm512_sub_ps(a, b)
+#define ZSL_X86_MUL(a, b)       _mm512_mul_ps(a, b)
+#define ZSL_X86_DIV(a, b)       _mm512_div_ps(a, b)
+#define ZSL_X86_FMADD(a, b, c)  _mm512_fmadd_ps(a, b, c)
+#define ZSL_X86_HSUM(a)         _mm512_reduce_add_ps(a)
+#else
+typedef __m512d zsl_x86_vec_t;
+#define ZSL_X86_LANES           (8)
+#define ZSL_X86_LOAD(p)         _mm512_loadu_pd(p)
+#define ZSL_X86_STORE(p, a)     _mm512_storeu_pd(p, a)
+#define ZSL_X86_SET1(s)         _mm512_set1_pd(s)
+#define ZSL_X86_ZERO()          _mm512_setzero_pd()
+#define ZSL_X86_ADD(a, b)       _mm512_add_pd(a, b)
+#define ZSL_X86_SUB(a, b)       _mm512_sub_pd(a, b)
+#define ZSL_X86_MUL(a, b)       _mm512_mul_pd(a, b)
+#define ZSL_X86_DIV(a, b)       _mm512_div_pd(a, b)
+#define ZSL_X86_FMADD(a, b, c)  _mm512_fmadd_pd(a, b, c)
+#define ZSL_X86_HSUM(a)         _mm512_reduce_add_pd(a)
+#endif
+#elif defined(__AVX2__)
+#define ZSL_X86_ISA "AVX2"
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+typedef __m256 zsl_x86_vec_t;
+#define ZSL_X86_LANES           (8)
+#define ZSL_X86_LOAD(p)         _mm256_loadu_ps(p)
+#define ZSL_X86_STORE(p, a)     _mm256_storeu_ps(p, a)
+#define ZSL_X86_SET1(s)         _mm256_set1_ps(s)
+#define ZSL_X86_ZERO()          _mm256_setzero_ps()
+#define ZSL_X86_ADD(a, b)       _mm256_add_ps(a, b)
+#define ZSL_X86_SUB(a, b)       _mm256_sub_ps(a, b)
+#define ZSL_X86_MUL(a, b)       _mm256_mul_ps(a, b)
+#define ZSL_X86_DIV(a, b)       _mm256_div_ps(a, b)
+#ifdef __FMA__
+#define ZSL_X86_FMADD(a, b, c)  _mm256_fmadd_ps(a, b, c)
+#endif
+
+static inline zsl_real_t zsl_x86_hsum(zsl_x86_vec_t a)
+{
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(a),
+			      _mm256_extractf128_ps(a, 1));
+
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+
+	return _mm_cvtss_f32(s);
+}
+#else
+typedef __m256d zsl_x86_vec_t;
+#define ZSL_X86_LANES           (4)
+#define ZSL_X86_LOAD(p)         _mm256_loadu_pd(p)
+#define ZSL_X86_STORE(p, a)     _mm256_storeu_pd(p, a)
+#define ZSL_X86_SET1(s)         _mm256_set1_pd(s)
+#define ZSL_X86_ZERO()          _mm256_setzero_pd()
+#define ZSL_X86_ADD(a, b)       _mm256_add_pd(a, b)
+#define ZSL_X86_SUB(a, b)       _mm256_sub_pd(a, b)
+#define ZSL_X86_MUL(a, b)       _mm256_mul_pd(a, b)
+#define ZSL_X86_DIV(a, b)       _mm256_div_pd(a, b)
+#ifdef __FMA__
+#define ZSL_X86_FMADD(a, b, c)  _mm256_fmadd_pd(a, b, c)
+#endif
+
+static inline zsl_real_t zsl_x86_hsum(zsl_x86_vec_t a)
+{
+	__m128d s = _mm_add_pd(_mm256_castpd256_pd128(a),
+			       _mm256_extractf128_pd(a, 1));
+
+	s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+
+	return _mm_cvtsd_f64(s);
+}
+#endif
+#define ZSL_X86_HSUM(a)         zsl_x86_hsum(a)
+#else
+#define ZSL_X86_ISA "SSE2"
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+typedef __m128 zsl_x86_vec_t;
+#define ZSL_X86_LANES           (4)
+#define ZSL_X86_LOAD(p)         _mm_loadu_ps(p)
+#define ZSL_X86_STORE(p, a)     _mm_storeu_ps(p, a)
+#define ZSL_X86_SET1(s)         _mm_set1_ps(s)
+#define ZSL_X86_ZERO()          _mm_setzero_ps()
+#define ZSL_X86_ADD(a, b)       _mm_add_ps(a, b)
+#define ZSL_X86_SUB(a, b)       _mm_sub_ps(a, b)
+#define ZSL_X86_MUL(a, b)       _mm_mul_ps(a, b)
+#define ZSL_X86_DIV(a, b)       _mm_div_ps(a, b)
+
+static inline zsl_real_t zsl_x86_hsum(zsl_x86_vec_t a)
+{
+	__m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+
+	return _mm_cvtss_f32(s);
+}
+#else
+typedef __m128d zsl_x86_vec_t;
+#define ZSL_X86_LANES           (2)
+#define ZSL_X86_LOAD(p)         _mm_loadu_pd(p)
+#define ZSL_X86_STORE(p, a)     _mm_storeu_pd(p, a)
+#define ZSL_X86_SET1(s)         _mm_set1_pd(s)
+#define ZSL_X86_ZERO()          _mm_setzero_pd()
+#define ZSL_X86_ADD(a, b)       _mm_add_pd(a, b)
+#define ZSL_X86_SUB(a, b)       _mm_sub_pd(a, b)
+#define ZSL_X86_MUL(a, b)       _mm_mul_pd(a, b)
+#define ZSL_X86_DIV(a, b)       _mm_div_pd(a, b)
+
+static inline zsl_real_t zsl_x86_hsum(zsl_x86_vec_t a)
+{
+	return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+}
+#endif
+#define ZSL_X86_HSUM(a)         zsl_x86_hsum(a)
+#endif
+
+#ifndef ZSL_X86_FMADD
+#define ZSL_X86_FMADD(a, b, c)  ZSL_X86_ADD(ZSL_X86_MUL(a, b), c)
+#endif
+
+/** c[i] = a[i] + b[i] for 'n' elements. 'c' may alias 'a' or 'b'. */
+static inline void zsl_x86_add(const zsl_real_t *a, const zsl_real_t *b,
+			       zsl_real_t *c, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + ZSL_X86_LANES <= n; i += ZSL_X86_LANES) {
+		ZSL_X86_STORE(&c[i], ZSL_X86_ADD(ZSL_X86_LOAD(&a[i]),
+						 ZSL_X86_LOAD(&b[i])));
+	}
+	for (; i < n; i++) {
+		c[i] = a[i] + b[i];
+	}
+}
+
+/** c[i] = a[i] - b[i] for 'n' elements. 'c' may alias 'a' or 'b'. */
+static inline void zsl_x86_sub(const zsl_real_t *a, const zsl_real_t *b,
+			       zsl_real_t *c, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + ZSL_X86_LANES <= n; i += ZSL_X86_LANES) {
+		ZSL_X86_STORE(&c[i], ZSL_X86_SUB(ZSL_X86_LOAD(&a[i]),
+						 ZSL_X86_LOAD(&b[i])));
+	}
+	for (; i < n; i++) {
+		c[i] = a[i] - b[i];
+	}
+}
+
+/** a[i] += s for 'n' elements. */
+static inline void zsl_x86_scalar_add(zsl_real_t *a, zsl_real_t s, size_t n)
+{
+	size_t i = 0;
+	zsl_x86_vec_t vs = ZSL_X86_SET1(s);
+
+	for (; i + ZSL_X86_LANES <= n; i += ZSL_X86_LANES) {
+		ZSL_X86_STORE(&a[i], ZSL_X86_ADD(ZSL_X86_LOAD(&a[i]), vs));
+	}
+	for (; i < n; i++) {
+		a[i] += s;
+	}
+}
+
+/** a[i] *= s for 'n' elements. */
+static inline void zsl_x86_scalar_mult(zsl_real_t *a, zsl_real_t s, size_t n)
+{
+	size_t i = 0;
+	zsl_x86_vec_t vs = ZSL_X86_SET1(s);
+
+	for (; i + ZSL_X86_LANES <= n; i += ZSL_X86_LANES) {
+		ZSL_X86_STORE(&a[i], ZSL_X86_MUL(ZSL_X86_LOAD(&a[i]), vs));
+	}
+	for (; i < n; i++) {
+		a[i] *= s;
+	}
+}
+
+/** a[i] /= s for 'n' elements, with a true division to match the C code. */
+static inline void zsl_x86_scalar_div(zsl_real_t *a, zsl_real_t s, size_t n)
+{
+	size_t i = 0;
+	zsl_x86_vec_t vs = ZSL_X86_SET1(s);
+
+	for (; i + ZSL_X86_LANES <= n; i += ZSL_X86_LANES) {
+		ZSL_X86_STORE(&a[i], ZSL_X86_DIV(ZSL_X86_LOAD(&a[i]), vs));
+	}
+	for (; i < n; i++) {
+		a[i] /= s;
+	}
+}
+
+/** y[i] += a * x[i] for 'n' elements. */
+static inline void zsl_x86_axpy(zsl_real_t a, const zsl_real_t *x,
+				zsl_real_t *y, size_t n)
+{
+	size_t i = 0;
+	zsl_x86_vec_t va = ZSL_X86_SET1(a);
+
+	for (; i + ZSL_X86_LANES <= n; i += ZSL_X86_LANES) {
+		ZSL_X86_STORE(&y[i], ZSL_X86_FMADD(va, ZSL_X86_LOAD(&x[i]),
+						   ZSL_X86_LOAD(&y[i])));
+	}
+	for (; i < n; i++) {
+		y[i] += a * x[i];
+	}
+}
+
+/**
+ * Returns the sum of a[i] * b[i] for 'n' elements. Two independent
+ * accumulators are used to hide the latency of the multiply-add.
+ */
+static inline zsl_real_t zsl_x86_dot(const zsl_real_t *a, const zsl_real_t *b,
+				     size_t n)
+{
+	size_t i = 0;
+	zsl_real_t res;
+	zsl_x86_vec_t acc0 = ZSL_X86_ZERO();
+	zsl_x86_vec_t acc1 = ZSL_X86_ZERO();
+
+	for (; i + (2 * ZSL_X86_LANES) <= n; i += 2 * ZSL_X86_LANES) {
+		acc0 = ZSL_X86_FMADD(ZSL_X86_LOAD(&a[i]), ZSL_X86_LOAD(&b[i]),
+				     acc0);
+		acc1 = ZSL_X86_FMADD(ZSL_X86_LOAD(&a[i + ZSL_X86_LANES]),
+				     ZSL_X86_LOAD(&b[i + ZSL_X86_LANES]), acc1);
+	}
+	if (i + ZSL_X86_LANES <= n) {
+		acc0 = ZSL_X86_FMADD(ZSL_X86_LOAD(&a[i]), ZSL_X86_LOAD(&b[i]),
+				     acc0);
+		i += ZSL_X86_LANES;
+	}
+
+	res = ZSL_X86_HSUM(ZSL_X86_ADD(acc0, acc1));
+	for (; i < n; i++) {
+		res += a[i] * b[i];
+	}
+
+	return res;
+}
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_H_ */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised fixed-point functions for zscilib using x86-64 SIMD.
+ *
+ * This file contains SSE2 versions of the Q15 element-wise functions, which
+ * map directly onto the packed saturating 16-bit instructions.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_FIXEDPOINT_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_FIXEDPOINT_H_
+
+#if !asm_vec_q15_add
+int zsl_vec_q15_add(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x)
+{
+	size_t i = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (; i + 8 <= v->sz; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *)&v->data[i]);
+		__m128i b = _mm_loadu_si128((const __m128i *)&w->data[i]);
+
+		_mm_storeu_si128((__m128i *)&x->data[i], _mm_adds_epi16(a, b));
+	}
+
+	for (; i < v->sz; i++) {
+		x->data[i] = zsl_q15_sat((int32_t)v->data[i] + w->data[i]);
+	}
+
+	return 0;
+}
+#define asm_vec_q15_add 1
+#endif
+
+#if !asm_vec_q15_sub
+int zsl_vec_q15_sub(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x)
+{
+	size_t i = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (; i + 8 <= v->sz; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *)&v->data[i]);
+		__m128i b = _mm_loadu_si128((const __m128i *)&w->data[i]);
+
+		_mm_storeu_si128((__m128i *)&x->data[i], _mm_subs_epi16(a, b));
+	}
+
+	for (; i < v->sz; i++) {
+		x->data[i] = zsl_q15_sat((int32_t)v->data[i] - w->data[i]);
+	}
+
+	return 0;
+}
+#define asm_vec_q15_sub 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_FIXEDPOINT_H_ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised half-precision functions for zscilib using x86-64 SIMD.
+ *
+ * This file contains SSE2 versions of the bf16 pack and unpack kernels, and
+ * F16C versions of the fp16 ones when F16C is enabled in the compiler flags
+ * (for example with '-mf16c' or '-march=native'). Without F16C, fp16 uses
+ * the scalar conversions.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_HALF_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_HALF_H_
+
+/* Loads four zsl_real_t values as floats. */
+static inline __m128 zsl_x86_half_load4(const zsl_real_t *x)
+{
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	return _mm_loadu_ps(x);
+#else
+	return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(x)),
+			     _mm_cvtpd_ps(_mm_loadu_pd(x + 2)));
+#endif
+}
+
+/* Stores four floats as zsl_real_t values. */
+static inline void zsl_x86_half_store4(zsl_real_t *x, __m128 f)
+{
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	_mm_storeu_ps(x, f);
+#else
+	_mm_storeu_pd(x, _mm_cvtps_pd(f));
+	_mm_storeu_pd(x + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+#endif
+}
+
+/* Rounds four floats to bf16, returned in the low 64 bits. */
+static inline __m128i zsl_x86_half_bf16_pack4(__m128 f)
+{
+	__m128i x = _mm_castps_si128(f);
+	__m128i nan = _mm_castps_si128(_mm_cmpunord_ps(f, f));
+	__m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+	__m128i r = _mm_add_epi32(x, _mm_add_epi32(_mm_set1_epi32(0x7FFF), lsb));
+	__m128i q = _mm_or_si128(x, _mm_set1_epi32(0x00400000));
+
+	/* NaN stays a quiet NaN, everything else rounds to nearest even. */
+	r = _mm_or_si128(_mm_and_si128(nan, q), _mm_andnot_si128(nan, r));
+
+	/* The arithmetic shift makes the signed pack exact. */
+	r = _mm_srai_epi32(r, 16);
+
+	return _mm_packs_epi32(r, r);
+}
+
+#if !asm_half_pack
+int zsl_half_pack(const zsl_real_t *x, zsl_half_t *h, size_t n,
+		  enum zsl_half_fmt fmt)
+{
+	size_t i = 0;
+
+	switch (fmt) {
+	case ZSL_HALF_FP16:
+#if defined(__F16C__)
+		for (; i + 4 <= n; i += 4) {
+			_mm_storel_epi64((__m128i *)&h[i],
+					 _mm_cvtps_ph(zsl_x86_half_load4(&x[i]),
+						      _MM_FROUND_TO_NEAREST_INT));
+		}
+#endif
+		break;
+	case ZSL_HALF_BF16:
+		for (; i + 4 <= n; i += 4) {
+			_mm_storel_epi64((__m128i *)&h[i],
+				zsl_x86_half_bf16_pack4(zsl_x86_half_load4(&x[i])));
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	for (; i < n; i++) {
+		h[i] = zsl_half_from_real(x[i], fmt);
+	}
+
+	return 0;
+}
+#define asm_half_pack 1
+#endif
+
+#if !asm_half_unpack
+int zsl_half_unpack(const zsl_half_t *h, zsl_real_t *x, size_t n,
+		    enum zsl_half_fmt fmt)
+{
+	size_t i = 0;
+	__m128i hv;
+
+	switch (fmt) {
+	case ZSL_HALF_FP16:
+#if defined(__F16C__)
+		for (; i + 4 <= n; i += 4) {
+			hv = _mm_loadl_epi64((const __m128i *)&h[i]);
+			zsl_x86_half_store4(&x[i], _mm_cvtph_ps(hv));
+		}
+#endif
+		break;
+	case ZSL_HALF_BF16:
+		/* bf16 is the upper half of a float. */
+		for (; i + 4 <= n; i += 4) {
+			hv = _mm_loadl_epi64((const __m128i *)&h[i]);
+			hv = _mm_unpacklo_epi16(_mm_setzero_si128(), hv);
+			zsl_x86_half_store4(&x[i], _mm_castsi128_ps(hv));
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	for (; i < n; i++) {
+		x[i] = zsl_half_to_real(h[i], fmt);
+	}
+
+	return 0;
+}
+#define asm_half_unpack 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_HALF_H_ */
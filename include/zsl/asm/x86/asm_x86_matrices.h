@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised matrix functions for zscilib using x86-64 SIMD.
+ *
+ * This file contains optimised element-wise matrix functions for SSE2, AVX2
+ * and AVX-512.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_MATRICES_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_MATRICES_H_
+
+/*
+ * Runs 'fn' on the rows of matrices 'ma', 'mb' and 'mc', or on their whole
+ * buffers in one call if none of them is a view. All three matrices must
+ * have the same layout, and transposed ones are walked in storage order.
+ */
+#define ZSL_X86_MTX_ROWS(fn, ma, mb, mc)				      \
+	do {								      \
+		if (ZSL_MTX_IS_CONTIG(ma) && ZSL_MTX_IS_CONTIG(mb) &&	      \
+		    ZSL_MTX_IS_CONTIG(mc)) {				      \
+			fn((ma)->data, (mb)->data, (mc)->data,		      \
+			   (ma)->sz_rows * (ma)->sz_cols);		      \
+			break;						      \
+		}							      \
+		for (size_t r = 0; r < ZSL_MTX_STORE_ROWS(ma); r++) {	      \
+			fn(&(ma)->data[r * ZSL_MTX_STRIDE(ma)],		      \
+			   &(mb)->data[r * ZSL_MTX_STRIDE(mb)],		      \
+			   &(mc)->data[r * ZSL_MTX_STRIDE(mc)],		      \
+			   ZSL_MTX_STORE_COLS(ma));			      \
+		}							      \
+	} while (0)
+
+/* True if matrices 'ma', 'mb' and 'mc' don't all have the same layout. */
+#define ZSL_X86_MTX_MIXED(ma, mb, mc) \
+	(((ma)->trans != (mb)->trans) || ((mb)->trans != (mc)->trans))
+
+#if !asm_mtx_add
+int
+zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (ZSL_X86_MTX_MIXED(ma, mb, mc)) {
+		return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_ADD);
+	}
+
+	ZSL_X86_MTX_ROWS(zsl_x86_add, ma, mb, mc);
+
+	return 0;
+}
+#define asm_mtx_add 1
+#endif
+
+#if !asm_mtx_add_d
+int
+zsl_mtx_add_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+	return zsl_mtx_add(ma, mb, ma);
+}
+#define asm_mtx_add_d 1
+#endif
+
+#if !asm_mtx_sub
+int
+zsl_mtx_sub(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (ZSL_X86_MTX_MIXED(ma, mb, mc)) {
+		return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_SUB);
+	}
+
+	ZSL_X86_MTX_ROWS(zsl_x86_sub, ma, mb, mc);
+
+	return 0;
+}
+#define asm_mtx_sub 1
+#endif
+
+#if !asm_mtx_sub_d
+int
+zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+	return zsl_mtx_sub(ma, mb, ma);
+}
+#define asm_mtx_sub_d 1
+#endif
+
+#if !asm_mtx_scalar_mult_d
+int
+zsl_mtx_scalar_mult_d(struct zsl_mtx *m, zsl_real_t s)
+{
+	if (ZSL_MTX_IS_CONTIG(m)) {
+		zsl_x86_scalar_mult(m->data, s, m->sz_rows * m->sz_cols);
+		return 0;
+	}
+
+	for (size_t r = 0; r < ZSL_MTX_STORE_ROWS(m); r++) {
+		zsl_x86_scalar_mult(&m->data[r * ZSL_MTX_STRIDE(m)], s,
+				    ZSL_MTX_STORE_COLS(m));
+	}
+
+	return 0;
+}
+#define asm_mtx_scalar_mult_d 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_MATRICES_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised vector functions for zscilib using x86-64 SIMD.
+ *
+ * This file contains optimised vector functions for SSE2, AVX2 and AVX-512.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_VECTORS_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_VECTORS_H_
+
+#if !asm_vec_add
+int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_x86_add(v->data, w->data, x->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_add 1
+#endif
+
+#if !asm_vec_sub
+int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_x86_sub(v->data, w->data, x->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_sub 1
+#endif
+
+#if !asm_vec_scalar_add
+int zsl_vec_scalar_add(struct zsl_vec *v, zsl_real_t s)
+{
+	zsl_x86_scalar_add(v->data, s, v->sz);
+
+	return 0;
+}
+#define asm_vec_scalar_add 1
+#endif
+
+#if !asm_vec_scalar_mult
+int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s)
+{
+	zsl_x86_scalar_mult(v->data, s, v->sz);
+
+	return 0;
+}
+#define asm_vec_scalar_mult 1
+#endif
+
+#if !asm_vec_scalar_div
+int zsl_vec_scalar_div(struct zsl_vec *v, zsl_real_t s)
+{
+	/* Avoid divide by zero errors. */
+	if (s == 0) {
+		return -EINVAL;
+	}
+
+	zsl_x86_scalar_div(v->data, s, v->sz);
+
+	return 0;
+}
+#define asm_vec_scalar_div 1
+#endif
+
+#if !asm_vec_axpy
+int zsl_vec_axpy(zsl_real_t a, struct zsl_vec *x, struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure x and y are equal length. */
+	if (x->sz != y->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_x86_axpy(a, x->data, y->data, x->sz);
+
+	return 0;
+}
+#define asm_vec_axpy 1
+#endif
+
+#if !asm_vec_dot
+int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	*d = zsl_x86_dot(v->data, w->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_dot 1
+#endif
+
+#if !asm_vec_sum_of_sqrs
+/* Also used by zsl_vec_norm. */
+zsl_real_t zsl_vec_sum_of_sqrs(struct zsl_vec *v)
+{
+	return zsl_x86_dot(v->data, v->data, v->sz);
+}
+#define asm_vec_sum_of_sqrs 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_VECTORS_H_ */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup BATCH Matrix Batches
+ *
+ * @brief Operations on batches of small, same-shaped matrices.
+ *
+ * A batch holds 'count' matrices of the same shape in a structure-of-arrays
+ * layout: the value at row i and column j of every matrix in the batch is
+ * stored contiguously, followed by the values at (i, j + 1), and so on. Each
+ * function processes the whole batch in one call, checking the shapes once,
+ * and its inner loops run across the batch so that the compiler can
+ * vectorise them, which makes it much faster than calling the matching
+ * @ref MATRICES function on thousands of 3x3 or 4x4 matrices one at a time.
+ *
+ * A batch of vectors is a batch of n x 1 matrices.
+ */
+
+/**
+ * @file
+ * @brief API header file for matrix batches in zscilib.
+ *
+ * This file contains the zscilib matrix batch APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_BATCH_H_
+#define ZEPHYR_INCLUDE_ZSL_BATCH_H_
+
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup BATCH_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with matrix batches.
+ *
+ * @ingroup BATCH
+ *  @{ */
+
+/** @brief Represents a batch of 'count' m x n matrices. */
+struct zsl_mtx_batch {
+	/** The number of rows in each matrix. */
+	size_t sz_rows;
+	/** The number of columns in each matrix. */
+	size_t sz_cols;
+	/** The number of matrices in the batch. */
+	size_t count;
+	/**
+	 * The values of every matrix, where the value at row i and column j
+	 * of matrix k is at data[(((i * sz_cols) + j) * count) + k].
+	 */
+	zsl_real_t *data;
+};
+
+/**
+ * Macro to declare a batch of 'count' matrices of shape m*n.
+ *
+ * Be sure to also call 'zsl_mtx_batch_init' on the batch after this macro,
+ * since batches declared on the stack may have non-zero values by default!
+ */
+#define ZSL_MTX_BATCH_DEF(name, m, n, cnt)		     \
+	zsl_real_t name ## _bat[(m) * (n) * (cnt)];	     \
+	struct zsl_mtx_batch name = {			     \
+		.sz_rows = m,				     \
+		.sz_cols = n,				     \
+		.count = cnt,				     \
+		.data = name ## _bat			     \
+	}
+
+/** @} */ /* End of BATCH_STRUCTS group */
+
+/**
+ * @addtogroup BATCH_FUNCS Functions
+ *
+ * @brief Batch initialisation, data access and math.
+ *
+ * @ingroup BATCH
+ *  @{ */
+
+/**
+ * @brief Sets every value of every matrix in batch 'b' to 0.0.
+ *
+ * @param b     The batch to initialise.
+ *
+ * @return  0 on success, and non-zero error code on failure
+ */
+int zsl_mtx_batch_init(struct zsl_mtx_batch *b);
+
+/**
+ * @brief Copies matrix 'm' into slot 'k' of batch 'b'.
+ *
+ * @param b     The batch to write to.
+ * @param k     The index of the matrix in the batch (0-based).
+ * @param m     The source matrix, with the same shape as the batch.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'k' is out of
+ *          bounds or the shapes don't match.
+ */
+int zsl_mtx_batch_set(struct zsl_mtx_batch *b, size_t k, struct zsl_mtx *m);
+
+/**
+ * @brief Copies slot 'k' of batch 'b' into matrix 'm'.
+ *
+ * @param b     The batch to read from.
+ * @param k     The index of the matrix in the batch (0-based).
+ * @param m     The output matrix, with the same shape as the batch.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'k' is out of
+ *          bounds or the shapes don't match.
+ */
+int zsl_mtx_batch_get(struct zsl_mtx_batch *b, size_t k, struct zsl_mtx *m);
+
+/**
+ * @brief Multiplies each matrix in batch 'ba' by the matching matrix in
+ *        batch 'bb', such that 'bc[k] = ba[k] * bb[k]'.
+ *
+ * @param ba    The batch of m x n left-hand matrices.
+ * @param bb    The batch of n x p right-hand matrices.
+ * @param bc    The batch of m x p output matrices. Must not be the same
+ *              batch as 'ba' or 'bb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the shapes or
+ *          counts don't match.
+ */
+int zsl_mtx_batch_mult(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bb,
+		       struct zsl_mtx_batch *bc);
+
+/**
+ * @brief Multiplies each matrix in batch 'ba' by the matching vector in
+ *        batch 'bv', such that 'bw[k] = ba[k] * bv[k]'.
+ *
+ * This is @ref zsl_mtx_batch_mult with n x 1 right-hand matrices, and is
+ * provided for clarity.
+ *
+ * @param ba    The batch of m x n matrices.
+ * @param bv    The batch of n x 1 vectors.
+ * @param bw    The batch of m x 1 output vectors.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the shapes or
+ *          counts don't match.
+ */
+int zsl_mtx_batch_mult_vec(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bv,
+			   struct zsl_mtx_batch *bw);
+
+/**
+ * @brief Transposes each matrix in batch 'ba' into batch 'bt'.
+ *
+ * @param ba    The batch of m x n input matrices.
+ * @param bt    The batch of n x m output matrices. Must not be the same
+ *              batch as 'ba'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the shapes or
+ *          counts don't match.
+ */
+int zsl_mtx_batch_trans(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bt);
+
+/**
+ * @brief Calculates the determinant of each matrix in batch 'ba'.
+ *
+ * @param ba    The batch of 2x2, 3x3 or 4x4 input matrices.
+ * @param d     The output array of 'ba->count' determinants.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          aren't 2x2, 3x3 or 4x4.
+ */
+int zsl_mtx_batch_deter(struct zsl_mtx_batch *ba, zsl_real_t *d);
+
+/**
+ * @brief Calculates the inverse of each matrix in batch 'ba'.
+ *
+ * As with @ref zsl_mtx_inv_3x3, the identity matrix is returned for any
+ * matrix whose determinant is zero. Use @ref zsl_mtx_batch_deter first if
+ * singular matrices need to be detected.
+ *
+ * @param ba    The batch of 2x2, 3x3 or 4x4 input matrices.
+ * @param bi    The batch of output inverse matrices. Must not be the same
+ *              batch as 'ba'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          aren't 2x2, 3x3 or 4x4 or the shapes or counts don't match.
+ */
+int zsl_mtx_batch_inv(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bi);
+
+/** @} */ /* End of BATCH_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_BATCH_H_ */
+
+/** @} */ /* End of BATCH group */
@@ -0,0 +1,573 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FIXEDPOINT Fixed-Point
+ *
+ * @brief Q15 and Q31 fixed-point vectors and matrices for targets without
+ *        an FPU.
+ *
+ * A Q15 value is an int16_t holding x * 2^15, and a Q31 value is an int32_t
+ * holding x * 2^31, so both represent numbers in the range [-1.0, 1.0).
+ * The functions below only use integer arithmetic, except for the
+ * conversions to and from zsl_real_t.
+ *
+ * Rounding and overflow rules:
+ *
+ * - Every result that doesn't fit in the output format saturates to the
+ *   largest or smallest representable value (0x7FFF/0x8000 for Q15,
+ *   0x7FFFFFFF/0x80000000 for Q31) rather than wrapping. In particular,
+ *   -1.0 * -1.0 saturates to just below 1.0.
+ * - Products are rounded to the nearest value, with ties rounded up
+ *   (towards +infinity), by adding half an LSB before the shift.
+ * - Dot products, matrix products and matrix-vector products accumulate
+ *   in 64 bits and are rounded and saturated once, at the end. Q15 sums
+ *   keep the full Q30 products and can't overflow. Q31 sums keep Q46
+ *   products, so a full-scale product (2^46) leaves 17 guard bits in the
+ *   accumulator, and sums can't overflow for up to 2^16 terms.
+ * - Conversions from zsl_real_t round to the nearest value and saturate.
+ *   NaN converts to 0.
+ *
+ * The element-wise functions accept the same object as an input and the
+ * output. The dot and matrix products don't, since an output element can
+ * depend on every input element.
+ *
+ * Key kernels can be replaced by platform-specific versions through
+ * CONFIG_ZSL_PLATFORM_OPT, in the same way as the floating-point vector
+ * functions.
+ */
+
+/**
+ * @file
+ * @brief API header file for fixed-point vectors and matrices in zscilib.
+ *
+ * This file contains the zscilib Q15 and Q31 APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FIXEDPOINT_H_
+#define ZEPHYR_INCLUDE_ZSL_FIXEDPOINT_H_
+
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FIXEDPOINT_STRUCTS Structs and Macros
+ *
+ * @brief Fixed-point types, and macros to declare fixed-point objects.
+ *
+ * @ingroup FIXEDPOINT
+ *  @{ */
+
+/** A Q15 fixed-point value, representing x * 2^15. */
+typedef int16_t zsl_q15_t;
+
+/** A Q31 fixed-point value, representing x * 2^31. */
+typedef int32_t zsl_q31_t;
+
+/** @brief Represents a vector of Q15 values. */
+struct zsl_vec_q15 {
+	/** The number of elements in the vector. */
+	size_t sz;
+	/** The Q15 data assigned to the vector. */
+	zsl_q15_t *data;
+};
+
+/** @brief Represents a vector of Q31 values. */
+struct zsl_vec_q31 {
+	/** The number of elements in the vector. */
+	size_t sz;
+	/** The Q31 data assigned to the vector. */
+	zsl_q31_t *data;
+};
+
+/** @brief Represents a row-major matrix of Q15 values. */
+struct zsl_mtx_q15 {
+	/** The number of rows in the matrix. */
+	size_t sz_rows;
+	/** The number of columns in the matrix. */
+	size_t sz_cols;
+	/** The Q15 data assigned to the matrix, in row-major order. */
+	zsl_q15_t *data;
+};
+
+/** @brief Represents a row-major matrix of Q31 values. */
+struct zsl_mtx_q31 {
+	/** The number of rows in the matrix. */
+	size_t sz_rows;
+	/** The number of columns in the matrix. */
+	size_t sz_cols;
+	/** The Q31 data assigned to the matrix, in row-major order. */
+	zsl_q31_t *data;
+};
+
+/** Macro to declare a Q15 vector of size `n`. */
+#define ZSL_VEC_Q15_DEF(name, n)	      \
+	zsl_q15_t name ## _vec_q15[n];	      \
+	struct zsl_vec_q15 name = {	      \
+		.sz = n,		      \
+		.data = name ## _vec_q15      \
+	}
+
+/** Macro to declare a Q31 vector of size `n`. */
+#define ZSL_VEC_Q31_DEF(name, n)	      \
+	zsl_q31_t name ## _vec_q31[n];	      \
+	struct zsl_vec_q31 name = {	      \
+		.sz = n,		      \
+		.data = name ## _vec_q31      \
+	}
+
+/** Macro to declare a Q15 matrix with `m` rows and `n` columns. */
+#define ZSL_MTX_Q15_DEF(name, m, n)	      \
+	zsl_q15_t name ## _mtx_q15[m * n];    \
+	struct zsl_mtx_q15 name = {	      \
+		.sz_rows = m,		      \
+		.sz_cols = n,		      \
+		.data = name ## _mtx_q15      \
+	}
+
+/** Macro to declare a Q31 matrix with `m` rows and `n` columns. */
+#define ZSL_MTX_Q31_DEF(name, m, n)	      \
+	zsl_q31_t name ## _mtx_q31[m * n];    \
+	struct zsl_mtx_q31 name = {	      \
+		.sz_rows = m,		      \
+		.sz_cols = n,		      \
+		.data = name ## _mtx_q31      \
+	}
+
+/** @} */ /* End of FIXEDPOINT_STRUCTS group */
+
+/**
+ * @addtogroup FIXEDPOINT_SCALAR Scalar Operations
+ *
+ * @brief Conversions and saturating arithmetic on single Q15/Q31 values.
+ *
+ * @ingroup FIXEDPOINT
+ *  @{ */
+
+/**
+ * @brief Converts 'x' to Q15, rounding to the nearest value and saturating
+ *        outside of [-1.0, 1.0).
+ *
+ * @param x     The value to convert.
+ *
+ * @return The Q15 value.
+ */
+zsl_q15_t zsl_q15_from_real(zsl_real_t x);
+
+/**
+ * @brief Converts the Q15 value 'q' to zsl_real_t. This is exact.
+ *
+ * @param q     The value to convert.
+ *
+ * @return The zsl_real_t value.
+ */
+zsl_real_t zsl_q15_to_real(zsl_q15_t q);
+
+/**
+ * @brief Converts 'x' to Q31, rounding to the nearest value and saturating
+ *        outside of [-1.0, 1.0).
+ *
+ * With single-precision floats only the 24 most significant bits of the
+ * result can be non-zero.
+ *
+ * @param x     The value to convert.
+ *
+ * @return The Q31 value.
+ */
+zsl_q31_t zsl_q31_from_real(zsl_real_t x);
+
+/**
+ * @brief Converts the Q31 value 'q' to zsl_real_t, which is exact with
+ *        double-precision floats.
+ *
+ * @param q     The value to convert.
+ *
+ * @return The zsl_real_t value.
+ */
+zsl_real_t zsl_q31_to_real(zsl_q31_t q);
+
+/** @brief Saturates 'x' to the Q15 range. */
+static inline zsl_q15_t zsl_q15_sat(int32_t x)
+{
+	return (zsl_q15_t)(x > INT16_MAX ? INT16_MAX :
+			   (x < INT16_MIN ? INT16_MIN : x));
+}
+
+/** @brief Saturates 'x' to the Q31 range. */
+static inline zsl_q31_t zsl_q31_sat(int64_t x)
+{
+	return (zsl_q31_t)(x > INT32_MAX ? INT32_MAX :
+			   (x < INT32_MIN ? INT32_MIN : x));
+}
+
+/** @brief Returns the saturated Q15 product of 'a' and 'b'. */
+static inline zsl_q15_t zsl_q15_mult(zsl_q15_t a, zsl_q15_t b)
+{
+	return zsl_q15_sat((((int32_t)a * b) + (1 << 14)) >> 15);
+}
+
+/** @brief Returns the saturated Q31 product of 'a' and 'b'. */
+static inline zsl_q31_t zsl_q31_mult(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat((((int64_t)a * b) + (1 << 30)) >> 31);
+}
+
+/** @} */ /* End of FIXEDPOINT_SCALAR group */
+
+/**
+ * @addtogroup FIXEDPOINT_VEC Vectors
+ *
+ * @brief Q15 and Q31 vector functions.
+ *
+ * @ingroup FIXEDPOINT
+ *  @{ */
+
+/**
+ * @brief Converts the elements of 'v' to Q15, saturating outside of
+ *        [-1.0, 1.0).
+ *
+ * @param vq    The output Q15 vector, of the same size as 'v'.
+ * @param v     The input vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q15_from_vec(struct zsl_vec_q15 *vq, struct zsl_vec *v);
+
+/**
+ * @brief Converts the Q15 vector 'vq' to zsl_real_t.
+ *
+ * @param vq    The input Q15 vector.
+ * @param v     The output vector, of the same size as 'vq'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q15_to_vec(struct zsl_vec_q15 *vq, struct zsl_vec *v);
+
+/**
+ * @brief Calculates 'x = v + w' element by element, with saturation.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param x     The output vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q15_add(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x);
+
+/**
+ * @brief Calculates 'x = v - w' element by element, with saturation.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param x     The output vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q15_sub(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x);
+
+/**
+ * @brief Multiplies every element of 'v' by the Q15 scalar 's', with
+ *        rounding and saturation.
+ *
+ * @param v     The vector to scale in place.
+ * @param s     The Q15 scale factor.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q15_scalar_mult(struct zsl_vec_q15 *v, zsl_q15_t s);
+
+/**
+ * @brief Calculates the dot product of 'v' and 'w', accumulated in 64 bits
+ *        and then rounded and saturated to Q15.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param d     The Q15 dot product.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q15_dot(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    zsl_q15_t *d);
+
+/**
+ * @brief Converts the elements of 'v' to Q31, saturating outside of
+ *        [-1.0, 1.0).
+ *
+ * @param vq    The output Q31 vector, of the same size as 'v'.
+ * @param v     The input vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q31_from_vec(struct zsl_vec_q31 *vq, struct zsl_vec *v);
+
+/**
+ * @brief Converts the Q31 vector 'vq' to zsl_real_t.
+ *
+ * @param vq    The input Q31 vector.
+ * @param v     The output vector, of the same size as 'vq'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q31_to_vec(struct zsl_vec_q31 *vq, struct zsl_vec *v);
+
+/**
+ * @brief Calculates 'x = v + w' element by element, with saturation.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param x     The output vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q31_add(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x);
+
+/**
+ * @brief Calculates 'x = v - w' element by element, with saturation.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param x     The output vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q31_sub(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x);
+
+/**
+ * @brief Multiplies every element of 'v' by the Q31 scalar 's', with
+ *        rounding and saturation.
+ *
+ * @param v     The vector to scale in place.
+ * @param s     The Q31 scale factor.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q31_scalar_mult(struct zsl_vec_q31 *v, zsl_q31_t s);
+
+/**
+ * @brief Calculates the dot product of 'v' and 'w', accumulated as Q46 in
+ *        64 bits and then rounded and saturated to Q31.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param d     The Q31 dot product.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_q31_dot(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    zsl_q31_t *d);
+
+/** @} */ /* End of FIXEDPOINT_VEC group */
+
+/**
+ * @addtogroup FIXEDPOINT_MTX Matrices
+ *
+ * @brief Q15 and Q31 matrix functions.
+ *
+ * @ingroup FIXEDPOINT
+ *  @{ */
+
+/**
+ * @brief Converts the elements of 'm' to Q15, saturating outside of
+ *        [-1.0, 1.0). Any layout of 'm' is accepted.
+ *
+ * @param mq    The output Q15 matrix, of the same shape as 'm'.
+ * @param m     The input matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q15_from_mtx(struct zsl_mtx_q15 *mq, struct zsl_mtx *m);
+
+/**
+ * @brief Converts the Q15 matrix 'mq' to zsl_real_t.
+ *
+ * @param mq    The input Q15 matrix.
+ * @param m     The output matrix, of the same shape as 'mq'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q15_to_mtx(struct zsl_mtx_q15 *mq, struct zsl_mtx *m);
+
+/**
+ * @brief Calculates 'mc = ma + mb' element by element, with saturation.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix.
+ * @param mc    The output matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q15_add(struct zsl_mtx_q15 *ma, struct zsl_mtx_q15 *mb,
+		    struct zsl_mtx_q15 *mc);
+
+/**
+ * @brief Calculates 'mc = ma - mb' element by element, with saturation.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix.
+ * @param mc    The output matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q15_sub(struct zsl_mtx_q15 *ma, struct zsl_mtx_q15 *mb,
+		    struct zsl_mtx_q15 *mc);
+
+/**
+ * @brief Calculates the matrix product 'mc = ma * mb'. Each element is
+ *        accumulated in 64 bits, then rounded and saturated to Q15.
+ *
+ * @param ma    The first input matrix, of size m x n.
+ * @param mb    The second input matrix, of size n x p.
+ * @param mc    The output matrix, of size m x p, which can't be 'ma' or
+ *              'mb'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q15_mult(struct zsl_mtx_q15 *ma, struct zsl_mtx_q15 *mb,
+		     struct zsl_mtx_q15 *mc);
+
+/**
+ * @brief Calculates the matrix-vector product 'w = m * v'. Each element is
+ *        accumulated in 64 bits, then rounded and saturated to Q15.
+ *
+ * @param m     The input matrix, of size m x n.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size m, which can't be 'v'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_mtx_q15_mult_vec(struct zsl_mtx_q15 *m, struct zsl_vec_q15 *v,
+			 struct zsl_vec_q15 *w);
+
+/**
+ * @brief Calculates the inverse of the 3x3 Q15 matrix 'm', scaled by a power
+ *        of two so that it fits in Q15: inv(m) = mi * 2^shift.
+ *
+ * The inverse of a matrix with elements in [-1.0, 1.0) usually has elements
+ * outside of that range, so 'shift' is chosen as the smallest value for
+ * which no element of 'mi' saturates. The calculation is carried out in
+ * Q31, see @ref zsl_mtx_q31_inv_3x3.
+ *
+ * @param m     The input 3x3 matrix.
+ * @param mi    The output 3x3 matrix, which may be 'm'.
+ * @param shift The power of two that 'mi' must be multiplied by.
+ *
+ * @return 0 on success, -EINVAL if the matrices aren't 3x3, or -ESINGULAR
+ *         if the determinant of 'm' is zero.
+ */
+int zsl_mtx_q15_inv_3x3(struct zsl_mtx_q15 *m, struct zsl_mtx_q15 *mi,
+			int *shift);
+
+/**
+ * @brief Converts the elements of 'm' to Q31, saturating outside of
+ *        [-1.0, 1.0). Any layout of 'm' is accepted.
+ *
+ * @param mq    The output Q31 matrix, of the same shape as 'm'.
+ * @param m     The input matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_from_mtx(struct zsl_mtx_q31 *mq, struct zsl_mtx *m);
+
+/**
+ * @brief Converts the Q31 matrix 'mq' to zsl_real_t.
+ *
+ * @param mq    The input Q31 matrix.
+ * @param m     The output matrix, of the same shape as 'mq'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_to_mtx(struct zsl_mtx_q31 *mq, struct zsl_mtx *m);
+
+/**
+ * @brief Calculates 'mc = ma + mb' element by element, with saturation.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix.
+ * @param mc    The output matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_add(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		    struct zsl_mtx_q31 *mc);
+
+/**
+ * @brief Calculates 'mc = ma - mb' element by element, with saturation.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix.
+ * @param mc    The output matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_sub(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		    struct zsl_mtx_q31 *mc);
+
+/**
+ * @brief Calculates the matrix product 'mc = ma * mb'. Each element is
+ *        accumulated as Q46 in 64 bits, then rounded and saturated to Q31.
+ *
+ * @param ma    The first input matrix, of size m x n.
+ * @param mb    The second input matrix, of size n x p.
+ * @param mc    The output matrix, of size m x p, which can't be 'ma' or
+ *              'mb'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_mult(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		     struct zsl_mtx_q31 *mc);
+
+/**
+ * @brief Calculates the matrix-vector product 'w = m * v'. Each element is
+ *        accumulated as Q46 in 64 bits, then rounded and saturated to Q31.
+ *
+ * @param m     The input matrix, of size m x n.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size m, which can't be 'v'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_mtx_q31_mult_vec(struct zsl_mtx_q31 *m, struct zsl_vec_q31 *v,
+			 struct zsl_vec_q31 *w);
+
+/**
+ * @brief Calculates the inverse of the 3x3 Q31 matrix 'm', scaled by a power
+ *        of two so that it fits in Q31: inv(m) = mi * 2^shift.
+ *
+ * The cofactors are calculated exactly in 64 bits and rounded to Q29, and
+ * the determinant is kept as Q60. The determinant is then normalised, so
+ * the relative precision of 'mi' doesn't depend on the magnitude of the
+ * determinant, and 'shift' is chosen as the smallest value for which no
+ * element of 'mi' saturates. Each element of 'mi' is rounded to nearest.
+ *
+ * @param m     The input 3x3 matrix.
+ * @param mi    The output 3x3 matrix, which may be 'm'.
+ * @param shift The power of two that 'mi' must be multiplied by.
+ *
+ * @return 0 on success, -EINVAL if the matrices aren't 3x3, or -ESINGULAR
+ *         if the determinant of 'm' is zero.
+ */
+int zsl_mtx_q31_inv_3x3(struct zsl_mtx_q31 *m, struct zsl_mtx_q31 *mi,
+			int *shift);
+
+/** @} */ /* End of FIXEDPOINT_MTX group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FIXEDPOINT_H_ */
+
+/** @} */ /* End of FIXEDPOINT group */
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup HALF Half-Precision Storage
+ *
+ * @brief Compact 16-bit storage for large vectors and matrices.
+ *
+ * Vectors and matrices can be stored with 16 bits per element, in one of
+ * two formats:
+ *
+ * - IEEE 754 binary16 (fp16): 11 significant bits (about 3.3 decimal
+ *   digits), with a range of +/-65504. Smaller values down to 6.0E-8 are
+ *   stored with reduced precision, and larger ones become infinity.
+ * - bfloat16 (bf16): 8 significant bits (about 2.4 decimal digits), with
+ *   the same range as a 32-bit float.
+ *
+ * This halves the memory used by a single-precision payload, and quarters
+ * that of a double-precision one. Packing rounds to the nearest value, with
+ * ties to even. Unpacking is exact.
+ *
+ * The dot product, the matrix-vector and matrix-matrix products, and the
+ * mean and variance in @ref STATISTICS read the compact data directly, a
+ * block at a time, and accumulate in zsl_real_t. No full-size copy in
+ * zsl_real_t is needed.
+ *
+ * The pack and unpack kernels can be replaced by platform-specific versions
+ * through CONFIG_ZSL_PLATFORM_OPT, in the same way as the vector functions.
+ */
+
+/**
+ * @file
+ * @brief API header file for half-precision storage in zscilib.
+ *
+ * This file contains the zscilib fp16/bf16 APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_HALF_H_
+#define ZEPHYR_INCLUDE_ZSL_HALF_H_
+
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup HALF_STRUCTS Structs, Enums and Macros
+ *
+ * @brief Half-precision types, and macros to declare compact objects.
+ *
+ * @ingroup HALF
+ *  @{ */
+
+/** A 16-bit value, in one of the formats of @ref zsl_half_fmt. */
+typedef uint16_t zsl_half_t;
+
+/** The number of elements unpacked at a time by the compact kernels. */
+#define ZSL_HALF_BLOCK (32)
+
+/** @brief The 16-bit storage formats. */
+enum zsl_half_fmt {
+	/** IEEE 754 binary16: 1 sign, 5 exponent and 10 fraction bits. */
+	ZSL_HALF_FP16 = 0,
+	/** bfloat16: 1 sign, 8 exponent and 7 fraction bits. */
+	ZSL_HALF_BF16,
+};
+
+/** @brief Represents a vector stored with 16 bits per element. */
+struct zsl_vec_half {
+	/** The number of elements in the vector. */
+	size_t sz;
+	/** The storage format of 'data'. */
+	enum zsl_half_fmt fmt;
+	/** The packed data assigned to the vector. */
+	zsl_half_t *data;
+};
+
+/** @brief Represents a row-major matrix stored with 16 bits per element. */
+struct zsl_mtx_half {
+	/** The number of rows in the matrix. */
+	size_t sz_rows;
+	/** The number of columns in the matrix. */
+	size_t sz_cols;
+	/** The storage format of 'data'. */
+	enum zsl_half_fmt fmt;
+	/** The packed data assigned to the matrix, in row-major order. */
+	zsl_half_t *data;
+};
+
+/** Macro to declare a vector of size `n`, stored in format `f`. */
+#define ZSL_VEC_HALF_DEF(name, n, f)	      \
+	zsl_half_t name ## _vec_half[n];      \
+	struct zsl_vec_half name = {	      \
+		.sz = n,		      \
+		.fmt = f,		      \
+		.data = name ## _vec_half     \
+	}
+
+/**
+ * Macro to declare a matrix with `m` rows and `n` columns, stored in
+ * format `f`.
+ */
+#define ZSL_MTX_HALF_DEF(name, m, n, f)	      \
+	zsl_half_t name ## _mtx_half[m * n];  \
+	struct zsl_mtx_half name = {	      \
+		.sz_rows = m,		      \
+		.sz_cols = n,		      \
+		.fmt = f,		      \
+		.data = name ## _mtx_half     \
+	}
+
+/** @} */ /* End of HALF_STRUCTS group */
+
+/**
+ * @addtogroup HALF_CONV Conversions
+ *
+ * @brief Conversions between zsl_real_t and the 16-bit formats.
+ *
+ * @ingroup HALF
+ *  @{ */
+
+/**
+ * @brief Converts 'x' to format 'fmt', rounding to the nearest value with
+ *        ties to even.
+ *
+ * Values too large for fp16 become +/-infinity, and NaN stays NaN. With
+ * double-precision floats, 'x' is rounded to single precision first.
+ *
+ * @param x     The value to convert.
+ * @param fmt   The output format.
+ *
+ * @return The packed value.
+ */
+zsl_half_t zsl_half_from_real(zsl_real_t x, enum zsl_half_fmt fmt);
+
+/**
+ * @brief Converts the packed value 'h' in format 'fmt' to zsl_real_t. This
+ *        is exact.
+ *
+ * @param h     The value to convert.
+ * @param fmt   The format of 'h'.
+ *
+ * @return The zsl_real_t value.
+ */
+zsl_real_t zsl_half_to_real(zsl_half_t h, enum zsl_half_fmt fmt);
+
+/**
+ * @brief Packs 'n' values from 'x' into 'h', in format 'fmt'.
+ *
+ * @param x     The input values.
+ * @param h     The output array, of at least 'n' elements.
+ * @param n     The number of values to convert.
+ * @param fmt   The output format.
+ *
+ * @return 0 on success, or -EINVAL if 'fmt' is unknown.
+ */
+int zsl_half_pack(const zsl_real_t *x, zsl_half_t *h, size_t n,
+		  enum zsl_half_fmt fmt);
+
+/**
+ * @brief Unpacks 'n' values in format 'fmt' from 'h' into 'x'.
+ *
+ * @param h     The input values.
+ * @param x     The output array, of at least 'n' elements.
+ * @param n     The number of values to convert.
+ * @param fmt   The format of 'h'.
+ *
+ * @return 0 on success, or -EINVAL if 'fmt' is unknown.
+ */
+int zsl_half_unpack(const zsl_half_t *h, zsl_real_t *x, size_t n,
+		    enum zsl_half_fmt fmt);
+
+/** @} */ /* End of HALF_CONV group */
+
+/**
+ * @addtogroup HALF_VEC_MTX Vectors and Matrices
+ *
+ * @brief Compact vector and matrix functions.
+ *
+ * @ingroup HALF
+ *  @{ */
+
+/**
+ * @brief Packs the vector 'v' into 'vh', in the format of 'vh'.
+ *
+ * @param vh    The output compact vector, of the same size as 'v'.
+ * @param v     The input vector.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_half_pack(struct zsl_vec_half *vh, struct zsl_vec *v);
+
+/**
+ * @brief Unpacks the compact vector 'vh' into 'v'.
+ *
+ * @param vh    The input compact vector.
+ * @param v     The output vector, of the same size as 'vh'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_half_unpack(struct zsl_vec_half *vh, struct zsl_vec *v);
+
+/**
+ * @brief Calculates the dot product of two compact vectors, which may use
+ *        different formats, accumulating in zsl_real_t.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param d     The dot product.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_vec_half_dot(struct zsl_vec_half *v, struct zsl_vec_half *w,
+		     zsl_real_t *d);
+
+/**
+ * @brief Packs the matrix 'm' into 'mh', in the format of 'mh'. Any layout
+ *        of 'm' is accepted.
+ *
+ * @param mh    The output compact matrix, of the same shape as 'm'.
+ * @param m     The input matrix.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_half_pack(struct zsl_mtx_half *mh, struct zsl_mtx *m);
+
+/**
+ * @brief Unpacks the compact matrix 'mh' into 'm'.
+ *
+ * @param mh    The input compact matrix.
+ * @param m     The output matrix, of the same shape as 'mh'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_half_unpack(struct zsl_mtx_half *mh, struct zsl_mtx *m);
+
+/**
+ * @brief Calculates the matrix-vector product 'w = m * v', where 'm' is
+ *        compact, accumulating in zsl_real_t.
+ *
+ * @param m     The input compact matrix, of size m x n.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size m, which can't be 'v'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_mtx_half_mult_vec(struct zsl_mtx_half *m, struct zsl_vec *v,
+			  struct zsl_vec *w);
+
+/**
+ * @brief Calculates the matrix product 'mc = ma * mb' of two compact
+ *        matrices, which may use different formats, accumulating in
+ *        zsl_real_t.
+ *
+ * @param ma    The first input matrix, of size m x n.
+ * @param mb    The second input matrix, of size n x p.
+ * @param mc    The output matrix, of size m x p.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_half_mult(struct zsl_mtx_half *ma, struct zsl_mtx_half *mb,
+		      struct zsl_mtx *mc);
+
+/** @} */ /* End of HALF_VEC_MTX group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_HALF_H_ */
+
+/** @} */ /* End of HALF group */
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <zsl/zsl.h>
+#include <zsl/workspace.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -186,11 +187,47 @@ int zsl_interp_lin_x(struct zsl_interp_xy *xy1, struct zsl_interp_xy *xy3,
  * @param yp1 1st derivative at 1. Set to >= 1e30 for natural spline.
  * @param ypn 1st derivative at n'th point. Set to >= 1e30 for natural spline.
  *
+ * The second derivatives are the solution of a tridiagonal system, which
+ * is solved with zsl_mtx_tridiag_solve. Temporary values are declared on
+ * the stack. Use 'zsl_interp_cubic_calc_ws' to take them from a workspace
+ * instead.
+ *
  * NOTE: This function must be called BEFORE using zsl_interp_cubic_arr.
+ *
+ * @return 0 on success, -EINVAL if n < 3, or -ESINGULAR if two X values
+ *         are identical.
  */
 int zsl_interp_cubic_calc (struct zsl_interp_xyc xyc[], size_t n,
                            zsl_real_t yp1, zsl_real_t ypn);
 
+/**
+ * @brief Same as 'zsl_interp_cubic_calc', but takes all temporary storage
+ *        from the workspace 'ws' rather than from the stack.
+ *
+ * @param xyc The array of X,Y,Y2 values to use when interpolating (min four!).
+ * @param n   The number of elements in the X,Y,Y2 array.
+ * @param yp1 1st derivative at 1. Set to >= 1e30 for natural spline.
+ * @param ypn 1st derivative at n'th point. Set to >= 1e30 for natural spline.
+ * @param ws  The workspace, of at least 'zsl_interp_cubic_calc_ws_size'
+ *            bytes.
+ *
+ * @return 0 on success, -EINVAL if n < 3, -ENOMEM if 'ws' is too small,
+ *         or -ESINGULAR if two X values are identical.
+ */
+int zsl_interp_cubic_calc_ws(struct zsl_interp_xyc xyc[], size_t n,
+                             zsl_real_t yp1, zsl_real_t ypn,
+                             struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_interp_cubic_calc_ws'
+ *        needs for 'n' X,Y,Y2 values.
+ *
+ * @param n   The number of elements in the X,Y,Y2 array.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_interp_cubic_calc_ws_size(size_t n);
+
 /**
  * @brief Natural cubic spline interpolation between two points, based on
  *        zsl_real_ts.
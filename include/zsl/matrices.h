@@ -24,6 +24,7 @@
 
 #include <zsl/zsl.h>
 #include <zsl/vectors.h>
+#include <zsl/workspace.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,8 +42,26 @@ extern "C" {
 #define EEIGENSIZE   (100)
 /** Error: Occurs when the input matrix has complex eigenvalues. */
 #define ECOMPLEXVAL  (101)
-
-/** @brief Represents a m x n matrix, with data stored in row-major order. */
+/** Error: Occurs when the input matrix is singular (has no inverse). */
+#define ESINGULAR    (102)
+/** Error: An iterative method failed to converge in the allowed steps. */
+#define ENOCONVERGE  (103)
+/** Error: Occurs when the input matrix is not positive definite. */
+#define ENOTPOSDEF   (104)
+
+/**
+ * @brief Represents a m x n matrix, with data stored in row-major order.
+ *
+ * A matrix can also be a view of a block of another matrix (see
+ * @ref zsl_mtx_view), in which case 'data' points into the parent's buffer
+ * and 'stride' is the parent's row length, or a transposed view of another
+ * matrix (see @ref zsl_mtx_trans_view), in which case 'trans' is set and
+ * 'data' holds the matrix in column-major order. Views are accepted by the
+ * data access functions, @ref zsl_mtx_init, @ref zsl_mtx_copy, the unary
+ * and binary operations, @ref zsl_mtx_add, @ref zsl_mtx_sub, the scalar and
+ * row operations, the @ref zsl_mtx_mult family and @ref zsl_mtx_trans. All
+ * other functions require contiguous matrices.
+ */
 struct zsl_mtx {
 	/** The number of rows in the matrix (typically denoted as 'm'). */
 	size_t sz_rows;
@@ -50,8 +69,42 @@ struct zsl_mtx {
 	size_t sz_cols;
 	/** Data assigned to the matrix, in row-major order (left to right). */
 	zsl_real_t *data;
+	/**
+	 * The number of elements between the start of two consecutive rows in
+	 * 'data' (columns if 'trans' is set), or 0 if they are contiguous.
+	 */
+	size_t stride;
+	/**
+	 * If true, 'data' is stored in column-major order, so that the value
+	 * at (i, j) is at data[(j * stride) + i].
+	 */
+	bool trans;
 };
 
+/** The number of rows of matrix 'm' as laid out in 'data'. */
+#define ZSL_MTX_STORE_ROWS(m) ((m)->trans ? (m)->sz_cols : (m)->sz_rows)
+
+/** The number of columns of matrix 'm' as laid out in 'data'. */
+#define ZSL_MTX_STORE_COLS(m) ((m)->trans ? (m)->sz_rows : (m)->sz_cols)
+
+/** The distance in elements between two consecutive rows of 'data'. */
+#define ZSL_MTX_STRIDE(m) ((m)->stride ? (m)->stride : ZSL_MTX_STORE_COLS(m))
+
+/** The distance in elements between (i, j) and (i + 1, j) of matrix 'm'. */
+#define ZSL_MTX_ROW_STEP(m) ((m)->trans ? 1 : ZSL_MTX_STRIDE(m))
+
+/** The distance in elements between (i, j) and (i, j + 1) of matrix 'm'. */
+#define ZSL_MTX_COL_STEP(m) ((m)->trans ? ZSL_MTX_STRIDE(m) : 1)
+
+/** True if the rows of matrix 'm' are stored contiguously. */
+#define ZSL_MTX_IS_CONTIG(m) \
+	(!(m)->trans &&	     \
+	 (((m)->stride == 0) || ((m)->stride == (m)->sz_cols)))
+
+/** The element at row 'i' and column 'j' of matrix 'm', in any layout. */
+#define ZSL_MTX_AT(m, i, j) \
+	((m)->data[((i) * ZSL_MTX_ROW_STEP(m)) + ((j) * ZSL_MTX_COL_STEP(m))])
+
 /**
  * Macro to declare a matrix of shape m*n.
  *
@@ -63,7 +116,90 @@ struct zsl_mtx {
 	struct zsl_mtx name = {		\
 		.sz_rows = m,		\
 		.sz_cols = n,		\
-		.data = name ## _mtx	\
+		.data = name ## _mtx,	\
+		.stride = 0,		\
+		.trans = false		\
+	}
+
+/**
+ * @brief Represents a n x n banded matrix, with 'kl' non-zero diagonals
+ *        below the main diagonal and 'ku' above it.
+ *
+ * Row i is stored in 'data' as the 2 * kl + ku + 1 values of columns
+ * i - kl to i + ku + kl, so that the value at (i, j) is at
+ * data[(i * (2 * kl + ku + 1)) + j - i + kl]. The last 'kl' values of each
+ * row are only used to hold the fill-in of @ref zsl_mtx_band_lu. Values
+ * that fall outside of the matrix are unused.
+ */
+struct zsl_mtx_band {
+	/** The number of rows and columns in the matrix. */
+	size_t sz;
+	/** The number of sub-diagonals. */
+	size_t kl;
+	/** The number of super-diagonals. */
+	size_t ku;
+	/** The band values, in the row-major layout described above. */
+	zsl_real_t *data;
+};
+
+/** The number of values stored per row of banded matrix 'b'. */
+#define ZSL_MTX_BAND_WIDTH(b) ((2 * (b)->kl) + (b)->ku + 1)
+
+/**
+ * Macro to declare a n x n banded matrix with 'kl' sub-diagonals and 'ku'
+ * super-diagonals.
+ *
+ * Be sure to also call 'zsl_mtx_band_init' on the matrix after this macro.
+ */
+#define ZSL_MTX_BAND_DEF(name, n, l, u)				    \
+	zsl_real_t name ## _band[(n) * ((2 * (l)) + (u) + 1)];	    \
+	struct zsl_mtx_band name = {				    \
+		.sz = n,					    \
+		.kl = l,					    \
+		.ku = u,					    \
+		.data = name ## _band				    \
+	}
+
+/**
+ * @brief Represents the state of a streaming linear least squares fit of
+ *        'A * x = b', with n unknowns and 'nrhs' right-hand sides.
+ *
+ * Rows of 'A' and 'b' are folded into the upper triangular factor 'R' of
+ * the QR decomposition of 'A' as they arrive, so the memory used doesn't
+ * depend on the number of rows. See @ref zsl_mtx_lstsq_add.
+ */
+struct zsl_mtx_lstsq {
+	/** The n x n upper triangular factor R. */
+	struct zsl_mtx r;
+	/** The n x nrhs matrix Q^T * b. */
+	struct zsl_mtx qtb;
+	/** The sum of the squared residuals of each right-hand side. */
+	struct zsl_vec ssr;
+	/** Scratch row of n + nrhs values. */
+	struct zsl_vec work;
+	/** The number of rows added so far. */
+	size_t rows;
+};
+
+/**
+ * Macro to declare the state of a least squares fit with 'n' unknowns and
+ * 'nrhs' right-hand sides.
+ *
+ * Be sure to also call 'zsl_mtx_lstsq_init' on the state after this macro.
+ */
+#define ZSL_MTX_LSTSQ_DEF(name, n, nrhs)				\
+	zsl_real_t name ## _r[(n) * (n)];				\
+	zsl_real_t name ## _qtb[(n) * (nrhs)];				\
+	zsl_real_t name ## _ssr[nrhs];					\
+	zsl_real_t name ## _work[(n) + (nrhs)];				\
+	struct zsl_mtx_lstsq name = {					\
+		.r = { .sz_rows = n, .sz_cols = n,			\
+		       .data = name ## _r },				\
+		.qtb = { .sz_rows = n, .sz_cols = nrhs,			\
+			 .data = name ## _qtb },			\
+		.ssr = { .sz = nrhs, .data = name ## _ssr },		\
+		.work = { .sz = (n) + (nrhs), .data = name ## _work },	\
+		.rows = 0						\
 	}
 
 /** @} */ /* End of MTX_STRUCTS group */
@@ -336,6 +472,26 @@ int zsl_mtx_get_col(struct zsl_mtx *m, size_t j, zsl_real_t *v);
  */
 int zsl_mtx_set_col(struct zsl_mtx *m, size_t j, zsl_real_t *v);
 
+/**
+ * @brief Makes 'mv' a view of the 'rows' x 'cols' block of matrix 'm'
+ *        starting at row 'i' and column 'j', without copying any data.
+ *
+ * Writing to the view writes to the matching elements of 'm'. 'm' can
+ * itself be a view.
+ *
+ * @param m     Pointer to the parent zsl_mtx.
+ * @param mv    Pointer to the zsl_mtx that will describe the view.
+ * @param i     The first row of the block (0-based).
+ * @param j     The first column of the block (0-based).
+ * @param rows  The number of rows in the block.
+ * @param cols  The number of columns in the block.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the block
+ *          isn't inside 'm'.
+ */
+int zsl_mtx_view(struct zsl_mtx *m, struct zsl_mtx *mv, size_t i, size_t j,
+		 size_t rows, size_t cols);
+
 /** @} */ /* End of MTX_DATAACCESS group */
 
 /**
@@ -498,6 +654,10 @@ int zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
  *        'ma' must have the same numbers of columns as there are rows
  *        in 'mb'.
  *
+ * Dedicated kernels are used for 3x3, 4x4 and 6x6 square matrices, and a
+ * cache-blocked kernel operating on 4x4 output tiles is used for all other
+ * shapes. 'mc' must not point to the same data as 'ma' or 'mb'.
+ *
  * @param ma    Pointer to the first input zsl_mtx.
  * @param mb    Pointer to the second input zsl_mtx.
  * @param mc    Pointer to the output zsl_mtx.
@@ -507,6 +667,124 @@ int zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
  */
 int zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
 
+/**
+ * @brief Multiplies the transpose of matrix 'ma' by 'mb', assigning the
+ *        output to 'mc'. 'ma' is read in place, so no transposed copy of
+ *        'ma' is required. Matrices 'ma' and 'mb' must have the same number
+ *        of rows.
+ *
+ * @param ma    Pointer to the first input zsl_mtx, which will be transposed.
+ * @param mb    Pointer to the second input zsl_mtx.
+ * @param mc    Pointer to the output zsl_mtx, of shape
+ *              ma->sz_cols x mb->sz_cols.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the input
+ *          matrices are not compatibly shaped.
+ */
+int zsl_mtx_mult_trans_a(struct zsl_mtx *ma, struct zsl_mtx *mb,
+			 struct zsl_mtx *mc);
+
+/**
+ * @brief Multiplies matrix 'ma' by the transpose of 'mb', assigning the
+ *        output to 'mc'. 'mb' is read in place, so no transposed copy of
+ *        'mb' is required. Matrices 'ma' and 'mb' must have the same number
+ *        of columns.
+ *
+ * @param ma    Pointer to the first input zsl_mtx.
+ * @param mb    Pointer to the second input zsl_mtx, which will be transposed.
+ * @param mc    Pointer to the output zsl_mtx, of shape
+ *              ma->sz_rows x mb->sz_rows.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the input
+ *          matrices are not compatibly shaped.
+ */
+int zsl_mtx_mult_trans_b(struct zsl_mtx *ma, struct zsl_mtx *mb,
+			 struct zsl_mtx *mc);
+
+/**
+ * @brief General matrix-matrix multiply and accumulate, calculating
+ *        'mc = alpha * op(ma) * op(mb) + beta * mc' in a single pass, where
+ *        op(x) is either 'x' or its transpose.
+ *
+ * Transposed operands are read in place. When 'beta' is 0.0 the previous
+ * contents of 'mc' are ignored, so it doesn't need to be initialised.
+ * 'mc' must not point to the same data as 'ma' or 'mb'.
+ *
+ * @param ta    If true, op(ma) is the transpose of 'ma'.
+ * @param tb    If true, op(mb) is the transpose of 'mb'.
+ * @param alpha The scalar to multiply op(ma) * op(mb) by.
+ * @param ma    Pointer to the first input zsl_mtx.
+ * @param mb    Pointer to the second input zsl_mtx.
+ * @param beta  The scalar to multiply the initial value of 'mc' by.
+ * @param mc    Pointer to the input/output zsl_mtx, with as many rows as
+ *              op(ma) and as many columns as op(mb).
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          are not compatibly shaped.
+ */
+int zsl_mtx_gemm(bool ta, bool tb, zsl_real_t alpha, struct zsl_mtx *ma,
+		 struct zsl_mtx *mb, zsl_real_t beta, struct zsl_mtx *mc);
+
+/**
+ * @brief General matrix-vector multiply and accumulate, calculating
+ *        'y = alpha * op(ma) * x + beta * y', where op(ma) is either 'ma'
+ *        or its transpose.
+ *
+ * When 'beta' is 0.0 the previous contents of 'y' are ignored.
+ *
+ * @param ta    If true, op(ma) is the transpose of 'ma'.
+ * @param alpha The scalar to multiply op(ma) * x by.
+ * @param ma    Pointer to the input zsl_mtx.
+ * @param x     The input vector, with as many elements as op(ma) has
+ *              columns.
+ * @param beta  The scalar to multiply the initial value of 'y' by.
+ * @param y     The input/output vector, with as many elements as op(ma)
+ *              has rows. Must not be the same vector as 'x'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_gemv(bool ta, zsl_real_t alpha, struct zsl_mtx *ma,
+		 struct zsl_vec *x, zsl_real_t beta, struct zsl_vec *y);
+
+/**
+ * @brief Applies the rank-1 update 'ma = alpha * x * y^T + ma' in place,
+ *        without forming the outer product 'x * y^T'.
+ *
+ * @param alpha The scalar to multiply the outer product by.
+ * @param x     The column vector, with as many elements as 'ma' has rows.
+ * @param y     The row vector, with as many elements as 'ma' has columns.
+ * @param ma    Pointer to the zsl_mtx to update.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_ger(zsl_real_t alpha, struct zsl_vec *x, struct zsl_vec *y,
+		struct zsl_mtx *ma);
+
+/**
+ * @brief Symmetric rank-k update, calculating
+ *        'mc = alpha * ma * ma^T + beta * mc', or
+ *        'mc = alpha * ma^T * ma + beta * mc' if 'ta' is true.
+ *
+ * Only the upper triangle of the result is calculated, which is then
+ * mirrored into the lower triangle, so this takes roughly half the work of
+ * @ref zsl_mtx_gemm. 'mc' is assumed to be symmetric: only its upper
+ * triangle is read when 'beta' is non-zero.
+ *
+ * @param ta    If true, calculate ma^T * ma rather than ma * ma^T.
+ * @param alpha The scalar to multiply the product by.
+ * @param ma    Pointer to the input zsl_mtx.
+ * @param beta  The scalar to multiply the initial value of 'mc' by.
+ * @param mc    Pointer to the square input/output zsl_mtx. Must not point
+ *              to the same data as 'ma'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'mc' has the
+ *          wrong shape.
+ */
+int zsl_mtx_syrk(bool ta, zsl_real_t alpha, struct zsl_mtx *ma,
+		 zsl_real_t beta, struct zsl_mtx *mc);
+
 /**
  * @brief Multiplies all elements in matrix 'm' by scalar value 's'.
  *
@@ -553,6 +831,21 @@ int zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s);
  */
 int zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb);
 
+/**
+ * @brief Makes 'mt' a view of the transpose of matrix 'ma', in O(1) and
+ *        without copying any data.
+ *
+ * 'mt' shares the buffer of 'ma', and reads and writes through it. Passing
+ * the same matrix as 'ma' and 'mt' transposes that matrix in place. The
+ * transpose of a transposed view is a regular row-major matrix again.
+ *
+ * @param ma    Pointer to the matrix to transpose.
+ * @param mt    Pointer to the zsl_mtx that will describe the transpose.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_mtx_trans_view(struct zsl_mtx *ma, struct zsl_mtx *mt);
+
 /**
  * @brief Calculates the ajoint matrix, based on the input 3x3 matrix 'm'.
  *
@@ -632,6 +925,11 @@ int zsl_mtx_deter_3x3(struct zsl_mtx *m, zsl_real_t *d);
 /**
  * @brief Calculates the determinant of the input square matrix 'm'.
  *
+ * For matrices larger than 3x3, the determinant is calculated from the LU
+ * decomposition of 'm' (see @ref zsl_mtx_lu), using O(n^3) operations and
+ * a single nxn temporary matrix on the stack. Use 'zsl_mtx_deter_ws' to
+ * take the temporary matrix from a workspace instead.
+ *
  * @param m     The input square matrix to use.
  * @param d     The determinant of square matrix m.
  *
@@ -640,6 +938,31 @@ int zsl_mtx_deter_3x3(struct zsl_mtx *m, zsl_real_t *d);
  */
 int zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d);
 
+/**
+ * @brief Same as 'zsl_mtx_deter', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input square matrix to use.
+ * @param d     The determinant of square matrix m.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_deter_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if this isn't a
+ *          square matrix, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_deter_ws(struct zsl_mtx *m, zsl_real_t *d,
+		     struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_deter_ws' needs for
+ *        an nxn matrix.
+ *
+ * @param n     The number of rows and columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_deter_ws_size(size_t n);
+
 /**
  * @brief Given the element (i,j) in matrix 'm', this function performs
  *        gaussian elimination by adding row 'i' to the other rows until
@@ -758,7 +1081,11 @@ int zsl_mtx_norm_elem_d(struct zsl_mtx *m, struct zsl_mtx *mi,
 int zsl_mtx_inv_3x3(struct zsl_mtx *m, struct zsl_mtx *mi);
 
 /**
- * @brief Calculates the inverse of square matrix 'm'.
+ * @brief Calculates the inverse of square matrix 'm'. If 'm' is singular,
+ *        an identity matrix will be returned via 'mi'.
+ *
+ * For matrices larger than 3x3, the inverse is calculated from the LU
+ * decomposition of 'm' (see @ref zsl_mtx_lu).
  *
  * @param m     The input square matrix to use.
  * @param mi    The output inverse square matrix.
@@ -768,6 +1095,400 @@ int zsl_mtx_inv_3x3(struct zsl_mtx *m, struct zsl_mtx *mi);
  */
 int zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi);
 
+/**
+ * @brief Same as 'zsl_mtx_inv', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input square matrix to use.
+ * @param mi    The output inverse square matrix.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_inv_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if this isn't a
+ *          square matrix, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_inv_ws(struct zsl_mtx *m, struct zsl_mtx *mi,
+		   struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_inv_ws' needs for
+ *        an nxn matrix.
+ *
+ * @param n     The number of rows and columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_inv_ws_size(size_t n);
+
+/**
+ * @brief Performs the LU decomposition of square matrix 'm' with partial
+ *        (row) pivoting, such that P * m = L * U.
+ *
+ * The unit lower triangular matrix L and the upper triangular matrix U are
+ * packed into a single output matrix 'lu': the elements below the diagonal
+ * hold L (whose diagonal elements are implicitly 1.0), and the diagonal and
+ * the elements above it hold U. Row swaps are recorded in 'piv', where
+ * row 'k' was exchanged with row 'piv[k]' during step 'k' of the
+ * factorisation.
+ *
+ * The factors can then be reused by @ref zsl_mtx_lu_deter,
+ * @ref zsl_mtx_lu_solve and @ref zsl_mtx_lu_inv, avoiding repeated O(n^3)
+ * work when the same matrix is used several times.
+ *
+ * @param m     The input square matrix to decompose.
+ * @param lu    The output square matrix where the packed L and U factors
+ *              will be stored. This may point to the same matrix as 'm' for
+ *              an in-place decomposition.
+ * @param piv   Pointer to an array of at least m->sz_rows elements where the
+ *              row pivot indices will be stored.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          are not square or are not identically shaped. A singular input
+ *          matrix is not considered an error here, but will result in a
+ *          zero-valued diagonal element in U.
+ */
+int zsl_mtx_lu(struct zsl_mtx *m, struct zsl_mtx *lu, size_t *piv);
+
+/**
+ * @brief Calculates the determinant of a matrix from the LU factors
+ *        generated by @ref zsl_mtx_lu.
+ *
+ * @param lu    The packed LU square matrix generated by zsl_mtx_lu.
+ * @param piv   The row pivot indices generated by zsl_mtx_lu.
+ * @param d     The determinant of the original square matrix.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if this isn't a
+ *          square matrix.
+ */
+int zsl_mtx_lu_deter(struct zsl_mtx *lu, size_t *piv, zsl_real_t *d);
+
+/**
+ * @brief Solves the linear system 'm * x = b' using the LU factors of 'm'
+ *        generated by @ref zsl_mtx_lu.
+ *
+ * Each column in 'b' is treated as an independent right-hand side, allowing
+ * several systems sharing the same coefficient matrix to be solved in a
+ * single call.
+ *
+ * @param lu    The packed LU nxn matrix generated by zsl_mtx_lu.
+ * @param piv   The row pivot indices generated by zsl_mtx_lu.
+ * @param b     The nxk matrix containing the right-hand side column vectors.
+ * @param x     The nxk output matrix where the solution column vectors will
+ *              be stored. This may point to the same matrix as 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ESINGULAR if the original matrix is
+ *          singular.
+ */
+int zsl_mtx_lu_solve(struct zsl_mtx *lu, size_t *piv, struct zsl_mtx *b,
+		     struct zsl_mtx *x);
+
+/**
+ * @brief Calculates the inverse of a square matrix from the LU factors
+ *        generated by @ref zsl_mtx_lu.
+ *
+ * @param lu    The packed LU square matrix generated by zsl_mtx_lu.
+ * @param piv   The row pivot indices generated by zsl_mtx_lu.
+ * @param mi    The output inverse square matrix.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not square or are not identically shaped, or -ESINGULAR if the
+ *          original matrix is singular.
+ */
+int zsl_mtx_lu_inv(struct zsl_mtx *lu, size_t *piv, struct zsl_mtx *mi);
+
+/**
+ * @brief Performs the Cholesky decomposition of the symmetric
+ *        positive-definite matrix 'm', such that m = L * L^T.
+ *
+ * Only the lower triangle of 'm' is read. The lower triangular factor L is
+ * stored in 'l', with the elements above the diagonal set to zero. This
+ * takes about half the operations of @ref zsl_mtx_lu, and the factor can be
+ * reused by @ref zsl_mtx_cho_solve, @ref zsl_mtx_cho_update and
+ * @ref zsl_mtx_cho_downdate.
+ *
+ * @param m     The input symmetric positive-definite square matrix.
+ * @param l     The output lower triangular square matrix. This may point to
+ *              the same matrix as 'm' for an in-place decomposition.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not square or are not identically shaped, or -ENOTPOSDEF if 'm'
+ *          isn't positive definite.
+ */
+int zsl_mtx_cholesky(struct zsl_mtx *m, struct zsl_mtx *l);
+
+/**
+ * @brief Performs the LDL^T decomposition of the symmetric matrix 'm', such
+ *        that m = L * D * L^T, where L is unit lower triangular and D is
+ *        diagonal.
+ *
+ * Unlike @ref zsl_mtx_cholesky, no square roots are needed and 'm' doesn't
+ * have to be positive definite, although no pivoting takes place so the
+ * decomposition is only reliable for positive-definite or diagonally
+ * dominant matrices. Only the lower triangle of 'm' is read.
+ *
+ * The elements below the diagonal of 'ld' hold L (whose diagonal elements
+ * are implicitly 1.0), the diagonal holds D, and the elements above the
+ * diagonal are set to zero.
+ *
+ * @param m     The input symmetric square matrix.
+ * @param ld    The output square matrix where the packed L and D factors
+ *              will be stored. This may point to the same matrix as 'm'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not square or are not identically shaped, or -ESINGULAR if a
+ *          zero pivot was found.
+ */
+int zsl_mtx_ldl(struct zsl_mtx *m, struct zsl_mtx *ld);
+
+/**
+ * @brief Solves 'l * x = b' by forward substitution, where 'l' is lower
+ *        triangular. Only the lower triangle of 'l' is read.
+ *
+ * @param l     The lower triangular nxn matrix.
+ * @param b     The nxk matrix containing the right-hand side column vectors.
+ * @param x     The nxk output matrix, which may point to the same matrix as
+ *              'b'.
+ * @param unit  If true, the diagonal of 'l' is taken to be all 1.0, as in the
+ *              factors generated by @ref zsl_mtx_lu or @ref zsl_mtx_ldl.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ESINGULAR if 'l' is singular.
+ */
+int zsl_mtx_solve_lower(struct zsl_mtx *l, struct zsl_mtx *b,
+			struct zsl_mtx *x, bool unit);
+
+/**
+ * @brief Solves 'u * x = b' by back substitution, where 'u' is upper
+ *        triangular. Only the upper triangle of 'u' is read.
+ *
+ * @param u     The upper triangular nxn matrix.
+ * @param b     The nxk matrix containing the right-hand side column vectors.
+ * @param x     The nxk output matrix, which may point to the same matrix as
+ *              'b'.
+ * @param unit  If true, the diagonal of 'u' is taken to be all 1.0.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ESINGULAR if 'u' is singular.
+ */
+int zsl_mtx_solve_upper(struct zsl_mtx *u, struct zsl_mtx *b,
+			struct zsl_mtx *x, bool unit);
+
+/**
+ * @brief Solves the linear system 'm * x = b' using the Cholesky factor of
+ *        'm' generated by @ref zsl_mtx_cholesky.
+ *
+ * Each column in 'b' is treated as an independent right-hand side.
+ *
+ * @param l     The lower triangular nxn Cholesky factor of 'm'.
+ * @param b     The nxk matrix containing the right-hand side column vectors.
+ * @param x     The nxk output matrix where the solution column vectors will
+ *              be stored. This may point to the same matrix as 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ESINGULAR if 'l' is singular.
+ */
+int zsl_mtx_cho_solve(struct zsl_mtx *l, struct zsl_mtx *b,
+		      struct zsl_mtx *x);
+
+/**
+ * @brief Solves the linear system 'm * x = b' using the LDL^T factors of
+ *        'm' generated by @ref zsl_mtx_ldl.
+ *
+ * Each column in 'b' is treated as an independent right-hand side.
+ *
+ * @param ld    The packed LDL^T nxn matrix generated by zsl_mtx_ldl.
+ * @param b     The nxk matrix containing the right-hand side column vectors.
+ * @param x     The nxk output matrix where the solution column vectors will
+ *              be stored. This may point to the same matrix as 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ESINGULAR if D has a zero element.
+ */
+int zsl_mtx_ldl_solve(struct zsl_mtx *ld, struct zsl_mtx *b,
+		      struct zsl_mtx *x);
+
+/**
+ * @brief Updates the Cholesky factor 'l' of 'm' in place, so that it becomes
+ *        the Cholesky factor of m + v * v^T, in O(n^2) operations.
+ *
+ * @param l     The lower triangular nxn Cholesky factor to update.
+ * @param v     The vector of n elements to add. Its contents are destroyed.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'l' and 'v' are
+ *          not compatibly shaped, or -ENOTPOSDEF if 'l' has a zero on its
+ *          diagonal, and so isn't the Cholesky factor of a positive
+ *          definite matrix.
+ */
+int zsl_mtx_cho_update(struct zsl_mtx *l, struct zsl_vec *v);
+
+/**
+ * @brief Downdates the Cholesky factor 'l' of 'm' in place, so that it
+ *        becomes the Cholesky factor of m - v * v^T, in O(n^2) operations.
+ *
+ * @param l     The lower triangular nxn Cholesky factor to downdate.
+ * @param v     The vector of n elements to remove. Its contents are
+ *              destroyed.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'l' and 'v' are
+ *          not compatibly shaped, or -ENOTPOSDEF if m - v * v^T isn't
+ *          positive definite, in which case the contents of 'l' are no
+ *          longer valid.
+ */
+int zsl_mtx_cho_downdate(struct zsl_mtx *l, struct zsl_vec *v);
+
+/**
+ * @brief Sets every value of the banded matrix 'b' to 0.0.
+ *
+ * @param b     The banded matrix to initialise.
+ *
+ * @return  0 on success, and non-zero error code on failure
+ */
+int zsl_mtx_band_init(struct zsl_mtx_band *b);
+
+/**
+ * @brief Copies the band of the dense square matrix 'm' into 'b'. Values of
+ *        'm' outside of the band are ignored.
+ *
+ * @param m     The source nxn matrix.
+ * @param b     The output nxn banded matrix.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_band_from_mtx(struct zsl_mtx *m, struct zsl_mtx_band *b);
+
+/**
+ * @brief Gets the value at position (i, j) of the banded matrix 'b', which
+ *        is 0.0 outside of the band.
+ *
+ * @param b     The banded matrix.
+ * @param i     The row number.
+ * @param j     The column number.
+ * @param x     Pointer to the output value.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if (i, j) is out
+ *          of bounds.
+ */
+int zsl_mtx_band_get(struct zsl_mtx_band *b, size_t i, size_t j,
+		     zsl_real_t *x);
+
+/**
+ * @brief Sets the value at position (i, j) of the banded matrix 'b'.
+ *
+ * @param b     The banded matrix.
+ * @param i     The row number.
+ * @param j     The column number, within 'kl' below and 'ku' above 'i'.
+ * @param x     The value to set.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if (i, j) is out
+ *          of bounds or outside of the band.
+ */
+int zsl_mtx_band_set(struct zsl_mtx_band *b, size_t i, size_t j,
+		     zsl_real_t x);
+
+/**
+ * @brief Multiplies the banded matrix 'b' by the vector 'v', such that
+ *        'w = b * v', in O(n * (kl + ku)) operations.
+ *
+ * @param b     The nxn banded matrix. Must not be an LU decomposition.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size n. Must not be the same vector
+ *              as 'v'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_band_mult_vec(struct zsl_mtx_band *b, struct zsl_vec *v,
+			  struct zsl_vec *w);
+
+/**
+ * @brief Calculates the LU decomposition of the banded matrix 'b' in place,
+ *        with partial pivoting, in O(n * kl * (kl + ku)) operations.
+ *
+ * The pivoting widens the upper band of U to kl + ku diagonals, which is
+ * why @ref zsl_mtx_band stores 'kl' extra values per row. As with
+ * @ref zsl_mtx_lu, a singular matrix isn't an error here, and is reported
+ * by @ref zsl_mtx_band_lu_solve.
+ *
+ * @param b     The nxn banded matrix, overwritten with its decomposition.
+ * @param piv   The output array of n row pivot indices.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_band_lu(struct zsl_mtx_band *b, size_t *piv);
+
+/**
+ * @brief Solves 'A * x = b' using the banded LU decomposition 'lu' of 'A'
+ *        calculated by @ref zsl_mtx_band_lu.
+ *
+ * @param lu    The banded LU decomposition of the nxn matrix 'A'.
+ * @param piv   The pivot indices from @ref zsl_mtx_band_lu.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output vector, of size n, which may point to the same
+ *              vector as 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ESINGULAR if 'A' is singular.
+ */
+int zsl_mtx_band_lu_solve(struct zsl_mtx_band *lu, size_t *piv,
+			  struct zsl_vec *b, struct zsl_vec *x);
+
+/**
+ * @brief Solves the tridiagonal system 'A * x = d' with the Thomas
+ *        algorithm, in O(n) operations.
+ *
+ * No pivoting is performed, so 'A' should be diagonally dominant or
+ * symmetric positive definite, as is the case for spline fitting. The
+ * temporary values are declared on the stack. Use
+ * 'zsl_mtx_tridiag_solve_ws' to take them from a workspace instead.
+ *
+ * @param a     The n - 1 sub-diagonal values, a[i] being at (i + 1, i).
+ * @param b     The n diagonal values.
+ * @param c     The n - 1 super-diagonal values, c[i] being at (i, i + 1).
+ * @param d     The right-hand side vector, of size n.
+ * @param x     The output vector, of size n, which may point to the same
+ *              vector as 'd'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ESINGULAR if a zero pivot was encountered.
+ */
+int zsl_mtx_tridiag_solve(struct zsl_vec *a, struct zsl_vec *b,
+			  struct zsl_vec *c, struct zsl_vec *d,
+			  struct zsl_vec *x);
+
+/**
+ * @brief Same as 'zsl_mtx_tridiag_solve', but takes all temporary storage
+ *        from the workspace 'ws' rather than from the stack.
+ *
+ * @param a     The n - 1 sub-diagonal values, a[i] being at (i + 1, i).
+ * @param b     The n diagonal values.
+ * @param c     The n - 1 super-diagonal values, c[i] being at (i, i + 1).
+ * @param d     The right-hand side vector, of size n.
+ * @param x     The output vector, of size n, which may point to the same
+ *              vector as 'd'.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_tridiag_solve_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, -ENOMEM if 'ws' is too small, or -ESINGULAR if a zero
+ *          pivot was encountered.
+ */
+int zsl_mtx_tridiag_solve_ws(struct zsl_vec *a, struct zsl_vec *b,
+			     struct zsl_vec *c, struct zsl_vec *d,
+			     struct zsl_vec *x, struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_tridiag_solve_ws'
+ *        needs for a system of size n.
+ *
+ * @param n     The size of the system.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_mtx_tridiag_solve_ws_size(size_t n);
+
 /**
  * @brief Balances the square matrix 'm', a process in which the eigenvalues of
  *        the output matrix are the same as the eigenvalues of the input matrix.
@@ -808,7 +1529,11 @@ int zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg);
  * but they tend to be less stable than the householder method for a similar
  * computational cost.
  *
- * @param m     Pointer to the input square matrix.
+ * The reflections are applied in place without building the Householder
+ * matrices, see 'zsl_mtx_qrd_compact'.
+ *
+ * @param m     Pointer to the input matrix, which must be square when
+ *              'hessenberg' is true.
  * @param q     Pointer to the output orthoogonal square matrix.
  * @param r     Pointer to the output upper triangular square matrix or
  *              hessenberg matrix if set to true.
@@ -820,7 +1545,362 @@ int zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg);
 int zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
 		bool hessenberg);
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Same as 'zsl_mtx_qrd', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param m     Pointer to the input matrix.
+ * @param q     Pointer to the output orthoogonal square matrix.
+ * @param r     Pointer to the output upper triangular square matrix or
+ *              hessenberg matrix if set to true.
+ * @param hessenberg Sets the matrix to hessenberg format if 'true'.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_qrd_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise an appropriate error code.
+ */
+int zsl_mtx_qrd_ws(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+		   bool hessenberg, struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_qrd_ws' needs for
+ *        an mxn matrix.
+ *
+ * @param m     The number of rows of the input matrix.
+ * @param n     The number of columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_qrd_ws_size(size_t m, size_t n);
+
+/**
+ * @brief Performs the Householder QR decomposition of 'm' in compact form,
+ *        without building any intermediate Householder or Q matrix.
+ *
+ * On return, the upper triangle of 'qr' holds R, and the entries below the
+ * diagonal of column 'k' hold the Householder vector v_k (with an implicit
+ * leading 1), such that Q = H_0 * H_1 * ... * H_(k-1) with
+ * H_k = I - tau[k] * v_k * v_k^T. Use 'zsl_mtx_qrd_apply_q' and
+ * 'zsl_mtx_qrd_apply_qt' to apply Q or Q^T to another matrix.
+ *
+ * @param m     Pointer to the input m x n matrix.
+ * @param qr    Pointer to the m x n output matrix. May be the same as 'm'.
+ * @param tau   Pointer to the output vector of min(m, n) reflector scaling
+ *              factors.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_qrd_compact(struct zsl_mtx *m, struct zsl_mtx *qr,
+			struct zsl_vec *tau);
+
+/**
+ * @brief Computes Q * b in place, using the compact QR decomposition output
+ *        of 'zsl_mtx_qrd_compact'.
+ *
+ * @param qr    Pointer to the compact QR decomposition of an m x n matrix.
+ * @param tau   Pointer to the reflector scaling factors.
+ * @param b     Pointer to the m x p matrix to multiply, overwritten with
+ *              the result.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_qrd_apply_q(struct zsl_mtx *qr, struct zsl_vec *tau,
+			struct zsl_mtx *b);
+
+/**
+ * @brief Computes Q^T * b in place, using the compact QR decomposition
+ *        output of 'zsl_mtx_qrd_compact'.
+ *
+ * @param qr    Pointer to the compact QR decomposition of an m x n matrix.
+ * @param tau   Pointer to the reflector scaling factors.
+ * @param b     Pointer to the m x p matrix to multiply, overwritten with
+ *              the result.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_qrd_apply_qt(struct zsl_mtx *qr, struct zsl_vec *tau,
+			 struct zsl_mtx *b);
+
+/**
+ * @brief Updates the QR factor R of a matrix 'A' in place for a new row
+ *        'v' appended to 'A', so that R'^T * R' = R^T * R + v * v^T.
+ *
+ * The row is rotated into R with n Givens rotations, in O(n^2) operations,
+ * without needing Q.
+ *
+ * @param r     The m x n factor R, with m >= n. Only the top n x n upper
+ *              triangle is used.
+ * @param v     The new row of n values. Its contents are destroyed.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_qrd_update_row(struct zsl_mtx *r, struct zsl_vec *v);
+
+/**
+ * @brief Downdates the QR factor R of a matrix 'A' in place for the row
+ *        'v' being removed from 'A', so that R'^T * R' = R^T * R - v * v^T.
+ *
+ * This is the Cholesky downdate of R^T, see @ref zsl_mtx_cho_downdate,
+ * in O(n^2) operations. The diagonal of R must be positive, which is the
+ * case for any R built with @ref zsl_mtx_qrd_update_row or
+ * @ref zsl_mtx_lstsq_add.
+ *
+ * @param r     The m x n factor R, with m >= n. Only the top n x n upper
+ *              triangle is used.
+ * @param v     The row of n values to remove. Its contents are destroyed.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ENOTPOSDEF if the result would be rank deficient,
+ *          in which case 'r' is left partially modified.
+ */
+int zsl_mtx_qrd_downdate_row(struct zsl_mtx *r, struct zsl_vec *v);
+
+/**
+ * @brief Updates the full QR decomposition 'A = Q * R' in place to the QR
+ *        decomposition of the rank-1 update 'A + u * v^T'.
+ *
+ * Uses 2 * m Givens rotations, in O(m^2 + m * n) operations rather than
+ * the O(m * n^2) of a new decomposition. Temporary storage for m values is
+ * declared on the stack. Use 'zsl_mtx_qrd_update_ws' to take it from a
+ * workspace instead.
+ *
+ * @param q     The m x m orthogonal factor Q, with m > 0.
+ * @param r     The m x n upper triangular factor R.
+ * @param u     The vector of m values.
+ * @param v     The vector of n values.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match or 'q' is empty.
+ */
+int zsl_mtx_qrd_update(struct zsl_mtx *q, struct zsl_mtx *r,
+		       struct zsl_vec *u, struct zsl_vec *v);
+
+/**
+ * @brief Same as 'zsl_mtx_qrd_update', but takes all temporary storage
+ *        from the workspace 'ws' rather than from the stack.
+ *
+ * @param q     The m x m orthogonal factor Q, with m > 0.
+ * @param r     The m x n upper triangular factor R.
+ * @param u     The vector of m values.
+ * @param v     The vector of n values.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_qrd_update_ws_size' bytes.
+ *
+ * @return  As for 'zsl_mtx_qrd_update', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_qrd_update_ws(struct zsl_mtx *q, struct zsl_mtx *r,
+			  struct zsl_vec *u, struct zsl_vec *v,
+			  struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_qrd_update_ws'
+ *        needs for an m x m factor Q.
+ *
+ * @param m     The number of rows of 'q' and 'r'.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_mtx_qrd_update_ws_size(size_t m);
+
+/**
+ * @brief Clears the least squares state 'ls', so that a new fit can start.
+ *
+ * @param ls    The least squares state.
+ *
+ * @return  0 on success, and non-zero error code on failure
+ */
+int zsl_mtx_lstsq_init(struct zsl_mtx_lstsq *ls);
+
+/**
+ * @brief Adds a chunk of rows to the least squares fit 'ls'.
+ *
+ * Each row of '[a b]' is rotated into '[R Q^T*b]' with n Givens rotations,
+ * in O(n * (n + nrhs)) operations, and the part of 'b' that can't be
+ * fitted is added to the sum of the squared residuals. 'a' and 'b' aren't
+ * modified and can be discarded afterwards, so any number of rows can be
+ * fitted in O(n^2) memory.
+ *
+ * @param ls    The least squares state.
+ * @param a     The k x n matrix of new rows of 'A'.
+ * @param b     The k x nrhs matrix of the matching rows of 'b'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_lstsq_add(struct zsl_mtx_lstsq *ls, struct zsl_mtx *a,
+		      struct zsl_mtx *b);
+
+/**
+ * @brief Solves the least squares fit 'ls' for the rows added so far,
+ *        minimising the norm of 'A * x - b' for each right-hand side.
+ *
+ * The state isn't modified, so more rows can be added and the fit solved
+ * again later.
+ *
+ * @param ls    The least squares state.
+ * @param x     The n x nrhs output solution.
+ * @param res   Optional output vector of size nrhs, receiving the residual
+ *              norm |A * x - b| of each right-hand side, or NULL.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ESINGULAR if 'A' is rank deficient (for example if
+ *          fewer than n rows were added).
+ */
+int zsl_mtx_lstsq_solve(struct zsl_mtx_lstsq *ls, struct zsl_mtx *x,
+			struct zsl_vec *res);
+
+/**
+ * @brief Solves the overdetermined system 'A * x = b' in the least squares
+ *        sense, for the rows of 'a' all at once.
+ *
+ * This is a convenience wrapper around @ref zsl_mtx_lstsq_add and
+ * @ref zsl_mtx_lstsq_solve, using state declared on the stack. Use
+ * 'zsl_mtx_lstsq_ws' to take it from a workspace instead.
+ *
+ * @param a     The m x n matrix 'A', with m >= n.
+ * @param b     The m x nrhs right-hand side matrix.
+ * @param x     The n x nrhs output solution.
+ * @param res   Optional output vector of size nrhs, receiving the residual
+ *              norm of each right-hand side, or NULL.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ESINGULAR if 'a' is rank deficient.
+ */
+int zsl_mtx_lstsq(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x,
+		  struct zsl_vec *res);
+
+/**
+ * @brief Same as 'zsl_mtx_lstsq', but takes the state from the workspace
+ *        'ws' rather than from the stack.
+ *
+ * @param a     The m x n matrix 'A', with m >= n.
+ * @param b     The m x nrhs right-hand side matrix.
+ * @param x     The n x nrhs output solution.
+ * @param res   Optional output vector of size nrhs, or NULL.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_lstsq_ws_size' bytes.
+ *
+ * @return  As for 'zsl_mtx_lstsq', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_lstsq_ws(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x,
+		     struct zsl_vec *res, struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_lstsq_ws' needs
+ *        for 'n' unknowns and 'nrhs' right-hand sides.
+ *
+ * @param n     The number of unknowns.
+ * @param nrhs  The number of right-hand sides.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_mtx_lstsq_ws_size(size_t n, size_t nrhs);
+
+/**
+ * @brief Calculates the matrix exponential 'e = exp(m)' of the square
+ *        matrix 'm'.
+ *
+ * Uses scaling and squaring with a [6/6] Pade approximant: 'm' is scaled
+ * by a power of two to an infinity norm of at most 0.5, the approximant is
+ * evaluated with five multiplications and one LU solve, and the result is
+ * squared back. For the small state-space models this is aimed at (n up to
+ * about 12) the work is a few dozen n x n products, and the 3x3, 4x4 and
+ * 6x6 cases use the unrolled multiply kernels. Temporary storage is
+ * declared on the stack. Use 'zsl_mtx_expm_ws' to take it from a
+ * workspace instead.
+ *
+ * @param m     The input nxn matrix.
+ * @param e     The output nxn matrix, which may point to the same matrix
+ *              as 'm'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't square and identically shaped, or 'e' isn't contiguous,
+ *          or -ESINGULAR if the Pade denominator is numerically singular.
+ */
+int zsl_mtx_expm(struct zsl_mtx *m, struct zsl_mtx *e);
+
+/**
+ * @brief Same as 'zsl_mtx_expm', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input nxn matrix.
+ * @param e     The output nxn matrix, which may point to the same matrix
+ *              as 'm'.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_expm_ws_size' bytes.
+ *
+ * @return  As for 'zsl_mtx_expm', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_expm_ws(struct zsl_mtx *m, struct zsl_mtx *e,
+		    struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_expm_ws' needs for
+ *        an nxn matrix.
+ *
+ * @param n     The size of the matrix.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_mtx_expm_ws_size(size_t n);
+
+/**
+ * @brief Discretises the continuous-time model 'dx/dt = A * x + w', with
+ *        white process noise 'w' of spectral density 'Q', for the sample
+ *        period 'dt', using the method of Van Loan.
+ *
+ * The discrete model is 'x[k + 1] = Ad * x[k] + w[k]', where
+ * 'Ad = exp(A * dt)' and 'w[k]' has the covariance
+ * 'Qd = integral(exp(A * t) * Q * exp(A^T * t), t = 0..dt)'. Both are read
+ * from the exponential of a single 2n x 2n block matrix. Temporary storage
+ * is declared on the stack. Use 'zsl_mtx_van_loan_ws' to take it from a
+ * workspace instead.
+ *
+ * @param a     The nxn continuous-time state matrix 'A'.
+ * @param q     The nxn symmetric process noise spectral density 'Q'.
+ * @param dt    The sample period.
+ * @param ad    The nxn output discrete state matrix 'Ad'.
+ * @param qd    The nxn output discrete process noise covariance 'Qd'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          aren't compatibly shaped, or 'qd' isn't contiguous.
+ */
+int zsl_mtx_van_loan(struct zsl_mtx *a, struct zsl_mtx *q, zsl_real_t dt,
+		     struct zsl_mtx *ad, struct zsl_mtx *qd);
+
+/**
+ * @brief Same as 'zsl_mtx_van_loan', but takes all temporary storage from
+ *        the workspace 'ws' rather than from the stack.
+ *
+ * @param a     The nxn continuous-time state matrix 'A'.
+ * @param q     The nxn symmetric process noise spectral density 'Q'.
+ * @param dt    The sample period.
+ * @param ad    The nxn output discrete state matrix 'Ad'.
+ * @param qd    The nxn output discrete process noise covariance 'Qd'.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_van_loan_ws_size' bytes.
+ *
+ * @return  As for 'zsl_mtx_van_loan', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_van_loan_ws(struct zsl_mtx *a, struct zsl_mtx *q, zsl_real_t dt,
+			struct zsl_mtx *ad, struct zsl_mtx *qd,
+			struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_van_loan_ws' needs
+ *        for an nxn model.
+ *
+ * @param n     The number of states.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_mtx_van_loan_ws_size(size_t n);
+
 /**
  * @brief Computes recursively the QR decompisition method to put the input
  *        square matrix into upper triangular form.
@@ -835,32 +1915,106 @@ int zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
  *          error code.
  */
 int zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter);
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
- * @brief   Calculates the eigenvalues for input matrix 'm' using QR
- *          decomposition recursively. The output vector will only contain real
+ * @brief   Calculates the eigenvalues for input matrix 'm' using the Francis
+ *          double-shift QR method. The output vector will only contain real
  *          eigenvalues, even if the input matrix has complex eigenvalues.
  *
  * @param m     The input square matrix to use.
  * @param v     The placeholder for the output vector where the real eigenvalues
  *              should be stored.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called
- *              during the QR decomposition phase.
+ * @param iter  The maximum number of QR steps allowed to converge on any
+ *              single eigenvalue (or pair of eigenvalues). 30 is generally
+ *              more than enough.
  *
- * NOTE: Large values required more iterations to get precise results, and
- * some trial and error may be required to find the right balance of
- * iterations versus processing time.
+ * The eigenvalues are sorted by decreasing modulus.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code. If -ECOMPLEXVAL is returned, it means that complex
- *          numbers were detected in the output eigenvalues.
+ *          numbers were detected in the output eigenvalues. -ENOCONVERGE is
+ *          returned if the iteration count was exceeded.
  */
 int zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter);
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Same as 'zsl_mtx_eigenvalues', but takes all temporary storage from
+ *        the workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input square matrix to use.
+ * @param v     The placeholder for the output vector of real eigenvalues.
+ * @param iter  The maximum number of QR steps per eigenvalue.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_eigenvalues_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise the same error codes as 'zsl_mtx_eigenvalues'.
+ */
+int zsl_mtx_eigenvalues_ws(struct zsl_mtx *m, struct zsl_vec *v, size_t iter,
+			   struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_eigenvalues_ws'
+ *        needs for an nxn matrix.
+ *
+ * @param n     The number of rows and columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_eigenvalues_ws_size(size_t n);
+
+/**
+ * @brief   Calculates the eigenvalues for input matrix 'm', including complex
+ *          ones, using the Francis double-shift QR method on the Hessenberg
+ *          form of 'm', with deflation as each eigenvalue converges.
+ *
+ * @param m     The input square matrix to use.
+ * @param re    The placeholder for the output vector where the real part of
+ *              the eigenvalues should be stored.
+ * @param im    The placeholder for the output vector where the imaginary part
+ *              of the eigenvalues should be stored.
+ * @param iter  The maximum number of QR steps allowed to converge on any
+ *              single eigenvalue (or pair of eigenvalues).
+ *
+ * The eigenvalues are sorted by decreasing modulus, and complex conjugate
+ * pairs are stored next to each other, the one with the positive imaginary
+ * part first.
+ *
+ * @return  0 if everything executed correctly, -ENOCONVERGE if the iteration
+ *          count was exceeded, otherwise an appropriate error code.
+ */
+int zsl_mtx_eigenvalues_cplx(struct zsl_mtx *m, struct zsl_vec *re,
+			     struct zsl_vec *im, size_t iter);
+
+/**
+ * @brief Same as 'zsl_mtx_eigenvalues_cplx', but takes all temporary storage
+ *        from the workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input square matrix to use.
+ * @param re    The placeholder for the real part of the eigenvalues.
+ * @param im    The placeholder for the imaginary part of the eigenvalues.
+ * @param iter  The maximum number of QR steps per eigenvalue.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_eigenvalues_cplx_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise the same error codes as
+ *          'zsl_mtx_eigenvalues_cplx'.
+ */
+int zsl_mtx_eigenvalues_cplx_ws(struct zsl_mtx *m, struct zsl_vec *re,
+				struct zsl_vec *im, size_t iter,
+				struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_eigenvalues_cplx_ws'
+ *        needs for an nxn matrix.
+ *
+ * @param n     The number of rows and columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_eigenvalues_cplx_ws_size(size_t n);
+
 /**
  * @brief Calcualtes the set of eigenvectors for input matrix 'm', using the
  *        specified number of iterations to find a balance between precision and
@@ -870,24 +2024,139 @@ int zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter);
  * @param m             The input square matrix to use.
  * @param mev           The placeholder for the output square matrix where the
  *                      eigenvectors should be stored as column vectors.
- * @param iter          The number of times that 'zsl_mtx_qrd' should be called.
- *                      during the QR decomposition phase.
+ * @param iter          The maximum number of QR steps per eigenvalue, see
+ *                      'zsl_mtx_eigenvalues'.
  * @param orthonormal   If set to true, the output matrix 'mev' will be
  *                      orthonormalised.
  *
- * NOTE: Large values required more iterations to get precise results, and
- * some trial and error may be required to find the right balance of
- * iterations versus processing time.
+ * If 'm' is symmetric and 'orthonormal' is true, the eigenvectors are
+ * obtained directly with 'zsl_mtx_eigen_sym'.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
- *          error code. If the number of calcualted eigenvectors is less
- *          than the columns in 'm', EEIGENSIZE will be returned.
+ *          error code. -ENOCONVERGE is returned as for
+ *          'zsl_mtx_eigenvalues', in which case 'mev' isn't modified. If
+ *          'm' has complex eigenvalues, the eigenvectors of the real ones
+ *          are calculated and -ECOMPLEXVAL is returned. If the number of
+ *          calcualted eigenvectors is otherwise less than the columns in
+ *          'm', EEIGENSIZE will be returned.
  */
 int zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
                          bool orthonormal);
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Same as 'zsl_mtx_eigenvectors', but takes all temporary storage from
+ *        the workspace 'ws' rather than from the stack.
+ *
+ * @param m             The input square matrix to use.
+ * @param mev           The placeholder for the output eigenvectors.
+ * @param iter          The maximum number of QR steps per eigenvalue.
+ * @param orthonormal   If set to true, the output matrix 'mev' will be
+ *                      orthonormalised.
+ * @param ws            The workspace to allocate temporary storage from, of
+ *                      at least 'zsl_mtx_eigenvectors_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise the same error codes as 'zsl_mtx_eigenvectors'.
+ */
+int zsl_mtx_eigenvectors_ws(struct zsl_mtx *m, struct zsl_mtx *mev,
+			    size_t iter, bool orthonormal,
+			    struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_eigenvectors_ws'
+ *        needs for an nxn matrix.
+ *
+ * @param n     The number of rows and columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_eigenvectors_ws_size(size_t n);
+
+/**
+ * @brief Calculates the eigenvalues and, optionally, the orthonormal
+ *        eigenvectors of the symmetric matrix 'm' in a single pass, using
+ *        Householder tridiagonalisation followed by the implicit QL method.
+ *
+ * This is considerably faster and more robust than 'zsl_mtx_eigenvalues'
+ * and 'zsl_mtx_eigenvectors' for symmetric input, such as the covariance
+ * matrices produced by 'zsl_sta_covar_mtx'. Only symmetric matrices are
+ * supported: the results are meaningless for any other input.
+ *
+ * @param m     The input symmetric square matrix to use.
+ * @param v     The placeholder for the output vector of eigenvalues, sorted
+ *              by decreasing modulus.
+ * @param mev   The placeholder for the output square matrix where the
+ *              orthonormal eigenvectors should be stored as column vectors,
+ *              in the same order as 'v'. Set to NULL to only calculate the
+ *              eigenvalues.
+ * @param iter  The maximum number of QL steps allowed to converge on any
+ *              single eigenvalue. 30 is generally more than enough.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'm' isn't square,
+ *          -ENOCONVERGE if the iteration count was exceeded, otherwise an
+ *          appropriate error code.
+ */
+int zsl_mtx_eigen_sym(struct zsl_mtx *m, struct zsl_vec *v,
+		      struct zsl_mtx *mev, size_t iter);
+
+/**
+ * @brief Same as 'zsl_mtx_eigen_sym', but takes all temporary storage from
+ *        the workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input symmetric square matrix to use.
+ * @param v     The placeholder for the output vector of eigenvalues.
+ * @param mev   The placeholder for the output eigenvectors, or NULL.
+ * @param iter  The maximum number of QL steps per eigenvalue.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_eigen_sym_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise the same error codes as 'zsl_mtx_eigen_sym'.
+ */
+int zsl_mtx_eigen_sym_ws(struct zsl_mtx *m, struct zsl_vec *v,
+			 struct zsl_mtx *mev, size_t iter,
+			 struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_eigen_sym_ws' needs
+ *        for an nxn matrix.
+ *
+ * @param n     The number of rows and columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_eigen_sym_ws_size(size_t n);
+
+/**
+ * @brief Performs the thin singular value decomposition of the mxn matrix
+ *        'm', with k = min(m, n), using the one-sided Jacobi method directly
+ *        on 'm' (m * m^T and m^T * m are never formed).
+ *
+ * 'm' is equal to u * diag(s) * v^T. Either or both of 'u' and 'v' can be
+ * omitted to only calculate what is needed: the singular values on their
+ * own are the cheapest.
+ *
+ * The method works on an m x n (or n x m) copy of 'm' which is stored in
+ * 'u' when m >= n, or in 'v' when m < n. When that output is NULL, 'work'
+ * must point to a scratch buffer of at least m * n values, otherwise it can
+ * be NULL. 'm' can be any view, but 'u' and 'v' must be contiguous.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param s     The placeholder for the output vector of k singular values,
+ *              in decreasing order.
+ * @param u     The placeholder for the output mxk matrix u, or NULL.
+ * @param v     The placeholder for the output nxk matrix v, or NULL.
+ * @param work  Scratch buffer of m * n values, or NULL (see above).
+ * @param iter  The maximum number of Jacobi sweeps. Convergence typically
+ *              takes well under 10 sweeps.
+ *
+ * @return  0 if everything executed correctly, -ENOCONVERGE if the iteration
+ *          count was exceeded, -EINVAL if 'u' or 'v' isn't contiguous,
+ *          otherwise an appropriate error code.
+ */
+int zsl_mtx_svd_thin(struct zsl_mtx *m, struct zsl_vec *s, struct zsl_mtx *u,
+		     struct zsl_mtx *v, zsl_real_t *work, size_t iter);
+
 /**
  * @brief Performs singular value decomposition, converting input matrix 'm'
  *        into matrices 'u', 'e', and 'v'.
@@ -896,31 +2165,87 @@ int zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
  * @param u     The placeholder for the output mxm matrix u.
  * @param e     The placeholder for the output mxn matrix sigma.
  * @param v     The placeholder for the output nxn matrix v.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
- *              during the QR decomposition phase.
+ * @param iter  The maximum number of Jacobi sweeps, see 'zsl_mtx_svd_thin'.
  *
- * @return  0 if everything executed correctly, otherwise an appropriate
- *          error code.
+ * The singular values are sorted in decreasing order. The columns of 'u' and
+ * 'v' beyond min(m, n) are completed into orthonormal bases. 'm' and 'e' can
+ * be any view, but 'u' and 'v' must be contiguous.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'u' or 'v' isn't
+ *          contiguous, otherwise an appropriate error code.
  */
 int zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 		struct zsl_mtx *v, size_t iter);
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Same as 'zsl_mtx_svd', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param u     The placeholder for the output mxm matrix u.
+ * @param e     The placeholder for the output mxn matrix sigma.
+ * @param v     The placeholder for the output nxn matrix v.
+ * @param iter  The maximum number of Jacobi sweeps.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_svd_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise an appropriate error code.
+ */
+int zsl_mtx_svd_ws(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+		   struct zsl_mtx *v, size_t iter, struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the exact number of workspace bytes 'zsl_mtx_svd_ws' needs
+ *        for an mxn matrix. Only min(m, n) values are required, since 'u'
+ *        and 'v' double as scratch storage.
+ *
+ * @param m     The number of rows of the input matrix.
+ * @param n     The number of columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_svd_ws_size(size_t m, size_t n);
+
 /**
  * @brief   Performs the pseudo-inverse (aka pinv or Moore-Penrose inverse)
  *          on input matrix 'm'.
  *
  * @param m     The input mxn matrix to use.
  * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
- *              during the QR decomposition phase.
+ * @param iter  The maximum number of Jacobi sweeps, see 'zsl_mtx_svd_thin'.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
 int zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter);
-#endif
+
+/**
+ * @brief Same as 'zsl_mtx_pinv', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
+ * @param iter  The maximum number of Jacobi sweeps.
+ * @param ws    The workspace to allocate temporary storage from, of at
+ *              least 'zsl_mtx_pinv_ws_size' bytes.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, otherwise an appropriate error code.
+ */
+int zsl_mtx_pinv_ws(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		    struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_mtx_pinv_ws' needs for
+ *        an mxn matrix.
+ *
+ * @param m     The number of rows of the input matrix.
+ * @param n     The number of columns of the input matrix.
+ *
+ * @return  The required workspace size in bytes.
+ */
+size_t zsl_mtx_pinv_ws_size(size_t m, size_t n);
 
 /** @} */ /* End of MTX_TRANSFORMATIONS group */
 
@@ -0,0 +1,667 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FIXED Fixed-Size Matrices
+ *
+ * @brief Fully unrolled 2x2, 3x3, 4x4 and 6x6 matrices and vectors.
+ *
+ * The types in this module have their size fixed at compile time, so they
+ * carry no size fields and their functions need no shape checks. Every
+ * function is generated from the same set of macros for each supported
+ * size, and those macros expand each loop into one statement per element,
+ * so no loops are left in the compiled code. This suits the small, hot
+ * matrices found in filters and attitude estimation.
+ *
+ * For a size N of 2, 3, 4 or 6 the following functions are available:
+ *
+ * - zsl_vecN_add, zsl_vecN_sub, zsl_vecN_scalar_mult, zsl_vecN_dot,
+ *   zsl_vecN_from_vec, zsl_vecN_to_vec
+ * - zsl_mtxN_identity, zsl_mtxN_add, zsl_mtxN_sub, zsl_mtxN_scalar_mult,
+ *   zsl_mtxN_mult, zsl_mtxN_mult_vec, zsl_mtxN_trans, zsl_mtxN_deter,
+ *   zsl_mtxN_inv, zsl_mtxN_from_mtx, zsl_mtxN_to_mtx
+ *
+ * The output of every function may be the same object as one of its
+ * inputs. The determinant and inverse use closed-form cofactor expressions
+ * up to 4x4; the 6x6 versions use Gaussian elimination with partial
+ * pivoting, whose loops have fixed trip counts that the compiler unrolls.
+ *
+ * When CONFIG_ZSL_VECTOR_INLINE or CONFIG_ZSL_MATRIX_INLINE is enabled, the
+ * vector or matrix functions are defined in this header as static inline
+ * functions, otherwise they are compiled once in matrices_fixed.c.
+ */
+
+/**
+ * @file
+ * @brief API header file for fixed-size matrices in zscilib.
+ *
+ * This file contains the zscilib fixed-size matrix and vector APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_MATRICES_FIXED_H_
+#define ZEPHYR_INCLUDE_ZSL_MATRICES_FIXED_H_
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FIXED_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with fixed-size matrices.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/** @brief Represents a 2 element vector. */
+struct zsl_vec2 {
+	/** The vector's values. */
+	zsl_real_t data[2];
+};
+
+/** @brief Represents a 3 element vector. */
+struct zsl_vec3 {
+	/** The vector's values. */
+	zsl_real_t data[3];
+};
+
+/** @brief Represents a 4 element vector. */
+struct zsl_vec4 {
+	/** The vector's values. */
+	zsl_real_t data[4];
+};
+
+/** @brief Represents a 6 element vector. */
+struct zsl_vec6 {
+	/** The vector's values. */
+	zsl_real_t data[6];
+};
+
+/** @brief Represents a 2x2 matrix, stored row by row. */
+struct zsl_mtx2 {
+	/** The matrix's values, where row i and column j is data[(i * 2) + j]. */
+	zsl_real_t data[2 * 2];
+};
+
+/** @brief Represents a 3x3 matrix, stored row by row. */
+struct zsl_mtx3 {
+	/** The matrix's values, where row i and column j is data[(i * 3) + j]. */
+	zsl_real_t data[3 * 3];
+};
+
+/** @brief Represents a 4x4 matrix, stored row by row. */
+struct zsl_mtx4 {
+	/** The matrix's values, where row i and column j is data[(i * 4) + j]. */
+	zsl_real_t data[4 * 4];
+};
+
+/** @brief Represents a 6x6 matrix, stored row by row. */
+struct zsl_mtx6 {
+	/** The matrix's values, where row i and column j is data[(i * 6) + j]. */
+	zsl_real_t data[6 * 6];
+};
+
+/** Storage class of the fixed-size vector functions. */
+#if CONFIG_ZSL_VECTOR_INLINE
+#define ZSL_VECF_API static inline
+#else
+#define ZSL_VECF_API
+#endif
+
+/** Storage class of the fixed-size matrix functions. */
+#if CONFIG_ZSL_MATRIX_INLINE
+#define ZSL_MTXF_API static inline
+#else
+#define ZSL_MTXF_API
+#endif
+
+/*
+ * Unrolling helpers: ZSL_FIXED_REP_n expands to the statements M(k, ...) for
+ * k = 0 .. n - 1, and ZSL_FIXED_SUM_n to the sum of the terms T(k, ...).
+ */
+#define ZSL_FIXED_REP_2(M, ...) M(0, __VA_ARGS__) M(1, __VA_ARGS__)
+#define ZSL_FIXED_REP_3(M, ...) ZSL_FIXED_REP_2(M, __VA_ARGS__) M(2, __VA_ARGS__)
+#define ZSL_FIXED_REP_4(M, ...) ZSL_FIXED_REP_3(M, __VA_ARGS__) M(3, __VA_ARGS__)
+#define ZSL_FIXED_REP_6(M, ...)			   \
+	ZSL_FIXED_REP_4(M, __VA_ARGS__)		   \
+	M(4, __VA_ARGS__) M(5, __VA_ARGS__)
+#define ZSL_FIXED_REP_9(M, ...)			   \
+	ZSL_FIXED_REP_6(M, __VA_ARGS__)		   \
+	M(6, __VA_ARGS__) M(7, __VA_ARGS__) M(8, __VA_ARGS__)
+#define ZSL_FIXED_REP_16(M, ...)		   \
+	ZSL_FIXED_REP_9(M, __VA_ARGS__)		   \
+	M(9, __VA_ARGS__) M(10, __VA_ARGS__)	   \
+	M(11, __VA_ARGS__) M(12, __VA_ARGS__)	   \
+	M(13, __VA_ARGS__) M(14, __VA_ARGS__)	   \
+	M(15, __VA_ARGS__)
+#define ZSL_FIXED_REP_36(M, ...)		   \
+	ZSL_FIXED_REP_16(M, __VA_ARGS__)	   \
+	M(16, __VA_ARGS__) M(17, __VA_ARGS__)	   \
+	M(18, __VA_ARGS__) M(19, __VA_ARGS__)	   \
+	M(20, __VA_ARGS__) M(21, __VA_ARGS__)	   \
+	M(22, __VA_ARGS__) M(23, __VA_ARGS__)	   \
+	M(24, __VA_ARGS__) M(25, __VA_ARGS__)	   \
+	M(26, __VA_ARGS__) M(27, __VA_ARGS__)	   \
+	M(28, __VA_ARGS__) M(29, __VA_ARGS__)	   \
+	M(30, __VA_ARGS__) M(31, __VA_ARGS__)	   \
+	M(32, __VA_ARGS__) M(33, __VA_ARGS__)	   \
+	M(34, __VA_ARGS__) M(35, __VA_ARGS__)
+
+#define ZSL_FIXED_SUM_2(T, ...) (T(0, __VA_ARGS__) + T(1, __VA_ARGS__))
+#define ZSL_FIXED_SUM_3(T, ...)			   \
+	(T(0, __VA_ARGS__) + T(1, __VA_ARGS__) +   \
+	 T(2, __VA_ARGS__))
+#define ZSL_FIXED_SUM_4(T, ...)			   \
+	(T(0, __VA_ARGS__) + T(1, __VA_ARGS__) +   \
+	 T(2, __VA_ARGS__) + T(3, __VA_ARGS__))
+#define ZSL_FIXED_SUM_6(T, ...)			   \
+	(T(0, __VA_ARGS__) + T(1, __VA_ARGS__) +   \
+	 T(2, __VA_ARGS__) + T(3, __VA_ARGS__) +   \
+	 T(4, __VA_ARGS__) + T(5, __VA_ARGS__))
+
+/* Per-element statements and terms, where 'k' is the element index. */
+#define ZSL_FIXED_COPY_EL(k, a, c) (c)->data[k] = (a)->data[k];
+#define ZSL_FIXED_ADD_EL(k, a, b, c) (c)->data[k] = (a)->data[k] + (b)->data[k];
+#define ZSL_FIXED_SUB_EL(k, a, b, c) (c)->data[k] = (a)->data[k] - (b)->data[k];
+#define ZSL_FIXED_SCALE_EL(k, a, s) (a)->data[k] *= (s);
+#define ZSL_FIXED_DOT_TERM(k, a, b) ((a)->data[k] * (b)->data[k])
+#define ZSL_FIXED_EYE_EL(k, n, a) \
+	(a)->data[k] = ((k) % ((n) + 1) == 0) ? 1.0f : 0.0f;
+#define ZSL_FIXED_TRANS_EL(k, n, a, t) \
+	(t).data[k] = (a)->data[(((k) % (n)) * (n)) + ((k) / (n))];
+#define ZSL_FIXED_MULT_TERM(l, n, a, b, k) \
+	((a)->data[(((k) / (n)) * (n)) + (l)] * (b)->data[((l) * (n)) + ((k) % (n))])
+#define ZSL_FIXED_MULT_EL(k, n, a, b, t) \
+	(t).data[k] = ZSL_FIXED_SUM_ ## n(ZSL_FIXED_MULT_TERM, n, a, b, k);
+#define ZSL_FIXED_MV_TERM(l, n, a, v, k) \
+	((a)->data[((k) * (n)) + (l)] * (v)->data[l])
+#define ZSL_FIXED_MV_EL(k, n, a, v, t) \
+	(t).data[k] = ZSL_FIXED_SUM_ ## n(ZSL_FIXED_MV_TERM, n, a, v, k);
+
+/** @} */ /* End of FIXED_STRUCTS group */
+
+/**
+ * @addtogroup FIXED_FUNCS Functions
+ *
+ * @brief Fixed-size vector and matrix math.
+ *
+ * The functions are declared by the macros below for each supported size N;
+ * see the @ref FIXED module description for the full list.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * @brief Declares the fixed-size vector functions of size 'n'.
+ *
+ * - zsl_vecN_add(v, w, x) and zsl_vecN_sub(v, w, x) set x = v + w and
+ *   x = v - w.
+ * - zsl_vecN_scalar_mult(v, s) multiplies every element of v by s.
+ * - zsl_vecN_dot(v, w) returns the dot product of v and w.
+ * - zsl_vecN_from_vec(vf, v) and zsl_vecN_to_vec(vf, v) copy between a
+ *   fixed-size vector and a struct zsl_vec of 'n' elements, returning -EINVAL
+ *   if 'v' has another size.
+ */
+#define ZSL_VECF_DECLARE(n)						 \
+	ZSL_VECF_API void zsl_vec ## n ## _add(const struct zsl_vec ## n *v,  \
+		const struct zsl_vec ## n *w, struct zsl_vec ## n *x);	 \
+	ZSL_VECF_API void zsl_vec ## n ## _sub(const struct zsl_vec ## n *v,  \
+		const struct zsl_vec ## n *w, struct zsl_vec ## n *x);	 \
+	ZSL_VECF_API void zsl_vec ## n ## _scalar_mult(			 \
+		struct zsl_vec ## n *v, zsl_real_t s);			 \
+	ZSL_VECF_API zsl_real_t zsl_vec ## n ## _dot(			 \
+		const struct zsl_vec ## n *v, const struct zsl_vec ## n *w);  \
+	ZSL_VECF_API int zsl_vec ## n ## _from_vec(struct zsl_vec ## n *vf,   \
+		const struct zsl_vec *v);				 \
+	ZSL_VECF_API int zsl_vec ## n ## _to_vec(			 \
+		const struct zsl_vec ## n *vf, struct zsl_vec *v);
+
+/**
+ * @brief Declares the fixed-size matrix functions of size 'n' x 'n'.
+ *
+ * - zsl_mtxN_identity(m) sets m to the identity matrix.
+ * - zsl_mtxN_add(ma, mb, mc) and zsl_mtxN_sub(ma, mb, mc) set mc = ma + mb
+ *   and mc = ma - mb.
+ * - zsl_mtxN_scalar_mult(m, s) multiplies every element of m by s.
+ * - zsl_mtxN_mult(ma, mb, mc) sets mc = ma * mb.
+ * - zsl_mtxN_mult_vec(ma, v, w) sets w = ma * v.
+ * - zsl_mtxN_trans(ma, mt) sets mt to the transpose of ma.
+ * - zsl_mtxN_deter(m) returns the determinant of m.
+ * - zsl_mtxN_inv(m, mi) sets mi to the inverse of m, returning -ESINGULAR
+ *   and leaving mi untouched if m is singular.
+ * - zsl_mtxN_from_mtx(mf, m) and zsl_mtxN_to_mtx(mf, m) copy between a
+ *   fixed-size matrix and an 'n' x 'n' struct zsl_mtx of any layout,
+ *   returning -EINVAL if 'm' has another shape.
+ */
+#define ZSL_MTXF_DECLARE(n)						 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _identity(struct zsl_mtx ## n *m);  \
+	ZSL_MTXF_API void zsl_mtx ## n ## _add(const struct zsl_mtx ## n *ma, \
+		const struct zsl_mtx ## n *mb, struct zsl_mtx ## n *mc);	 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _sub(const struct zsl_mtx ## n *ma, \
+		const struct zsl_mtx ## n *mb, struct zsl_mtx ## n *mc);	 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _scalar_mult(			 \
+		struct zsl_mtx ## n *m, zsl_real_t s);			 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _mult(			 \
+		const struct zsl_mtx ## n *ma,				 \
+		const struct zsl_mtx ## n *mb, struct zsl_mtx ## n *mc);	 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _mult_vec(			 \
+		const struct zsl_mtx ## n *ma,				 \
+		const struct zsl_vec ## n *v, struct zsl_vec ## n *w);	 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _trans(			 \
+		const struct zsl_mtx ## n *ma, struct zsl_mtx ## n *mt);	 \
+	ZSL_MTXF_API zsl_real_t zsl_mtx ## n ## _deter(			 \
+		const struct zsl_mtx ## n *m);				 \
+	ZSL_MTXF_API int zsl_mtx ## n ## _inv(const struct zsl_mtx ## n *m,   \
+		struct zsl_mtx ## n *mi);				 \
+	ZSL_MTXF_API int zsl_mtx ## n ## _from_mtx(struct zsl_mtx ## n *mf,   \
+		struct zsl_mtx *m);					 \
+	ZSL_MTXF_API int zsl_mtx ## n ## _to_mtx(			 \
+		const struct zsl_mtx ## n *mf, struct zsl_mtx *m);
+
+ZSL_VECF_DECLARE(2)
+ZSL_VECF_DECLARE(3)
+ZSL_VECF_DECLARE(4)
+ZSL_VECF_DECLARE(6)
+
+ZSL_MTXF_DECLARE(2)
+ZSL_MTXF_DECLARE(3)
+ZSL_MTXF_DECLARE(4)
+ZSL_MTXF_DECLARE(6)
+
+/** @} */ /* End of FIXED_FUNCS group */
+
+/*
+ * Definitions. These are compiled in this header when the matching inline
+ * option is enabled, and once in matrices_fixed.c otherwise.
+ */
+
+/* Defines the vector functions of size 'n'. */
+#define ZSL_VECF_DEFINE(n)						 \
+	ZSL_VECF_API void zsl_vec ## n ## _add(const struct zsl_vec ## n *v,  \
+		const struct zsl_vec ## n *w, struct zsl_vec ## n *x)	 \
+	{								 \
+		ZSL_FIXED_REP_ ## n(ZSL_FIXED_ADD_EL, v, w, x)		 \
+	}								 \
+									 \
+	ZSL_VECF_API void zsl_vec ## n ## _sub(const struct zsl_vec ## n *v,  \
+		const struct zsl_vec ## n *w, struct zsl_vec ## n *x)	 \
+	{								 \
+		ZSL_FIXED_REP_ ## n(ZSL_FIXED_SUB_EL, v, w, x)		 \
+	}								 \
+									 \
+	ZSL_VECF_API void zsl_vec ## n ## _scalar_mult(			 \
+		struct zsl_vec ## n *v, zsl_real_t s)			 \
+	{								 \
+		ZSL_FIXED_REP_ ## n(ZSL_FIXED_SCALE_EL, v, s)		 \
+	}								 \
+									 \
+	ZSL_VECF_API zsl_real_t zsl_vec ## n ## _dot(			 \
+		const struct zsl_vec ## n *v, const struct zsl_vec ## n *w)   \
+	{								 \
+		return ZSL_FIXED_SUM_ ## n(ZSL_FIXED_DOT_TERM, v, w);	 \
+	}								 \
+									 \
+	ZSL_VECF_API int zsl_vec ## n ## _from_vec(struct zsl_vec ## n *vf,   \
+		const struct zsl_vec *v)				 \
+	{								 \
+		if (v->sz != n) {					 \
+			return -EINVAL;					 \
+		}							 \
+		ZSL_FIXED_REP_ ## n(ZSL_FIXED_COPY_EL, v, vf)		 \
+		return 0;						 \
+	}								 \
+									 \
+	ZSL_VECF_API int zsl_vec ## n ## _to_vec(			 \
+		const struct zsl_vec ## n *vf, struct zsl_vec *v)	 \
+	{								 \
+		if (v->sz != n) {					 \
+			return -EINVAL;					 \
+		}							 \
+		ZSL_FIXED_REP_ ## n(ZSL_FIXED_COPY_EL, vf, v)		 \
+		return 0;						 \
+	}
+
+/* Defines the size-independent matrix functions of size 'n', with nn = n*n. */
+#define ZSL_MTXF_DEFINE(n, nn)						 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _identity(struct zsl_mtx ## n *m)   \
+	{								 \
+		ZSL_FIXED_REP_ ## nn(ZSL_FIXED_EYE_EL, n, m)		 \
+	}								 \
+									 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _add(const struct zsl_mtx ## n *ma, \
+		const struct zsl_mtx ## n *mb, struct zsl_mtx ## n *mc)	 \
+	{								 \
+		ZSL_FIXED_REP_ ## nn(ZSL_FIXED_ADD_EL, ma, mb, mc)	 \
+	}								 \
+									 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _sub(const struct zsl_mtx ## n *ma, \
+		const struct zsl_mtx ## n *mb, struct zsl_mtx ## n *mc)	 \
+	{								 \
+		ZSL_FIXED_REP_ ## nn(ZSL_FIXED_SUB_EL, ma, mb, mc)	 \
+	}								 \
+									 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _scalar_mult(			 \
+		struct zsl_mtx ## n *m, zsl_real_t s)			 \
+	{								 \
+		ZSL_FIXED_REP_ ## nn(ZSL_FIXED_SCALE_EL, m, s)		 \
+	}								 \
+									 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _mult(			 \
+		const struct zsl_mtx ## n *ma,				 \
+		const struct zsl_mtx ## n *mb, struct zsl_mtx ## n *mc)	 \
+	{								 \
+		struct zsl_mtx ## n t;					 \
+									 \
+		ZSL_FIXED_REP_ ## nn(ZSL_FIXED_MULT_EL, n, ma, mb, t)	 \
+		*mc = t;						 \
+	}								 \
+									 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _mult_vec(			 \
+		const struct zsl_mtx ## n *ma,				 \
+		const struct zsl_vec ## n *v, struct zsl_vec ## n *w)	 \
+	{								 \
+		struct zsl_vec ## n t;					 \
+									 \
+		ZSL_FIXED_REP_ ## n(ZSL_FIXED_MV_EL, n, ma, v, t)	 \
+		*w = t;							 \
+	}								 \
+									 \
+	ZSL_MTXF_API void zsl_mtx ## n ## _trans(			 \
+		const struct zsl_mtx ## n *ma, struct zsl_mtx ## n *mt)	 \
+	{								 \
+		struct zsl_mtx ## n t;					 \
+									 \
+		ZSL_FIXED_REP_ ## nn(ZSL_FIXED_TRANS_EL, n, ma, t)	 \
+		*mt = t;						 \
+	}								 \
+									 \
+	ZSL_MTXF_API int zsl_mtx ## n ## _from_mtx(struct zsl_mtx ## n *mf,   \
+		struct zsl_mtx *m)					 \
+	{								 \
+		if ((m->sz_rows != n) || (m->sz_cols != n)) {		 \
+			return -EINVAL;					 \
+		}							 \
+		for (size_t i = 0; i < n; i++) {			 \
+			for (size_t j = 0; j < n; j++) {		 \
+				zsl_mtx_get(m, i, j, &mf->data[(i * n) + j]); \
+			}						 \
+		}							 \
+		return 0;						 \
+	}								 \
+									 \
+	ZSL_MTXF_API int zsl_mtx ## n ## _to_mtx(			 \
+		const struct zsl_mtx ## n *mf, struct zsl_mtx *m)	 \
+	{								 \
+		if ((m->sz_rows != n) || (m->sz_cols != n)) {		 \
+			return -EINVAL;					 \
+		}							 \
+		return zsl_mtx_from_arr(m, (zsl_real_t *)mf->data);	 \
+	}
+
+#if CONFIG_ZSL_VECTOR_INLINE || defined(ZSL_FIXED_IMPL)
+
+ZSL_VECF_DEFINE(2)
+ZSL_VECF_DEFINE(3)
+ZSL_VECF_DEFINE(4)
+ZSL_VECF_DEFINE(6)
+
+#endif
+
+#if CONFIG_ZSL_MATRIX_INLINE || defined(ZSL_FIXED_IMPL)
+
+ZSL_MTXF_DEFINE(2, 4)
+ZSL_MTXF_DEFINE(3, 9)
+ZSL_MTXF_DEFINE(4, 16)
+ZSL_MTXF_DEFINE(6, 36)
+
+ZSL_MTXF_API zsl_real_t zsl_mtx2_deter(const struct zsl_mtx2 *m)
+{
+	const zsl_real_t *a = m->data;
+
+	return (a[0] * a[3]) - (a[1] * a[2]);
+}
+
+ZSL_MTXF_API int zsl_mtx2_inv(const struct zsl_mtx2 *m, struct zsl_mtx2 *mi)
+{
+	const zsl_real_t *a = m->data;
+	zsl_real_t d = zsl_mtx2_deter(m);
+	zsl_real_t s;
+	struct zsl_mtx2 t;
+
+	if (d == 0.0) {
+		return -ESINGULAR;
+	}
+	s = 1.0f / d;
+
+	t.data[0] = a[3] * s;
+	t.data[1] = -a[1] * s;
+	t.data[2] = -a[2] * s;
+	t.data[3] = a[0] * s;
+	*mi = t;
+
+	return 0;
+}
+
+ZSL_MTXF_API zsl_real_t zsl_mtx3_deter(const struct zsl_mtx3 *m)
+{
+	const zsl_real_t *a = m->data;
+
+	return a[0] * ((a[4] * a[8]) - (a[5] * a[7])) +
+	       a[1] * ((a[5] * a[6]) - (a[3] * a[8])) +
+	       a[2] * ((a[3] * a[7]) - (a[4] * a[6]));
+}
+
+ZSL_MTXF_API int zsl_mtx3_inv(const struct zsl_mtx3 *m, struct zsl_mtx3 *mi)
+{
+	const zsl_real_t *a = m->data;
+	zsl_real_t d;
+	zsl_real_t s;
+	struct zsl_mtx3 t;
+
+	/* Adjugate, i.e. the transposed matrix of cofactors. */
+	t.data[0] = (a[4] * a[8]) - (a[5] * a[7]);
+	t.data[1] = (a[2] * a[7]) - (a[1] * a[8]);
+	t.data[2] = (a[1] * a[5]) - (a[2] * a[4]);
+	t.data[3] = (a[5] * a[6]) - (a[3] * a[8]);
+	t.data[4] = (a[0] * a[8]) - (a[2] * a[6]);
+	t.data[5] = (a[2] * a[3]) - (a[0] * a[5]);
+	t.data[6] = (a[3] * a[7]) - (a[4] * a[6]);
+	t.data[7] = (a[1] * a[6]) - (a[0] * a[7]);
+	t.data[8] = (a[0] * a[4]) - (a[1] * a[3]);
+
+	d = (a[0] * t.data[0]) + (a[1] * t.data[3]) + (a[2] * t.data[6]);
+	if (d == 0.0) {
+		return -ESINGULAR;
+	}
+	s = 1.0f / d;
+
+	ZSL_FIXED_REP_9(ZSL_FIXED_SCALE_EL, &t, s)
+	*mi = t;
+
+	return 0;
+}
+
+/*
+ * The 4x4 determinant and inverse are expanded over the six 2x2 minors of
+ * the top two rows (s0..s5) and of the bottom two rows (c0..c5).
+ */
+#define ZSL_MTX4_MINORS(a)				   \
+	const zsl_real_t s0 = (a[0] * a[5]) - (a[4] * a[1]);   \
+	const zsl_real_t s1 = (a[0] * a[6]) - (a[4] * a[2]);   \
+	const zsl_real_t s2 = (a[0] * a[7]) - (a[4] * a[3]);   \
+	const zsl_real_t s3 = (a[1] * a[6]) - (a[5] * a[2]);   \
+	const zsl_real_t s4 = (a[1] * a[7]) - (a[5] * a[3]);   \
+	const zsl_real_t s5 = (a[2] * a[7]) - (a[6] * a[3]);   \
+	const zsl_real_t c0 = (a[8] * a[13]) - (a[12] * a[9]);  \
+	const zsl_real_t c1 = (a[8] * a[14]) - (a[12] * a[10]); \
+	const zsl_real_t c2 = (a[8] * a[15]) - (a[12] * a[11]); \
+	const zsl_real_t c3 = (a[9] * a[14]) - (a[13] * a[10]); \
+	const zsl_real_t c4 = (a[9] * a[15]) - (a[13] * a[11]); \
+	const zsl_real_t c5 = (a[10] * a[15]) - (a[14] * a[11])
+
+#define ZSL_MTX4_DETER() \
+	((s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0))
+
+ZSL_MTXF_API zsl_real_t zsl_mtx4_deter(const struct zsl_mtx4 *m)
+{
+	const zsl_real_t *a = m->data;
+
+	ZSL_MTX4_MINORS(a);
+
+	return ZSL_MTX4_DETER();
+}
+
+ZSL_MTXF_API int zsl_mtx4_inv(const struct zsl_mtx4 *m, struct zsl_mtx4 *mi)
+{
+	const zsl_real_t *a = m->data;
+	zsl_real_t d;
+	zsl_real_t s;
+	struct zsl_mtx4 t;
+
+	ZSL_MTX4_MINORS(a);
+
+	d = ZSL_MTX4_DETER();
+	if (d == 0.0) {
+		return -ESINGULAR;
+	}
+	s = 1.0f / d;
+
+	t.data[0] = ((a[5] * c5) - (a[6] * c4) + (a[7] * c3)) * s;
+	t.data[1] = (-(a[1] * c5) + (a[2] * c4) - (a[3] * c3)) * s;
+	t.data[2] = ((a[13] * s5) - (a[14] * s4) + (a[15] * s3)) * s;
+	t.data[3] = (-(a[9] * s5) + (a[10] * s4) - (a[11] * s3)) * s;
+	t.data[4] = (-(a[4] * c5) + (a[6] * c2) - (a[7] * c1)) * s;
+	t.data[5] = ((a[0] * c5) - (a[2] * c2) + (a[3] * c1)) * s;
+	t.data[6] = (-(a[12] * s5) + (a[14] * s2) - (a[15] * s1)) * s;
+	t.data[7] = ((a[8] * s5) - (a[10] * s2) + (a[11] * s1)) * s;
+	t.data[8] = ((a[4] * c4) - (a[5] * c2) + (a[7] * c0)) * s;
+	t.data[9] = (-(a[0] * c4) + (a[1] * c2) - (a[3] * c0)) * s;
+	t.data[10] = ((a[12] * s4) - (a[13] * s2) + (a[15] * s0)) * s;
+	t.data[11] = (-(a[8] * s4) + (a[9] * s2) - (a[11] * s0)) * s;
+	t.data[12] = (-(a[4] * c3) + (a[5] * c1) - (a[6] * c0)) * s;
+	t.data[13] = ((a[0] * c3) - (a[1] * c1) + (a[2] * c0)) * s;
+	t.data[14] = (-(a[12] * s3) + (a[13] * s1) - (a[14] * s0)) * s;
+	t.data[15] = ((a[8] * s3) - (a[9] * s1) + (a[10] * s0)) * s;
+	*mi = t;
+
+	return 0;
+}
+
+ZSL_MTXF_API zsl_real_t zsl_mtx6_deter(const struct zsl_mtx6 *m)
+{
+	struct zsl_mtx6 u = *m;
+	zsl_real_t d = 1.0;
+
+	/* Gaussian elimination with partial pivoting; d = +/- prod(diag(U)). */
+	for (size_t k = 0; k < 6; k++) {
+		size_t p = k;
+
+		for (size_t i = k + 1; i < 6; i++) {
+			if (ZSL_ABS(u.data[(i * 6) + k]) >
+			    ZSL_ABS(u.data[(p * 6) + k])) {
+				p = i;
+			}
+		}
+		if (u.data[(p * 6) + k] == 0.0) {
+			return 0.0;
+		}
+		if (p != k) {
+			for (size_t j = k; j < 6; j++) {
+				zsl_real_t x = u.data[(k * 6) + j];
+
+				u.data[(k * 6) + j] = u.data[(p * 6) + j];
+				u.data[(p * 6) + j] = x;
+			}
+			d = -d;
+		}
+		d *= u.data[(k * 6) + k];
+
+		for (size_t i = k + 1; i < 6; i++) {
+			zsl_real_t f = u.data[(i * 6) + k] / u.data[(k * 6) + k];
+
+			for (size_t j = k + 1; j < 6; j++) {
+				u.data[(i * 6) + j] -= f * u.data[(k * 6) + j];
+			}
+		}
+	}
+
+	return d;
+}
+
+ZSL_MTXF_API int zsl_mtx6_inv(const struct zsl_mtx6 *m, struct zsl_mtx6 *mi)
+{
+	struct zsl_mtx6 u = *m;
+	struct zsl_mtx6 t;
+
+	zsl_mtx6_identity(&t);
+
+	/* Gauss-Jordan elimination with partial pivoting on [u | t]. */
+	for (size_t k = 0; k < 6; k++) {
+		size_t p = k;
+		zsl_real_t s;
+
+		for (size_t i = k + 1; i < 6; i++) {
+			if (ZSL_ABS(u.data[(i * 6) + k]) >
+			    ZSL_ABS(u.data[(p * 6) + k])) {
+				p = i;
+			}
+		}
+		if (u.data[(p * 6) + k] == 0.0) {
+			return -ESINGULAR;
+		}
+		if (p != k) {
+			for (size_t j = 0; j < 6; j++) {
+				zsl_real_t x = u.data[(k * 6) + j];
+				zsl_real_t y = t.data[(k * 6) + j];
+
+				u.data[(k * 6) + j] = u.data[(p * 6) + j];
+				u.data[(p * 6) + j] = x;
+				t.data[(k * 6) + j] = t.data[(p * 6) + j];
+				t.data[(p * 6) + j] = y;
+			}
+		}
+
+		s = 1.0f / u.data[(k * 6) + k];
+		for (size_t j = 0; j < 6; j++) {
+			u.data[(k * 6) + j] *= s;
+			t.data[(k * 6) + j] *= s;
+		}
+
+		for (size_t i = 0; i < 6; i++) {
+			zsl_real_t f = u.data[(i * 6) + k];
+
+			if (i == k) {
+				continue;
+			}
+			for (size_t j = 0; j < 6; j++) {
+				u.data[(i * 6) + j] -= f * u.data[(k * 6) + j];
+				t.data[(i * 6) + j] -= f * t.data[(k * 6) + j];
+			}
+		}
+	}
+
+	*mi = t;
+
+	return 0;
+}
+
+#undef ZSL_MTX4_MINORS
+#undef ZSL_MTX4_DETER
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_MATRICES_FIXED_H_ */
+
+/** @} */ /* End of FIXED group */
@@ -0,0 +1,504 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup SOLVERS Iterative Solvers
+ *
+ * @brief Matrix-free iterative solvers for the linear system 'A * x = b'.
+ *
+ * The solvers only ever need the product of 'A' with a vector, which is
+ * provided by a linear operator (@ref zsl_linop). The operator can wrap a
+ * dense or sparse matrix, or be any user callback, so 'A' never needs to be
+ * formed or inverted. An optional preconditioner (@ref zsl_precond)
+ * approximates the action of the inverse of 'A' to speed up convergence.
+ *
+ * - @ref zsl_solve_cg for symmetric positive definite systems.
+ * - @ref zsl_solve_bicgstab for general non-symmetric systems.
+ * - @ref zsl_solve_gmres for general systems, restarted every 'restart'
+ *   iterations to bound memory use.
+ *
+ * All temporary vectors are taken from a caller-provided workspace, and the
+ * iteration count and residual history are reported through
+ * @ref zsl_solver_params.
+ *
+ * The mixed-precision solvers (@ref zsl_solve_lu_mixed and
+ * @ref zsl_solve_cho_mixed) instead factorise a dense 'A' in single
+ * precision, which is faster and takes half the memory on targets with a
+ * single-precision FPU, and then recover double-precision accuracy by
+ * iterative refinement.
+ */
+
+/**
+ * @file
+ * @brief API header file for iterative solvers in zscilib.
+ *
+ * This file contains the zscilib iterative solver APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_SOLVERS_H_
+#define ZEPHYR_INCLUDE_ZSL_SOLVERS_H_
+
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/sparse.h>
+#include <zsl/workspace.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SOLVERS_STRUCTS Structs and Macros
+ *
+ * @brief Linear operators, preconditioners and solver parameters.
+ *
+ * @ingroup SOLVERS
+ *  @{ */
+
+/**
+ * @brief Function prototype to calculate 'y = A * x'.
+ *
+ * @param ctx   The context pointer of the operator.
+ * @param x     The input vector.
+ * @param y     The output vector, which is never the same vector as 'x'.
+ *
+ * @return 0 on success, or a negative error code that aborts the solver.
+ */
+typedef int (*zsl_linop_fn_t)(void *ctx, struct zsl_vec *x, struct zsl_vec *y);
+
+/**
+ * @brief Function prototype to calculate 'z = M^-1 * r', where 'M' is a
+ *        preconditioner approximating 'A'.
+ *
+ * @param ctx   The context pointer of the preconditioner.
+ * @param r     The input vector.
+ * @param z     The output vector, which is never the same vector as 'r'.
+ *
+ * @return 0 on success, or a negative error code that aborts the solver.
+ */
+typedef int (*zsl_precond_fn_t)(void *ctx, struct zsl_vec *r,
+				struct zsl_vec *z);
+
+/** @brief Represents the n x n linear operator 'A' of a system. */
+struct zsl_linop {
+	/** The number of rows and columns of 'A'. */
+	size_t n;
+	/** Calculates 'y = A * x'. */
+	zsl_linop_fn_t apply;
+	/** Context pointer passed to 'apply', e.g. the matrix. */
+	void *ctx;
+};
+
+/** @brief Represents a preconditioner. */
+struct zsl_precond {
+	/** Calculates 'z = M^-1 * r'. */
+	zsl_precond_fn_t apply;
+	/** Context pointer passed to 'apply'. */
+	void *ctx;
+};
+
+/** @brief Stopping criteria and statistics of an iterative solve. */
+struct zsl_solver_params {
+	/**
+	 * Input: the solve stops once the residual norm |b - A * x| is at most
+	 * 'tol' times |b|.
+	 */
+	zsl_real_t tol;
+	/** Input: the maximum number of iterations. */
+	size_t max_iter;
+	/**
+	 * Input: the number of iterations between restarts of
+	 * @ref zsl_solve_gmres. Ignored by the other solvers.
+	 */
+	size_t restart;
+	/**
+	 * Input: optional array receiving the residual norm before the first
+	 * iteration and after each iteration, or NULL.
+	 */
+	zsl_real_t *hist;
+	/** Input: the number of entries in 'hist'. Extra values are dropped. */
+	size_t hist_sz;
+	/** Output: the number of iterations carried out. */
+	size_t iter;
+	/** Output: the final residual norm |b - A * x|. */
+	zsl_real_t res;
+};
+
+/** @} */ /* End of SOLVERS_STRUCTS group */
+
+/**
+ * @addtogroup SOLVERS_OPS Operators and Preconditioners
+ *
+ * @brief Functions to set up linear operators and preconditioners.
+ *
+ * @ingroup SOLVERS
+ *  @{ */
+
+/**
+ * @brief Sets up 'op' to multiply by the dense square matrix 'm'.
+ *
+ * @param op    The operator to set up.
+ * @param m     The matrix, which must remain valid while 'op' is used.
+ *
+ * @return  0 on success, or -EINVAL if 'm' isn't square.
+ */
+int zsl_linop_mtx(struct zsl_linop *op, struct zsl_mtx *m);
+
+/**
+ * @brief Sets up 'op' to multiply by the sparse square matrix 'sp'.
+ *
+ * @param op    The operator to set up.
+ * @param sp    The matrix, which must remain valid while 'op' is used.
+ *
+ * @return  0 on success, or -EINVAL if 'sp' isn't square.
+ */
+int zsl_linop_spmtx(struct zsl_linop *op, struct zsl_spmtx *sp);
+
+/**
+ * @brief Sets up the Jacobi (diagonal) preconditioner of the dense matrix
+ *        'm', storing the inverse of its diagonal in 'd'.
+ *
+ * @param pc    The preconditioner to set up.
+ * @param m     The square matrix.
+ * @param d     The vector receiving the inverse diagonal, of size n, which
+ *              must remain valid while 'pc' is used.
+ *
+ * @return  0 on success, -EINVAL if the sizes don't match, or -ESINGULAR if
+ *          a diagonal value is zero.
+ */
+int zsl_precond_jacobi_mtx(struct zsl_precond *pc, struct zsl_mtx *m,
+			   struct zsl_vec *d);
+
+/**
+ * @brief Sets up the Jacobi (diagonal) preconditioner of the sparse matrix
+ *        'sp', storing the inverse of its diagonal in 'd'.
+ *
+ * @param pc    The preconditioner to set up.
+ * @param sp    The square sparse matrix.
+ * @param d     The vector receiving the inverse diagonal, of size n, which
+ *              must remain valid while 'pc' is used.
+ *
+ * @return  0 on success, -EINVAL if the sizes don't match, or -ESINGULAR if
+ *          a diagonal value is zero or missing.
+ */
+int zsl_precond_jacobi_spmtx(struct zsl_precond *pc, struct zsl_spmtx *sp,
+			     struct zsl_vec *d);
+
+/**
+ * @brief Sets up the zero fill-in incomplete Cholesky preconditioner,
+ *        IC(0), of the symmetric positive definite sparse matrix 'sp'.
+ *
+ * The factor 'l' has the sparsity pattern of the lower triangle of 'sp',
+ * and 'L * L^T' matches 'sp' on that pattern. Only the lower triangle and
+ * diagonal of 'sp' are read. Applying the preconditioner takes one forward
+ * and one backward sparse triangular solve.
+ *
+ * @param pc    The preconditioner to set up.
+ * @param sp    The square sparse matrix.
+ * @param l     The output lower triangular factor, with room for the
+ *              values on and below the diagonal of 'sp', which must remain
+ *              valid while 'pc' is used.
+ *
+ * @return  0 on success, -EINVAL if the shapes don't match, -ENOMEM if 'l'
+ *          is too small, or -ENOTPOSDEF if a diagonal value is missing or
+ *          the factorisation breaks down.
+ */
+int zsl_precond_ic0(struct zsl_precond *pc, struct zsl_spmtx *sp,
+		    struct zsl_spmtx *l);
+
+/** @} */ /* End of SOLVERS_OPS group */
+
+/**
+ * @addtogroup SOLVERS_FUNCS Solvers
+ *
+ * @brief Conjugate gradient, BiCGSTAB and GMRES.
+ *
+ * Each solver uses 'x' as the initial guess, and overwrites it with the
+ * solution. Pass NULL as the preconditioner to solve without one.
+ *
+ * @ingroup SOLVERS
+ *  @{ */
+
+/**
+ * @brief Solves 'A * x = b' with the preconditioned conjugate gradient
+ *        method, where 'A' (and the preconditioner) must be symmetric
+ *        positive definite.
+ *
+ * Temporary vectors are declared on the stack. Use 'zsl_solve_cg_ws' to
+ * take them from a workspace instead.
+ *
+ * @param a     The linear operator.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The initial guess, overwritten with the solution.
+ * @param pc    The preconditioner, or NULL.
+ * @param p     The stopping criteria, and the output statistics.
+ *
+ * @return  0 if the solve converged, -EINVAL if the sizes don't match,
+ *          -ENOTPOSDEF if 'A' was found not to be positive definite, or
+ *          -ENOCONVERGE if 'p->max_iter' was reached first.
+ */
+int zsl_solve_cg(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		 struct zsl_precond *pc, struct zsl_solver_params *p);
+
+/**
+ * @brief Same as 'zsl_solve_cg', but takes all temporary storage from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param a     The linear operator.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The initial guess, overwritten with the solution.
+ * @param pc    The preconditioner, or NULL.
+ * @param p     The stopping criteria, and the output statistics.
+ * @param ws    The workspace, of at least 'zsl_solve_cg_ws_size' bytes.
+ *
+ * @return  As for 'zsl_solve_cg', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_solve_cg_ws(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		    struct zsl_precond *pc, struct zsl_solver_params *p,
+		    struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_solve_cg_ws' needs for
+ *        a system of size n.
+ *
+ * @param n     The size of the system.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_solve_cg_ws_size(size_t n);
+
+/**
+ * @brief Solves 'A * x = b' with the right-preconditioned biconjugate
+ *        gradient stabilised method (BiCGSTAB), for non-symmetric 'A'.
+ *
+ * Temporary vectors are declared on the stack. Use 'zsl_solve_bicgstab_ws'
+ * to take them from a workspace instead.
+ *
+ * @param a     The linear operator.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The initial guess, overwritten with the solution.
+ * @param pc    The preconditioner, or NULL.
+ * @param p     The stopping criteria, and the output statistics.
+ *
+ * @return  0 if the solve converged, -EINVAL if the sizes don't match, or
+ *          -ENOCONVERGE if 'p->max_iter' was reached first or the method
+ *          broke down.
+ */
+int zsl_solve_bicgstab(struct zsl_linop *a, struct zsl_vec *b,
+		       struct zsl_vec *x, struct zsl_precond *pc,
+		       struct zsl_solver_params *p);
+
+/**
+ * @brief Same as 'zsl_solve_bicgstab', but takes all temporary storage from
+ *        the workspace 'ws' rather than from the stack.
+ *
+ * @param a     The linear operator.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The initial guess, overwritten with the solution.
+ * @param pc    The preconditioner, or NULL.
+ * @param p     The stopping criteria, and the output statistics.
+ * @param ws    The workspace, of at least 'zsl_solve_bicgstab_ws_size'
+ *              bytes.
+ *
+ * @return  As for 'zsl_solve_bicgstab', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_solve_bicgstab_ws(struct zsl_linop *a, struct zsl_vec *b,
+			  struct zsl_vec *x, struct zsl_precond *pc,
+			  struct zsl_solver_params *p,
+			  struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_solve_bicgstab_ws'
+ *        needs for a system of size n.
+ *
+ * @param n     The size of the system.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_solve_bicgstab_ws_size(size_t n);
+
+/**
+ * @brief Solves 'A * x = b' with the right-preconditioned generalised
+ *        minimal residual method, restarted every 'p->restart' iterations.
+ *
+ * The residual norm is that of the unpreconditioned system, and is
+ * obtained at no extra cost in each iteration. Temporary storage is
+ * declared on the stack. Use 'zsl_solve_gmres_ws' to take it from a
+ * workspace instead.
+ *
+ * @param a     The linear operator.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The initial guess, overwritten with the solution.
+ * @param pc    The preconditioner, or NULL.
+ * @param p     The stopping criteria, and the output statistics.
+ *
+ * @return  0 if the solve converged, -EINVAL if the sizes don't match or
+ *          'p->restart' is zero, or -ENOCONVERGE if 'p->max_iter' was
+ *          reached first.
+ */
+int zsl_solve_gmres(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		    struct zsl_precond *pc, struct zsl_solver_params *p);
+
+/**
+ * @brief Same as 'zsl_solve_gmres', but takes all temporary storage from
+ *        the workspace 'ws' rather than from the stack.
+ *
+ * @param a     The linear operator.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The initial guess, overwritten with the solution.
+ * @param pc    The preconditioner, or NULL.
+ * @param p     The stopping criteria, and the output statistics.
+ * @param ws    The workspace, of at least 'zsl_solve_gmres_ws_size' bytes.
+ *
+ * @return  As for 'zsl_solve_gmres', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_solve_gmres_ws(struct zsl_linop *a, struct zsl_vec *b,
+		       struct zsl_vec *x, struct zsl_precond *pc,
+		       struct zsl_solver_params *p, struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_solve_gmres_ws' needs
+ *        for a system of size n, restarted every 'restart' iterations.
+ *
+ * @param n         The size of the system.
+ * @param restart   The restart length.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_solve_gmres_ws_size(size_t n, size_t restart);
+
+/** @} */ /* End of SOLVERS_FUNCS group */
+
+/**
+ * @addtogroup SOLVERS_MIXED Mixed Precision
+ *
+ * @brief Dense solvers with a single-precision factor and iterative
+ *        refinement.
+ *
+ * The n x n matrix 'A' is copied to a float matrix and factorised once in
+ * O(n^3) single-precision operations. Each refinement step then calculates
+ * the residual 'r = b - A * x' in double precision from the original 'A',
+ * solves 'A * d = r' with the float factor in O(n^2) and adds 'd' to 'x'.
+ * The error shrinks by roughly cond(A) * FLT_EPSILON per step, so this
+ * converges to double-precision accuracy as long as cond(A) is well below
+ * 1 / FLT_EPSILON, i.e. 10^7.
+ *
+ * The initial contents of 'x' are ignored, and the first step starts from
+ * 'x = 0'. The refinement stops with -ENOCONVERGE when 'p->max_iter' steps
+ * have been taken or the residual stops decreasing, which means 'A' is too
+ * ill-conditioned for a single-precision factor. 'p->restart' is unused.
+ *
+ * In single-precision builds the residual is still accumulated in double
+ * precision, which improves the result of the float factor, but 'x' itself
+ * can only be as accurate as zsl_real_t allows.
+ *
+ * @ingroup SOLVERS
+ *  @{ */
+
+/**
+ * @brief Solves 'A * x = b' for a general square 'A', using a
+ *        single-precision LU factor with partial pivoting and iterative
+ *        refinement.
+ *
+ * The factor is declared on the stack. Use 'zsl_solve_lu_mixed_ws' to take
+ * it from a workspace instead.
+ *
+ * @param a     The n x n matrix 'A'. Any layout is accepted.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output solution, of size n.
+ * @param p     The stopping criteria, and the output statistics.
+ *
+ * @return  0 if the solve converged, -EINVAL if the sizes don't match,
+ *          -ESINGULAR if 'A' is singular in single precision, or
+ *          -ENOCONVERGE if the refinement didn't converge.
+ */
+int zsl_solve_lu_mixed(struct zsl_mtx *a, struct zsl_vec *b,
+		       struct zsl_vec *x, struct zsl_solver_params *p);
+
+/**
+ * @brief Same as 'zsl_solve_lu_mixed', but takes the factor from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param a     The n x n matrix 'A'.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output solution, of size n.
+ * @param p     The stopping criteria, and the output statistics.
+ * @param ws    The workspace, of at least 'zsl_solve_lu_mixed_ws_size'
+ *              bytes.
+ *
+ * @return  As for 'zsl_solve_lu_mixed', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_solve_lu_mixed_ws(struct zsl_mtx *a, struct zsl_vec *b,
+			  struct zsl_vec *x, struct zsl_solver_params *p,
+			  struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_solve_lu_mixed_ws'
+ *        needs for a system of size n.
+ *
+ * @param n     The size of the system.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_solve_lu_mixed_ws_size(size_t n);
+
+/**
+ * @brief Solves 'A * x = b' for a symmetric positive definite 'A', using a
+ *        single-precision Cholesky factor and iterative refinement.
+ *
+ * Only the lower triangle of 'A' is factorised, but the whole matrix is
+ * read for the residual. The factor is declared on the stack. Use
+ * 'zsl_solve_cho_mixed_ws' to take it from a workspace instead.
+ *
+ * @param a     The n x n symmetric positive definite matrix 'A'.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output solution, of size n.
+ * @param p     The stopping criteria, and the output statistics.
+ *
+ * @return  0 if the solve converged, -EINVAL if the sizes don't match,
+ *          -ENOTPOSDEF if 'A' isn't positive definite in single precision,
+ *          or -ENOCONVERGE if the refinement didn't converge.
+ */
+int zsl_solve_cho_mixed(struct zsl_mtx *a, struct zsl_vec *b,
+			struct zsl_vec *x, struct zsl_solver_params *p);
+
+/**
+ * @brief Same as 'zsl_solve_cho_mixed', but takes the factor from the
+ *        workspace 'ws' rather than from the stack.
+ *
+ * @param a     The n x n symmetric positive definite matrix 'A'.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output solution, of size n.
+ * @param p     The stopping criteria, and the output statistics.
+ * @param ws    The workspace, of at least 'zsl_solve_cho_mixed_ws_size'
+ *              bytes.
+ *
+ * @return  As for 'zsl_solve_cho_mixed', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_solve_cho_mixed_ws(struct zsl_mtx *a, struct zsl_vec *b,
+			   struct zsl_vec *x, struct zsl_solver_params *p,
+			   struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the number of workspace bytes 'zsl_solve_cho_mixed_ws'
+ *        needs for a system of size n.
+ *
+ * @param n     The size of the system.
+ *
+ * @return The workspace size in bytes.
+ */
+size_t zsl_solve_cho_mixed_ws_size(size_t n);
+
+/** @} */ /* End of SOLVERS_MIXED group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_SOLVERS_H_ */
+
+/** @} */ /* End of SOLVERS group */
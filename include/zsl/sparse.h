@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup SPARSE Sparse Matrices
+ *
+ * @brief Sparse matrix functions.
+ *
+ * Sparse matrices are stored in compressed sparse row (CSR) format, where
+ * only the non-zero values are kept along with their column indices, and
+ * the values of each row are stored contiguously. A coordinate (COO) list of
+ * (row, column, value) triplets can be filled in any order and converted to
+ * CSR once complete, which is the simplest way to assemble a sparse matrix.
+ *
+ * As with dense matrices and vectors, the memory used by a sparse matrix is
+ * owned by the caller, and is declared with @ref ZSL_SPMTX_DEF or
+ * @ref ZSL_SPCOO_DEF with a maximum number of non-zero values.
+ */
+
+/**
+ * @file
+ * @brief API header file for sparse matrices in zscilib.
+ *
+ * This file contains the zscilib sparse matrix APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_SPARSE_H_
+#define ZEPHYR_INCLUDE_ZSL_SPARSE_H_
+
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SP_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with sparse matrices.
+ *
+ * @ingroup SPARSE
+ *  @{ */
+
+/** @brief Represents a sparse matrix in compressed sparse row format. */
+struct zsl_spmtx {
+	/** The number of rows in the matrix. */
+	size_t sz_rows;
+	/** The number of columns in the matrix. */
+	size_t sz_cols;
+	/** The number of non-zero values currently stored. */
+	size_t nnz;
+	/** The maximum number of non-zero values that can be stored. */
+	size_t max_nnz;
+	/**
+	 * sz_rows + 1 offsets into 'col_idx' and 'data', where the values of
+	 * row i are stored from row_ptr[i] up to, but excluding, row_ptr[i+1].
+	 */
+	size_t *row_ptr;
+	/** The column index of each value, in ascending order in each row. */
+	size_t *col_idx;
+	/** The non-zero values. */
+	zsl_real_t *data;
+};
+
+/** @brief Represents a sparse matrix as a list of coordinate triplets. */
+struct zsl_spcoo {
+	/** The number of rows in the matrix. */
+	size_t sz_rows;
+	/** The number of columns in the matrix. */
+	size_t sz_cols;
+	/** The number of triplets currently stored. */
+	size_t nnz;
+	/** The maximum number of triplets that can be stored. */
+	size_t max_nnz;
+	/** The row index of each triplet. */
+	size_t *row_idx;
+	/** The column index of each triplet. */
+	size_t *col_idx;
+	/** The value of each triplet. */
+	zsl_real_t *data;
+};
+
+/**
+ * Macro to declare an empty CSR sparse matrix with 'nz' non-zero values.
+ *
+ * Be sure to also call 'zsl_spmtx_init' on the matrix after this macro.
+ */
+#define ZSL_SPMTX_DEF(name, m, n, nz)			    \
+	size_t name ## _rp[(m) + 1];			    \
+	size_t name ## _ci[nz];				    \
+	zsl_real_t name ## _sp[nz];			    \
+	struct zsl_spmtx name = {			    \
+		.sz_rows = m,				    \
+		.sz_cols = n,				    \
+		.nnz = 0,				    \
+		.max_nnz = nz,				    \
+		.row_ptr = name ## _rp,			    \
+		.col_idx = name ## _ci,			    \
+		.data = name ## _sp			    \
+	}
+
+/**
+ * Macro to declare an empty coordinate list with room for 'nz' triplets.
+ *
+ * Be sure to also call 'zsl_spcoo_init' on the list after this macro.
+ */
+#define ZSL_SPCOO_DEF(name, m, n, nz)			    \
+	size_t name ## _ri[nz];				    \
+	size_t name ## _ci[nz];				    \
+	zsl_real_t name ## _coo[nz];			    \
+	struct zsl_spcoo name = {			    \
+		.sz_rows = m,				    \
+		.sz_cols = n,				    \
+		.nnz = 0,				    \
+		.max_nnz = nz,				    \
+		.row_idx = name ## _ri,			    \
+		.col_idx = name ## _ci,			    \
+		.data = name ## _coo			    \
+	}
+
+/** @} */ /* End of SP_STRUCTS group */
+
+/**
+ * @addtogroup SP_INIT Initialisation and Conversion
+ *
+ * @brief Sparse matrix initialisation, assembly and conversion.
+ *
+ * @ingroup SPARSE
+ *  @{ */
+
+/**
+ * @brief Empties the sparse matrix 'sp', making every value zero.
+ *
+ * @param sp    The sparse matrix to initialise.
+ *
+ * @return  0 on success, and non-zero error code on failure
+ */
+int zsl_spmtx_init(struct zsl_spmtx *sp);
+
+/**
+ * @brief Empties the coordinate list 'coo'.
+ *
+ * @param coo   The coordinate list to initialise.
+ *
+ * @return  0 on success, and non-zero error code on failure
+ */
+int zsl_spcoo_init(struct zsl_spcoo *coo);
+
+/**
+ * @brief Appends the value 'x' at position (i, j) to the coordinate list.
+ *
+ * The triplets can be added in any order. Several triplets with the same
+ * position are summed when the list is converted with
+ * @ref zsl_spmtx_from_coo.
+ *
+ * @param coo   The coordinate list.
+ * @param i     The row number.
+ * @param j     The column number.
+ * @param x     The value to add.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if (i, j) is out of
+ *          bounds, or -ENOMEM if the list is full.
+ */
+int zsl_spcoo_add(struct zsl_spcoo *coo, size_t i, size_t j, zsl_real_t x);
+
+/**
+ * @brief Converts the coordinate list 'coo' to the CSR matrix 'sp'.
+ *
+ * The columns of each row are sorted, and triplets sharing a position are
+ * summed into a single value. 'coo' is left unmodified.
+ *
+ * @param coo   The source coordinate list.
+ * @param sp    The output sparse matrix, with the same shape as 'coo'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the shapes
+ *          differ, or -ENOMEM if 'sp' has room for fewer values than there
+ *          are triplets in 'coo'.
+ */
+int zsl_spmtx_from_coo(struct zsl_spcoo *coo, struct zsl_spmtx *sp);
+
+/**
+ * @brief Converts the dense matrix 'm' to the sparse matrix 'sp', keeping
+ *        only the values whose magnitude is greater than 'tol'.
+ *
+ * @param m     The source dense matrix.
+ * @param sp    The output sparse matrix, with the same shape as 'm'.
+ * @param tol   Values with a magnitude less than or equal to 'tol' are
+ *              dropped. Use 0.0 to only drop exact zeros.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the shapes
+ *          differ, or -ENOMEM if 'sp' can't hold the non-zero values.
+ */
+int zsl_spmtx_from_mtx(struct zsl_mtx *m, struct zsl_spmtx *sp,
+		       zsl_real_t tol);
+
+/**
+ * @brief Converts the sparse matrix 'sp' to the dense matrix 'm'.
+ *
+ * @param sp    The source sparse matrix.
+ * @param m     The output dense matrix, with the same shape as 'sp'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the shapes
+ *          differ.
+ */
+int zsl_spmtx_to_mtx(struct zsl_spmtx *sp, struct zsl_mtx *m);
+
+/**
+ * @brief Gets the value at position (i, j) of the sparse matrix 'sp'.
+ *
+ * @param sp    The sparse matrix.
+ * @param i     The row number.
+ * @param j     The column number.
+ * @param x     Pointer to the output value, set to 0.0 if (i, j) isn't
+ *              stored.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if (i, j) is out
+ *          of bounds.
+ */
+int zsl_spmtx_get(struct zsl_spmtx *sp, size_t i, size_t j, zsl_real_t *x);
+
+/** @} */ /* End of SP_INIT group */
+
+/**
+ * @addtogroup SP_MATH Math
+ *
+ * @brief Products, transposition and triangular solves.
+ *
+ * @ingroup SPARSE
+ *  @{ */
+
+/**
+ * @brief Multiplies the sparse matrix 'sp' by the vector 'v', such that
+ *        'w = sp * v'.
+ *
+ * @param sp    The mxn sparse matrix.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size m. Must not be the same vector
+ *              as 'v'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_spmtx_mult_vec(struct zsl_spmtx *sp, struct zsl_vec *v,
+		       struct zsl_vec *w);
+
+/**
+ * @brief Multiplies the transpose of the sparse matrix 'sp' by the vector
+ *        'v', such that 'w = sp^T * v', without forming the transpose.
+ *
+ * @param sp    The mxn sparse matrix.
+ * @param v     The input vector, of size m.
+ * @param w     The output vector, of size n. Must not be the same vector
+ *              as 'v'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_spmtx_mult_trans_vec(struct zsl_spmtx *sp, struct zsl_vec *v,
+			     struct zsl_vec *w);
+
+/**
+ * @brief Multiplies the sparse matrix 'sp' by the dense matrix 'mb', such
+ *        that 'mc = sp * mb'.
+ *
+ * @param sp    The mxn sparse matrix.
+ * @param mb    The nxk dense matrix.
+ * @param mc    The mxk output dense matrix. Must not be the same matrix as
+ *              'mb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the shapes
+ *          don't match.
+ */
+int zsl_spmtx_mult_mtx(struct zsl_spmtx *sp, struct zsl_mtx *mb,
+		       struct zsl_mtx *mc);
+
+/**
+ * @brief Transposes the sparse matrix 'sp' into 'st'.
+ *
+ * @param sp    The mxn sparse matrix.
+ * @param st    The nxm output sparse matrix.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the shapes don't
+ *          match, or -ENOMEM if 'st' can't hold the values of 'sp'.
+ */
+int zsl_spmtx_trans(struct zsl_spmtx *sp, struct zsl_spmtx *st);
+
+/**
+ * @brief Solves 'l * x = b' by forward substitution, where 'l' is a sparse
+ *        lower triangular matrix. Values above the diagonal are ignored.
+ *
+ * @param l     The nxn sparse lower triangular matrix.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output vector, of size n, which may point to the same
+ *              vector as 'b'.
+ * @param unit  If true, the diagonal of 'l' is taken to be all 1.0, and any
+ *              stored diagonal value is ignored.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ESINGULAR if a diagonal value is zero or missing.
+ */
+int zsl_spmtx_solve_lower(struct zsl_spmtx *l, struct zsl_vec *b,
+			  struct zsl_vec *x, bool unit);
+
+/**
+ * @brief Solves 'u * x = b' by back substitution, where 'u' is a sparse
+ *        upper triangular matrix. Values below the diagonal are ignored.
+ *
+ * @param u     The nxn sparse upper triangular matrix.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output vector, of size n, which may point to the same
+ *              vector as 'b'.
+ * @param unit  If true, the diagonal of 'u' is taken to be all 1.0, and any
+ *              stored diagonal value is ignored.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the sizes don't
+ *          match, or -ESINGULAR if a diagonal value is zero or missing.
+ */
+int zsl_spmtx_solve_upper(struct zsl_spmtx *u, struct zsl_vec *b,
+			  struct zsl_vec *x, bool unit);
+
+/** @} */ /* End of SP_MATH group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_SPARSE_H_ */
+
+/** @} */ /* End of SPARSE group */
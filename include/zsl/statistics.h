@@ -24,6 +24,7 @@
 #include <zsl/zsl.h>
 #include <zsl/vectors.h>
 #include <zsl/matrices.h>
+#include <zsl/half.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +46,41 @@ struct zsl_sta_linreg {
 	zsl_real_t correlation;
 };
 
+/**
+ * @brief State of a recursive least squares (RLS) estimator of the n
+ *        parameters 'theta' of the model 'y = phi^T * theta'.
+ *
+ * The estimator keeps the QR factor R of the exponentially weighted
+ * regressors rather than the inverse covariance matrix P of the classic
+ * RLS update, so it can't lose symmetry or positive definiteness.
+ */
+struct zsl_sta_rls {
+	/** The least squares state, with one right-hand side. */
+	struct zsl_mtx_lstsq ls;
+	/** The current parameter estimates. */
+	struct zsl_vec theta;
+	/**
+	 * The forgetting factor, in (0, 1]. Past samples are weighted down by
+	 * 'lambda' with each new sample, for a memory of about
+	 * 1 / (1 - lambda) samples.
+	 */
+	zsl_real_t lambda;
+};
+
+/**
+ * Macro to declare a recursive least squares estimator with 'n' parameters.
+ *
+ * Be sure to also call 'zsl_sta_rls_init' on the estimator after this macro.
+ */
+#define ZSL_STA_RLS_DEF(name, n)				  \
+	ZSL_MTX_LSTSQ_DEF(name ## _ls, n, 1);			  \
+	zsl_real_t name ## _theta[n];				  \
+	struct zsl_sta_rls name = {				  \
+		.ls = name ## _ls,				  \
+		.theta = { .sz = n, .data = name ## _theta },	  \
+		.lambda = 1.0					  \
+	}
+
 /**
  * @brief Computes the arithmetic mean (average) of a vector.
  *
@@ -55,6 +91,18 @@ struct zsl_sta_linreg {
  */
 int zsl_sta_mean(struct zsl_vec *v, zsl_real_t *m);
 
+/**
+ * @brief Computes the arithmetic mean of a compact (fp16 or bf16) vector,
+ *        reading the packed data directly and accumulating in zsl_real_t.
+ *
+ * @param v  The compact vector to use.
+ * @param m  The arithmetic mean of the components of v.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if v is empty or
+ *          its format is unknown.
+ */
+int zsl_sta_mean_half(struct zsl_vec_half *v, zsl_real_t *m);
+
 /**
  * @brief Subtracts the mean of vector v from every component of the vector.
  *        The output vector w then has a zero mean.
@@ -153,6 +201,21 @@ int zsl_sta_data_range(struct zsl_vec *v, zsl_real_t *r);
  */
 int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var);
 
+/**
+ * @brief Computes the variance of a compact (fp16 or bf16) vector v, with
+ *        the same definition as @ref zsl_sta_var.
+ *
+ * The packed data is read directly, a block at a time, in two passes over
+ * v, so no full-size copy of v is needed.
+ *
+ * @param v     The compact vector to use.
+ * @param var   The variance of v.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if v has fewer than
+ *          two elements or its format is unknown.
+ */
+int zsl_sta_var_half(struct zsl_vec_half *v, zsl_real_t *var);
+
 /**
  * @brief Computes the standard deviation of vector v.
  * 
@@ -221,6 +284,39 @@ int zsl_sta_covar_mtx(struct zsl_mtx *m, struct zsl_mtx *mc);
 int zsl_sta_linear_reg(struct zsl_vec *v, struct zsl_vec *w,
 		       struct zsl_sta_linreg *c);
 
+/**
+ * @brief Resets the recursive least squares estimator 'rls', with all
+ *        parameter estimates set to zero.
+ *
+ * @param rls     The estimator.
+ * @param lambda  The forgetting factor, in (0, 1]. Use 1.0 to weigh all
+ *                samples equally.
+ * @param delta   The initial variance of the estimates, which acts as a
+ *                prior pulling them towards zero with a weight of
+ *                1 / delta. Use a large value (e.g. 1E4) when nothing is
+ *                known about the parameters.
+ *
+ * @return 0 on success, or -EINVAL if 'lambda' or 'delta' is out of range.
+ */
+int zsl_sta_rls_init(struct zsl_sta_rls *rls, zsl_real_t lambda,
+		     zsl_real_t delta);
+
+/**
+ * @brief Updates the estimates of 'rls' with the new sample 'y' of the
+ *        model 'y = phi^T * theta', in O(n^2) operations.
+ *
+ * @param rls     The estimator.
+ * @param phi     The regressor vector of the sample, of size n.
+ * @param y       The measured value of the sample.
+ * @param e       Optional pointer to the a priori error
+ *                'y - phi^T * theta' of the previous estimates, or NULL.
+ *
+ * @return 0 on success, -EINVAL if the size of 'phi' doesn't match, or
+ *         -ESINGULAR if the estimates can't be updated.
+ */
+int zsl_sta_rls_update(struct zsl_sta_rls *rls, struct zsl_vec *phi,
+		       zsl_real_t y, zsl_real_t *e);
+
 /**
  * @brief Calculates the absolute error given a value and its expected value.
  *
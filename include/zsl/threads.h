@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup THREADS Threads
+ *
+ * @brief Optional thread pool used to split large matrix operations.
+ *
+ * When CONFIG_ZSL_THREADS is enabled, zsl_mtx_mult, zsl_mtx_gemm,
+ * zsl_mtx_unary_op, zsl_mtx_binary_op and the Householder updates behind
+ * the QR decomposition split their work across a pool of worker threads,
+ * with the calling thread taking a share of the work. The pool uses POSIX
+ * threads in host builds and one work queue per worker in Zephyr builds.
+ *
+ * Operations below a minimum size, measured in multiply-adds, stay on the
+ * calling thread, since waking the workers costs more than it saves on
+ * small matrices. Only one operation uses the pool at a time: a call made
+ * while the pool is busy, including one made from inside a worker, runs
+ * serially on its own thread.
+ *
+ * When CONFIG_ZSL_THREADS is disabled, every operation runs serially and
+ * the functions below only accept a thread count of 1.
+ */
+
+/**
+ * @file
+ * @brief API header file for the thread pool in zscilib.
+ *
+ * This file contains the zscilib thread pool APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_THREADS_H_
+#define ZEPHYR_INCLUDE_ZSL_THREADS_H_
+
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup THREADS_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with the thread pool.
+ *
+ * @ingroup THREADS
+ *  @{ */
+
+#ifndef CONFIG_ZSL_THREADS_MAX
+/** Maximum number of threads, including the calling thread. */
+#if CONFIG_ZSL_THREADS
+#define CONFIG_ZSL_THREADS_MAX (4)
+#else
+#define CONFIG_ZSL_THREADS_MAX (1)
+#endif
+#endif
+
+#ifndef CONFIG_ZSL_THREADS_MIN_OPS
+/** Default number of multiply-adds below which operations stay serial. */
+#define CONFIG_ZSL_THREADS_MIN_OPS (32768)
+#endif
+
+/**
+ * @brief Function type run by zsl_threads_for on the half-open index range
+ *        from 'start' to 'end'.
+ *
+ * @param ctx   The context pointer passed to zsl_threads_for.
+ * @param start The first index to process.
+ * @param end   One past the last index to process.
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+typedef int (*zsl_threads_fn_t)(void *ctx, size_t start, size_t end);
+
+/** @} */ /* End of THREADS_STRUCTS group */
+
+/**
+ * @addtogroup THREADS_FUNCS Functions
+ *
+ * @brief Thread pool configuration and dispatch.
+ *
+ * @ingroup THREADS
+ *  @{ */
+
+/**
+ * @brief Sets the number of threads used by the pool, including the calling
+ *        thread. A count of 1 makes every operation serial.
+ *
+ * Workers are started the first time an operation needs them, and workers
+ * beyond the new count stay idle rather than being stopped.
+ *
+ * @param count The number of threads, from 1 to CONFIG_ZSL_THREADS_MAX.
+ *
+ * @return 0 on success, -EINVAL if 'count' is out of range, or -ENOSYS if
+ *         'count' is larger than 1 and CONFIG_ZSL_THREADS is disabled.
+ */
+int zsl_threads_set_count(size_t count);
+
+/**
+ * @brief Returns the number of threads used by the pool, including the
+ *        calling thread.
+ *
+ * @return The thread count, which is 1 when CONFIG_ZSL_THREADS is disabled.
+ */
+size_t zsl_threads_get_count(void);
+
+/**
+ * @brief Pins worker 'idx' to the CPUs set in 'cpu_mask', where bit n
+ *        selects CPU n. A mask of 0 lets the worker run on any CPU.
+ *
+ * The mask is applied straight away if the worker is running, and otherwise
+ * when it is started.
+ *
+ * @param idx       The worker index, from 0 to CONFIG_ZSL_THREADS_MAX - 2.
+ *                  The calling thread isn't a worker and is never pinned.
+ * @param cpu_mask  The set of CPUs the worker may run on.
+ *
+ * @return 0 on success, -EINVAL if 'idx' is out of range, or -ENOSYS if
+ *         threads or CPU affinity aren't supported by this build.
+ */
+int zsl_threads_set_affinity(size_t idx, uint32_t cpu_mask);
+
+/**
+ * @brief Sets the number of multiply-adds below which an operation stays
+ *        on the calling thread. Defaults to CONFIG_ZSL_THREADS_MIN_OPS.
+ *
+ * @param ops   The minimum operation size, in multiply-adds.
+ */
+void zsl_threads_set_min_ops(size_t ops);
+
+/**
+ * @brief Returns the number of multiply-adds below which an operation stays
+ *        on the calling thread.
+ *
+ * @return The minimum operation size, in multiply-adds.
+ */
+size_t zsl_threads_get_min_ops(void);
+
+/**
+ * @brief Runs 'fn' over the index range 0..n-1, split into contiguous
+ *        ranges that are processed in parallel by the pool.
+ *
+ * The work runs serially, as a single call to fn(ctx, 0, n), if 'ops' is
+ * below the minimum operation size, if the thread count is 1 or if the pool
+ * is already in use. Different ranges must not write to the same memory.
+ *
+ * @param n     The number of indices to process.
+ * @param ops   The approximate cost of the whole range, in multiply-adds.
+ * @param fn    The function to run on each range.
+ * @param ctx   The context pointer passed to 'fn'.
+ *
+ * @return 0 on success, or the first non-zero value returned by 'fn'.
+ */
+int zsl_threads_for(size_t n, size_t ops, zsl_threads_fn_t fn, void *ctx);
+
+/** @} */ /* End of THREADS_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_THREADS_H_ */
+
+/** @} */ /* End of THREADS group */
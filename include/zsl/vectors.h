@@ -210,6 +210,18 @@ int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s);
  */
 int zsl_vec_scalar_div(struct zsl_vec *v, zsl_real_t s);
 
+/**
+ * @brief Adds vector 'x' scaled by 'a' to vector 'y' in place, such that
+ *        'y = a * x + y', in a single pass over both vectors.
+ *
+ * @param a The scalar to multiply 'x' by.
+ * @param x The vector to scale.
+ * @param y The vector to accumulate into.
+ *
+ * @return 0 on success, or -EINVAL if vectors x and y aren't equal-length.
+ */
+int zsl_vec_axpy(zsl_real_t a, struct zsl_vec *x, struct zsl_vec *y);
+
 /**
  * @brief Calculates the distance between two vectors, which is equal to the
  *        norm of vector v - vector w.
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup WORKSPACE Workspace
+ *
+ * @brief Caller-supplied scratch memory for the heavier matrix functions.
+ *
+ * A workspace is a simple bump (arena) allocator over a memory block owned
+ * by the caller. Functions with a `_ws` suffix take their scratch memory
+ * from a workspace instead of declaring matrices on the stack, and every
+ * one of them has a matching `_ws_size` function returning the exact number
+ * of bytes it needs, so that memory use is known up front.
+ */
+
+/**
+ * @file
+ * @brief API header file for workspaces in zscilib.
+ *
+ * This file contains the zscilib workspace APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_WORKSPACE_H_
+#define ZEPHYR_INCLUDE_ZSL_WORKSPACE_H_
+
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct zsl_mtx;
+struct zsl_vec;
+
+/**
+ * @addtogroup WS_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with workspaces.
+ *
+ * @ingroup WORKSPACE
+ *  @{ */
+
+/** Alignment, in bytes, of the workspace memory and of every allocation. */
+#define ZSL_WS_ALIGN (8)
+
+/** Number of workspace bytes taken by an allocation of 'n' bytes. */
+#define ZSL_WS_BYTES(n) \
+	(((size_t)(n) + ZSL_WS_ALIGN - 1) & ~((size_t)ZSL_WS_ALIGN - 1))
+
+/** Number of workspace bytes taken by an array of 'n' zsl_real_t values. */
+#define ZSL_WS_REALS(n) ZSL_WS_BYTES((n) * sizeof(zsl_real_t))
+
+/** @brief Represents a block of scratch memory that is allocated from. */
+struct zsl_workspace {
+	/** The memory block, aligned on ZSL_WS_ALIGN bytes. */
+	uint8_t *data;
+	/** The size of the memory block in bytes. */
+	size_t sz;
+	/** The number of bytes currently allocated. */
+	size_t used;
+};
+
+/**
+ * Macro to declare a workspace of at least 'bytes' bytes on the stack.
+ *
+ * 'bytes' will typically be the value returned by one of the `_ws_size`
+ * functions, or the largest of several of these values if the workspace is
+ * used by several functions in turn. One extra word is reserved so that
+ * the array is never zero-sized.
+ */
+#define ZSL_WORKSPACE_DEF(name, bytes)					   \
+	uint64_t name ## _ws[(ZSL_WS_BYTES(bytes) / sizeof(uint64_t)) + 1];  \
+	struct zsl_workspace name = {					   \
+		.data = (uint8_t *)name ## _ws,				   \
+		.sz = ZSL_WS_BYTES(bytes),				   \
+		.used = 0						   \
+	}
+
+/** @} */ /* End of WS_STRUCTS group */
+
+/**
+ * @addtogroup WS_FUNCS Functions
+ *
+ * @brief Workspace initialisation and allocation functions.
+ *
+ * @ingroup WORKSPACE
+ *  @{ */
+
+/**
+ * @brief Initialises workspace 'ws' to allocate from the memory block 'buf'.
+ *
+ * @param ws    Pointer to the workspace to initialise.
+ * @param buf   The memory block to use, aligned on ZSL_WS_ALIGN bytes.
+ * @param sz    The size of 'buf' in bytes.
+ *
+ * @return 0 on success, -EINVAL if 'buf' isn't properly aligned.
+ */
+int zsl_ws_init(struct zsl_workspace *ws, void *buf, size_t sz);
+
+/**
+ * @brief Allocates 'sz' bytes from workspace 'ws'.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param sz    The number of bytes to allocate.
+ *
+ * @return A pointer aligned on ZSL_WS_ALIGN bytes, or NULL if the workspace
+ *         doesn't have enough free memory left.
+ */
+void *zsl_ws_alloc(struct zsl_workspace *ws, size_t sz);
+
+/**
+ * @brief Allocates a 'rows' x 'cols' matrix from workspace 'ws'. The matrix
+ *        data is not initialised.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param m     Pointer to the matrix to assign the memory to.
+ * @param rows  The number of rows in the matrix.
+ * @param cols  The number of columns in the matrix.
+ *
+ * @return 0 on success, -ENOMEM if the workspace is too small.
+ */
+int zsl_ws_mtx(struct zsl_workspace *ws, struct zsl_mtx *m, size_t rows,
+	       size_t cols);
+
+/**
+ * @brief Allocates a vector of 'sz' elements from workspace 'ws'. The vector
+ *        data is not initialised.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param v     Pointer to the vector to assign the memory to.
+ * @param sz    The number of elements in the vector.
+ *
+ * @return 0 on success, -ENOMEM if the workspace is too small.
+ */
+int zsl_ws_vec(struct zsl_workspace *ws, struct zsl_vec *v, size_t sz);
+
+/**
+ * @brief Returns the current allocation mark of workspace 'ws', to be passed
+ *        to 'zsl_ws_release' later on.
+ *
+ * @param ws    Pointer to the workspace to use.
+ *
+ * @return The number of bytes currently allocated.
+ */
+size_t zsl_ws_mark(struct zsl_workspace *ws);
+
+/**
+ * @brief Frees everything allocated from workspace 'ws' since 'mark' was
+ *        obtained with 'zsl_ws_mark'.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param mark  The allocation mark to go back to. 0 frees everything.
+ *
+ * @return 0 on success, -EINVAL if 'mark' is past the current allocation.
+ */
+int zsl_ws_release(struct zsl_workspace *ws, size_t mark);
+
+/**
+ * @brief Returns the number of free bytes left in workspace 'ws'.
+ *
+ * @param ws    Pointer to the workspace to use.
+ *
+ * @return The number of free bytes.
+ */
+size_t zsl_ws_avail(struct zsl_workspace *ws);
+
+/** @} */ /* End of WS_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_WORKSPACE_H_ */
+
+/** @} */ /* End of WORKSPACE group */
@@ -14,6 +14,7 @@
 #ifndef ZEPHYR_INCLUDE_ZSL_H_
 #define ZEPHYR_INCLUDE_ZSL_H_
 
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -76,6 +77,7 @@ typedef double zsl_real_t;
 #define ZSL_TANH       tanhf
 #define ZSL_ERF        erff
 #define ZSL_FMA        fmaf
+#define ZSL_EPSILON    FLT_EPSILON
 #else
 #define ZSL_CEIL       ceil
 #define ZSL_FLOOR      floor
@@ -99,6 +101,7 @@ typedef double zsl_real_t;
 #define ZSL_TANH       tanh
 #define ZSL_ERF        erf
 #define ZSL_FMA        fma
+#define ZSL_EPSILON    DBL_EPSILON
 #endif
 
 
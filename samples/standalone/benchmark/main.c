@@ -0,0 +1,1803 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host-native (Linux) benchmark suite for zscilib.
+ *
+ * Every kernel is timed across a sweep of input sizes, reporting the time
+ * and the number of CPU cycles per call, the number of heap allocations made
+ * by a single call, and the peak stack usage of a single call. Results can
+ * be written as JSON and/or CSV to track regressions between releases.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "zsl/zsl.h"
+#include "zsl/matrices.h"
+#include "zsl/matrices_fixed.h"
+#include "zsl/vectors.h"
+#include "zsl/sparse.h"
+#include "zsl/batch.h"
+#include "zsl/solvers.h"
+#include "zsl/half.h"
+#include "zsl/fixedpoint.h"
+#include "zsl/statistics.h"
+#include "zsl/probability.h"
+#include "zsl/interp.h"
+#include "zsl/colorimetry.h"
+#include "zsl/orientation/quaternions.h"
+
+/** Number of timed batches per size, the median of which is reported. */
+#define BENCH_BATCHES (5)
+
+/** Default minimum duration of a timed batch, in milliseconds. */
+#define BENCH_MIN_MS (20)
+
+/** Size of the stack used to measure the peak stack usage of a call. */
+#define BENCH_STACK_SZ (8 * 1024 * 1024)
+
+/** Byte pattern used to paint the measurement stack. */
+#define BENCH_STACK_FILL (0xA5)
+
+
+/** Input sizes for the vector kernels. */
+static const size_t bench_vec_sz[] = {
+	3, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 0
+};
+
+/** Input sizes (rows and columns) for the matrix kernels. */
+static const size_t bench_mtx_sz[] = {
+	3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 0
+};
+
+/** Fixed-size kernels (quaternions, etc.) are only run once. */
+static const size_t bench_fix_sz[] = { 1, 0 };
+
+/** Inputs and outputs shared by all kernels, sized for the current run. */
+struct bench_ctx {
+	size_t n;
+	struct zsl_vec va, vb, vc, vd;
+	struct zsl_mtx ma, mb, mc, md, me;
+	/** Symmetric positive-definite input. */
+	struct zsl_mtx spd;
+	/** LU factors of 'ma', and their pivots. */
+	struct zsl_mtx lu;
+	size_t *piv;
+	/** Cholesky factor of 'spd'. */
+	struct zsl_mtx chol;
+	/** QR decomposition of 'ma'. */
+	struct zsl_mtx q, r;
+	/** Recursive least squares estimator with one parameter per column. */
+	struct zsl_sta_rls rls;
+	/** n x n sparse tridiagonal matrix, with 4 on the diagonal and -1 off
+	 * it, and the operator and solver settings used to solve with it. */
+	struct zsl_spmtx sp;
+	struct zsl_linop op;
+	struct zsl_solver_params par;
+	/** The same tridiagonal matrix as three vectors. */
+	struct zsl_vec tda, tdb, tdc;
+	/** n x n banded matrix with two sub- and super-diagonals, its LU
+	 * factors and their pivots. */
+	struct zsl_mtx_band band, band_lu;
+	size_t *band_piv;
+	/** Batches of n 3x3 matrices, 'ba' being well conditioned. */
+	struct zsl_mtx_batch ba, bb, bc;
+	/** 'va', 'vb' and 'mb' in the fp16 and bf16 formats. */
+	struct zsl_vec_half f16a, f16b, b16a, b16b;
+	struct zsl_mtx_half f16m, b16m;
+	/** 'va', 'vb' and 'mb' in Q15 and Q31, and the output vectors. */
+	struct zsl_vec_q15 q15a, q15b, q15c;
+	struct zsl_mtx_q15 q15m;
+	struct zsl_vec_q31 q31a, q31b, q31c;
+	struct zsl_mtx_q31 q31m;
+	/** Fixed-size inputs, 'a' being well conditioned, and outputs. */
+	struct zsl_mtx3 m3a, m3b, m3c;
+	struct zsl_mtx4 m4a, m4b, m4c;
+	struct zsl_mtx6 m6a, m6b, m6c;
+	struct zsl_vec3 v3a, v3c;
+	struct zsl_quat qa, qb, qc;
+	/** n samples of a smooth curve at x = 0 .. n - 1, for interpolation. */
+	struct zsl_interp_xy *xy;
+	/** The same samples, with room for the cubic spline coefficients. */
+	struct zsl_interp_xyc *xyc;
+	/** Two points on the curve, for the single-interval kernels. */
+	struct zsl_interp_xy pt[2];
+	/** Uniform probability distribution of length n, for the entropy. */
+	struct zsl_vec vp;
+	/** Distribution parameters and sample point, for the PDFs/CDFs. */
+	zsl_real_t pa, pb, px;
+	/** Writable copy of the CIE 1988 photopic luminous efficiency SPD. */
+	struct zsl_clr_spd *clr_spd;
+	/** The sRGB (D65) color correction matrix. */
+	struct zsl_mtx *ccm;
+	struct zsl_clr_xyz xyz;
+	struct zsl_clr_xyy xyy;
+	struct zsl_clr_uv60 uv60;
+	struct zsl_clr_uv76 uv76;
+	struct zsl_clr_cct cct;
+	struct zsl_clr_rgb8 rgb8;
+	struct zsl_clr_rgbf rgbf;
+};
+
+struct bench {
+	const char *module;
+	const char *func;
+	const size_t *sizes;
+	int (*run)(struct bench_ctx *c);
+};
+
+struct bench_result {
+	const struct bench *b;
+	size_t n;
+	int rc;
+	uint64_t iters;
+	double ns;
+	double cycles;
+	size_t allocs;
+	size_t stack;
+};
+
+/* Heap allocation counter, see the --wrap linker flags in the Makefile. */
+static volatile size_t bench_allocs;
+
+void *__real_malloc(size_t sz);
+void *__real_calloc(size_t n, size_t sz);
+void *__real_realloc(void *p, size_t sz);
+
+void *
+__wrap_malloc(size_t sz)
+{
+	bench_allocs++;
+	return __real_malloc(sz);
+}
+
+void *
+__wrap_calloc(size_t n, size_t sz)
+{
+	bench_allocs++;
+	return __real_calloc(n, sz);
+}
+
+void *
+__wrap_realloc(void *p, size_t sz)
+{
+	bench_allocs++;
+	return __real_realloc(p, sz);
+}
+
+/* -------------------------------------------------------------------------
+ * Kernels.
+ * ---------------------------------------------------------------------- */
+
+static zsl_real_t bench_sink;
+
+static int
+bench_vec_add(struct bench_ctx *c)
+{
+	return zsl_vec_add(&c->va, &c->vb, &c->vc);
+}
+
+static int
+bench_vec_sub(struct bench_ctx *c)
+{
+	return zsl_vec_sub(&c->va, &c->vb, &c->vc);
+}
+
+static int
+bench_vec_dot(struct bench_ctx *c)
+{
+	return zsl_vec_dot(&c->va, &c->vb, &bench_sink);
+}
+
+static int
+bench_vec_norm(struct bench_ctx *c)
+{
+	bench_sink = zsl_vec_norm(&c->va);
+	return 0;
+}
+
+static int
+bench_vec_sum_of_sqrs(struct bench_ctx *c)
+{
+	bench_sink = zsl_vec_sum_of_sqrs(&c->va);
+	return 0;
+}
+
+static int
+bench_vec_scalar_mult(struct bench_ctx *c)
+{
+	return zsl_vec_scalar_mult(&c->vc, 1.0);
+}
+
+static int
+bench_vec_scalar_add(struct bench_ctx *c)
+{
+	return zsl_vec_scalar_add(&c->vc, 0.0);
+}
+
+static int
+bench_vec_dist(struct bench_ctx *c)
+{
+	bench_sink = zsl_vec_dist(&c->va, &c->vb);
+	return 0;
+}
+
+static int
+bench_vec_ar_mean(struct bench_ctx *c)
+{
+	return zsl_vec_ar_mean(&c->va, &bench_sink);
+}
+
+static int
+bench_sta_mean(struct bench_ctx *c)
+{
+	return zsl_sta_mean(&c->va, &bench_sink);
+}
+
+static int
+bench_sta_var(struct bench_ctx *c)
+{
+	return zsl_sta_var(&c->va, &bench_sink);
+}
+
+static int
+bench_sta_covar(struct bench_ctx *c)
+{
+	return zsl_sta_covar(&c->va, &c->vb, &bench_sink);
+}
+
+static int
+bench_sta_covar_mtx(struct bench_ctx *c)
+{
+	return zsl_sta_covar_mtx(&c->ma, &c->mc);
+}
+
+static int
+bench_mtx_add(struct bench_ctx *c)
+{
+	return zsl_mtx_add(&c->ma, &c->mb, &c->mc);
+}
+
+static int
+bench_mtx_sub(struct bench_ctx *c)
+{
+	return zsl_mtx_sub(&c->ma, &c->mb, &c->mc);
+}
+
+static int
+bench_mtx_scalar_mult_d(struct bench_ctx *c)
+{
+	return zsl_mtx_scalar_mult_d(&c->mc, 1.0);
+}
+
+static int
+bench_mtx_mult(struct bench_ctx *c)
+{
+	return zsl_mtx_mult(&c->ma, &c->mb, &c->mc);
+}
+
+static int
+bench_mtx_mult_trans_a(struct bench_ctx *c)
+{
+	return zsl_mtx_mult_trans_a(&c->ma, &c->mb, &c->mc);
+}
+
+static int
+bench_mtx_trans(struct bench_ctx *c)
+{
+	return zsl_mtx_trans(&c->ma, &c->mc);
+}
+
+static int
+bench_mtx_deter(struct bench_ctx *c)
+{
+	return zsl_mtx_deter(&c->ma, &bench_sink);
+}
+
+static int
+bench_mtx_inv(struct bench_ctx *c)
+{
+	return zsl_mtx_inv(&c->ma, &c->mc);
+}
+
+static int
+bench_mtx_lu(struct bench_ctx *c)
+{
+	return zsl_mtx_lu(&c->ma, &c->mc, c->piv);
+}
+
+static int
+bench_mtx_lu_solve(struct bench_ctx *c)
+{
+	return zsl_mtx_lu_solve(&c->lu, c->piv, &c->mb, &c->mc);
+}
+
+static int
+bench_mtx_cholesky(struct bench_ctx *c)
+{
+	return zsl_mtx_cholesky(&c->spd, &c->mc);
+}
+
+static int
+bench_mtx_cho_solve(struct bench_ctx *c)
+{
+	return zsl_mtx_cho_solve(&c->chol, &c->mb, &c->mc);
+}
+
+static int
+bench_mtx_qrd(struct bench_ctx *c)
+{
+	return zsl_mtx_qrd(&c->ma, &c->mc, &c->md, false);
+}
+
+static int
+bench_mtx_qrd_compact(struct bench_ctx *c)
+{
+	return zsl_mtx_qrd_compact(&c->ma, &c->mc, &c->vc);
+}
+
+static int
+bench_mtx_eigen_sym(struct bench_ctx *c)
+{
+	return zsl_mtx_eigen_sym(&c->spd, &c->vc, &c->mc, 100);
+}
+
+static int
+bench_mtx_svd_thin(struct bench_ctx *c)
+{
+	return zsl_mtx_svd_thin(&c->ma, &c->vc, &c->mc, &c->md, NULL, 100);
+}
+
+static int
+bench_mtx_eigenvalues(struct bench_ctx *c)
+{
+	c->vc.sz = c->n;
+	return zsl_mtx_eigenvalues(&c->spd, &c->vc, 100);
+}
+
+static int
+bench_mtx_eigenvalues_cplx(struct bench_ctx *c)
+{
+	return zsl_mtx_eigenvalues_cplx(&c->ma, &c->vc, &c->vd, 500);
+}
+
+static int
+bench_mtx_svd(struct bench_ctx *c)
+{
+	return zsl_mtx_svd(&c->ma, &c->mc, &c->md, &c->me, 100);
+}
+
+static int
+bench_mtx_pinv(struct bench_ctx *c)
+{
+	return zsl_mtx_pinv(&c->ma, &c->mc, 100);
+}
+
+static int
+bench_mtx_gemm(struct bench_ctx *c)
+{
+	return zsl_mtx_gemm(false, false, 1.0, &c->ma, &c->mb, 0.0, &c->mc);
+}
+
+static int
+bench_mtx_gemv(struct bench_ctx *c)
+{
+	return zsl_mtx_gemv(false, 1.0, &c->ma, &c->va, 0.0, &c->vc);
+}
+
+static int
+bench_mtx_ger(struct bench_ctx *c)
+{
+	return zsl_mtx_ger(1.0, &c->va, &c->vb, &c->mc);
+}
+
+static int
+bench_mtx_syrk(struct bench_ctx *c)
+{
+	return zsl_mtx_syrk(false, 1.0, &c->ma, 0.0, &c->mc);
+}
+
+static int
+bench_mtx_band_mult_vec(struct bench_ctx *c)
+{
+	return zsl_mtx_band_mult_vec(&c->band, &c->va, &c->vc);
+}
+
+/* Includes copying the band back in, which is cheap next to the
+ * factorisation itself. */
+static int
+bench_mtx_band_lu(struct bench_ctx *c)
+{
+	memcpy(c->band_lu.data, c->band.data,
+	       c->n * ZSL_MTX_BAND_WIDTH(&c->band) * sizeof(zsl_real_t));
+	return zsl_mtx_band_lu(&c->band_lu, c->band_piv);
+}
+
+static int
+bench_mtx_band_lu_solve(struct bench_ctx *c)
+{
+	return zsl_mtx_band_lu_solve(&c->band_lu, c->band_piv, &c->va, &c->vc);
+}
+
+static int
+bench_mtx_tridiag_solve(struct bench_ctx *c)
+{
+	return zsl_mtx_tridiag_solve(&c->tda, &c->tdb, &c->tdc, &c->va,
+				     &c->vc);
+}
+
+static int
+bench_mtx_lstsq(struct bench_ctx *c)
+{
+	return zsl_mtx_lstsq(&c->ma, &c->mb, &c->mc, &c->vc);
+}
+
+/* 'va' is negated on each call, so the factored matrix alternates between
+ * 'ma' and ma + va * vb^T rather than drifting. */
+static int
+bench_mtx_qrd_update(struct bench_ctx *c)
+{
+	zsl_vec_neg(&c->va);
+	return zsl_mtx_qrd_update(&c->q, &c->r, &c->va, &c->vb);
+}
+
+static int
+bench_mtx_expm(struct bench_ctx *c)
+{
+	return zsl_mtx_expm(&c->mb, &c->mc);
+}
+
+static int
+bench_mtx_van_loan(struct bench_ctx *c)
+{
+	return zsl_mtx_van_loan(&c->mb, &c->spd, (zsl_real_t)0.01, &c->mc,
+				&c->md);
+}
+
+static int
+bench_sta_rls_update(struct bench_ctx *c)
+{
+	return zsl_sta_rls_update(&c->rls, &c->va, (zsl_real_t)0.5,
+				  &bench_sink);
+}
+
+static int
+bench_mtx3_mult(struct bench_ctx *c)
+{
+	zsl_mtx3_mult(&c->m3a, &c->m3b, &c->m3c);
+	return 0;
+}
+
+static int
+bench_mtx3_mult_vec(struct bench_ctx *c)
+{
+	zsl_mtx3_mult_vec(&c->m3a, &c->v3a, &c->v3c);
+	return 0;
+}
+
+static int
+bench_mtx3_inv(struct bench_ctx *c)
+{
+	return zsl_mtx3_inv(&c->m3a, &c->m3c);
+}
+
+static int
+bench_mtx4_mult(struct bench_ctx *c)
+{
+	zsl_mtx4_mult(&c->m4a, &c->m4b, &c->m4c);
+	return 0;
+}
+
+static int
+bench_mtx4_inv(struct bench_ctx *c)
+{
+	return zsl_mtx4_inv(&c->m4a, &c->m4c);
+}
+
+static int
+bench_mtx6_mult(struct bench_ctx *c)
+{
+	zsl_mtx6_mult(&c->m6a, &c->m6b, &c->m6c);
+	return 0;
+}
+
+static int
+bench_mtx6_inv(struct bench_ctx *c)
+{
+	return zsl_mtx6_inv(&c->m6a, &c->m6c);
+}
+
+static int
+bench_mtx_batch_mult(struct bench_ctx *c)
+{
+	return zsl_mtx_batch_mult(&c->ba, &c->bb, &c->bc);
+}
+
+static int
+bench_mtx_batch_inv(struct bench_ctx *c)
+{
+	return zsl_mtx_batch_inv(&c->ba, &c->bc);
+}
+
+static int
+bench_spmtx_mult_vec(struct bench_ctx *c)
+{
+	return zsl_spmtx_mult_vec(&c->sp, &c->va, &c->vc);
+}
+
+/* The iterative solvers start from x = 0 on each call, so that every call
+ * does the same work. */
+static int
+bench_solve_cg(struct bench_ctx *c)
+{
+	zsl_vec_init(&c->vc);
+	return zsl_solve_cg(&c->op, &c->va, &c->vc, NULL, &c->par);
+}
+
+static int
+bench_solve_bicgstab(struct bench_ctx *c)
+{
+	zsl_vec_init(&c->vc);
+	return zsl_solve_bicgstab(&c->op, &c->va, &c->vc, NULL, &c->par);
+}
+
+static int
+bench_solve_gmres(struct bench_ctx *c)
+{
+	zsl_vec_init(&c->vc);
+	return zsl_solve_gmres(&c->op, &c->va, &c->vc, NULL, &c->par);
+}
+
+static int
+bench_solve_lu_mixed(struct bench_ctx *c)
+{
+	return zsl_solve_lu_mixed(&c->ma, &c->va, &c->vc, &c->par);
+}
+
+static int
+bench_solve_cho_mixed(struct bench_ctx *c)
+{
+	return zsl_solve_cho_mixed(&c->spd, &c->va, &c->vc, &c->par);
+}
+
+static int
+bench_vec_q15_dot(struct bench_ctx *c)
+{
+	zsl_q15_t d;
+
+	return zsl_vec_q15_dot(&c->q15a, &c->q15b, &d);
+}
+
+static int
+bench_mtx_q15_mult_vec(struct bench_ctx *c)
+{
+	return zsl_mtx_q15_mult_vec(&c->q15m, &c->q15a, &c->q15c);
+}
+
+static int
+bench_vec_q31_dot(struct bench_ctx *c)
+{
+	zsl_q31_t d;
+
+	return zsl_vec_q31_dot(&c->q31a, &c->q31b, &d);
+}
+
+static int
+bench_mtx_q31_mult_vec(struct bench_ctx *c)
+{
+	return zsl_mtx_q31_mult_vec(&c->q31m, &c->q31a, &c->q31c);
+}
+
+static int
+bench_vec_half_dot_fp16(struct bench_ctx *c)
+{
+	return zsl_vec_half_dot(&c->f16a, &c->f16b, &bench_sink);
+}
+
+static int
+bench_vec_half_dot_bf16(struct bench_ctx *c)
+{
+	return zsl_vec_half_dot(&c->b16a, &c->b16b, &bench_sink);
+}
+
+static int
+bench_mtx_half_mult_vec_fp16(struct bench_ctx *c)
+{
+	return zsl_mtx_half_mult_vec(&c->f16m, &c->va, &c->vc);
+}
+
+static int
+bench_mtx_half_mult_vec_bf16(struct bench_ctx *c)
+{
+	return zsl_mtx_half_mult_vec(&c->b16m, &c->va, &c->vc);
+}
+
+static int
+bench_quat_mult(struct bench_ctx *c)
+{
+	return zsl_quat_mult(&c->qa, &c->qb, &c->qc);
+}
+
+static int
+bench_quat_slerp(struct bench_ctx *c)
+{
+	return zsl_quat_slerp(&c->qa, &c->qb, (zsl_real_t)0.3, &c->qc);
+}
+
+static int
+bench_quat_to_rot_mtx(struct bench_ctx *c)
+{
+	return zsl_quat_to_rot_mtx(&c->qa, &c->mc);
+}
+
+/* A point between two samples, 37% of the way along the x range. */
+static zsl_real_t
+bench_interp_x(struct bench_ctx *c)
+{
+	return (zsl_real_t)(c->n - 1) * (zsl_real_t)0.37;
+}
+
+static int
+bench_interp_lerp(struct bench_ctx *c)
+{
+	return zsl_interp_lerp(c->pt[0].y, c->pt[1].y, (zsl_real_t)0.37,
+			       &bench_sink);
+}
+
+static int
+bench_interp_nn(struct bench_ctx *c)
+{
+	return zsl_interp_nn(&c->pt[0], &c->pt[1], (zsl_real_t)0.37,
+			     &bench_sink);
+}
+
+static int
+bench_interp_lin_y(struct bench_ctx *c)
+{
+	return zsl_interp_lin_y(&c->pt[0], &c->pt[1], (zsl_real_t)0.37,
+				&bench_sink);
+}
+
+static int
+bench_interp_lin_x(struct bench_ctx *c)
+{
+	return zsl_interp_lin_x(&c->pt[0], &c->pt[1],
+				(c->pt[0].y + c->pt[1].y) / 2, &bench_sink);
+}
+
+static int
+bench_interp_find_x(struct bench_ctx *c)
+{
+	int idx;
+
+	return zsl_interp_find_x(c->xy, c->n, bench_interp_x(c), &idx);
+}
+
+static int
+bench_interp_nn_arr(struct bench_ctx *c)
+{
+	return zsl_interp_nn_arr(c->xy, c->n, bench_interp_x(c), &bench_sink);
+}
+
+static int
+bench_interp_lin_y_arr(struct bench_ctx *c)
+{
+	return zsl_interp_lin_y_arr(c->xy, c->n, bench_interp_x(c),
+				    &bench_sink);
+}
+
+static int
+bench_interp_cubic_calc(struct bench_ctx *c)
+{
+	return zsl_interp_cubic_calc(c->xyc, c->n, 0.0, 0.0);
+}
+
+static int
+bench_interp_cubic_arr(struct bench_ctx *c)
+{
+	return zsl_interp_cubic_arr(c->xyc, c->n, bench_interp_x(c),
+				    &bench_sink);
+}
+
+static int
+bench_prob_uni_pdf(struct bench_ctx *c)
+{
+	bench_sink = zsl_prob_uni_pdf(&c->pa, &c->pb, &c->px);
+	return 0;
+}
+
+static int
+bench_prob_uni_mean(struct bench_ctx *c)
+{
+	return zsl_prob_uni_mean(&c->pa, &c->pb, &bench_sink);
+}
+
+static int
+bench_prob_uni_var(struct bench_ctx *c)
+{
+	return zsl_prob_uni_var(&c->pa, &c->pb, &bench_sink);
+}
+
+static int
+bench_prob_uni_cdf(struct bench_ctx *c)
+{
+	bench_sink = zsl_prob_uni_cdf(&c->pa, &c->pb, &c->px);
+	return 0;
+}
+
+static int
+bench_prob_normal_pdf(struct bench_ctx *c)
+{
+	bench_sink = zsl_prob_normal_pdf(&c->pa, &c->pb, &c->px);
+	return 0;
+}
+
+static int
+bench_prob_normal_cdf(struct bench_ctx *c)
+{
+	bench_sink = zsl_prob_normal_cdf(&c->pa, &c->pb, &c->px);
+	return 0;
+}
+
+static int
+bench_prob_erf_inv(struct bench_ctx *c)
+{
+	bench_sink = zsl_prob_erf_inv(&c->px);
+	return 0;
+}
+
+static int
+bench_prob_normal_cdf_inv(struct bench_ctx *c)
+{
+	bench_sink = zsl_prob_normal_cdf_inv(&c->pa, &c->pb, &c->px);
+	return 0;
+}
+
+static int
+bench_prob_entropy(struct bench_ctx *c)
+{
+	return zsl_prob_entropy(&c->vp, &bench_sink);
+}
+
+static int
+bench_clr_conv_spd_xyz(struct bench_ctx *c)
+{
+	return zsl_clr_conv_spd_xyz(c->clr_spd, ZSL_CLR_OBS_2_DEG, &c->xyz);
+}
+
+static int
+bench_clr_conv_xyy_xyz(struct bench_ctx *c)
+{
+	return zsl_clr_conv_xyy_xyz(&c->xyy, &c->xyz);
+}
+
+static int
+bench_clr_conv_xyz_xyy(struct bench_ctx *c)
+{
+	return zsl_clr_conv_xyz_xyy(&c->xyz, &c->xyy);
+}
+
+static int
+bench_clr_conv_xyy_uv60(struct bench_ctx *c)
+{
+	return zsl_clr_conv_xyy_uv60(&c->xyy, &c->uv60);
+}
+
+static int
+bench_clr_conv_xyz_uv60(struct bench_ctx *c)
+{
+	return zsl_clr_conv_xyz_uv60(&c->xyz, &c->uv60);
+}
+
+static int
+bench_clr_conv_uv60_xyz(struct bench_ctx *c)
+{
+	return zsl_clr_conv_uv60_xyz(&c->uv60, &c->xyz);
+}
+
+static int
+bench_clr_conv_uv60_xyy(struct bench_ctx *c)
+{
+	return zsl_clr_conv_uv60_xyy(&c->uv60, &c->xyy);
+}
+
+static int
+bench_clr_conv_uv60_uv76(struct bench_ctx *c)
+{
+	return zsl_clr_conv_uv60_uv76(&c->uv60, &c->uv76);
+}
+
+static int
+bench_clr_conv_uv76_uv60(struct bench_ctx *c)
+{
+	return zsl_clr_conv_uv76_uv60(&c->uv76, &c->uv60);
+}
+
+static int
+bench_clr_conv_ct_uv60(struct bench_ctx *c)
+{
+	return zsl_clr_conv_ct_uv60(4000.0, ZSL_CLR_OBS_2_DEG, &c->uv60);
+}
+
+static int
+bench_clr_conv_ct_xyz(struct bench_ctx *c)
+{
+	return zsl_clr_conv_ct_xyz(4000.0, ZSL_CLR_OBS_2_DEG, &c->xyz);
+}
+
+static int
+bench_clr_conv_ct_rgb8(struct bench_ctx *c)
+{
+	return zsl_clr_conv_ct_rgb8(4000.0, ZSL_CLR_OBS_2_DEG, c->ccm,
+				    &c->rgb8);
+}
+
+static int
+bench_clr_conv_ct_rgbf(struct bench_ctx *c)
+{
+	return zsl_clr_conv_ct_rgbf(4000.0, ZSL_CLR_OBS_2_DEG, c->ccm,
+				    &c->rgbf);
+}
+
+static int
+bench_clr_conv_cct_xyy(struct bench_ctx *c)
+{
+	return zsl_clr_conv_cct_xyy(&c->cct, ZSL_CLR_OBS_2_DEG, &c->xyy);
+}
+
+static int
+bench_clr_conv_cct_xyz(struct bench_ctx *c)
+{
+	return zsl_clr_conv_cct_xyz(&c->cct, ZSL_CLR_OBS_2_DEG, &c->xyz);
+}
+
+static int
+bench_clr_conv_uv60_cct_mccamy(struct bench_ctx *c)
+{
+	struct zsl_clr_cct cct;
+
+	return zsl_clr_conv_uv60_cct(ZSL_CLR_UV_CCT_METHOD_MCCAMY, &c->uv60,
+				     &cct);
+}
+
+static int
+bench_clr_conv_uv60_cct_ohno2011(struct bench_ctx *c)
+{
+	struct zsl_clr_cct cct;
+
+	return zsl_clr_conv_uv60_cct(ZSL_CLR_UV_CCT_METHOD_OHNO2011, &c->uv60,
+				     &cct);
+}
+
+static int
+bench_clr_conv_uv60_cct_ohno2014(struct bench_ctx *c)
+{
+	struct zsl_clr_cct cct;
+
+	return zsl_clr_conv_uv60_cct(ZSL_CLR_UV_CCT_METHOD_OHNO2014, &c->uv60,
+				     &cct);
+}
+
+static int
+bench_clr_conv_xyz_rgb8(struct bench_ctx *c)
+{
+	return zsl_clr_conv_xyz_rgb8(&c->xyz, c->ccm, &c->rgb8);
+}
+
+static int
+bench_clr_conv_xyz_rgbf(struct bench_ctx *c)
+{
+	return zsl_clr_conv_xyz_rgbf(&c->xyz, c->ccm, &c->rgbf);
+}
+
+static int
+bench_clr_norm_spd(struct bench_ctx *c)
+{
+	return zsl_clr_norm_spd(c->clr_spd);
+}
+
+static int
+bench_clr_lef_lerp(struct bench_ctx *c)
+{
+	return zsl_clr_lef_lerp(ZSL_CLR_LEF_CIE88_PHOTOPIC, 555, &bench_sink);
+}
+
+/*
+ * Kernels of the vector, statistics, matrix, fixed-size matrix, batch,
+ * sparse, solver, compact (fp16/bf16), fixed-point, orientation,
+ * interpolation, probability and colorimetry modules. Not listed here:
+ *
+ * - the '_ws' variants: they run the same code as the listed functions,
+ *   which only add a stack workspace around them.
+ * - element-wise, conversion and accessor functions of the sparse, batch,
+ *   band, compact and fixed-point types (add, sub, trans, get, pack,
+ *   from_mtx, ...): they are single loops over the values, like the vector
+ *   kernels above. The fixed-size add, sub, trans and 2x2 functions are
+ *   excluded for the same reason.
+ * - zsl_mtx_batch_mult_vec and zsl_mtx_batch_deter: the first is
+ *   zsl_mtx_batch_mult with one column, and the second is the first half
+ *   of zsl_mtx_batch_inv.
+ * - sparse products other than SpMV, sparse triangular solves and the
+ *   Jacobi and IC(0) preconditioners: the solvers above are run without a
+ *   preconditioner, and these share the CSR row loop of SpMV.
+ * - Q15/Q31 and compact matrix-matrix products: they run the inner loop
+ *   of the matrix-vector kernels above once per column.
+ * - the Q15/Q31 3x3 inverses: like zsl_mtx3_inv, they are closed-form
+ *   expressions of a fixed size.
+ * - zsl_mtx_qrd_update_row/downdate_row, zsl_mtx_cho_update/downdate and
+ *   zsl_mtx_lstsq_add/solve: they are the building blocks of the listed
+ *   zsl_mtx_lstsq, zsl_mtx_qrd_update and zsl_sta_rls_update.
+ * - physics: each of its ~150 functions evaluates a single closed-form
+ *   expression of a few flops, with no loops, allocations or size-dependent
+ *   cost, so a timing would only measure the call overhead.
+ * - chemistry: the module only defines constants (the element table), and
+ *   has no functions.
+ * - colorimetry data getters (zsl_clr_illum_get, zsl_clr_obs_get,
+ *   zsl_clr_lef_get, zsl_clr_rgbccm_get): each returns a pointer into a
+ *   constant table.
+ */
+static const struct bench benches[] = {
+	{ "vectors", "zsl_vec_add", bench_vec_sz, bench_vec_add },
+	{ "vectors", "zsl_vec_sub", bench_vec_sz, bench_vec_sub },
+	{ "vectors", "zsl_vec_dot", bench_vec_sz, bench_vec_dot },
+	{ "vectors", "zsl_vec_norm", bench_vec_sz, bench_vec_norm },
+	{ "vectors", "zsl_vec_sum_of_sqrs", bench_vec_sz,
+	  bench_vec_sum_of_sqrs },
+	{ "vectors", "zsl_vec_scalar_mult", bench_vec_sz,
+	  bench_vec_scalar_mult },
+	{ "vectors", "zsl_vec_scalar_add", bench_vec_sz, bench_vec_scalar_add },
+	{ "vectors", "zsl_vec_dist", bench_vec_sz, bench_vec_dist },
+	{ "vectors", "zsl_vec_ar_mean", bench_vec_sz, bench_vec_ar_mean },
+	{ "statistics", "zsl_sta_mean", bench_vec_sz, bench_sta_mean },
+	{ "statistics", "zsl_sta_var", bench_vec_sz, bench_sta_var },
+	{ "statistics", "zsl_sta_covar", bench_vec_sz, bench_sta_covar },
+	{ "statistics", "zsl_sta_covar_mtx", bench_mtx_sz,
+	  bench_sta_covar_mtx },
+	{ "matrices", "zsl_mtx_add", bench_mtx_sz, bench_mtx_add },
+	{ "matrices", "zsl_mtx_sub", bench_mtx_sz, bench_mtx_sub },
+	{ "matrices", "zsl_mtx_scalar_mult_d", bench_mtx_sz,
+	  bench_mtx_scalar_mult_d },
+	{ "matrices", "zsl_mtx_mult", bench_mtx_sz, bench_mtx_mult },
+	{ "matrices", "zsl_mtx_mult_trans_a", bench_mtx_sz,
+	  bench_mtx_mult_trans_a },
+	{ "matrices", "zsl_mtx_trans", bench_mtx_sz, bench_mtx_trans },
+	{ "matrices", "zsl_mtx_deter", bench_mtx_sz, bench_mtx_deter },
+	{ "matrices", "zsl_mtx_inv", bench_mtx_sz, bench_mtx_inv },
+	{ "matrices", "zsl_mtx_lu", bench_mtx_sz, bench_mtx_lu },
+	{ "matrices", "zsl_mtx_lu_solve", bench_mtx_sz, bench_mtx_lu_solve },
+	{ "matrices", "zsl_mtx_cholesky", bench_mtx_sz, bench_mtx_cholesky },
+	{ "matrices", "zsl_mtx_cho_solve", bench_mtx_sz, bench_mtx_cho_solve },
+	{ "matrices", "zsl_mtx_qrd", bench_mtx_sz, bench_mtx_qrd },
+	{ "matrices", "zsl_mtx_qrd_compact", bench_mtx_sz,
+	  bench_mtx_qrd_compact },
+	{ "matrices", "zsl_mtx_eigen_sym", bench_mtx_sz, bench_mtx_eigen_sym },
+	{ "matrices", "zsl_mtx_svd_thin", bench_mtx_sz, bench_mtx_svd_thin },
+	{ "matrices", "zsl_mtx_eigenvalues", bench_mtx_sz,
+	  bench_mtx_eigenvalues },
+	{ "matrices", "zsl_mtx_eigenvalues_cplx", bench_mtx_sz,
+	  bench_mtx_eigenvalues_cplx },
+	{ "matrices", "zsl_mtx_svd", bench_mtx_sz, bench_mtx_svd },
+	{ "matrices", "zsl_mtx_pinv", bench_mtx_sz, bench_mtx_pinv },
+	{ "matrices", "zsl_mtx_gemm", bench_mtx_sz, bench_mtx_gemm },
+	{ "matrices", "zsl_mtx_gemv", bench_mtx_sz, bench_mtx_gemv },
+	{ "matrices", "zsl_mtx_ger", bench_mtx_sz, bench_mtx_ger },
+	{ "matrices", "zsl_mtx_syrk", bench_mtx_sz, bench_mtx_syrk },
+	{ "matrices", "zsl_mtx_band_mult_vec", bench_vec_sz,
+	  bench_mtx_band_mult_vec },
+	{ "matrices", "zsl_mtx_band_lu", bench_vec_sz, bench_mtx_band_lu },
+	{ "matrices", "zsl_mtx_band_lu_solve", bench_vec_sz,
+	  bench_mtx_band_lu_solve },
+	{ "matrices", "zsl_mtx_tridiag_solve", bench_vec_sz,
+	  bench_mtx_tridiag_solve },
+	{ "matrices", "zsl_mtx_lstsq", bench_mtx_sz, bench_mtx_lstsq },
+	{ "matrices", "zsl_mtx_qrd_update", bench_mtx_sz,
+	  bench_mtx_qrd_update },
+	{ "matrices", "zsl_mtx_expm", bench_mtx_sz, bench_mtx_expm },
+	{ "matrices", "zsl_mtx_van_loan", bench_mtx_sz, bench_mtx_van_loan },
+	{ "statistics", "zsl_sta_rls_update", bench_mtx_sz,
+	  bench_sta_rls_update },
+	{ "fixed", "zsl_mtx3_mult", bench_fix_sz, bench_mtx3_mult },
+	{ "fixed", "zsl_mtx3_mult_vec", bench_fix_sz, bench_mtx3_mult_vec },
+	{ "fixed", "zsl_mtx3_inv", bench_fix_sz, bench_mtx3_inv },
+	{ "fixed", "zsl_mtx4_mult", bench_fix_sz, bench_mtx4_mult },
+	{ "fixed", "zsl_mtx4_inv", bench_fix_sz, bench_mtx4_inv },
+	{ "fixed", "zsl_mtx6_mult", bench_fix_sz, bench_mtx6_mult },
+	{ "fixed", "zsl_mtx6_inv", bench_fix_sz, bench_mtx6_inv },
+	{ "batch", "zsl_mtx_batch_mult (3x3)", bench_vec_sz,
+	  bench_mtx_batch_mult },
+	{ "batch", "zsl_mtx_batch_inv (3x3)", bench_vec_sz,
+	  bench_mtx_batch_inv },
+	{ "sparse", "zsl_spmtx_mult_vec", bench_vec_sz, bench_spmtx_mult_vec },
+	{ "solvers", "zsl_solve_cg", bench_vec_sz, bench_solve_cg },
+	{ "solvers", "zsl_solve_bicgstab", bench_vec_sz, bench_solve_bicgstab },
+	{ "solvers", "zsl_solve_gmres", bench_vec_sz, bench_solve_gmres },
+	{ "solvers", "zsl_solve_lu_mixed", bench_mtx_sz, bench_solve_lu_mixed },
+	{ "solvers", "zsl_solve_cho_mixed", bench_mtx_sz,
+	  bench_solve_cho_mixed },
+	{ "fixedpoint", "zsl_vec_q15_dot", bench_vec_sz, bench_vec_q15_dot },
+	{ "fixedpoint", "zsl_mtx_q15_mult_vec", bench_mtx_sz,
+	  bench_mtx_q15_mult_vec },
+	{ "fixedpoint", "zsl_vec_q31_dot", bench_vec_sz, bench_vec_q31_dot },
+	{ "fixedpoint", "zsl_mtx_q31_mult_vec", bench_mtx_sz,
+	  bench_mtx_q31_mult_vec },
+	{ "half", "zsl_vec_half_dot (fp16)", bench_vec_sz,
+	  bench_vec_half_dot_fp16 },
+	{ "half", "zsl_vec_half_dot (bf16)", bench_vec_sz,
+	  bench_vec_half_dot_bf16 },
+	{ "half", "zsl_mtx_half_mult_vec (fp16)", bench_mtx_sz,
+	  bench_mtx_half_mult_vec_fp16 },
+	{ "half", "zsl_mtx_half_mult_vec (bf16)", bench_mtx_sz,
+	  bench_mtx_half_mult_vec_bf16 },
+	{ "orientation", "zsl_quat_mult", bench_fix_sz, bench_quat_mult },
+	{ "orientation", "zsl_quat_slerp", bench_fix_sz, bench_quat_slerp },
+	{ "orientation", "zsl_quat_to_rot_mtx", bench_fix_sz,
+	  bench_quat_to_rot_mtx },
+	{ "interp", "zsl_interp_lerp", bench_fix_sz, bench_interp_lerp },
+	{ "interp", "zsl_interp_nn", bench_fix_sz, bench_interp_nn },
+	{ "interp", "zsl_interp_lin_y", bench_fix_sz, bench_interp_lin_y },
+	{ "interp", "zsl_interp_lin_x", bench_fix_sz, bench_interp_lin_x },
+	{ "interp", "zsl_interp_find_x", bench_vec_sz, bench_interp_find_x },
+	{ "interp", "zsl_interp_nn_arr", bench_vec_sz, bench_interp_nn_arr },
+	{ "interp", "zsl_interp_lin_y_arr", bench_vec_sz,
+	  bench_interp_lin_y_arr },
+	{ "interp", "zsl_interp_cubic_calc", bench_vec_sz,
+	  bench_interp_cubic_calc },
+	{ "interp", "zsl_interp_cubic_arr", bench_vec_sz,
+	  bench_interp_cubic_arr },
+	{ "probability", "zsl_prob_uni_pdf", bench_fix_sz, bench_prob_uni_pdf },
+	{ "probability", "zsl_prob_uni_mean", bench_fix_sz,
+	  bench_prob_uni_mean },
+	{ "probability", "zsl_prob_uni_var", bench_fix_sz, bench_prob_uni_var },
+	{ "probability", "zsl_prob_uni_cdf", bench_fix_sz, bench_prob_uni_cdf },
+	{ "probability", "zsl_prob_normal_pdf", bench_fix_sz,
+	  bench_prob_normal_pdf },
+	{ "probability", "zsl_prob_normal_cdf", bench_fix_sz,
+	  bench_prob_normal_cdf },
+	{ "probability", "zsl_prob_erf_inv", bench_fix_sz, bench_prob_erf_inv },
+	{ "probability", "zsl_prob_normal_cdf_inv", bench_fix_sz,
+	  bench_prob_normal_cdf_inv },
+	{ "probability", "zsl_prob_entropy", bench_vec_sz, bench_prob_entropy },
+	{ "colorimetry", "zsl_clr_conv_spd_xyz", bench_fix_sz,
+	  bench_clr_conv_spd_xyz },
+	{ "colorimetry", "zsl_clr_conv_xyy_xyz", bench_fix_sz,
+	  bench_clr_conv_xyy_xyz },
+	{ "colorimetry", "zsl_clr_conv_xyz_xyy", bench_fix_sz,
+	  bench_clr_conv_xyz_xyy },
+	{ "colorimetry", "zsl_clr_conv_xyy_uv60", bench_fix_sz,
+	  bench_clr_conv_xyy_uv60 },
+	{ "colorimetry", "zsl_clr_conv_xyz_uv60", bench_fix_sz,
+	  bench_clr_conv_xyz_uv60 },
+	{ "colorimetry", "zsl_clr_conv_uv60_xyz", bench_fix_sz,
+	  bench_clr_conv_uv60_xyz },
+	{ "colorimetry", "zsl_clr_conv_uv60_xyy", bench_fix_sz,
+	  bench_clr_conv_uv60_xyy },
+	{ "colorimetry", "zsl_clr_conv_uv60_uv76", bench_fix_sz,
+	  bench_clr_conv_uv60_uv76 },
+	{ "colorimetry", "zsl_clr_conv_uv76_uv60", bench_fix_sz,
+	  bench_clr_conv_uv76_uv60 },
+	{ "colorimetry", "zsl_clr_conv_ct_uv60", bench_fix_sz,
+	  bench_clr_conv_ct_uv60 },
+	{ "colorimetry", "zsl_clr_conv_ct_xyz", bench_fix_sz,
+	  bench_clr_conv_ct_xyz },
+	{ "colorimetry", "zsl_clr_conv_ct_rgb8", bench_fix_sz,
+	  bench_clr_conv_ct_rgb8 },
+	{ "colorimetry", "zsl_clr_conv_ct_rgbf", bench_fix_sz,
+	  bench_clr_conv_ct_rgbf },
+	{ "colorimetry", "zsl_clr_conv_cct_xyy", bench_fix_sz,
+	  bench_clr_conv_cct_xyy },
+	{ "colorimetry", "zsl_clr_conv_cct_xyz", bench_fix_sz,
+	  bench_clr_conv_cct_xyz },
+	{ "colorimetry", "zsl_clr_conv_uv60_cct (McCamy)", bench_fix_sz,
+	  bench_clr_conv_uv60_cct_mccamy },
+	{ "colorimetry", "zsl_clr_conv_uv60_cct (Ohno 2011)", bench_fix_sz,
+	  bench_clr_conv_uv60_cct_ohno2011 },
+	{ "colorimetry", "zsl_clr_conv_uv60_cct (Ohno 2014)", bench_fix_sz,
+	  bench_clr_conv_uv60_cct_ohno2014 },
+	{ "colorimetry", "zsl_clr_conv_xyz_rgb8", bench_fix_sz,
+	  bench_clr_conv_xyz_rgb8 },
+	{ "colorimetry", "zsl_clr_conv_xyz_rgbf", bench_fix_sz,
+	  bench_clr_conv_xyz_rgbf },
+	{ "colorimetry", "zsl_clr_norm_spd", bench_fix_sz, bench_clr_norm_spd },
+	{ "colorimetry", "zsl_clr_lef_lerp", bench_fix_sz, bench_clr_lef_lerp },
+};
+
+/* -------------------------------------------------------------------------
+ * Input data.
+ * ---------------------------------------------------------------------- */
+
+static uint32_t bench_seed;
+
+/* Deterministic pseudo-random value in [-1.0, 1.0). */
+static zsl_real_t
+bench_rand(void)
+{
+	bench_seed = bench_seed * 1664525u + 1013904223u;
+	return ((zsl_real_t)(bench_seed >> 8) / (zsl_real_t)(1u << 23)) -
+	       (zsl_real_t)1.0;
+}
+
+static void
+bench_mtx_alloc(struct zsl_mtx *m, size_t n)
+{
+	m->sz_rows = n;
+	m->sz_cols = n;
+	m->data = calloc(n * n, sizeof(zsl_real_t));
+}
+
+static void
+bench_vec_alloc(struct zsl_vec *v, size_t n)
+{
+	v->sz = n;
+	v->data = calloc(n, sizeof(zsl_real_t));
+}
+
+static void
+bench_batch_alloc(struct zsl_mtx_batch *b, size_t count)
+{
+	b->sz_rows = 3;
+	b->sz_cols = 3;
+	b->count = count;
+	b->data = calloc(9 * count, sizeof(zsl_real_t));
+}
+
+/* Packs 'va', 'vb' and the m x m matrix 'mb' of 'c' in format 'fmt'. */
+static void
+bench_half_alloc(struct zsl_vec_half *va, struct zsl_vec_half *vb,
+		 struct zsl_mtx_half *mh, struct bench_ctx *c, size_t m,
+		 enum zsl_half_fmt fmt)
+{
+	va->sz = c->n;
+	va->fmt = fmt;
+	va->data = calloc(c->n, sizeof(zsl_half_t));
+	vb->sz = c->n;
+	vb->fmt = fmt;
+	vb->data = calloc(c->n, sizeof(zsl_half_t));
+	mh->sz_rows = m;
+	mh->sz_cols = m;
+	mh->fmt = fmt;
+	mh->data = calloc(m * m, sizeof(zsl_half_t));
+	zsl_vec_half_pack(va, &c->va);
+	zsl_vec_half_pack(vb, &c->vb);
+	zsl_mtx_half_pack(mh, &c->mb);
+}
+
+static void
+bench_ctx_free(struct bench_ctx *c)
+{
+	free(c->va.data);
+	free(c->vb.data);
+	free(c->vc.data);
+	free(c->vd.data);
+	free(c->ma.data);
+	free(c->mb.data);
+	free(c->mc.data);
+	free(c->md.data);
+	free(c->me.data);
+	free(c->spd.data);
+	free(c->lu.data);
+	free(c->chol.data);
+	free(c->piv);
+	free(c->q.data);
+	free(c->r.data);
+	free(c->rls.ls.r.data);
+	free(c->rls.ls.qtb.data);
+	free(c->rls.ls.ssr.data);
+	free(c->rls.ls.work.data);
+	free(c->rls.theta.data);
+	free(c->sp.row_ptr);
+	free(c->sp.col_idx);
+	free(c->sp.data);
+	free(c->tda.data);
+	free(c->tdb.data);
+	free(c->tdc.data);
+	free(c->band.data);
+	free(c->band_lu.data);
+	free(c->band_piv);
+	free(c->ba.data);
+	free(c->bb.data);
+	free(c->bc.data);
+	free(c->f16a.data);
+	free(c->f16b.data);
+	free(c->b16a.data);
+	free(c->b16b.data);
+	free(c->f16m.data);
+	free(c->b16m.data);
+	free(c->q15a.data);
+	free(c->q15b.data);
+	free(c->q15c.data);
+	free(c->q15m.data);
+	free(c->q31a.data);
+	free(c->q31b.data);
+	free(c->q31c.data);
+	free(c->q31m.data);
+	free(c->xy);
+	free(c->xyc);
+	free(c->vp.data);
+	free(c->clr_spd);
+}
+
+/*
+ * Fills the context for size 'n'. Matrix kernels ('mtx' set) use nxn
+ * matrices and n-vectors, where 'ma' is diagonally dominant so that it is
+ * well conditioned. Other kernels only get 3x3 matrices, which is what the
+ * quaternion kernels write to.
+ */
+static void
+bench_ctx_init(struct bench_ctx *c, size_t n, bool mtx)
+{
+	size_t m = mtx ? n : 3;
+	const struct zsl_clr_spd *lef;
+	size_t spd_sz;
+
+	memset(c, 0, sizeof(*c));
+	c->n = n;
+	bench_seed = 12345u;
+
+	bench_vec_alloc(&c->va, n);
+	bench_vec_alloc(&c->vb, n);
+	bench_vec_alloc(&c->vc, n);
+	bench_vec_alloc(&c->vd, n);
+	for (size_t i = 0; i < n; i++) {
+		c->va.data[i] = bench_rand();
+		c->vb.data[i] = bench_rand();
+	}
+
+	bench_mtx_alloc(&c->ma, m);
+	bench_mtx_alloc(&c->mb, m);
+	bench_mtx_alloc(&c->mc, m);
+	bench_mtx_alloc(&c->md, m);
+	bench_mtx_alloc(&c->me, m);
+	bench_mtx_alloc(&c->spd, m);
+	bench_mtx_alloc(&c->lu, m);
+	bench_mtx_alloc(&c->chol, m);
+	c->piv = calloc(m, sizeof(size_t));
+
+	for (size_t i = 0; i < m * m; i++) {
+		c->ma.data[i] = bench_rand();
+		c->mb.data[i] = bench_rand();
+	}
+	for (size_t i = 0; i < m; i++) {
+		c->ma.data[(i * m) + i] += (zsl_real_t)m;
+	}
+
+	/* spd = ma * ma^T + m * I */
+	zsl_mtx_mult_trans_b(&c->ma, &c->ma, &c->spd);
+	for (size_t i = 0; i < m; i++) {
+		c->spd.data[(i * m) + i] += (zsl_real_t)m;
+	}
+
+	zsl_mtx_lu(&c->ma, &c->lu, c->piv);
+	zsl_mtx_cholesky(&c->spd, &c->chol);
+
+	bench_mtx_alloc(&c->q, m);
+	bench_mtx_alloc(&c->r, m);
+	zsl_mtx_qrd(&c->ma, &c->q, &c->r, false);
+
+	bench_mtx_alloc(&c->rls.ls.r, m);
+	c->rls.ls.qtb.sz_rows = m;
+	c->rls.ls.qtb.sz_cols = 1;
+	c->rls.ls.qtb.data = calloc(m, sizeof(zsl_real_t));
+	bench_vec_alloc(&c->rls.ls.ssr, 1);
+	bench_vec_alloc(&c->rls.ls.work, m + 1);
+	bench_vec_alloc(&c->rls.theta, m);
+	zsl_sta_rls_init(&c->rls, (zsl_real_t)0.99, (zsl_real_t)100.0);
+
+	/* The tridiagonal system, in all three of its forms. */
+	c->sp.sz_rows = n;
+	c->sp.sz_cols = n;
+	c->sp.max_nnz = 3 * n;
+	c->sp.row_ptr = calloc(n + 1, sizeof(size_t));
+	c->sp.col_idx = calloc(3 * n, sizeof(size_t));
+	c->sp.data = calloc(3 * n, sizeof(zsl_real_t));
+	bench_vec_alloc(&c->tda, n - 1);
+	bench_vec_alloc(&c->tdb, n);
+	bench_vec_alloc(&c->tdc, n - 1);
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = (i > 0) ? i - 1 : 0; (j <= i + 1) && (j < n);
+		     j++) {
+			c->sp.col_idx[c->sp.nnz] = j;
+			c->sp.data[c->sp.nnz++] = (i == j) ? (zsl_real_t)4.0 :
+						  (zsl_real_t)-1.0;
+		}
+		c->sp.row_ptr[i + 1] = c->sp.nnz;
+		c->tdb.data[i] = (zsl_real_t)4.0;
+		if (i + 1 < n) {
+			c->tda.data[i] = (zsl_real_t)-1.0;
+			c->tdc.data[i] = (zsl_real_t)-1.0;
+		}
+	}
+	zsl_linop_spmtx(&c->op, &c->sp);
+
+	/* A tolerance that single-precision builds can reach too. */
+	c->par.tol = (zsl_real_t)1E-5;
+	c->par.max_iter = 1000;
+	c->par.restart = 20;
+
+	c->band.sz = n;
+	c->band.kl = 2;
+	c->band.ku = 2;
+	c->band.data = calloc(n * ZSL_MTX_BAND_WIDTH(&c->band),
+			      sizeof(zsl_real_t));
+	c->band_lu = c->band;
+	c->band_lu.data = calloc(n * ZSL_MTX_BAND_WIDTH(&c->band),
+				 sizeof(zsl_real_t));
+	c->band_piv = calloc(n, sizeof(size_t));
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = (i > 2) ? i - 2 : 0; (j <= i + 2) && (j < n);
+		     j++) {
+			zsl_mtx_band_set(&c->band, i, j, (i == j) ?
+					 (zsl_real_t)5.0 + bench_rand() :
+					 bench_rand());
+		}
+	}
+	bench_mtx_band_lu(c);
+
+	bench_batch_alloc(&c->ba, n);
+	bench_batch_alloc(&c->bb, n);
+	bench_batch_alloc(&c->bc, n);
+	for (size_t i = 0; i < 9 * n; i++) {
+		c->ba.data[i] = bench_rand();
+		c->bb.data[i] = bench_rand();
+	}
+	for (size_t i = 0; i < 3 * n; i++) {
+		/* Element (k, k) of matrix j is at data[(k * 4 * n) + j]. */
+		c->ba.data[((i / n) * 4 * n) + (i % n)] += (zsl_real_t)3.0;
+	}
+
+	bench_half_alloc(&c->f16a, &c->f16b, &c->f16m, c, m, ZSL_HALF_FP16);
+	bench_half_alloc(&c->b16a, &c->b16b, &c->b16m, c, m, ZSL_HALF_BF16);
+
+	c->q15a.sz = n;
+	c->q15a.data = calloc(n, sizeof(zsl_q15_t));
+	c->q15b.sz = n;
+	c->q15b.data = calloc(n, sizeof(zsl_q15_t));
+	c->q15c.sz = m;
+	c->q15c.data = calloc(m, sizeof(zsl_q15_t));
+	c->q15m.sz_rows = m;
+	c->q15m.sz_cols = m;
+	c->q15m.data = calloc(m * m, sizeof(zsl_q15_t));
+	zsl_vec_q15_from_vec(&c->q15a, &c->va);
+	zsl_vec_q15_from_vec(&c->q15b, &c->vb);
+	zsl_mtx_q15_from_mtx(&c->q15m, &c->mb);
+
+	c->q31a.sz = n;
+	c->q31a.data = calloc(n, sizeof(zsl_q31_t));
+	c->q31b.sz = n;
+	c->q31b.data = calloc(n, sizeof(zsl_q31_t));
+	c->q31c.sz = m;
+	c->q31c.data = calloc(m, sizeof(zsl_q31_t));
+	c->q31m.sz_rows = m;
+	c->q31m.sz_cols = m;
+	c->q31m.data = calloc(m * m, sizeof(zsl_q31_t));
+	zsl_vec_q31_from_vec(&c->q31a, &c->va);
+	zsl_vec_q31_from_vec(&c->q31b, &c->vb);
+	zsl_mtx_q31_from_mtx(&c->q31m, &c->mb);
+
+	for (size_t i = 0; i < 9; i++) {
+		c->m3a.data[i] = bench_rand();
+		c->m3b.data[i] = bench_rand();
+	}
+	for (size_t i = 0; i < 16; i++) {
+		c->m4a.data[i] = bench_rand();
+		c->m4b.data[i] = bench_rand();
+	}
+	for (size_t i = 0; i < 36; i++) {
+		c->m6a.data[i] = bench_rand();
+		c->m6b.data[i] = bench_rand();
+	}
+	for (size_t i = 0; i < 3; i++) {
+		c->m3a.data[(i * 3) + i] += (zsl_real_t)3.0;
+		c->v3a.data[i] = bench_rand();
+	}
+	for (size_t i = 0; i < 4; i++) {
+		c->m4a.data[(i * 4) + i] += (zsl_real_t)4.0;
+	}
+	for (size_t i = 0; i < 6; i++) {
+		c->m6a.data[(i * 6) + i] += (zsl_real_t)6.0;
+	}
+
+	c->qa.r = (zsl_real_t)0.7;
+	c->qa.i = (zsl_real_t)0.1;
+	c->qa.j = (zsl_real_t)-0.5;
+	c->qa.k = (zsl_real_t)0.5;
+	c->qb.r = (zsl_real_t)0.2;
+	c->qb.i = (zsl_real_t)0.9;
+	c->qb.j = (zsl_real_t)0.3;
+	c->qb.k = (zsl_real_t)-0.2;
+	zsl_quat_to_unit_d(&c->qa);
+	zsl_quat_to_unit_d(&c->qb);
+
+	c->xy = calloc(n, sizeof(*c->xy));
+	c->xyc = calloc(n, sizeof(*c->xyc));
+	for (size_t i = 0; i < n; i++) {
+		c->xy[i].x = (zsl_real_t)i;
+		c->xy[i].y = ZSL_SIN((zsl_real_t)i * (zsl_real_t)0.1);
+		c->xyc[i].x = c->xy[i].x;
+		c->xyc[i].y = c->xy[i].y;
+	}
+	zsl_interp_cubic_calc(c->xyc, n, 0.0, 0.0);
+	c->pt[0].x = (zsl_real_t)0.0;
+	c->pt[0].y = (zsl_real_t)0.0;
+	c->pt[1].x = (zsl_real_t)1.0;
+	c->pt[1].y = ZSL_SIN((zsl_real_t)0.1);
+
+	bench_vec_alloc(&c->vp, n);
+	for (size_t i = 0; i < n; i++) {
+		c->vp.data[i] = (zsl_real_t)1.0 / (zsl_real_t)n;
+	}
+	c->pa = (zsl_real_t)-0.5;
+	c->pb = (zsl_real_t)1.5;
+	c->px = (zsl_real_t)0.25;
+
+	zsl_clr_lef_get(ZSL_CLR_LEF_CIE88_PHOTOPIC, &lef);
+	spd_sz = sizeof(*lef) + (lef->size * sizeof(lef->comps[0]));
+	c->clr_spd = malloc(spd_sz);
+	memcpy(c->clr_spd, lef, spd_sz);
+	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &c->ccm);
+
+	/* A 4000 K white point, in every color space used as an input. */
+	c->cct.cct = (zsl_real_t)4000.0;
+	c->cct.duv = (zsl_real_t)0.002;
+	zsl_clr_conv_cct_xyz(&c->cct, ZSL_CLR_OBS_2_DEG, &c->xyz);
+	zsl_clr_conv_xyz_xyy(&c->xyz, &c->xyy);
+	zsl_clr_conv_xyz_uv60(&c->xyz, &c->uv60);
+	zsl_clr_conv_uv60_uv76(&c->uv60, &c->uv76);
+}
+
+/* -------------------------------------------------------------------------
+ * Measurement.
+ * ---------------------------------------------------------------------- */
+
+static int bench_perf_fd = -1;
+static const char *bench_cycle_src = "none";
+
+static void
+bench_cycles_init(void)
+{
+	struct perf_event_attr pe;
+
+	memset(&pe, 0, sizeof(pe));
+	pe.type = PERF_TYPE_HARDWARE;
+	pe.size = sizeof(pe);
+	pe.config = PERF_COUNT_HW_CPU_CYCLES;
+	pe.exclude_kernel = 1;
+	pe.exclude_hv = 1;
+
+	bench_perf_fd = (int)syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+	if (bench_perf_fd >= 0) {
+		ioctl(bench_perf_fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(bench_perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+		bench_cycle_src = "perf";
+		return;
+	}
+
+#if defined(__x86_64__) || defined(__i386__)
+	bench_cycle_src = "rdtsc";
+#endif
+}
+
+static uint64_t
+bench_cycles(void)
+{
+	uint64_t count = 0;
+
+	if (bench_perf_fd >= 0) {
+		if (read(bench_perf_fd, &count, sizeof(count)) !=
+		    sizeof(count)) {
+			return 0;
+		}
+		return count;
+	}
+
+#if defined(__x86_64__) || defined(__i386__)
+	count = __rdtsc();
+#endif
+
+	return count;
+}
+
+static uint64_t
+bench_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int
+bench_cmp_dbl(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+struct bench_job {
+	const struct bench *b;
+	struct bench_ctx *c;
+	int rc;
+};
+
+static void *
+bench_job_thread(void *arg)
+{
+	struct bench_job *j = arg;
+
+	if (j->b != NULL) {
+		j->rc = j->b->run(j->c);
+	}
+
+	return NULL;
+}
+
+/*
+ * Runs a single call on a freshly painted stack, returning the number of
+ * stack bytes touched. The thread overhead is removed by the caller.
+ */
+static size_t
+bench_stack_run(struct bench_job *j)
+{
+	uint8_t *stk;
+	size_t i;
+	pthread_t t;
+	pthread_attr_t attr;
+
+	stk = aligned_alloc(4096, BENCH_STACK_SZ);
+	if (stk == NULL) {
+		return 0;
+	}
+	memset(stk, BENCH_STACK_FILL, BENCH_STACK_SZ);
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstack(&attr, stk, BENCH_STACK_SZ);
+	if (pthread_create(&t, &attr, bench_job_thread, j) == 0) {
+		pthread_join(t, NULL);
+	}
+	pthread_attr_destroy(&attr);
+
+	/* The stack grows down, so find the lowest modified byte. */
+	for (i = 0; i < BENCH_STACK_SZ && stk[i] == BENCH_STACK_FILL; i++) {
+	}
+	free(stk);
+
+	return BENCH_STACK_SZ - i;
+}
+
+static void
+bench_measure(const struct bench *b, struct bench_ctx *c, uint64_t min_ns,
+	      size_t stack_base, struct bench_result *r)
+{
+	uint64_t iters = 1;
+	uint64_t t0, t1, c0, c1;
+	double ns[BENCH_BATCHES];
+	double cyc[BENCH_BATCHES];
+	struct bench_job j = { .b = b, .c = c };
+	size_t stack;
+
+	r->b = b;
+	r->n = c->n;
+
+	/* One call on its own stack, counting allocations. */
+	bench_allocs = 0;
+	stack = bench_stack_run(&j);
+	r->allocs = bench_allocs;
+	r->stack = stack > stack_base ? stack - stack_base : 0;
+	r->rc = j.rc;
+
+	/* Find an iteration count giving batches of at least 'min_ns'. */
+	for (;;) {
+		t0 = bench_ns();
+		for (uint64_t i = 0; i < iters; i++) {
+			b->run(c);
+		}
+		t1 = bench_ns();
+		if ((t1 - t0) >= min_ns) {
+			break;
+		}
+		iters *= 2;
+	}
+
+	for (int g = 0; g < BENCH_BATCHES; g++) {
+		c0 = bench_cycles();
+		t0 = bench_ns();
+		for (uint64_t i = 0; i < iters; i++) {
+			b->run(c);
+		}
+		t1 = bench_ns();
+		c1 = bench_cycles();
+		ns[g] = (double)(t1 - t0) / (double)iters;
+		cyc[g] = (double)(c1 - c0) / (double)iters;
+	}
+
+	qsort(ns, BENCH_BATCHES, sizeof(double), bench_cmp_dbl);
+	qsort(cyc, BENCH_BATCHES, sizeof(double), bench_cmp_dbl);
+
+	r->iters = iters;
+	r->ns = ns[BENCH_BATCHES / 2];
+	r->cycles = bench_perf_fd >= 0 || strcmp(bench_cycle_src, "rdtsc") == 0 ?
+		    cyc[BENCH_BATCHES / 2] : -1.0;
+}
+
+/* -------------------------------------------------------------------------
+ * Output.
+ * ---------------------------------------------------------------------- */
+
+static const char *
+bench_precision(void)
+{
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	return "single";
+#else
+	return "double";
+#endif
+}
+
+static void
+bench_write_json(FILE *f, struct bench_result *r, size_t count)
+{
+	fprintf(f, "{\n");
+	fprintf(f, "  \"zsl_version\": \"%s\",\n", ZSL_VERSION);
+	fprintf(f, "  \"precision\": \"%s\",\n", bench_precision());
+	fprintf(f, "  \"platform_opt\": %d,\n", CONFIG_ZSL_PLATFORM_OPT);
+	fprintf(f, "  \"cycle_source\": \"%s\",\n", bench_cycle_src);
+	fprintf(f, "  \"results\": [\n");
+	for (size_t i = 0; i < count; i++) {
+		fprintf(f, "    { \"module\": \"%s\", \"func\": \"%s\", "
+			"\"size\": %zu, \"rc\": %d, \"iters\": %llu, "
+			"\"ns_per_op\": %.3f, \"cycles_per_op\": %.1f, "
+			"\"allocs\": %zu, \"stack_bytes\": %zu }%s\n",
+			r[i].b->module, r[i].b->func, r[i].n, r[i].rc,
+			(unsigned long long)r[i].iters, r[i].ns, r[i].cycles,
+			r[i].allocs, r[i].stack, i + 1 < count ? "," : "");
+	}
+	fprintf(f, "  ]\n}\n");
+}
+
+static void
+bench_write_csv(FILE *f, struct bench_result *r, size_t count)
+{
+	fprintf(f, "module,func,size,rc,iters,ns_per_op,cycles_per_op,"
+		"allocs,stack_bytes\n");
+	for (size_t i = 0; i < count; i++) {
+		fprintf(f, "%s,%s,%zu,%d,%llu,%.3f,%.1f,%zu,%zu\n",
+			r[i].b->module, r[i].b->func, r[i].n, r[i].rc,
+			(unsigned long long)r[i].iters, r[i].ns, r[i].cycles,
+			r[i].allocs, r[i].stack);
+	}
+}
+
+static void
+bench_usage(const char *name)
+{
+	printf("Usage: %s [-j file.json] [-c file.csv] [-f filter] [-t ms]\n",
+	       name);
+	printf("  -j FILE   Write the results as JSON to FILE.\n");
+	printf("  -c FILE   Write the results as CSV to FILE.\n");
+	printf("  -f TEXT   Only run functions whose name contains TEXT.\n");
+	printf("  -t MS     Minimum duration of each timed batch (default %d).\n",
+	       BENCH_MIN_MS);
+}
+
+int
+main(int argc, char *argv[])
+{
+	const char *json = NULL;
+	const char *csv = NULL;
+	const char *filter = NULL;
+	uint64_t min_ns = BENCH_MIN_MS * 1000000ull;
+	size_t count = 0;
+	size_t max = 0;
+	size_t stack_base;
+	struct bench_result *res;
+	struct bench_ctx ctx;
+	struct bench_job idle = { .b = NULL };
+	FILE *f;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "j:c:f:t:h")) != -1) {
+		switch (opt) {
+		case 'j':
+			json = optarg;
+			break;
+		case 'c':
+			csv = optarg;
+			break;
+		case 'f':
+			filter = optarg;
+			break;
+		case 't':
+			min_ns = strtoull(optarg, NULL, 10) * 1000000ull;
+			break;
+		default:
+			bench_usage(argv[0]);
+			return opt == 'h' ? 0 : -EINVAL;
+		}
+	}
+
+	for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+		for (size_t s = 0; benches[i].sizes[s] != 0; s++) {
+			max++;
+		}
+	}
+	res = calloc(max, sizeof(*res));
+	if (res == NULL) {
+		return -ENOMEM;
+	}
+
+	bench_cycles_init();
+	stack_base = bench_stack_run(&idle);
+
+	printf("zscilib %s benchmark (%s precision, CONFIG_ZSL_PLATFORM_OPT=%d, "
+	       "cycles: %s)\n\n", ZSL_VERSION, bench_precision(),
+	       CONFIG_ZSL_PLATFORM_OPT, bench_cycle_src);
+	printf("%-12s %-34s %6s %14s %14s %7s %9s\n", "module", "func",
+	       "size", "ns/op", "cycles/op", "allocs", "stack");
+
+	for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+		const struct bench *b = &benches[i];
+
+		if ((filter != NULL) && (strstr(b->func, filter) == NULL)) {
+			continue;
+		}
+
+		for (size_t s = 0; b->sizes[s] != 0; s++) {
+			bench_ctx_init(&ctx, b->sizes[s],
+				       b->sizes == bench_mtx_sz);
+			bench_measure(b, &ctx, min_ns, stack_base, &res[count]);
+			bench_ctx_free(&ctx);
+
+			printf("%-12s %-34s %6zu %14.1f %14.1f %7zu %9zu%s\n",
+			       b->module, b->func, res[count].n,
+			       res[count].ns, res[count].cycles,
+			       res[count].allocs, res[count].stack,
+			       res[count].rc ? "  (error)" : "");
+			fflush(stdout);
+			count++;
+		}
+	}
+
+	if (json != NULL) {
+		f = fopen(json, "w");
+		if (f == NULL) {
+			perror(json);
+			return -EIO;
+		}
+		bench_write_json(f, res, count);
+		fclose(f);
+	}
+
+	if (csv != NULL) {
+		f = fopen(csv, "w");
+		if (f == NULL) {
+			perror(csv);
+			return -EIO;
+		}
+		bench_write_csv(f, res, count);
+		fclose(f);
+	}
+
+	free(res);
+
+	return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/batch.h>
+
+/*
+ * Every loop over 'k' below runs across the batch with unit stride and no
+ * branches, which allows the compiler to vectorise it.
+ */
+
+/* Pointer to value (i, j) of the first matrix in batch 'b'. */
+#define ZSL_BATCH_AT(b, i, j) \
+	(&(b)->data[(((i) * (b)->sz_cols) + (j)) * (b)->count])
+
+int
+zsl_mtx_batch_init(struct zsl_mtx_batch *b)
+{
+	memset(b->data, 0, b->sz_rows * b->sz_cols * b->count *
+	       sizeof(zsl_real_t));
+
+	return 0;
+}
+
+int
+zsl_mtx_batch_set(struct zsl_mtx_batch *b, size_t k, struct zsl_mtx *m)
+{
+	if ((k >= b->count) || (m->sz_rows != b->sz_rows) ||
+	    (m->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < b->sz_rows; i++) {
+		for (size_t j = 0; j < b->sz_cols; j++) {
+			ZSL_BATCH_AT(b, i, j)[k] =
+				m->data[(i * ZSL_MTX_ROW_STEP(m)) +
+					(j * ZSL_MTX_COL_STEP(m))];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_batch_get(struct zsl_mtx_batch *b, size_t k, struct zsl_mtx *m)
+{
+	if ((k >= b->count) || (m->sz_rows != b->sz_rows) ||
+	    (m->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < b->sz_rows; i++) {
+		for (size_t j = 0; j < b->sz_cols; j++) {
+			m->data[(i * ZSL_MTX_ROW_STEP(m)) +
+				(j * ZSL_MTX_COL_STEP(m))] =
+				ZSL_BATCH_AT(b, i, j)[k];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_batch_mult(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bb,
+		   struct zsl_mtx_batch *bc)
+{
+	size_t cnt = ba->count;
+	const zsl_real_t *a;
+	const zsl_real_t *b;
+	zsl_real_t *c;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ba->sz_cols != bb->sz_rows) || (bc->sz_rows != ba->sz_rows) ||
+	    (bc->sz_cols != bb->sz_cols) || (bb->count != cnt) ||
+	    (bc->count != cnt)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < bc->sz_rows; i++) {
+		for (size_t j = 0; j < bc->sz_cols; j++) {
+			c = ZSL_BATCH_AT(bc, i, j);
+			memset(c, 0, cnt * sizeof(zsl_real_t));
+			for (size_t p = 0; p < ba->sz_cols; p++) {
+				a = ZSL_BATCH_AT(ba, i, p);
+				b = ZSL_BATCH_AT(bb, p, j);
+				for (size_t k = 0; k < cnt; k++) {
+					c[k] += a[k] * b[k];
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_batch_mult_vec(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bv,
+		       struct zsl_mtx_batch *bw)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((bv->sz_cols != 1) || (bw->sz_cols != 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_mtx_batch_mult(ba, bv, bw);
+}
+
+int
+zsl_mtx_batch_trans(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bt)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ba->sz_rows != bt->sz_cols) || (ba->sz_cols != bt->sz_rows) ||
+	    (ba->count != bt->count)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Whole planes of the batch are moved at a time. */
+	for (size_t i = 0; i < ba->sz_rows; i++) {
+		for (size_t j = 0; j < ba->sz_cols; j++) {
+			memcpy(ZSL_BATCH_AT(bt, j, i), ZSL_BATCH_AT(ba, i, j),
+			       ba->count * sizeof(zsl_real_t));
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Calculates the determinants of a batch of 2x2, 3x3 or 4x4 matrices, and
+ * their inverses if 'i' isn't NULL.
+ */
+static int
+zsl_mtx_batch_inv_deter(struct zsl_mtx_batch *ba, zsl_real_t *d,
+			zsl_real_t *i)
+{
+	size_t n = ba->count;
+	const zsl_real_t *a = ba->data;
+	zsl_real_t det, id, e;
+
+	if (ba->sz_rows != ba->sz_cols) {
+		return -EINVAL;
+	}
+
+	switch (ba->sz_rows) {
+	case 2:
+		for (size_t k = 0; k < n; k++) {
+			zsl_real_t a00 = a[k], a01 = a[n + k];
+			zsl_real_t a10 = a[(2 * n) + k], a11 = a[(3 * n) + k];
+
+			det = (a00 * a11) - (a01 * a10);
+			if (d != NULL) {
+				d[k] = det;
+			}
+			if (i == NULL) {
+				continue;
+			}
+
+			/* Singular matrices give the identity matrix. */
+			e = (det == 0.0) ? 1.0f : 0.0f;
+			id = (det == 0.0) ? 0.0f : 1.0f / det;
+			i[k] = (a11 * id) + e;
+			i[n + k] = -a01 * id;
+			i[(2 * n) + k] = -a10 * id;
+			i[(3 * n) + k] = (a00 * id) + e;
+		}
+		break;
+	case 3:
+		for (size_t k = 0; k < n; k++) {
+			zsl_real_t a00 = a[k];
+			zsl_real_t a01 = a[n + k];
+			zsl_real_t a02 = a[(2 * n) + k];
+			zsl_real_t a10 = a[(3 * n) + k];
+			zsl_real_t a11 = a[(4 * n) + k];
+			zsl_real_t a12 = a[(5 * n) + k];
+			zsl_real_t a20 = a[(6 * n) + k];
+			zsl_real_t a21 = a[(7 * n) + k];
+			zsl_real_t a22 = a[(8 * n) + k];
+
+			/* Cofactors of the first row. */
+			zsl_real_t c00 = (a11 * a22) - (a12 * a21);
+			zsl_real_t c01 = (a12 * a20) - (a10 * a22);
+			zsl_real_t c02 = (a10 * a21) - (a11 * a20);
+
+			det = (a00 * c00) + (a01 * c01) + (a02 * c02);
+			if (d != NULL) {
+				d[k] = det;
+			}
+			if (i == NULL) {
+				continue;
+			}
+
+			e = (det == 0.0) ? 1.0f : 0.0f;
+			id = (det == 0.0) ? 0.0f : 1.0f / det;
+			i[k] = (c00 * id) + e;
+			i[n + k] = ((a02 * a21) - (a01 * a22)) * id;
+			i[(2 * n) + k] = ((a01 * a12) - (a02 * a11)) * id;
+			i[(3 * n) + k] = c01 * id;
+			i[(4 * n) + k] = (((a00 * a22) - (a02 * a20)) * id) + e;
+			i[(5 * n) + k] = ((a02 * a10) - (a00 * a12)) * id;
+			i[(6 * n) + k] = c02 * id;
+			i[(7 * n) + k] = ((a01 * a20) - (a00 * a21)) * id;
+			i[(8 * n) + k] = (((a00 * a11) - (a01 * a10)) * id) + e;
+		}
+		break;
+	case 4:
+		for (size_t k = 0; k < n; k++) {
+			zsl_real_t a00 = a[k];
+			zsl_real_t a01 = a[n + k];
+			zsl_real_t a02 = a[(2 * n) + k];
+			zsl_real_t a03 = a[(3 * n) + k];
+			zsl_real_t a10 = a[(4 * n) + k];
+			zsl_real_t a11 = a[(5 * n) + k];
+			zsl_real_t a12 = a[(6 * n) + k];
+			zsl_real_t a13 = a[(7 * n) + k];
+			zsl_real_t a20 = a[(8 * n) + k];
+			zsl_real_t a21 = a[(9 * n) + k];
+			zsl_real_t a22 = a[(10 * n) + k];
+			zsl_real_t a23 = a[(11 * n) + k];
+			zsl_real_t a30 = a[(12 * n) + k];
+			zsl_real_t a31 = a[(13 * n) + k];
+			zsl_real_t a32 = a[(14 * n) + k];
+			zsl_real_t a33 = a[(15 * n) + k];
+
+			/* 2x2 minors of the top (s) and bottom (c) rows. */
+			zsl_real_t s0 = (a00 * a11) - (a10 * a01);
+			zsl_real_t s1 = (a00 * a12) - (a10 * a02);
+			zsl_real_t s2 = (a00 * a13) - (a10 * a03);
+			zsl_real_t s3 = (a01 * a12) - (a11 * a02);
+			zsl_real_t s4 = (a01 * a13) - (a11 * a03);
+			zsl_real_t s5 = (a02 * a13) - (a12 * a03);
+			zsl_real_t c5 = (a22 * a33) - (a32 * a23);
+			zsl_real_t c4 = (a21 * a33) - (a31 * a23);
+			zsl_real_t c3 = (a21 * a32) - (a31 * a22);
+			zsl_real_t c2 = (a20 * a33) - (a30 * a23);
+			zsl_real_t c1 = (a20 * a32) - (a30 * a22);
+			zsl_real_t c0 = (a20 * a31) - (a30 * a21);
+
+			det = (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) -
+			      (s4 * c1) + (s5 * c0);
+			if (d != NULL) {
+				d[k] = det;
+			}
+			if (i == NULL) {
+				continue;
+			}
+
+			e = (det == 0.0) ? 1.0f : 0.0f;
+			id = (det == 0.0) ? 0.0f : 1.0f / det;
+			i[k] = (((a11 * c5) - (a12 * c4) + (a13 * c3)) * id) + e;
+			i[n + k] = (-(a01 * c5) + (a02 * c4) - (a03 * c3)) * id;
+			i[(2 * n) + k] = ((a31 * s5) - (a32 * s4) +
+					  (a33 * s3)) * id;
+			i[(3 * n) + k] = (-(a21 * s5) + (a22 * s4) -
+					  (a23 * s3)) * id;
+			i[(4 * n) + k] = (-(a10 * c5) + (a12 * c2) -
+					  (a13 * c1)) * id;
+			i[(5 * n) + k] = (((a00 * c5) - (a02 * c2) +
+					   (a03 * c1)) * id) + e;
+			i[(6 * n) + k] = (-(a30 * s5) + (a32 * s2) -
+					  (a33 * s1)) * id;
+			i[(7 * n) + k] = ((a20 * s5) - (a22 * s2) +
+					  (a23 * s1)) * id;
+			i[(8 * n) + k] = ((a10 * c4) - (a11 * c2) +
+					  (a13 * c0)) * id;
+			i[(9 * n) + k] = (-(a00 * c4) + (a01 * c2) -
+					  (a03 * c0)) * id;
+			i[(10 * n) + k] = (((a30 * s4) - (a31 * s2) +
+					    (a33 * s0)) * id) + e;
+			i[(11 * n) + k] = (-(a20 * s4) + (a21 * s2) -
+					   (a23 * s0)) * id;
+			i[(12 * n) + k] = (-(a10 * c3) + (a11 * c1) -
+					   (a12 * c0)) * id;
+			i[(13 * n) + k] = ((a00 * c3) - (a01 * c1) +
+					   (a02 * c0)) * id;
+			i[(14 * n) + k] = (-(a30 * s3) + (a31 * s1) -
+					   (a32 * s0)) * id;
+			i[(15 * n) + k] = (((a20 * s3) - (a21 * s1) +
+					    (a22 * s0)) * id) + e;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_batch_deter(struct zsl_mtx_batch *ba, zsl_real_t *d)
+{
+	return zsl_mtx_batch_inv_deter(ba, d, NULL);
+}
+
+int
+zsl_mtx_batch_inv(struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bi)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ba->sz_rows != bi->sz_rows) || (ba->sz_cols != bi->sz_cols) ||
+	    (ba->count != bi->count)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_mtx_batch_inv_deter(ba, NULL, bi->data);
+}
@@ -0,0 +1,728 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/fixedpoint.h>
+
+/* Enable optimised ARM Thumb/Thumb2 functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 1 || CONFIG_ZSL_PLATFORM_OPT == 2)
+#include <zsl/asm/arm/asm_arm_fixedpoint.h>
+#endif
+
+/* Enable optimised x86-64 SIMD functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_fixedpoint.h>
+#endif
+
+/*
+ * Q31 products are accumulated as Q46 (the Q62 product shifted right by
+ * 16). The largest product, INT32_MIN * INT32_MIN, becomes 2^46, which
+ * leaves 17 guard bits in an int64_t: 2^16 full-scale terms sum to 2^62.
+ */
+#define ZSL_Q31_ACC_SHIFT (16)
+
+/* Rounds a Q30 sum of Q15 products to Q15, with saturation. */
+static inline zsl_q15_t
+zsl_q15_from_acc(int64_t acc)
+{
+	acc = (acc + (1 << 14)) >> 15;
+
+	return (zsl_q15_t)(acc > INT16_MAX ? INT16_MAX :
+			   (acc < INT16_MIN ? INT16_MIN : acc));
+}
+
+/* Rounds a Q46 sum of Q31 products to Q31, with saturation. */
+static inline zsl_q31_t
+zsl_q31_from_acc(int64_t acc)
+{
+	return zsl_q31_sat((acc + (1 << (30 - ZSL_Q31_ACC_SHIFT))) >>
+			   (31 - ZSL_Q31_ACC_SHIFT));
+}
+
+/* Rounds 'x' to the nearest integer, with ties rounded up. */
+static int64_t
+zsl_fxp_round(zsl_real_t x)
+{
+	zsl_real_t t = x + 0.5f;
+	int64_t r = (int64_t)t;
+
+	/* The cast truncates towards zero, so fix up negative values. */
+	if ((zsl_real_t)r > t) {
+		r--;
+	}
+
+	return r;
+}
+
+zsl_q15_t zsl_q15_from_real(zsl_real_t x)
+{
+	/* NaN. */
+	if (x != x) {
+		return 0;
+	}
+
+	if (x >= 1.0) {
+		return INT16_MAX;
+	}
+
+	if (x <= -1.0) {
+		return INT16_MIN;
+	}
+
+	/* |x| < 1.0, so the rounded value fits in an int32_t. */
+	return zsl_q15_sat((int32_t)zsl_fxp_round(x * 32768.0f));
+}
+
+zsl_real_t zsl_q15_to_real(zsl_q15_t q)
+{
+	return (zsl_real_t)q / 32768.0f;
+}
+
+zsl_q31_t zsl_q31_from_real(zsl_real_t x)
+{
+	/* NaN. */
+	if (x != x) {
+		return 0;
+	}
+
+	if (x >= 1.0) {
+		return INT32_MAX;
+	}
+
+	if (x <= -1.0) {
+		return INT32_MIN;
+	}
+
+	return zsl_q31_sat(zsl_fxp_round(x * 2147483648.0f));
+}
+
+zsl_real_t zsl_q31_to_real(zsl_q31_t q)
+{
+	return (zsl_real_t)q / 2147483648.0f;
+}
+
+/* ========================================================================== */
+/* Q15 vectors                                                                */
+/* ========================================================================== */
+
+int zsl_vec_q15_from_vec(struct zsl_vec_q15 *vq, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (vq->sz != v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		vq->data[i] = zsl_q15_from_real(v->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q15_to_vec(struct zsl_vec_q15 *vq, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (vq->sz != v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < vq->sz; i++) {
+		v->data[i] = zsl_q15_to_real(vq->data[i]);
+	}
+
+	return 0;
+}
+
+#if !asm_vec_q15_add
+int zsl_vec_q15_add(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q15_sat((int32_t)v->data[i] + w->data[i]);
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_vec_q15_sub
+int zsl_vec_q15_sub(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    struct zsl_vec_q15 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q15_sat((int32_t)v->data[i] - w->data[i]);
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_vec_q15_scalar_mult
+int zsl_vec_q15_scalar_mult(struct zsl_vec_q15 *v, zsl_q15_t s)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_q15_mult(v->data[i], s);
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_vec_q15_dot
+int zsl_vec_q15_dot(struct zsl_vec_q15 *v, struct zsl_vec_q15 *w,
+		    zsl_q15_t *d)
+{
+	int64_t acc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		acc += (int32_t)v->data[i] * w->data[i];
+	}
+
+	*d = zsl_q15_from_acc(acc);
+
+	return 0;
+}
+#endif
+
+/* ========================================================================== */
+/* Q31 vectors                                                                */
+/* ========================================================================== */
+
+int zsl_vec_q31_from_vec(struct zsl_vec_q31 *vq, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (vq->sz != v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		vq->data[i] = zsl_q31_from_real(v->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q31_to_vec(struct zsl_vec_q31 *vq, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (vq->sz != v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < vq->sz; i++) {
+		v->data[i] = zsl_q31_to_real(vq->data[i]);
+	}
+
+	return 0;
+}
+
+#if !asm_vec_q31_add
+int zsl_vec_q31_add(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q31_sat((int64_t)v->data[i] + w->data[i]);
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_vec_q31_sub
+int zsl_vec_q31_sub(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q31_sat((int64_t)v->data[i] - w->data[i]);
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_vec_q31_scalar_mult
+int zsl_vec_q31_scalar_mult(struct zsl_vec_q31 *v, zsl_q31_t s)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_q31_mult(v->data[i], s);
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_vec_q31_dot
+int zsl_vec_q31_dot(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    zsl_q31_t *d)
+{
+	int64_t acc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		acc += ((int64_t)v->data[i] * w->data[i]) >> ZSL_Q31_ACC_SHIFT;
+	}
+
+	*d = zsl_q31_from_acc(acc);
+
+	return 0;
+}
+#endif
+
+/* ========================================================================== */
+/* Q15 matrices                                                               */
+/* ========================================================================== */
+
+int zsl_mtx_q15_from_mtx(struct zsl_mtx_q15 *mq, struct zsl_mtx *m)
+{
+	size_t rs = ZSL_MTX_ROW_STEP(m);
+	size_t cs = ZSL_MTX_COL_STEP(m);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mq->sz_rows != m->sz_rows) || (mq->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			mq->data[i * mq->sz_cols + j] =
+				zsl_q15_from_real(m->data[i * rs + j * cs]);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q15_to_mtx(struct zsl_mtx_q15 *mq, struct zsl_mtx *m)
+{
+	size_t rs = ZSL_MTX_ROW_STEP(m);
+	size_t cs = ZSL_MTX_COL_STEP(m);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mq->sz_rows != m->sz_rows) || (mq->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			m->data[i * rs + j * cs] =
+				zsl_q15_to_real(mq->data[i * mq->sz_cols + j]);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q15_add(struct zsl_mtx_q15 *ma, struct zsl_mtx_q15 *mb,
+		    struct zsl_mtx_q15 *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+	struct zsl_vec_q15 va = { .sz = n, .data = ma->data };
+	struct zsl_vec_q15 vb = { .sz = n, .data = mb->data };
+	struct zsl_vec_q15 vc = { .sz = n, .data = mc->data };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The data is contiguous, so use the (possibly optimised) vector op. */
+	return zsl_vec_q15_add(&va, &vb, &vc);
+}
+
+int zsl_mtx_q15_sub(struct zsl_mtx_q15 *ma, struct zsl_mtx_q15 *mb,
+		    struct zsl_mtx_q15 *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+	struct zsl_vec_q15 va = { .sz = n, .data = ma->data };
+	struct zsl_vec_q15 vb = { .sz = n, .data = mb->data };
+	struct zsl_vec_q15 vc = { .sz = n, .data = mc->data };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_vec_q15_sub(&va, &vb, &vc);
+}
+
+int zsl_mtx_q15_mult(struct zsl_mtx_q15 *ma, struct zsl_mtx_q15 *mb,
+		     struct zsl_mtx_q15 *mc)
+{
+	int64_t acc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_cols != mb->sz_rows) || (mc->sz_rows != ma->sz_rows) ||
+	    (mc->sz_cols != mb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		for (size_t j = 0; j < mb->sz_cols; j++) {
+			acc = 0;
+			for (size_t k = 0; k < ma->sz_cols; k++) {
+				acc += (int32_t)ma->data[i * ma->sz_cols + k] *
+				       mb->data[k * mb->sz_cols + j];
+			}
+			mc->data[i * mc->sz_cols + j] = zsl_q15_from_acc(acc);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q15_mult_vec(struct zsl_mtx_q15 *m, struct zsl_vec_q15 *v,
+			 struct zsl_vec_q15 *w)
+{
+	struct zsl_vec_q15 row = { .sz = m->sz_cols };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_cols != v->sz) || (m->sz_rows != w->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Each output element is the (possibly optimised) dot of one row. */
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		row.data = &m->data[i * m->sz_cols];
+		zsl_vec_q15_dot(&row, v, &w->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q15_inv_3x3(struct zsl_mtx_q15 *m, struct zsl_mtx_q15 *mi,
+			int *shift)
+{
+	int rc;
+	zsl_q31_t d[9];
+	struct zsl_mtx_q31 mq = { .sz_rows = 3, .sz_cols = 3, .data = d };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_rows != 3) || (m->sz_cols != 3) ||
+	    (mi->sz_rows != 3) || (mi->sz_cols != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Q15 to Q31 is exact. */
+	for (size_t i = 0; i < 9; i++) {
+		d[i] = (zsl_q31_t)m->data[i] * 65536;
+	}
+
+	rc = zsl_mtx_q31_inv_3x3(&mq, &mq, shift);
+	if (rc) {
+		return rc;
+	}
+
+	/*
+	 * The largest Q31 element is in [0.5, 1.0), but it can still round up
+	 * to 1.0 in Q15, in which case everything is scaled down by one more
+	 * bit. Negative values can't overflow.
+	 */
+	for (size_t i = 0; i < 9; i++) {
+		if (d[i] >= INT32_MAX - (1 << 15)) {
+			for (size_t j = 0; j < 9; j++) {
+				d[j] /= 2;
+			}
+			(*shift)++;
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < 9; i++) {
+		mi->data[i] = zsl_q15_sat((int32_t)(((int64_t)d[i] +
+						     (1 << 15)) >> 16));
+	}
+
+	return 0;
+}
+
+/* ========================================================================== */
+/* Q31 matrices                                                               */
+/* ========================================================================== */
+
+int zsl_mtx_q31_from_mtx(struct zsl_mtx_q31 *mq, struct zsl_mtx *m)
+{
+	size_t rs = ZSL_MTX_ROW_STEP(m);
+	size_t cs = ZSL_MTX_COL_STEP(m);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mq->sz_rows != m->sz_rows) || (mq->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			mq->data[i * mq->sz_cols + j] =
+				zsl_q31_from_real(m->data[i * rs + j * cs]);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q31_to_mtx(struct zsl_mtx_q31 *mq, struct zsl_mtx *m)
+{
+	size_t rs = ZSL_MTX_ROW_STEP(m);
+	size_t cs = ZSL_MTX_COL_STEP(m);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mq->sz_rows != m->sz_rows) || (mq->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			m->data[i * rs + j * cs] =
+				zsl_q31_to_real(mq->data[i * mq->sz_cols + j]);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q31_add(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		    struct zsl_mtx_q31 *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+	struct zsl_vec_q31 va = { .sz = n, .data = ma->data };
+	struct zsl_vec_q31 vb = { .sz = n, .data = mb->data };
+	struct zsl_vec_q31 vc = { .sz = n, .data = mc->data };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_vec_q31_add(&va, &vb, &vc);
+}
+
+int zsl_mtx_q31_sub(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		    struct zsl_mtx_q31 *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+	struct zsl_vec_q31 va = { .sz = n, .data = ma->data };
+	struct zsl_vec_q31 vb = { .sz = n, .data = mb->data };
+	struct zsl_vec_q31 vc = { .sz = n, .data = mc->data };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_vec_q31_sub(&va, &vb, &vc);
+}
+
+int zsl_mtx_q31_mult(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		     struct zsl_mtx_q31 *mc)
+{
+	int64_t acc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_cols != mb->sz_rows) || (mc->sz_rows != ma->sz_rows) ||
+	    (mc->sz_cols != mb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		for (size_t j = 0; j < mb->sz_cols; j++) {
+			acc = 0;
+			for (size_t k = 0; k < ma->sz_cols; k++) {
+				acc += ((int64_t)ma->data[i * ma->sz_cols + k] *
+					mb->data[k * mb->sz_cols + j]) >>
+				       ZSL_Q31_ACC_SHIFT;
+			}
+			mc->data[i * mc->sz_cols + j] = zsl_q31_from_acc(acc);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_q31_mult_vec(struct zsl_mtx_q31 *m, struct zsl_vec_q31 *v,
+			 struct zsl_vec_q31 *w)
+{
+	struct zsl_vec_q31 row = { .sz = m->sz_cols };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_cols != v->sz) || (m->sz_rows != w->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		row.data = &m->data[i * m->sz_cols];
+		zsl_vec_q31_dot(&row, v, &w->data[i]);
+	}
+
+	return 0;
+}
+
+/*
+ * Returns the Q29 value of 'a * b - c * d' for Q31 inputs. The Q62 products
+ * are halved first so that the difference can't overflow.
+ */
+static inline int32_t
+zsl_q31_cof(zsl_q31_t a, zsl_q31_t b, zsl_q31_t c, zsl_q31_t d)
+{
+	int64_t x = (((int64_t)a * b) >> 1) - (((int64_t)c * d) >> 1);
+
+	return (int32_t)((x + ((int64_t)1 << 31)) >> 32);
+}
+
+int zsl_mtx_q31_inv_3x3(struct zsl_mtx_q31 *m, struct zsl_mtx_q31 *mi,
+			int *shift)
+{
+	zsl_q31_t *a = m->data;
+	int32_t cof[9];
+	int64_t det;
+	uint64_t dn;
+	uint64_t cmax = 0;
+	uint64_t n;
+	uint64_t q;
+	int e = 0;
+	int c = 0;
+	int k;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_rows != 3) || (m->sz_cols != 3) ||
+	    (mi->sz_rows != 3) || (mi->sz_cols != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Transposed cofactors (the adjugate), in Q29. */
+	cof[0] = zsl_q31_cof(a[4], a[8], a[5], a[7]);
+	cof[1] = zsl_q31_cof(a[2], a[7], a[1], a[8]);
+	cof[2] = zsl_q31_cof(a[1], a[5], a[2], a[4]);
+	cof[3] = zsl_q31_cof(a[5], a[6], a[3], a[8]);
+	cof[4] = zsl_q31_cof(a[0], a[8], a[2], a[6]);
+	cof[5] = zsl_q31_cof(a[2], a[3], a[0], a[5]);
+	cof[6] = zsl_q31_cof(a[3], a[7], a[4], a[6]);
+	cof[7] = zsl_q31_cof(a[1], a[6], a[0], a[7]);
+	cof[8] = zsl_q31_cof(a[0], a[4], a[1], a[3]);
+
+	/* Q60 determinant, expanded along the first row. */
+	det = (int64_t)a[0] * cof[0] + (int64_t)a[1] * cof[3] +
+	      (int64_t)a[2] * cof[6];
+	if (det == 0) {
+		return -ESINGULAR;
+	}
+
+	/* Work with a positive determinant, and flip the adjugate instead. */
+	if (det < 0) {
+		det = -det;
+		for (size_t i = 0; i < 9; i++) {
+			cof[i] = -cof[i];
+		}
+	}
+
+	/* Normalise the determinant to dn * 2^e, with dn in [2^30, 2^31). */
+	dn = (uint64_t)det;
+	while (dn >= ((uint64_t)1 << 31)) {
+		dn >>= 1;
+		e++;
+	}
+	while (dn < ((uint64_t)1 << 30)) {
+		dn <<= 1;
+		e--;
+	}
+	if (e > 0) {
+		/* Recompute with rounding rather than truncation. */
+		dn = ((uint64_t)det + ((uint64_t)1 << (e - 1))) >> e;
+	}
+
+	for (size_t i = 0; i < 9; i++) {
+		n = cof[i] < 0 ? -(int64_t)cof[i] : cof[i];
+		if (n > cmax) {
+			cmax = n;
+		}
+	}
+
+	/* Normalise the largest cofactor to [2^30, 2^31) too. */
+	while ((cmax << c) < ((uint64_t)1 << 30)) {
+		c++;
+	}
+
+	/*
+	 * The largest output, cmax * 2^k / dn, is in [2^(k-c-1), 2^(k-c+1)), so
+	 * k = c + 31 gives the most precision, unless it overflows Q31.
+	 */
+	k = c + 31;
+	if ((((cmax << k) + dn / 2) / dn) > INT32_MAX) {
+		k--;
+	}
+
+	/*
+	 * inv(m) = cof / det = (cof * 2^-29) / (dn * 2^(e-60)), and each output
+	 * element is cof * 2^k / dn, which is that times 2^(31 - shift).
+	 */
+	for (size_t i = 0; i < 9; i++) {
+		n = cof[i] < 0 ? -(int64_t)cof[i] : cof[i];
+		q = ((n << k) + dn / 2) / dn;
+		/* The choice of 'k' keeps 'q' within INT32_MAX. */
+		mi->data[i] = cof[i] < 0 ? -(zsl_q31_t)q : (zsl_q31_t)q;
+	}
+
+	*shift = 62 - k - e;
+
+	return 0;
+}
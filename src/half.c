@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/half.h>
+
+/* Enable optimised x86-64 SIMD functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_half.h>
+#endif
+
+/* Rounds the single-precision value with bits 'f' to fp16. */
+static zsl_half_t
+zsl_half_fp16_from_bits(uint32_t f)
+{
+	uint32_t sign = (f >> 16) & 0x8000;
+	uint32_t exp = (f >> 23) & 0xFF;
+	uint32_t man = f & 0x7FFFFF;
+	int32_t e = (int32_t)exp - 127 + 15;
+	uint32_t h;
+	uint32_t rem;
+	uint32_t half;
+	uint32_t shift;
+
+	/* Infinity, or NaN, which must keep a non-zero fraction. */
+	if (exp == 0xFF) {
+		return (zsl_half_t)(sign | 0x7C00 |
+				    (man ? 0x200 | (man >> 13) : 0));
+	}
+
+	/* Too large: round to infinity. */
+	if (e >= 31) {
+		return (zsl_half_t)(sign | 0x7C00);
+	}
+
+	/* Subnormal fp16 (or zero), below half of the smallest subnormal. */
+	if (e <= 0) {
+		if (e < -10) {
+			return (zsl_half_t)sign;
+		}
+		man |= 0x800000;
+		shift = 14 - e;
+		h = man >> shift;
+		rem = man & ((1u << shift) - 1);
+		half = 1u << (shift - 1);
+		if ((rem > half) || ((rem == half) && (h & 1))) {
+			/* May carry into the smallest normal, which is fine. */
+			h++;
+		}
+		return (zsl_half_t)(sign | h);
+	}
+
+	/* Normal. A carry out of the fraction correctly bumps the exponent. */
+	h = sign | ((uint32_t)e << 10) | (man >> 13);
+	rem = man & 0x1FFF;
+	if ((rem > 0x1000) || ((rem == 0x1000) && (h & 1))) {
+		h++;
+	}
+
+	return (zsl_half_t)h;
+}
+
+/* Returns the single-precision bits of the fp16 value 'h'. */
+static uint32_t
+zsl_half_fp16_to_bits(zsl_half_t h)
+{
+	uint32_t sign = ((uint32_t)h & 0x8000) << 16;
+	uint32_t exp = (h >> 10) & 0x1F;
+	uint32_t man = h & 0x3FF;
+	int32_t e = -14;
+
+	if (exp == 0x1F) {
+		return sign | 0x7F800000 | (man << 13);
+	}
+
+	if (exp != 0) {
+		return sign | ((exp + 127 - 15) << 23) | (man << 13);
+	}
+
+	if (man == 0) {
+		return sign;
+	}
+
+	/* Subnormal fp16, which is normal in single precision. */
+	while (!(man & 0x400)) {
+		man <<= 1;
+		e--;
+	}
+
+	return sign | ((uint32_t)(e + 127) << 23) | ((man & 0x3FF) << 13);
+}
+
+/* Rounds the single-precision value with bits 'f' to bf16. */
+static zsl_half_t
+zsl_half_bf16_from_bits(uint32_t f)
+{
+	/* Keep NaN as a quiet NaN rather than rounding it to infinity. */
+	if ((f & 0x7FFFFFFF) > 0x7F800000) {
+		return (zsl_half_t)((f >> 16) | 0x40);
+	}
+
+	return (zsl_half_t)((f + 0x7FFF + ((f >> 16) & 1)) >> 16);
+}
+
+zsl_half_t zsl_half_from_real(zsl_real_t x, enum zsl_half_fmt fmt)
+{
+	float xf = (float)x;
+	uint32_t f;
+
+	memcpy(&f, &xf, sizeof(f));
+
+	if (fmt == ZSL_HALF_BF16) {
+		return zsl_half_bf16_from_bits(f);
+	}
+
+	return zsl_half_fp16_from_bits(f);
+}
+
+zsl_real_t zsl_half_to_real(zsl_half_t h, enum zsl_half_fmt fmt)
+{
+	float xf;
+	uint32_t f;
+
+	if (fmt == ZSL_HALF_BF16) {
+		f = (uint32_t)h << 16;
+	} else {
+		f = zsl_half_fp16_to_bits(h);
+	}
+
+	memcpy(&xf, &f, sizeof(xf));
+
+	return xf;
+}
+
+#if !asm_half_pack
+int zsl_half_pack(const zsl_real_t *x, zsl_half_t *h, size_t n,
+		  enum zsl_half_fmt fmt)
+{
+	switch (fmt) {
+	case ZSL_HALF_FP16:
+		for (size_t i = 0; i < n; i++) {
+			h[i] = zsl_half_from_real(x[i], ZSL_HALF_FP16);
+		}
+		break;
+	case ZSL_HALF_BF16:
+		for (size_t i = 0; i < n; i++) {
+			h[i] = zsl_half_from_real(x[i], ZSL_HALF_BF16);
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
+#if !asm_half_unpack
+int zsl_half_unpack(const zsl_half_t *h, zsl_real_t *x, size_t n,
+		    enum zsl_half_fmt fmt)
+{
+	switch (fmt) {
+	case ZSL_HALF_FP16:
+		for (size_t i = 0; i < n; i++) {
+			x[i] = zsl_half_to_real(h[i], ZSL_HALF_FP16);
+		}
+		break;
+	case ZSL_HALF_BF16:
+		for (size_t i = 0; i < n; i++) {
+			x[i] = zsl_half_to_real(h[i], ZSL_HALF_BF16);
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
+int zsl_vec_half_pack(struct zsl_vec_half *vh, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (vh->sz != v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_half_pack(v->data, vh->data, v->sz, vh->fmt);
+}
+
+int zsl_vec_half_unpack(struct zsl_vec_half *vh, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (vh->sz != v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_half_unpack(vh->data, v->data, vh->sz, vh->fmt);
+}
+
+int zsl_vec_half_dot(struct zsl_vec_half *v, struct zsl_vec_half *w,
+		     zsl_real_t *d)
+{
+	zsl_real_t a[ZSL_HALF_BLOCK];
+	zsl_real_t b[ZSL_HALF_BLOCK];
+	zsl_real_t res = 0.0;
+	size_t n;
+	int rc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i += ZSL_HALF_BLOCK) {
+		n = v->sz - i < ZSL_HALF_BLOCK ? v->sz - i : ZSL_HALF_BLOCK;
+		rc = zsl_half_unpack(&v->data[i], a, n, v->fmt);
+		if (rc) {
+			return rc;
+		}
+		rc = zsl_half_unpack(&w->data[i], b, n, w->fmt);
+		if (rc) {
+			return rc;
+		}
+		for (size_t k = 0; k < n; k++) {
+			res += a[k] * b[k];
+		}
+	}
+
+	*d = res;
+
+	return 0;
+}
+
+int zsl_mtx_half_pack(struct zsl_mtx_half *mh, struct zsl_mtx *m)
+{
+	zsl_real_t x[ZSL_HALF_BLOCK];
+	size_t cs = ZSL_MTX_COL_STEP(m);
+	size_t n;
+	int rc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mh->sz_rows != m->sz_rows) || (mh->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Contiguous matrices are packed in a single call. */
+	if (ZSL_MTX_IS_CONTIG(m)) {
+		return zsl_half_pack(m->data, mh->data,
+				     m->sz_rows * m->sz_cols, mh->fmt);
+	}
+
+	/* Views are gathered into a block buffer, one row at a time. */
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		zsl_real_t *row = &m->data[i * ZSL_MTX_ROW_STEP(m)];
+
+		for (size_t j = 0; j < m->sz_cols; j += ZSL_HALF_BLOCK) {
+			n = m->sz_cols - j < ZSL_HALF_BLOCK ?
+			    m->sz_cols - j : ZSL_HALF_BLOCK;
+			for (size_t k = 0; k < n; k++) {
+				x[k] = row[(j + k) * cs];
+			}
+			rc = zsl_half_pack(x, &mh->data[i * mh->sz_cols + j],
+					   n, mh->fmt);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_half_unpack(struct zsl_mtx_half *mh, struct zsl_mtx *m)
+{
+	zsl_real_t x[ZSL_HALF_BLOCK];
+	size_t cs = ZSL_MTX_COL_STEP(m);
+	size_t n;
+	int rc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mh->sz_rows != m->sz_rows) || (mh->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (ZSL_MTX_IS_CONTIG(m)) {
+		return zsl_half_unpack(mh->data, m->data,
+				       m->sz_rows * m->sz_cols, mh->fmt);
+	}
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		zsl_real_t *row = &m->data[i * ZSL_MTX_ROW_STEP(m)];
+
+		for (size_t j = 0; j < m->sz_cols; j += ZSL_HALF_BLOCK) {
+			n = m->sz_cols - j < ZSL_HALF_BLOCK ?
+			    m->sz_cols - j : ZSL_HALF_BLOCK;
+			rc = zsl_half_unpack(&mh->data[i * mh->sz_cols + j], x,
+					     n, mh->fmt);
+			if (rc) {
+				return rc;
+			}
+			for (size_t k = 0; k < n; k++) {
+				row[(j + k) * cs] = x[k];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int zsl_mtx_half_mult_vec(struct zsl_mtx_half *m, struct zsl_vec *v,
+			  struct zsl_vec *w)
+{
+	zsl_real_t a[ZSL_HALF_BLOCK];
+	zsl_real_t res;
+	size_t n;
+	int rc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_cols != v->sz) || (m->sz_rows != w->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		const zsl_half_t *row = &m->data[i * m->sz_cols];
+
+		res = 0.0;
+		for (size_t j = 0; j < m->sz_cols; j += ZSL_HALF_BLOCK) {
+			n = m->sz_cols - j < ZSL_HALF_BLOCK ?
+			    m->sz_cols - j : ZSL_HALF_BLOCK;
+			rc = zsl_half_unpack(&row[j], a, n, m->fmt);
+			if (rc) {
+				return rc;
+			}
+			for (size_t k = 0; k < n; k++) {
+				res += a[k] * v->data[j + k];
+			}
+		}
+		w->data[i] = res;
+	}
+
+	return 0;
+}
+
+int zsl_mtx_half_mult(struct zsl_mtx_half *ma, struct zsl_mtx_half *mb,
+		      struct zsl_mtx *mc)
+{
+	zsl_real_t a[ZSL_HALF_BLOCK];
+	zsl_real_t b[ZSL_HALF_BLOCK];
+	size_t rs = ZSL_MTX_ROW_STEP(mc);
+	size_t cs = ZSL_MTX_COL_STEP(mc);
+	size_t kn;
+	size_t jn;
+	int rc;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_cols != mb->sz_rows) || (mc->sz_rows != ma->sz_rows) ||
+	    (mc->sz_cols != mb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/*
+	 * Row i of 'mc' is built up as the sum of the rows of 'mb', weighted
+	 * by row i of 'ma', so that both inputs are read contiguously.
+	 */
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		zsl_real_t *c = &mc->data[i * rs];
+
+		for (size_t j = 0; j < mb->sz_cols; j++) {
+			c[j * cs] = 0.0;
+		}
+
+		for (size_t k0 = 0; k0 < ma->sz_cols; k0 += ZSL_HALF_BLOCK) {
+			kn = ma->sz_cols - k0 < ZSL_HALF_BLOCK ?
+			     ma->sz_cols - k0 : ZSL_HALF_BLOCK;
+			rc = zsl_half_unpack(&ma->data[i * ma->sz_cols + k0], a,
+					     kn, ma->fmt);
+			if (rc) {
+				return rc;
+			}
+
+			for (size_t k = 0; k < kn; k++) {
+				const zsl_half_t *brow =
+					&mb->data[(k0 + k) * mb->sz_cols];
+
+				for (size_t j0 = 0; j0 < mb->sz_cols;
+				     j0 += ZSL_HALF_BLOCK) {
+					jn = mb->sz_cols - j0 < ZSL_HALF_BLOCK ?
+					     mb->sz_cols - j0 : ZSL_HALF_BLOCK;
+					rc = zsl_half_unpack(&brow[j0], b, jn,
+							     mb->fmt);
+					if (rc) {
+						return rc;
+					}
+					for (size_t j = 0; j < jn; j++) {
+						c[(j0 + j) * cs] += a[k] * b[j];
+					}
+				}
+			}
+		}
+	}
+
+	return 0;
+}
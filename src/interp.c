@@ -6,8 +6,10 @@
 
 #include <math.h>
 #include <errno.h>
-#include <kernel.h>
 #include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/workspace.h>
 #include <zsl/interp.h>
 
 int
@@ -252,72 +254,97 @@ err:
 
 int
 zsl_interp_cubic_calc(struct zsl_interp_xyc xyc[], size_t n, zsl_real_t yp1,
-		  zsl_real_t ypn)
+		      zsl_real_t ypn)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_interp_cubic_calc_ws_size(n));
+
+	return zsl_interp_cubic_calc_ws(xyc, n, yp1, ypn, &ws);
+}
+
+int
+zsl_interp_cubic_calc_ws(struct zsl_interp_xyc xyc[], size_t n,
+			 zsl_real_t yp1, zsl_real_t ypn,
+			 struct zsl_workspace *ws)
 {
 	int rc;
-	int i;
-	int k;
-	zsl_real_t sigma;
-	zsl_real_t p;
-	zsl_real_t qn;
-	zsl_real_t un;
-	zsl_real_t *u;
+	size_t mark;
+	zsl_real_t h;
+	zsl_real_t hp;
+	struct zsl_vec a, b, c, d;
 
 	/* Make sure we have at least three values. */
 	if (n < 3) {
-		rc = -EINVAL;
-		goto err;
+		return -EINVAL;
 	}
 
-	u = (zsl_real_t *)k_malloc((n - 1) * sizeof(zsl_real_t));
-	if (u == NULL) {
+	mark = zsl_ws_mark(ws);
+	if (zsl_ws_vec(ws, &a, n - 1) || zsl_ws_vec(ws, &b, n) ||
+	    zsl_ws_vec(ws, &c, n - 1) || zsl_ws_vec(ws, &d, n)) {
 		rc = -ENOMEM;
 		goto err;
 	}
 
-	/* TODO: Remove 'f' restrictions? */
+	/* Build the tridiagonal system for the second derivatives, where
+	 * row i for 0 < i < n - 1 is:
+	 * h[i-1] * y2[i-1] + 2 * (h[i-1] + h[i]) * y2[i] + h[i] * y2[i+1] =
+	 *   6 * ((y[i+1] - y[i]) / h[i] - (y[i] - y[i-1]) / h[i-1]). */
+	h = xyc[1].x - xyc[0].x;
 	if (yp1 > 0.99e30f) {
-		xyc[0].y2 = u[0] = 0.0f;
+		/* Natural spline: y2[0] = 0. */
+		b.data[0] = 1.0;
+		c.data[0] = 0.0;
+		d.data[0] = 0.0;
 	} else {
-		xyc[0].y2 = -0.5f;
-		u[0] = (3.0f / (xyc[1].x - xyc[0].x)) *
-		       ((xyc[1].y - xyc[0].y) / (xyc[1].x - xyc[0].x) - yp1);
+		b.data[0] = 2.0f * h;
+		c.data[0] = h;
+		d.data[0] = 6.0f * ((xyc[1].y - xyc[0].y) / h - yp1);
 	}
 
-	for (i = 1; i < n - 1; i++) {
-		/* Break out common values. */
-		zsl_real_t x_i_im1 = xyc[i].x - xyc[i - 1].x;
-		zsl_real_t x_ip1_im1 = xyc[i + 1].x - xyc[i - 1].x;
-		sigma = x_i_im1 / x_ip1_im1;
-		p = sigma * xyc[i - 1].y2 + 2.0f;
-		xyc[i].y2 = (sigma - 1.0f) / p;
-		u[i] = (xyc[i + 1].y - xyc[i].y) / (xyc[i + 1].x - xyc[i].x) -
-		       (xyc[i].y - xyc[i - 1].y) / (x_i_im1);
-		u[i] = (6.0f * u[i] / (x_ip1_im1) - sigma * u[i - 1]) / p;
+	for (size_t i = 1; i < n - 1; i++) {
+		hp = h;
+		h = xyc[i + 1].x - xyc[i].x;
+		a.data[i - 1] = hp;
+		b.data[i] = 2.0f * (hp + h);
+		c.data[i] = h;
+		d.data[i] = 6.0f * ((xyc[i + 1].y - xyc[i].y) / h -
+				   (xyc[i].y - xyc[i - 1].y) / hp);
 	}
 
 	if (ypn > 0.99e30f) {
-		qn = un = 0.0f;
+		a.data[n - 2] = 0.0;
+		b.data[n - 1] = 1.0;
+		d.data[n - 1] = 0.0;
 	} else {
-		qn = 0.5f;
-		un = (3.0f / (xyc[n - 1].x - xyc[n - 2].x)) *
-		     (ypn - (xyc[n - 1].y -
-			     xyc[n - 2].y) / (xyc[n - 1].x - xyc[n - 2].x));
+		a.data[n - 2] = h;
+		b.data[n - 1] = 2.0f * h;
+		d.data[n - 1] = 6.0f * (ypn - (xyc[n - 1].y - xyc[n - 2].y) / h);
 	}
 
-	xyc[n - 1].y2 = (un - qn * u[n - 2]) / (qn * xyc[n - 2].y2 + 1.0f);
-
-	for (k = n - 2; k >= 0; k--) {
-		xyc[k].y2 = xyc[k].y2 * xyc[k + 1].y2 + u[k];
+	rc = zsl_mtx_tridiag_solve_ws(&a, &b, &c, &d, &d, ws);
+	if (rc) {
+		goto err;
 	}
 
-	k_free(u);
+	for (size_t i = 0; i < n; i++) {
+		xyc[i].y2 = d.data[i];
+	}
 
-	return 0;
 err:
+	zsl_ws_release(ws, mark);
 	return rc;
 }
 
+size_t
+zsl_interp_cubic_calc_ws_size(size_t n)
+{
+	if (n < 3) {
+		return 0;
+	}
+
+	return 2 * ZSL_WS_REALS(n - 1) + 2 * ZSL_WS_REALS(n) +
+	       zsl_mtx_tridiag_solve_ws_size(n);
+}
+
 int
 zsl_interp_cubic_arr(struct zsl_interp_xyc xyc[], size_t n,
 		 zsl_real_t x, zsl_real_t *y)
@@ -5,11 +5,19 @@
  */
 
 #include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
 #include <zsl/zsl.h>
 #include <zsl/matrices.h>
+#include <zsl/threads.h>
+#include <zsl/workspace.h>
+
+/* Enable optimised x86-64 SIMD functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_matrices.h>
+#endif
 
 /*
  * WARNING: Work in progress!
@@ -27,18 +35,25 @@
 
 // TODO: Introduce local macros for bounds/shape checks to avoid duplication!
 
-/* To avoid declaring multiple matrices on the stack, two chunks of
- * statically declared memory are made available here for reuse in
+/* To avoid declaring the working matrix on the stack, a chunk of
+ * statically declared memory is made available here for reuse in
  * zsl_mtx_qrd_iter. */
 #if CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH
 static zsl_real_t scrd_1[CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE];
-static zsl_real_t scrd_2[CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE];
 #define ZSL_QRD_SCRATCH_1_CLEAR (memset(scrd_1, 0,			     \
 					CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE * \
 					sizeof(zsl_real_t)))
-#define ZSL_QRD_SCRATCH_2_CLEAR (memset(scrd_2, 0,			     \
-					CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE * \
-					sizeof(zsl_real_t)))
+#endif
+
+/*
+ * Magnitude below which the Gaussian reduction, eigenvector and symmetry
+ * checks treat a value as zero. Single-precision results carry roughly
+ * eight times fewer digits, so the threshold is raised to match.
+ */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_MTX_ZERO_TOL ((zsl_real_t)1E-4)
+#else
+#define ZSL_MTX_ZERO_TOL (1E-6)
 #endif
 
 int
@@ -86,7 +101,25 @@ zsl_mtx_init(struct zsl_mtx *m, zsl_mtx_init_entry_fn_t entry_fn)
 int
 zsl_mtx_from_arr(struct zsl_mtx *m, zsl_real_t *a)
 {
-	memcpy(m->data, a, (m->sz_rows * m->sz_cols) * sizeof(zsl_real_t));
+	if (ZSL_MTX_IS_CONTIG(m)) {
+		memcpy(m->data, a, (m->sz_rows * m->sz_cols) *
+		       sizeof(zsl_real_t));
+		return 0;
+	}
+
+	if (m->trans) {
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			for (size_t j = 0; j < m->sz_cols; j++) {
+				ZSL_MTX_AT(m, i, j) = a[(i * m->sz_cols) + j];
+			}
+		}
+		return 0;
+	}
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		memcpy(&m->data[i * m->stride], &a[i * m->sz_cols],
+		       m->sz_cols * sizeof(zsl_real_t));
+	}
 
 	return 0;
 }
@@ -103,8 +136,28 @@ zsl_mtx_copy(struct zsl_mtx *mdest, struct zsl_mtx *msrc)
 #endif
 
 	/* Make a copy of matrix 'msrc'. */
-	memcpy(mdest->data, msrc->data, sizeof(zsl_real_t) *
-	       msrc->sz_rows * msrc->sz_cols);
+	if (ZSL_MTX_IS_CONTIG(mdest) && ZSL_MTX_IS_CONTIG(msrc)) {
+		memcpy(mdest->data, msrc->data, sizeof(zsl_real_t) *
+		       msrc->sz_rows * msrc->sz_cols);
+		return 0;
+	}
+
+	/* Views with different layouts are copied element by element. */
+	if (mdest->trans != msrc->trans) {
+		for (size_t i = 0; i < msrc->sz_rows; i++) {
+			for (size_t j = 0; j < msrc->sz_cols; j++) {
+				ZSL_MTX_AT(mdest, i, j) = ZSL_MTX_AT(msrc, i, j);
+			}
+		}
+		return 0;
+	}
+
+	/* Other views are copied row by row, in storage order. */
+	for (size_t i = 0; i < ZSL_MTX_STORE_ROWS(msrc); i++) {
+		memmove(&mdest->data[i * ZSL_MTX_STRIDE(mdest)],
+			&msrc->data[i * ZSL_MTX_STRIDE(msrc)],
+			ZSL_MTX_STORE_COLS(msrc) * sizeof(zsl_real_t));
+	}
 
 	return 0;
 }
@@ -118,7 +171,7 @@ zsl_mtx_get(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t *x)
 	}
 #endif
 
-	*x = m->data[(i * m->sz_cols) + j];
+	*x = ZSL_MTX_AT(m, i, j);
 
 	return 0;
 }
@@ -132,7 +185,7 @@ zsl_mtx_set(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t x)
 	}
 #endif
 
-	m->data[(i * m->sz_cols) + j] = x;
+	ZSL_MTX_AT(m, i, j) = x;
 
 	return 0;
 }
@@ -202,70 +255,120 @@ zsl_mtx_set_col(struct zsl_mtx *m, size_t j, zsl_real_t *v)
 }
 
 int
-zsl_mtx_unary_op(struct zsl_mtx *m, zsl_mtx_unary_op_t op)
+zsl_mtx_view(struct zsl_mtx *m, struct zsl_mtx *mv, size_t i, size_t j,
+	     size_t rows, size_t cols)
 {
-	/* Execute the unary operation component by component. */
-	for (size_t i = 0; i < m->sz_cols * m->sz_rows; i++) {
+	if ((i + rows > m->sz_rows) || (j + cols > m->sz_cols)) {
+		return -EINVAL;
+	}
+
+	mv->sz_rows = rows;
+	mv->sz_cols = cols;
+	mv->data = &ZSL_MTX_AT(m, i, j);
+	mv->stride = ZSL_MTX_STRIDE(m);
+	mv->trans = m->trans;
+
+	return 0;
+}
+
+/*
+ * Gets the number of rows and the row length used to walk the elements of
+ * 'm' with the pointer returned by ZSL_MTX_ROW. Contiguous matrices are
+ * walked as a single row of 'sz_rows * sz_cols' elements, and transposed
+ * matrices in their storage order.
+ */
+static void
+zsl_mtx_walk(struct zsl_mtx *m, bool contig, size_t *rows, size_t *len)
+{
+	*rows = contig ? 1 : ZSL_MTX_STORE_ROWS(m);
+	*len = contig ? m->sz_rows * m->sz_cols : ZSL_MTX_STORE_COLS(m);
+}
+
+/* Pointer to the first element of row 'i' of the storage of matrix 'm'. */
+#define ZSL_MTX_ROW(m, i) (&(m)->data[(i) * ZSL_MTX_STRIDE(m)])
+
+/*
+ * A unary or binary operation split across the thread pool. A matrix walked
+ * as a single row is split by elements, and any other matrix by rows.
+ */
+struct zsl_mtx_op_job {
+	struct zsl_mtx *ma;
+	struct zsl_mtx *mb;
+	struct zsl_mtx *mc;
+	int op;
+	bool mixed;
+	size_t rows;
+	size_t len;
+	size_t sa;
+	size_t sb;
+	size_t sc;
+};
+
+/* Applies unary operation 'op' to the 'len' elements starting at 'x'. */
+static int
+zsl_mtx_unary_op_kern(zsl_real_t *x, size_t len, zsl_mtx_unary_op_t op)
+{
+	for (size_t i = 0; i < len; i++) {
 		switch (op) {
 		case ZSL_MTX_UNARY_OP_INCREMENT:
-			m->data[i] += 1.0;
+			x[i] += 1.0f;
 			break;
 		case ZSL_MTX_UNARY_OP_DECREMENT:
-			m->data[i] -= 1.0;
+			x[i] -= 1.0f;
 			break;
 		case ZSL_MTX_UNARY_OP_NEGATIVE:
-			m->data[i] = -m->data[i];
+			x[i] = -x[i];
 			break;
 		case ZSL_MTX_UNARY_OP_ROUND:
-			m->data[i] = ZSL_ROUND(m->data[i]);
+			x[i] = ZSL_ROUND(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_ABS:
-			m->data[i] = ZSL_ABS(m->data[i]);
+			x[i] = ZSL_ABS(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_FLOOR:
-			m->data[i] = ZSL_FLOOR(m->data[i]);
+			x[i] = ZSL_FLOOR(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_CEIL:
-			m->data[i] = ZSL_CEIL(m->data[i]);
+			x[i] = ZSL_CEIL(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_EXP:
-			m->data[i] = ZSL_EXP(m->data[i]);
+			x[i] = ZSL_EXP(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_LOG:
-			m->data[i] = ZSL_LOG(m->data[i]);
+			x[i] = ZSL_LOG(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_LOG10:
-			m->data[i] = ZSL_LOG10(m->data[i]);
+			x[i] = ZSL_LOG10(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_SQRT:
-			m->data[i] = ZSL_SQRT(m->data[i]);
+			x[i] = ZSL_SQRT(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_SIN:
-			m->data[i] = ZSL_SIN(m->data[i]);
+			x[i] = ZSL_SIN(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_COS:
-			m->data[i] = ZSL_COS(m->data[i]);
+			x[i] = ZSL_COS(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_TAN:
-			m->data[i] = ZSL_TAN(m->data[i]);
+			x[i] = ZSL_TAN(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_ASIN:
-			m->data[i] = ZSL_ASIN(m->data[i]);
+			x[i] = ZSL_ASIN(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_ACOS:
-			m->data[i] = ZSL_ACOS(m->data[i]);
+			x[i] = ZSL_ACOS(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_ATAN:
-			m->data[i] = ZSL_ATAN(m->data[i]);
+			x[i] = ZSL_ATAN(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_SINH:
-			m->data[i] = ZSL_SINH(m->data[i]);
+			x[i] = ZSL_SINH(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_COSH:
-			m->data[i] = ZSL_COSH(m->data[i]);
+			x[i] = ZSL_COSH(x[i]);
 			break;
 		case ZSL_MTX_UNARY_OP_TANH:
-			m->data[i] = ZSL_TANH(m->data[i]);
+			x[i] = ZSL_TANH(x[i]);
 			break;
 		default:
 			/* Not yet implemented! */
@@ -276,6 +379,40 @@ zsl_mtx_unary_op(struct zsl_mtx *m, zsl_mtx_unary_op_t op)
 	return 0;
 }
 
+static int
+zsl_mtx_unary_op_part(void *ctx, size_t start, size_t end)
+{
+	struct zsl_mtx_op_job *job = ctx;
+	int rc;
+
+	if (job->rows == 1) {
+		return zsl_mtx_unary_op_kern(ZSL_MTX_ROW(job->ma, 0) + start,
+					     end - start, job->op);
+	}
+
+	for (size_t r = start; r < end; r++) {
+		rc = zsl_mtx_unary_op_kern(ZSL_MTX_ROW(job->ma, r), job->len,
+					   job->op);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_unary_op(struct zsl_mtx *m, zsl_mtx_unary_op_t op)
+{
+	struct zsl_mtx_op_job job = { .ma = m, .op = op };
+
+	zsl_mtx_walk(m, ZSL_MTX_IS_CONTIG(m), &job.rows, &job.len);
+
+	/* Execute the unary operation component by component. */
+	return zsl_threads_for(job.rows == 1 ? job.len : job.rows,
+			       job.rows * job.len, zsl_mtx_unary_op_part, &job);
+}
+
 int
 zsl_mtx_unary_func(struct zsl_mtx *m, zsl_mtx_unary_fn_t fn)
 {
@@ -296,58 +433,55 @@ zsl_mtx_unary_func(struct zsl_mtx *m, zsl_mtx_unary_fn_t fn)
 	return 0;
 }
 
-int
-zsl_mtx_binary_op(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc,
-		  zsl_mtx_binary_op_t op)
+/*
+ * Applies binary operation 'op' to 'len' elements, reading 'a' and 'b' and
+ * writing 'c' with strides of 'sa', 'sb' and 'sc'.
+ */
+static int
+zsl_mtx_binary_op_kern(const zsl_real_t *a, size_t sa, const zsl_real_t *b,
+		       size_t sb, zsl_real_t *c, size_t sc, size_t len,
+		       zsl_mtx_binary_op_t op)
 {
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
-	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
-		return -EINVAL;
-	}
-#endif
-
-	/* Execute the binary operation component by component. */
-	for (size_t i = 0; i < ma->sz_cols * ma->sz_rows; i++) {
+	for (size_t i = 0; i < len; i++) {
 		switch (op) {
 		case ZSL_MTX_BINARY_OP_ADD:
-			mc->data[i] = ma->data[i] + mb->data[i];
+			c[i * sc] = a[i * sa] + b[i * sb];
 			break;
 		case ZSL_MTX_BINARY_OP_SUB:
-			mc->data[i] = ma->data[i] - mb->data[i];
+			c[i * sc] = a[i * sa] - b[i * sb];
 			break;
 		case ZSL_MTX_BINARY_OP_MULT:
-			mc->data[i] = ma->data[i] * mb->data[i];
+			c[i * sc] = a[i * sa] * b[i * sb];
 			break;
 		case ZSL_MTX_BINARY_OP_DIV:
-			if (mb->data[i] == 0.0) {
-				mc->data[i] = 0.0;
+			if (b[i * sb] == 0.0) {
+				c[i * sc] = 0.0;
 			} else {
-				mc->data[i] = ma->data[i] / mb->data[i];
+				c[i * sc] = a[i * sa] / b[i * sb];
 			}
 			break;
 		case ZSL_MTX_BINARY_OP_MEAN:
-			mc->data[i] = (ma->data[i] + mb->data[i]) / 2.0;
+			c[i * sc] = (a[i * sa] + b[i * sb]) / 2.0f;
 		case ZSL_MTX_BINARY_OP_EXPON:
-			mc->data[i] = ZSL_POW(ma->data[i], mb->data[i]);
+			c[i * sc] = ZSL_POW(a[i * sa], b[i * sb]);
 		case ZSL_MTX_BINARY_OP_MIN:
-			mc->data[i] = ma->data[i] < mb->data[i] ?
-				      ma->data[i] : mb->data[i];
+			c[i * sc] = a[i * sa] < b[i * sb] ?
+				      a[i * sa] : b[i * sb];
 		case ZSL_MTX_BINARY_OP_MAX:
-			mc->data[i] = ma->data[i] > mb->data[i] ?
-				      ma->data[i] : mb->data[i];
+			c[i * sc] = a[i * sa] > b[i * sb] ?
+				      a[i * sa] : b[i * sb];
 		case ZSL_MTX_BINARY_OP_EQUAL:
-			mc->data[i] = ma->data[i] == mb->data[i] ? 1.0 : 0.0;
+			c[i * sc] = a[i * sa] == b[i * sb] ? 1.0 : 0.0;
 		case ZSL_MTX_BINARY_OP_NEQUAL:
-			mc->data[i] = ma->data[i] != mb->data[i] ? 1.0 : 0.0;
+			c[i * sc] = a[i * sa] != b[i * sb] ? 1.0 : 0.0;
 		case ZSL_MTX_BINARY_OP_LESS:
-			mc->data[i] = ma->data[i] < mb->data[i] ? 1.0 : 0.0;
+			c[i * sc] = a[i * sa] < b[i * sb] ? 1.0 : 0.0;
 		case ZSL_MTX_BINARY_OP_GREAT:
-			mc->data[i] = ma->data[i] > mb->data[i] ? 1.0 : 0.0;
+			c[i * sc] = a[i * sa] > b[i * sb] ? 1.0 : 0.0;
 		case ZSL_MTX_BINARY_OP_LEQ:
-			mc->data[i] = ma->data[i] <= mb->data[i] ? 1.0 : 0.0;
+			c[i * sc] = a[i * sa] <= b[i * sb] ? 1.0 : 0.0;
 		case ZSL_MTX_BINARY_OP_GEQ:
-			mc->data[i] = ma->data[i] >= mb->data[i] ? 1.0 : 0.0;
+			c[i * sc] = a[i * sa] >= b[i * sb] ? 1.0 : 0.0;
 		default:
 			/* Not yet implemented! */
 			return -ENOSYS;
@@ -357,6 +491,83 @@ zsl_mtx_binary_op(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc,
 	return 0;
 }
 
+/* Start of row 'r' of 'm' for a binary operation, as walked by 'job'. */
+#define ZSL_MTX_OP_ROW(job, m, r) \
+	((job)->mixed ? &ZSL_MTX_AT(m, r, 0) : ZSL_MTX_ROW(m, r))
+
+static int
+zsl_mtx_binary_op_part(void *ctx, size_t start, size_t end)
+{
+	struct zsl_mtx_op_job *job = ctx;
+	int rc;
+
+	if (job->rows == 1) {
+		return zsl_mtx_binary_op_kern(
+			ZSL_MTX_OP_ROW(job, job->ma, 0) + (start * job->sa),
+			job->sa,
+			ZSL_MTX_OP_ROW(job, job->mb, 0) + (start * job->sb),
+			job->sb,
+			ZSL_MTX_OP_ROW(job, job->mc, 0) + (start * job->sc),
+			job->sc, end - start, job->op);
+	}
+
+	for (size_t r = start; r < end; r++) {
+		rc = zsl_mtx_binary_op_kern(ZSL_MTX_OP_ROW(job, job->ma, r),
+					    job->sa,
+					    ZSL_MTX_OP_ROW(job, job->mb, r),
+					    job->sb,
+					    ZSL_MTX_OP_ROW(job, job->mc, r),
+					    job->sc, job->len, job->op);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_binary_op(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc,
+		  zsl_mtx_binary_op_t op)
+{
+	struct zsl_mtx_op_job job = {
+		.ma = ma,
+		.mb = mb,
+		.mc = mc,
+		.op = op,
+		.mixed = (ma->trans != mb->trans) || (mb->trans != mc->trans),
+		.sa = 1,
+		.sb = 1,
+		.sc = 1
+	};
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (job.mixed) {
+		/* Operands with different layouts are walked row by row, with
+		 * each one's own column step. */
+		job.rows = ma->sz_rows;
+		job.len = ma->sz_cols;
+		job.sa = ZSL_MTX_COL_STEP(ma);
+		job.sb = ZSL_MTX_COL_STEP(mb);
+		job.sc = ZSL_MTX_COL_STEP(mc);
+	} else {
+		zsl_mtx_walk(ma, ZSL_MTX_IS_CONTIG(ma) &&
+			     ZSL_MTX_IS_CONTIG(mb) && ZSL_MTX_IS_CONTIG(mc),
+			     &job.rows, &job.len);
+	}
+
+	/* Execute the binary operation component by component. */
+	return zsl_threads_for(job.rows == 1 ? job.len : job.rows,
+			       job.rows * job.len, zsl_mtx_binary_op_part,
+			       &job);
+}
+
 int
 zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
 		    struct zsl_mtx *mc, zsl_mtx_binary_fn_t fn)
@@ -385,17 +596,21 @@ zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
 	return 0;
 }
 
+#if !asm_mtx_add
 int
 zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
 {
 	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_ADD);
 }
+#endif
 
+#if !asm_mtx_add_d
 int
 zsl_mtx_add_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
 {
 	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_ADD);
 }
+#endif
 
 int
 zsl_mtx_sum_rows_d(struct zsl_mtx *m, size_t i, size_t j)
@@ -408,7 +623,7 @@ zsl_mtx_sum_rows_d(struct zsl_mtx *m, size_t i, size_t j)
 
 	/* Add row j to row i, element by element. */
 	for (size_t x = 0; x < m->sz_cols; x++) {
-		m->data[(i * m->sz_cols) + x] += m->data[(j * m->sz_cols) + x];
+		ZSL_MTX_AT(m, i, x) += ZSL_MTX_AT(m, j, x);
 	}
 
 	return 0;
@@ -425,24 +640,351 @@ int zsl_mtx_sum_rows_scaled_d(struct zsl_mtx *m,
 
 	/* Set the values in row 'i' to 'i[n] += j[n] * s' . */
 	for (size_t x = 0; x < m->sz_cols; x++) {
-		m->data[(i * m->sz_cols) + x] +=
-			(m->data[(j * m->sz_cols) + x] * s);
+		ZSL_MTX_AT(m, i, x) += (ZSL_MTX_AT(m, j, x) * s);
 	}
 
 	return 0;
 }
 
+#if !asm_mtx_sub
 int
 zsl_mtx_sub(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
 {
 	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_SUB);
 }
+#endif
 
+#if !asm_mtx_sub_d
 int
 zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
 {
 	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_SUB);
 }
+#endif
+
+/*
+ * Depth of the 'k' blocks used by the generic multiply kernel. Each block
+ * reads at most ZSL_MTX_MULT_BLK rows of the right-hand operand, which keeps
+ * the working set of larger multiplications resident in cache.
+ */
+#define ZSL_MTX_MULT_BLK (64)
+
+/*
+ * Generic multiply kernel calculating 'c = alpha * a * b + beta * c', where
+ * 'c' is an m x p row-major matrix whose rows are 'crs' elements apart, 'a'
+ * is an m x n operand and 'b' an n x p operand. Each operand is described by
+ * its row stride ('ars', 'brs') and column stride ('acs', 'bcs'), so that
+ * transposed operands and views can be read in place without an
+ * intermediate copy. 'c' isn't read when 'beta' is zero.
+ *
+ * The output is calculated in 4x4 tiles held in local accumulators, with any
+ * remaining rows and columns being processed in i-k-j order.
+ */
+static void
+zsl_mtx_mult_kern(size_t m, size_t n, size_t p, zsl_real_t alpha,
+		  const zsl_real_t *a, size_t ars, size_t acs,
+		  const zsl_real_t *b, size_t brs, size_t bcs,
+		  zsl_real_t beta, zsl_real_t *c, size_t crs)
+{
+	size_t i;
+	size_t j;
+	size_t kend;
+	zsl_real_t s;
+	zsl_real_t acc[4][4];
+	zsl_real_t ak[4];
+	zsl_real_t bk[4];
+
+	for (i = 0; i < m; i++) {
+		if (beta == 0.0) {
+			memset(&c[i * crs], 0, p * sizeof(zsl_real_t));
+		} else if (beta != 1.0) {
+			for (j = 0; j < p; j++) {
+				c[(i * crs) + j] *= beta;
+			}
+		}
+	}
+
+	if (alpha == 0.0) {
+		return;
+	}
+
+	for (size_t kk = 0; kk < n; kk += ZSL_MTX_MULT_BLK) {
+		kend = (n - kk) > ZSL_MTX_MULT_BLK ? kk + ZSL_MTX_MULT_BLK : n;
+
+		for (i = 0; i + 4 <= m; i += 4) {
+			/* Calculate 4x4 output tiles. */
+			for (j = 0; j + 4 <= p; j += 4) {
+				for (size_t r = 0; r < 4; r++) {
+					for (size_t q = 0; q < 4; q++) {
+						acc[r][q] = c[((i + r) * crs) +
+							      j + q];
+					}
+				}
+				for (size_t k = kk; k < kend; k++) {
+					for (size_t r = 0; r < 4; r++) {
+						ak[r] = alpha *
+							a[((i + r) * ars) +
+							  (k * acs)];
+						bk[r] = b[(k * brs) +
+							  ((j + r) * bcs)];
+					}
+					for (size_t r = 0; r < 4; r++) {
+						for (size_t q = 0; q < 4; q++) {
+							acc[r][q] += ak[r] *
+								     bk[q];
+						}
+					}
+				}
+				for (size_t r = 0; r < 4; r++) {
+					for (size_t q = 0; q < 4; q++) {
+						c[((i + r) * crs) + j + q] =
+							acc[r][q];
+					}
+				}
+			}
+
+			/* Remaining columns for this group of rows. */
+			for (; j < p; j++) {
+				for (size_t r = i; r < i + 4; r++) {
+					s = 0.0;
+					for (size_t k = kk; k < kend; k++) {
+						s += a[(r * ars) + (k * acs)] *
+						     b[(k * brs) + (j * bcs)];
+					}
+					c[(r * crs) + j] += alpha * s;
+				}
+			}
+		}
+
+		/* Remaining rows, in i-k-j order. */
+		for (; i < m; i++) {
+			for (size_t k = kk; k < kend; k++) {
+				s = alpha * a[(i * ars) + (k * acs)];
+				for (j = 0; j < p; j++) {
+					c[(i * crs) + j] += s *
+							  b[(k * brs) +
+							    (j * bcs)];
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Matrix-vector kernel calculating 'y = alpha * a * x + beta * y' for the
+ * m x n operand 'a', described by its row and column strides as in
+ * zsl_mtx_mult_kern. 'x' and 'y' are read with strides of 'incx' and
+ * 'incy'. 'y' isn't read when 'beta' is zero.
+ */
+static void
+zsl_mtx_gemv_kern(size_t m, size_t n, zsl_real_t alpha,
+		  const zsl_real_t *a, size_t ars, size_t acs,
+		  const zsl_real_t *x, size_t incx,
+		  zsl_real_t beta, zsl_real_t *y, size_t incy)
+{
+	zsl_real_t s;
+	const zsl_real_t *ak;
+
+	if ((ars == 1) && (acs != 1)) {
+		/* The columns of 'a' are contiguous (a transposed operand), so
+		 * accumulate one column at a time rather than striding down
+		 * them for each dot product. */
+		for (size_t i = 0; i < m; i++) {
+			y[i * incy] = (beta == 0.0) ? 0.0f : beta * y[i * incy];
+		}
+		for (size_t k = 0; k < n; k++) {
+			s = alpha * x[k * incx];
+			if (s == 0.0) {
+				continue;
+			}
+			ak = &a[k * acs];
+			for (size_t i = 0; i < m; i++) {
+				y[i * incy] += s * ak[i];
+			}
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < m; i++) {
+		s = 0.0;
+		for (size_t k = 0; k < n; k++) {
+			s += a[(i * ars) + (k * acs)] * x[k * incx];
+		}
+		y[i * incy] = (beta == 0.0) ? alpha * s :
+			      (alpha * s) + (beta * y[i * incy]);
+	}
+}
+
+/*
+ * Rank-1 update kernel calculating 'a = alpha * x * y^T + a' for the m x n
+ * row-major block 'a', whose rows are 'lda' elements apart. 'x' and 'y' are
+ * read with strides of 'incx' and 'incy'.
+ */
+static void
+zsl_mtx_ger_kern(size_t m, size_t n, zsl_real_t alpha,
+		 const zsl_real_t *x, size_t incx,
+		 const zsl_real_t *y, size_t incy,
+		 zsl_real_t *a, size_t lda)
+{
+	zsl_real_t s;
+	zsl_real_t *ai;
+
+	for (size_t i = 0; i < m; i++) {
+		s = alpha * x[i * incx];
+		if (s == 0.0) {
+			continue;
+		}
+		ai = &a[i * lda];
+		for (size_t j = 0; j < n; j++) {
+			ai[j] += s * y[j * incy];
+		}
+	}
+}
+
+/* The arguments of a zsl_mtx_mult_kern call split by rows of 'c'. */
+struct zsl_mtx_mult_job {
+	size_t n;
+	size_t p;
+	zsl_real_t alpha;
+	const zsl_real_t *a;
+	size_t ars;
+	size_t acs;
+	const zsl_real_t *b;
+	size_t brs;
+	size_t bcs;
+	zsl_real_t beta;
+	zsl_real_t *c;
+	size_t crs;
+};
+
+static int
+zsl_mtx_mult_part(void *ctx, size_t start, size_t end)
+{
+	struct zsl_mtx_mult_job *job = ctx;
+
+	zsl_mtx_mult_kern(end - start, job->n, job->p, job->alpha,
+			  &job->a[start * job->ars], job->ars, job->acs,
+			  job->b, job->brs, job->bcs, job->beta,
+			  &job->c[start * job->crs], job->crs);
+
+	return 0;
+}
+
+/*
+ * Runs zsl_mtx_mult_kern with the output matrix 'mc', splitting the rows of
+ * the output across the thread pool. A transposed 'mc' is calculated as
+ * 'c^T = alpha * b^T * a^T + beta * c^T', which is row-major in its storage.
+ */
+static void
+zsl_mtx_mult_kern_mtx(size_t m, size_t n, size_t p, zsl_real_t alpha,
+		      const zsl_real_t *a, size_t ars, size_t acs,
+		      const zsl_real_t *b, size_t brs, size_t bcs,
+		      zsl_real_t beta, struct zsl_mtx *mc)
+{
+	struct zsl_mtx_mult_job job = {
+		.n = n,
+		.alpha = alpha,
+		.beta = beta,
+		.c = mc->data,
+		.crs = ZSL_MTX_STRIDE(mc)
+	};
+
+	if (mc->trans) {
+		job.p = m;
+		job.a = b;
+		job.ars = bcs;
+		job.acs = brs;
+		job.b = a;
+		job.brs = acs;
+		job.bcs = ars;
+		m = p;
+	} else {
+		job.p = p;
+		job.a = a;
+		job.ars = ars;
+		job.acs = acs;
+		job.b = b;
+		job.brs = brs;
+		job.bcs = bcs;
+	}
+
+	zsl_threads_for(m, m * n * job.p, zsl_mtx_mult_part, &job);
+}
+
+/* Unrolled multiply kernel for row-major 3x3 matrices. */
+static void
+zsl_mtx_mult_3x3(const zsl_real_t *a, const zsl_real_t *b, zsl_real_t *c)
+{
+	c[0] = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+	c[1] = a[0] * b[1] + a[1] * b[4] + a[2] * b[7];
+	c[2] = a[0] * b[2] + a[1] * b[5] + a[2] * b[8];
+
+	c[3] = a[3] * b[0] + a[4] * b[3] + a[5] * b[6];
+	c[4] = a[3] * b[1] + a[4] * b[4] + a[5] * b[7];
+	c[5] = a[3] * b[2] + a[4] * b[5] + a[5] * b[8];
+
+	c[6] = a[6] * b[0] + a[7] * b[3] + a[8] * b[6];
+	c[7] = a[6] * b[1] + a[7] * b[4] + a[8] * b[7];
+	c[8] = a[6] * b[2] + a[7] * b[5] + a[8] * b[8];
+}
+
+/* Multiply kernel for row-major 4x4 matrices, one output row at a time. */
+static void
+zsl_mtx_mult_4x4(const zsl_real_t *a, const zsl_real_t *b, zsl_real_t *c)
+{
+	zsl_real_t x;
+	zsl_real_t c0, c1, c2, c3;
+
+	for (size_t i = 0; i < 4; i++) {
+		c0 = 0.0;
+		c1 = 0.0;
+		c2 = 0.0;
+		c3 = 0.0;
+		for (size_t k = 0; k < 4; k++) {
+			x = a[(i * 4) + k];
+			c0 += x * b[(k * 4) + 0];
+			c1 += x * b[(k * 4) + 1];
+			c2 += x * b[(k * 4) + 2];
+			c3 += x * b[(k * 4) + 3];
+		}
+		c[(i * 4) + 0] = c0;
+		c[(i * 4) + 1] = c1;
+		c[(i * 4) + 2] = c2;
+		c[(i * 4) + 3] = c3;
+	}
+}
+
+/* Multiply kernel for row-major 6x6 matrices, one output row at a time. */
+static void
+zsl_mtx_mult_6x6(const zsl_real_t *a, const zsl_real_t *b, zsl_real_t *c)
+{
+	zsl_real_t x;
+	zsl_real_t c0, c1, c2, c3, c4, c5;
+
+	for (size_t i = 0; i < 6; i++) {
+		c0 = 0.0;
+		c1 = 0.0;
+		c2 = 0.0;
+		c3 = 0.0;
+		c4 = 0.0;
+		c5 = 0.0;
+		for (size_t k = 0; k < 6; k++) {
+			x = a[(i * 6) + k];
+			c0 += x * b[(k * 6) + 0];
+			c1 += x * b[(k * 6) + 1];
+			c2 += x * b[(k * 6) + 2];
+			c3 += x * b[(k * 6) + 3];
+			c4 += x * b[(k * 6) + 4];
+			c5 += x * b[(k * 6) + 5];
+		}
+		c[(i * 6) + 0] = c0;
+		c[(i * 6) + 1] = c1;
+		c[(i * 6) + 2] = c2;
+		c[(i * 6) + 3] = c3;
+		c[(i * 6) + 4] = c4;
+		c[(i * 6) + 5] = c5;
+	}
+}
 
 int
 zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
@@ -459,85 +1001,281 @@ zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
 	}
 #endif
 
-	for (size_t i = 0; i < ma->sz_rows; i++) {
-		for (size_t j = 0; j < mb->sz_cols; j++) {
-			mc->data[j + i * mb->sz_cols] = 0;
-			for (size_t k = 0; k < ma->sz_cols; k++) {
-				mc->data[j + i * mb->sz_cols] +=
-					ma->data[k + i * ma->sz_cols] *
-					mb->data[j + k * mb->sz_cols];
-			}
+	/* Use the dedicated kernels for common square matrix sizes. */
+	if ((ma->sz_rows == ma->sz_cols) && (mb->sz_rows == mb->sz_cols) &&
+	    ZSL_MTX_IS_CONTIG(ma) && ZSL_MTX_IS_CONTIG(mb) &&
+	    ZSL_MTX_IS_CONTIG(mc)) {
+		switch (ma->sz_rows) {
+		case 3:
+			zsl_mtx_mult_3x3(ma->data, mb->data, mc->data);
+			return 0;
+		case 4:
+			zsl_mtx_mult_4x4(ma->data, mb->data, mc->data);
+			return 0;
+		case 6:
+			zsl_mtx_mult_6x6(ma->data, mb->data, mc->data);
+			return 0;
+		default:
+			break;
 		}
 	}
 
+	zsl_mtx_mult_kern_mtx(ma->sz_rows, ma->sz_cols, mb->sz_cols, 1.0,
+			      ma->data, ZSL_MTX_ROW_STEP(ma),
+			      ZSL_MTX_COL_STEP(ma),
+			      mb->data, ZSL_MTX_ROW_STEP(mb),
+			      ZSL_MTX_COL_STEP(mb), 0.0, mc);
+
 	return 0;
 }
 
 int
-zsl_mtx_scalar_mult_d(struct zsl_mtx *m, zsl_real_t s)
+zsl_mtx_mult_trans_a(struct zsl_mtx *ma, struct zsl_mtx *mb,
+		     struct zsl_mtx *mc)
 {
-	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
-		m->data[i] *= s;
+	return zsl_mtx_gemm(true, false, 1.0, ma, mb, 0.0, mc);
+}
+
+int
+zsl_mtx_mult_trans_b(struct zsl_mtx *ma, struct zsl_mtx *mb,
+		     struct zsl_mtx *mc)
+{
+	return zsl_mtx_gemm(false, true, 1.0, ma, mb, 0.0, mc);
+}
+
+int
+zsl_mtx_gemm(bool ta, bool tb, zsl_real_t alpha, struct zsl_mtx *ma,
+	     struct zsl_mtx *mb, zsl_real_t beta, struct zsl_mtx *mc)
+{
+	size_t m = ta ? ma->sz_cols : ma->sz_rows;
+	size_t n = ta ? ma->sz_rows : ma->sz_cols;
+	size_t p = tb ? mb->sz_rows : mb->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that op(ma) has as many columns as op(mb) has rows. */
+	if (n != (tb ? mb->sz_cols : mb->sz_rows)) {
+		return -EINVAL;
+	}
+
+	/* Ensure that mc has op(ma) rows and op(mb) cols. */
+	if ((mc->sz_rows != m) || (mc->sz_cols != p)) {
+		return -EINVAL;
 	}
+#endif
+
+	/* Transposed operands are read column-wise, in place. */
+	zsl_mtx_mult_kern_mtx(m, n, p, alpha, ma->data,
+			      ta ? ZSL_MTX_COL_STEP(ma) : ZSL_MTX_ROW_STEP(ma),
+			      ta ? ZSL_MTX_ROW_STEP(ma) : ZSL_MTX_COL_STEP(ma),
+			      mb->data,
+			      tb ? ZSL_MTX_COL_STEP(mb) : ZSL_MTX_ROW_STEP(mb),
+			      tb ? ZSL_MTX_ROW_STEP(mb) : ZSL_MTX_COL_STEP(mb),
+			      beta, mc);
 
 	return 0;
 }
 
 int
-zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s)
+zsl_mtx_gemv(bool ta, zsl_real_t alpha, struct zsl_mtx *ma,
+	     struct zsl_vec *x, zsl_real_t beta, struct zsl_vec *y)
 {
+	size_t m = ta ? ma->sz_cols : ma->sz_rows;
+	size_t n = ta ? ma->sz_rows : ma->sz_cols;
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	if (i >= m->sz_rows) {
+	if ((x->sz != n) || (y->sz != m)) {
 		return -EINVAL;
 	}
 #endif
 
-	for (size_t k = 0; k < m->sz_cols; k++) {
-		m->data[(i * m->sz_cols) + k] *= s;
-	}
+	zsl_mtx_gemv_kern(m, n, alpha, ma->data,
+			  ta ? ZSL_MTX_COL_STEP(ma) : ZSL_MTX_ROW_STEP(ma),
+			  ta ? ZSL_MTX_ROW_STEP(ma) : ZSL_MTX_COL_STEP(ma),
+			  x->data, 1, beta, y->data, 1);
 
 	return 0;
 }
 
 int
-zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb)
+zsl_mtx_ger(zsl_real_t alpha, struct zsl_vec *x, struct zsl_vec *y,
+	    struct zsl_mtx *ma)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Ensure that ma and mb have the same shape. */
-	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+	if ((x->sz != ma->sz_rows) || (y->sz != ma->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	zsl_real_t d[ma->sz_cols];
-
-	for (size_t i = 0; i < ma->sz_rows; i++) {
-		zsl_mtx_get_row(ma, i, d);
-		zsl_mtx_set_col(mb, i, d);
+	/* A transposed 'ma' is updated as 'a^T = alpha * y * x^T + a^T'. */
+	if (ma->trans) {
+		zsl_mtx_ger_kern(ma->sz_cols, ma->sz_rows, alpha, y->data, 1,
+				 x->data, 1, ma->data, ZSL_MTX_STRIDE(ma));
+	} else {
+		zsl_mtx_ger_kern(ma->sz_rows, ma->sz_cols, alpha, x->data, 1,
+				 y->data, 1, ma->data, ZSL_MTX_STRIDE(ma));
 	}
 
 	return 0;
 }
 
 int
-zsl_mtx_adjoint_3x3(struct zsl_mtx *m, struct zsl_mtx *ma)
+zsl_mtx_syrk(bool ta, zsl_real_t alpha, struct zsl_mtx *ma, zsl_real_t beta,
+	     struct zsl_mtx *mc)
 {
-	/* Make sure this is a square matrix. */
-	if ((m->sz_rows != m->sz_cols) || (ma->sz_rows != ma->sz_cols)) {
-		return -EINVAL;
-	}
+	size_t n = ta ? ma->sz_cols : ma->sz_rows;
+	size_t k = ta ? ma->sz_rows : ma->sz_cols;
+	size_t cs = ZSL_MTX_STRIDE(mc);
+	size_t rs = ZSL_MTX_ROW_STEP(ma);
+	size_t js = ZSL_MTX_COL_STEP(ma);
+	zsl_real_t s;
+	zsl_real_t *ci;
+	zsl_real_t *ap;
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure this is a 3x3 matrix. */
-	if ((m->sz_rows != 3) || (ma->sz_rows != 3)) {
+	if ((mc->sz_rows != n) || (mc->sz_cols != n)) {
 		return -EINVAL;
 	}
 #endif
 
-	/*
-	 * 3x3 matrix element to array table:
-	 *
-	 * 1,1 = 0  1,2 = 1  1,3 = 2
+	/* Only the upper triangle is calculated, then mirrored, so the
+	 * layout of 'mc' doesn't matter. */
+	for (size_t i = 0; i < n; i++) {
+		ci = &mc->data[i * cs];
+		for (size_t j = i; j < n; j++) {
+			ci[j] = (beta == 0.0) ? 0.0f : beta * ci[j];
+		}
+	}
+
+	if (alpha != 0.0 && ta) {
+		/* Sum the outer products of the rows of 'ma'. */
+		for (size_t r = 0; r < k; r++) {
+			ap = &ma->data[r * rs];
+			for (size_t i = 0; i < n; i++) {
+				s = alpha * ap[i * js];
+				if (s == 0.0) {
+					continue;
+				}
+				ci = &mc->data[i * cs];
+				for (size_t j = i; j < n; j++) {
+					ci[j] += s * ap[j * js];
+				}
+			}
+		}
+	} else if (alpha != 0.0) {
+		/* Dot products of each pair of rows of 'ma'. */
+		for (size_t i = 0; i < n; i++) {
+			ci = &mc->data[i * cs];
+			for (size_t j = i; j < n; j++) {
+				s = 0.0;
+				for (size_t r = 0; r < k; r++) {
+					s += ZSL_MTX_AT(ma, i, r) *
+					     ZSL_MTX_AT(ma, j, r);
+				}
+				ci[j] += alpha * s;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			mc->data[(j * cs) + i] = mc->data[(i * cs) + j];
+		}
+	}
+
+	return 0;
+}
+
+#if !asm_mtx_scalar_mult_d
+int
+zsl_mtx_scalar_mult_d(struct zsl_mtx *m, zsl_real_t s)
+{
+	size_t rows, len;
+	zsl_real_t *x;
+
+	zsl_mtx_walk(m, ZSL_MTX_IS_CONTIG(m), &rows, &len);
+
+	for (size_t r = 0; r < rows; r++) {
+		x = ZSL_MTX_ROW(m, r);
+		for (size_t i = 0; i < len; i++) {
+			x[i] *= s;
+		}
+	}
+
+	return 0;
+}
+#endif
+
+int
+zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (i >= m->sz_rows) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < m->sz_cols; k++) {
+		ZSL_MTX_AT(m, i, k) *= s;
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma and mb have the same shape. */
+	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t d[ma->sz_cols];
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		zsl_mtx_get_row(ma, i, d);
+		zsl_mtx_set_col(mb, i, d);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_trans_view(struct zsl_mtx *ma, struct zsl_mtx *mt)
+{
+	size_t rows = ma->sz_rows;
+	size_t stride = ZSL_MTX_STRIDE(ma);
+
+	/* Only the shape and the layout change, so 'mt' can be 'ma'. */
+	mt->sz_rows = ma->sz_cols;
+	mt->sz_cols = rows;
+	mt->data = ma->data;
+	mt->stride = stride;
+	mt->trans = !ma->trans;
+
+	return 0;
+}
+
+int
+zsl_mtx_adjoint_3x3(struct zsl_mtx *m, struct zsl_mtx *ma)
+{
+	/* Make sure this is a square matrix. */
+	if ((m->sz_rows != m->sz_cols) || (ma->sz_rows != ma->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure this is a 3x3 matrix. */
+	if ((m->sz_rows != 3) || (ma->sz_rows != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/*
+	 * 3x3 matrix element to array table:
+	 *
+	 * 1,1 = 0  1,2 = 1  1,3 = 2
 	 * 2,1 = 3  2,2 = 4  2,3 = 5
 	 * 3,1 = 6  3,2 = 7  3,3 = 8
 	 */
@@ -699,6 +1437,24 @@ zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d)
 		return zsl_mtx_deter_3x3(m, d);
 	}
 
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_deter_ws_size(m->sz_rows));
+
+	return zsl_mtx_deter_ws(m, d, &ws);
+}
+
+int
+zsl_mtx_deter_ws(struct zsl_mtx *m, zsl_real_t *d, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t *piv;
+	struct zsl_mtx lu;
+
+	/* Shortcut for 3x3 matrices. */
+	if (m->sz_rows == 3) {
+		return zsl_mtx_deter_3x3(m, d);
+	}
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure this is a square matrix. */
 	if (m->sz_rows != m->sz_cols) {
@@ -706,42 +1462,29 @@ zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d)
 	}
 #endif
 
-	/* Full calculation required for non 3x3 matrices. */
-	int rc;
-	zsl_real_t dtmp;
-	zsl_real_t cur;
-	zsl_real_t sign;
-	ZSL_MATRIX_DEF(mr, (m->sz_rows - 1), (m->sz_rows - 1));
-
-	/* Clear determinant output before starting. */
-	*d = 0.0;
+	/* Use the LU decomposition for non 3x3 matrices. */
+	piv = zsl_ws_alloc(ws, m->sz_rows * sizeof(size_t));
+	if ((piv == NULL) || zsl_ws_mtx(ws, &lu, m->sz_rows, m->sz_rows)) {
+		rc = -ENOMEM;
+		goto err;
+	}
 
-	/*
-	 * Iterate across row 0, removing columns one by one.
-	 * Note that these calls are recursive until we reach a 3x3 matrix,
-	 * which will be calculated using the shortcut at the top of this
-	 * function.
-	 */
-	for (size_t g = 0; g < m->sz_cols; g++) {
-		zsl_mtx_get(m, 0, g, &cur);     /* Get value at (0, g). */
-		zsl_mtx_init(&mr, NULL);        /* Clear mr. */
-		zsl_mtx_reduce(m, &mr, 0, g);   /* Remove row 0, column g. */
-		rc = zsl_mtx_deter(&mr, &dtmp); /* Calc. determinant of mr. */
-		sign = 1.0;
-		if (rc) {
-			return -EINVAL;
-		}
+	rc = zsl_mtx_lu(m, &lu, piv);
+	if (rc) {
+		goto err;
+	}
 
-		/* Uneven elements are negative. */
-		if (g % 2 != 0) {
-			sign = -1.0;
-		}
+	rc = zsl_mtx_lu_deter(&lu, piv, d);
 
-		/* Add current determinant to final output value. */
-		*d += dtmp * cur * sign;
-	}
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
 
-	return 0;
+size_t
+zsl_mtx_deter_ws_size(size_t n)
+{
+	return ZSL_WS_BYTES(n * sizeof(size_t)) + ZSL_WS_REALS(n * n);
 }
 
 int
@@ -750,7 +1493,7 @@ zsl_mtx_gauss_elim(struct zsl_mtx *m, struct zsl_mtx *mg, struct zsl_mtx *mi,
 {
 	int rc;
 	zsl_real_t x, y;
-	zsl_real_t epsilon = 1E-6;
+	zsl_real_t epsilon = ZSL_MTX_ZERO_TOL;
 
 	/* Make a copy of matrix m. */
 	rc = zsl_mtx_copy(mg, m);
@@ -780,7 +1523,7 @@ zsl_mtx_gauss_elim(struct zsl_mtx *m, struct zsl_mtx *mg, struct zsl_mtx *mi,
 		}
 		/* Get the value of (p, j), aborting if value is zero. */
 		zsl_mtx_get(mg, p, j, &x);
-		if ((x >= 1E-6) || (x <= -1E-6)) {
+		if ((x >= ZSL_MTX_ZERO_TOL) || (x <= -ZSL_MTX_ZERO_TOL)) {
 			rc = zsl_mtx_sum_rows_scaled_d(mg, p, i, -(x / y));
 
 			if (rc) {
@@ -807,7 +1550,7 @@ zsl_mtx_gauss_reduc(struct zsl_mtx *m, struct zsl_mtx *mi,
 		    struct zsl_mtx *mg)
 {
 	zsl_real_t v[m->sz_rows];
-	zsl_real_t epsilon = 1E-6;
+	zsl_real_t epsilon = ZSL_MTX_ZERO_TOL;
 	zsl_real_t x;
 	zsl_real_t y;
 
@@ -906,7 +1649,7 @@ zsl_mtx_norm_elem(struct zsl_mtx *m, struct zsl_mtx *mn, struct zsl_mtx *mi,
 {
 	int rc;
 	zsl_real_t x;
-	zsl_real_t epsilon = 1E-6;
+	zsl_real_t epsilon = ZSL_MTX_ZERO_TOL;
 
 	/* Make a copy of matrix m. */
 	rc = zsl_mtx_copy(mn, m);
@@ -1001,9 +1744,25 @@ err:
 
 int
 zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi)
+{
+	/* Shortcut for 3x3 matrices. */
+	if (m->sz_rows == 3) {
+		return zsl_mtx_inv_3x3(m, mi);
+	}
+
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_inv_ws_size(m->sz_rows));
+
+	return zsl_mtx_inv_ws(m, mi, &ws);
+}
+
+int
+zsl_mtx_inv_ws(struct zsl_mtx *m, struct zsl_mtx *mi,
+	       struct zsl_workspace *ws)
 {
 	int rc;
-	zsl_real_t d = 0.0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t *piv;
+	struct zsl_mtx lu;
 
 	/* Shortcut for 3x3 matrices. */
 	if (m->sz_rows == 3) {
@@ -1025,254 +1784,1810 @@ zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi)
 	}
 #endif
 
-	/* Make a copy of matrix m on the stack to avoid modifying it. */
-	ZSL_MATRIX_DEF(m_tmp, mi->sz_rows, mi->sz_cols);
-	rc = zsl_mtx_copy(&m_tmp, m);
-	if (rc) {
-		return -EINVAL;
+	piv = zsl_ws_alloc(ws, m->sz_rows * sizeof(size_t));
+	if ((piv == NULL) || zsl_ws_mtx(ws, &lu, m->sz_rows, m->sz_rows)) {
+		rc = -ENOMEM;
+		goto err;
 	}
 
-	/* Initialise 'mi' as an identity matrix. */
-	rc = zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+	/* Decompose 'm' into its LU factors, leaving 'm' unmodified. */
+	rc = zsl_mtx_lu(m, &lu, piv);
 	if (rc) {
-		return -EINVAL;
+		rc = -EINVAL;
+		goto err;
 	}
 
-	/* Make sure the determinant of 'm' is not zero. */
-	zsl_mtx_deter(m, &d);
+	rc = zsl_mtx_lu_inv(&lu, piv, mi);
 
-	if (d == 0) {
-		return 0;
+	/* Provide an identity matrix if 'm' is singular. */
+	if (rc == -ESINGULAR) {
+		rc = zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
 	}
 
-	/* Use Gauss-Jordan elimination for nxn matrices. */
-	zsl_mtx_gauss_reduc(m, mi, &m_tmp);
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
 
-	return 0;
+size_t
+zsl_mtx_inv_ws_size(size_t n)
+{
+	return zsl_mtx_deter_ws_size(n);
 }
 
 int
-zsl_mtx_balance(struct zsl_mtx *m, struct zsl_mtx *mout)
+zsl_mtx_lu(struct zsl_mtx *m, struct zsl_mtx *lu, size_t *piv)
 {
-	int rc;
-	bool done = false;
-	zsl_real_t sum;
-	zsl_real_t row, row2;
-	zsl_real_t col, col2;
+	size_t n = m->sz_rows;
+	size_t p;
+	zsl_real_t max;
+	zsl_real_t x;
+	zsl_real_t *rk;
 
 	/* Make sure we have square matrices. */
-	if ((m->sz_rows != m->sz_cols) || (mout->sz_rows != mout->sz_cols)) {
+	if ((m->sz_rows != m->sz_cols) || (lu->sz_rows != lu->sz_cols)) {
 		return -EINVAL;
 	}
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure 'm' and 'mout' have the same shape. */
-	if (m->sz_rows != mout->sz_rows) {
-		return -EINVAL;
-	}
-	if (m->sz_cols != mout->sz_cols) {
+	/* Make sure 'm' and 'lu' have the same shape. */
+	if (m->sz_rows != lu->sz_rows) {
 		return -EINVAL;
 	}
 #endif
 
-	rc = zsl_mtx_copy(mout, m);
-	if (rc) {
-		goto err;
+	/* Work on a copy of 'm' unless the decomposition is in place. */
+	if (lu->data != m->data) {
+		zsl_mtx_copy(lu, m);
 	}
 
-	while (!done) {
-		done = true;
-
-		for (size_t i = 0; i < m->sz_rows; i++) {
-			/* Calculate sum of components of each row, column. */
-			for (size_t j = 0; j < m->sz_cols; j++) {
-				row += ZSL_ABS(mout->data[(i * m->sz_rows) +
-							  j]);
-				col += ZSL_ABS(mout->data[(j * m->sz_rows) +
-							  i]);
+	for (size_t k = 0; k < n; k++) {
+		/* Find the largest absolute value in column 'k' on or below
+		 * the diagonal, to use as the pivot. */
+		p = k;
+		max = ZSL_ABS(lu->data[(k * n) + k]);
+		for (size_t i = k + 1; i < n; i++) {
+			if (ZSL_ABS(lu->data[(i * n) + k]) > max) {
+				max = ZSL_ABS(lu->data[(i * n) + k]);
+				p = i;
 			}
+		}
 
-			/* TODO: Extend with a check against epsilon? */
-			if (col != 0.0 && row != 0.0) {
-				row2 = row / 2.0;
-				col2 = 1.0;
-				sum = col + row;
+		/* Swap the pivot row into position 'k'. */
+		piv[k] = p;
+		if (p != k) {
+			for (size_t j = 0; j < n; j++) {
+				x = lu->data[(k * n) + j];
+				lu->data[(k * n) + j] = lu->data[(p * n) + j];
+				lu->data[(p * n) + j] = x;
+			}
+		}
 
-				while (col < row2) {
-					col2 *= 2.0;
-					col *= 4.0;
-				}
+		/* A zero pivot means that 'm' is singular. Nothing remains to
+		 * be eliminated in this column, so move on to the next one. */
+		rk = &lu->data[k * n];
+		if (rk[k] == 0.0) {
+			continue;
+		}
 
-				row2 = row * 2.0;
+		/* Store the multipliers (L) below the diagonal, and eliminate
+		 * column 'k' from the remaining rows (U) with a rank-1 update
+		 * of the trailing submatrix. */
+		for (size_t i = k + 1; i < n; i++) {
+			lu->data[(i * n) + k] /= rk[k];
+		}
+		zsl_mtx_ger_kern(n - k - 1, n - k - 1, -1.0,
+				 &lu->data[((k + 1) * n) + k], n,
+				 &rk[k + 1], 1,
+				 &lu->data[((k + 1) * n) + k + 1], n);
+	}
 
-				while (col > row2) {
-					col2 /= 2.0;
-					col /= 4.0;
-				}
+	return 0;
+}
 
-				if ((col + row) / col2 < 0.95 * sum) {
-					done = false;
-					row2 = 1.0 / col2;
+int
+zsl_mtx_lu_deter(struct zsl_mtx *lu, size_t *piv, zsl_real_t *d)
+{
+	zsl_real_t det = 1.0;
 
-					for (int k = 0; k < m->sz_rows; k++) {
-						mout->data[(i * m->sz_rows) + k]
-							*= row2;
-						mout->data[(k * m->sz_rows) + i]
-							*= col2;
-					}
-				}
-			}
+	/* Make sure this is a square matrix. */
+	if (lu->sz_rows != lu->sz_cols) {
+		return -EINVAL;
+	}
 
-			row = 0.0;
-			col = 0.0;
+	/* The determinant is the product of the diagonal of U, with the sign
+	 * inverted for every row swap that took place. */
+	for (size_t k = 0; k < lu->sz_rows; k++) {
+		det *= lu->data[(k * lu->sz_cols) + k];
+		if (piv[k] != k) {
+			det = -det;
 		}
 	}
 
-err:
-	return rc;
+	*d = det;
+
+	return 0;
 }
 
 int
-zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg)
+zsl_mtx_lu_solve(struct zsl_mtx *lu, size_t *piv, struct zsl_mtx *b,
+		 struct zsl_mtx *x)
 {
-	size_t size = m->sz_rows;
+	size_t n = lu->sz_rows;
+	size_t c = b->sz_cols;
+	zsl_real_t s;
+	zsl_real_t *xi;
+	zsl_real_t *xr;
 
-	if (hessenberg == true) {
-		size--;
+	/* Make sure this is a square matrix. */
+	if (lu->sz_rows != lu->sz_cols) {
+		return -EINVAL;
 	}
 
-	ZSL_VECTOR_DEF(v, size);
-	ZSL_VECTOR_DEF(v2, m->sz_rows);
-	ZSL_VECTOR_DEF(e1, size);
-
-	ZSL_MATRIX_DEF(mv, size, 1);
-	ZSL_MATRIX_DEF(mvt, 1, size);
-	ZSL_MATRIX_DEF(id, size, size);
-	ZSL_MATRIX_DEF(vvt, size, size);
-	ZSL_MATRIX_DEF(h2, size, size);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'b' and 'x' are compatibly shaped. */
+	if ((b->sz_rows != n) || (x->sz_rows != n) || (x->sz_cols != c)) {
+		return -EINVAL;
+	}
+#endif
 
-	/* Create the e1 vector, i.e. the vector (1, 0, 0, ...). */
-	zsl_vec_init(&e1);
-	e1.data[0] = 1.0;
+	/* Check for zero pivots before modifying the output. */
+	for (size_t k = 0; k < n; k++) {
+		if (lu->data[(k * n) + k] == 0.0) {
+			return -ESINGULAR;
+		}
+	}
 
-	/* Get the first column of the input matrix. */
-	zsl_mtx_get_col(m, 0, v2.data);
-	if (hessenberg == true) {
-		zsl_vec_get_subset(&v2, 1, size, &v);
-	} else {
-		zsl_vec_copy(&v, &v2);
+	if (x->data != b->data) {
+		zsl_mtx_copy(x, b);
 	}
 
-	/* Change the 'sign' value according to the sign of the first
-	 * coefficient of the matrix. */
-	zsl_real_t sign = 1.0;
-	if (v.data[0] < 0) {
-		sign = -1.0;
+	/* Apply the row permutations in the order they were recorded. */
+	for (size_t k = 0; k < n; k++) {
+		if (piv[k] != k) {
+			xi = &x->data[k * c];
+			xr = &x->data[piv[k] * c];
+			for (size_t j = 0; j < c; j++) {
+				s = xi[j];
+				xi[j] = xr[j];
+				xr[j] = s;
+			}
+		}
 	}
 
-	/* Calculate the vector 'v' that will later be used to calculate the
-	 * Householder matrix. */
-	zsl_vec_scalar_mult(&e1, -sign * zsl_vec_norm(&v));
+	/* Forward substitution with the unit lower triangular L. */
+	for (size_t i = 1; i < n; i++) {
+		xi = &x->data[i * c];
+		for (size_t r = 0; r < i; r++) {
+			s = lu->data[(i * n) + r];
+			if (s == 0.0) {
+				continue;
+			}
+			xr = &x->data[r * c];
+			for (size_t j = 0; j < c; j++) {
+				xi[j] -= s * xr[j];
+			}
+		}
+	}
+
+	/* Back substitution with the upper triangular U. */
+	for (size_t i = n; i-- > 0;) {
+		xi = &x->data[i * c];
+		for (size_t r = i + 1; r < n; r++) {
+			s = lu->data[(i * n) + r];
+			if (s == 0.0) {
+				continue;
+			}
+			xr = &x->data[r * c];
+			for (size_t j = 0; j < c; j++) {
+				xi[j] -= s * xr[j];
+			}
+		}
+		s = lu->data[(i * n) + i];
+		for (size_t j = 0; j < c; j++) {
+			xi[j] /= s;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_lu_inv(struct zsl_mtx *lu, size_t *piv, struct zsl_mtx *mi)
+{
+	int rc;
+
+	/* Make sure we have square matrices. */
+	if ((lu->sz_rows != lu->sz_cols) || (mi->sz_rows != mi->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'lu' and 'mi' have the same shape. */
+	if (lu->sz_rows != mi->sz_rows) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Solve 'm * mi = I', one identity column per right-hand side. */
+	rc = zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+	if (rc) {
+		return rc;
+	}
+
+	return zsl_mtx_lu_solve(lu, piv, mi, mi);
+}
+
+int
+zsl_mtx_cholesky(struct zsl_mtx *m, struct zsl_mtx *l)
+{
+	size_t n = m->sz_rows;
+	zsl_real_t s;
+	zsl_real_t *lj;
+
+	/* Make sure we have square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (l->sz_rows != l->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'l' have the same shape. */
+	if (m->sz_rows != l->sz_rows) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Work on a copy of 'm' unless the decomposition is in place. */
+	if (l->data != m->data) {
+		zsl_mtx_copy(l, m);
+	}
+
+	/* Cholesky-Crout: column 'j' of L only depends on the previous
+	 * columns, and overwrites the lower triangle of 'm' as it goes. */
+	for (size_t j = 0; j < n; j++) {
+		lj = &l->data[j * n];
+		s = lj[j];
+		for (size_t k = 0; k < j; k++) {
+			s -= lj[k] * lj[k];
+		}
+		if (s <= 0.0) {
+			return -ENOTPOSDEF;
+		}
+		lj[j] = ZSL_SQRT(s);
+
+		/* l[j+1:n, j] -= L[j+1:n, 0:j] * L[j, 0:j]^T */
+		zsl_mtx_gemv_kern(n - j - 1, j, -1.0, &l->data[(j + 1) * n],
+				  n, 1, lj, 1, 1.0, &l->data[((j + 1) * n) + j],
+				  n);
+		for (size_t i = j + 1; i < n; i++) {
+			l->data[(i * n) + j] /= lj[j];
+		}
+
+		/* Clear the upper triangle. */
+		for (size_t k = j + 1; k < n; k++) {
+			lj[k] = 0.0;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_ldl(struct zsl_mtx *m, struct zsl_mtx *ld)
+{
+	size_t n = m->sz_rows;
+	zsl_real_t s;
+	zsl_real_t *li;
+	zsl_real_t *lj;
+
+	/* Make sure we have square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (ld->sz_rows != ld->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'ld' have the same shape. */
+	if (m->sz_rows != ld->sz_rows) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Work on a copy of 'm' unless the decomposition is in place. */
+	if (ld->data != m->data) {
+		zsl_mtx_copy(ld, m);
+	}
+
+	for (size_t j = 0; j < n; j++) {
+		lj = &ld->data[j * n];
+		s = lj[j];
+		for (size_t k = 0; k < j; k++) {
+			s -= lj[k] * lj[k] * ld->data[(k * n) + k];
+		}
+		if (s == 0.0) {
+			return -ESINGULAR;
+		}
+		lj[j] = s;
+
+		for (size_t i = j + 1; i < n; i++) {
+			li = &ld->data[i * n];
+			s = li[j];
+			for (size_t k = 0; k < j; k++) {
+				s -= li[k] * lj[k] * ld->data[(k * n) + k];
+			}
+			li[j] = s / lj[j];
+		}
+
+		/* Clear the upper triangle. */
+		for (size_t k = j + 1; k < n; k++) {
+			lj[k] = 0.0;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Checks that the triangular nxn matrix 't' and the nxk matrices 'b' and
+ * 'x' can be used for a triangular solve, and copies 'b' into 'x'.
+ */
+static int
+zsl_mtx_tri_prep(struct zsl_mtx *t, struct zsl_mtx *b, struct zsl_mtx *x,
+		 bool unit)
+{
+	size_t n = t->sz_rows;
+
+	/* Make sure this is a square matrix. */
+	if (t->sz_rows != t->sz_cols) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'b' and 'x' are compatibly shaped. */
+	if ((b->sz_rows != n) || (x->sz_rows != n) ||
+	    (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Check for zero diagonal elements before modifying the output. */
+	for (size_t k = 0; unit == false && k < n; k++) {
+		if (t->data[(k * n) + k] == 0.0) {
+			return -ESINGULAR;
+		}
+	}
+
+	if (x->data != b->data) {
+		zsl_mtx_copy(x, b);
+	}
+
+	return 0;
+}
+
+/*
+ * Solves 'A * x = x' in place for the 'c' columns of 'x', where A is the
+ * lower ('lower' true) or upper triangle of the nxn matrix 't', or of its
+ * transpose if 'trans' is true. The diagonal is taken as 1.0 if 'unit'.
+ */
+static void
+zsl_mtx_tri_solve(zsl_real_t *t, size_t n, zsl_real_t *x, size_t c,
+		  bool lower, bool trans, bool unit)
+{
+	/* Stride between A[i][r] and A[i][r + 1] in 't', and between A[i][r]
+	 * and A[i + 1][r]. */
+	size_t sr = trans ? n : 1;
+	size_t si = trans ? 1 : n;
+	bool fwd = (lower != trans);
+	zsl_real_t s;
+	zsl_real_t *xi;
+	zsl_real_t *xr;
+
+	for (size_t g = 0; g < n; g++) {
+		size_t i = fwd ? g : n - 1 - g;
+		size_t r0 = fwd ? 0 : i + 1;
+		size_t r1 = fwd ? i : n;
+
+		xi = &x[i * c];
+		for (size_t r = r0; r < r1; r++) {
+			s = t[(i * si) + (r * sr)];
+			if (s == 0.0) {
+				continue;
+			}
+			xr = &x[r * c];
+			for (size_t j = 0; j < c; j++) {
+				xi[j] -= s * xr[j];
+			}
+		}
+		if (unit == false) {
+			s = t[(i * n) + i];
+			for (size_t j = 0; j < c; j++) {
+				xi[j] /= s;
+			}
+		}
+	}
+}
+
+int
+zsl_mtx_solve_lower(struct zsl_mtx *l, struct zsl_mtx *b,
+		    struct zsl_mtx *x, bool unit)
+{
+	int rc;
+
+	rc = zsl_mtx_tri_prep(l, b, x, unit);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_mtx_tri_solve(l->data, l->sz_rows, x->data, x->sz_cols, true,
+			  false, unit);
+
+	return 0;
+}
+
+int
+zsl_mtx_solve_upper(struct zsl_mtx *u, struct zsl_mtx *b,
+		    struct zsl_mtx *x, bool unit)
+{
+	int rc;
+
+	rc = zsl_mtx_tri_prep(u, b, x, unit);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_mtx_tri_solve(u->data, u->sz_rows, x->data, x->sz_cols, false,
+			  false, unit);
+
+	return 0;
+}
+
+int
+zsl_mtx_cho_solve(struct zsl_mtx *l, struct zsl_mtx *b,
+		  struct zsl_mtx *x)
+{
+	int rc;
+
+	rc = zsl_mtx_tri_prep(l, b, x, false);
+	if (rc) {
+		return rc;
+	}
+
+	/* Solve 'L * y = b', then 'L^T * x = y'. */
+	zsl_mtx_tri_solve(l->data, l->sz_rows, x->data, x->sz_cols, true,
+			  false, false);
+	zsl_mtx_tri_solve(l->data, l->sz_rows, x->data, x->sz_cols, true,
+			  true, false);
+
+	return 0;
+}
+
+int
+zsl_mtx_ldl_solve(struct zsl_mtx *ld, struct zsl_mtx *b,
+		  struct zsl_mtx *x)
+{
+	int rc;
+	size_t n = ld->sz_rows;
+	size_t c = x->sz_cols;
+	zsl_real_t d;
+
+	/* Check D with the diagonal test, but solve with unit L. */
+	rc = zsl_mtx_tri_prep(ld, b, x, false);
+	if (rc) {
+		return rc;
+	}
+
+	/* Solve 'L * z = b', then 'D * y = z', then 'L^T * x = y'. */
+	zsl_mtx_tri_solve(ld->data, n, x->data, c, true, false, true);
+	for (size_t i = 0; i < n; i++) {
+		d = ld->data[(i * n) + i];
+		for (size_t j = 0; j < c; j++) {
+			x->data[(i * c) + j] /= d;
+		}
+	}
+	zsl_mtx_tri_solve(ld->data, n, x->data, c, true, true, true);
+
+	return 0;
+}
+
+/*
+ * Applies the rank-1 update (sign = 1.0) or downdate (sign = -1.0) of
+ * 'v * v^T' to the Cholesky factor 'l', one column at a time.
+ */
+static int
+zsl_mtx_cho_rank1(struct zsl_mtx *l, struct zsl_vec *v, zsl_real_t sign)
+{
+	size_t n = l->sz_rows;
+	zsl_real_t c, s, r;
+	zsl_real_t *lk;
+	zsl_real_t *lik;
+
+	/* Make sure this is a square matrix. 'l' can be a view, which lets
+	 * the QR factor R be handled as a transposed view of L. */
+	if (l->sz_rows != l->sz_cols) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'v' matches the size of 'l'. */
+	if (v->sz != n) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < n; k++) {
+		lk = &ZSL_MTX_AT(l, k, k);
+		r = (*lk * *lk) + sign * (v->data[k] * v->data[k]);
+		/* A zero diagonal means 'l' isn't a valid Cholesky factor. */
+		if ((*lk == 0.0) || (r <= 0.0)) {
+			return -ENOTPOSDEF;
+		}
+		r = ZSL_SQRT(r);
+		c = r / *lk;
+		s = v->data[k] / *lk;
+		*lk = r;
+
+		/* Rotate (or hyperbolically rotate) the rest of column 'k'
+		 * against what is left of 'v'. */
+		for (size_t i = k + 1; i < n; i++) {
+			lik = &ZSL_MTX_AT(l, i, k);
+			*lik = (*lik + sign * s * v->data[i]) / c;
+			v->data[i] = c * v->data[i] - s * *lik;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_cho_update(struct zsl_mtx *l, struct zsl_vec *v)
+{
+	return zsl_mtx_cho_rank1(l, v, 1.0);
+}
+
+int
+zsl_mtx_cho_downdate(struct zsl_mtx *l, struct zsl_vec *v)
+{
+	return zsl_mtx_cho_rank1(l, v, -1.0);
+}
+
+/* Pointer to value (i, j) of banded matrix 'b', with j >= i - kl. */
+#define ZSL_MTX_BAND_AT(b, i, j) \
+	(&(b)->data[((i) * ZSL_MTX_BAND_WIDTH(b)) + (j) + (b)->kl - (i)])
+
+int
+zsl_mtx_band_init(struct zsl_mtx_band *b)
+{
+	memset(b->data, 0, b->sz * ZSL_MTX_BAND_WIDTH(b) * sizeof(zsl_real_t));
+
+	return 0;
+}
+
+int
+zsl_mtx_band_from_mtx(struct zsl_mtx *m, struct zsl_mtx_band *b)
+{
+	size_t jmin, jmax;
+
+	if ((m->sz_rows != b->sz) || (m->sz_cols != b->sz)) {
+		return -EINVAL;
+	}
+
+	zsl_mtx_band_init(b);
+	for (size_t i = 0; i < b->sz; i++) {
+		jmin = (i > b->kl) ? i - b->kl : 0;
+		jmax = (i + b->ku < b->sz) ? i + b->ku : b->sz - 1;
+		for (size_t j = jmin; j <= jmax; j++) {
+			*ZSL_MTX_BAND_AT(b, i, j) = ZSL_MTX_AT(m, i, j);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_band_get(struct zsl_mtx_band *b, size_t i, size_t j, zsl_real_t *x)
+{
+	if ((i >= b->sz) || (j >= b->sz)) {
+		return -EINVAL;
+	}
+
+	*x = ((j + b->kl >= i) && (j <= i + b->ku)) ?
+	     *ZSL_MTX_BAND_AT(b, i, j) : 0.0f;
+
+	return 0;
+}
+
+int
+zsl_mtx_band_set(struct zsl_mtx_band *b, size_t i, size_t j, zsl_real_t x)
+{
+	if ((i >= b->sz) || (j >= b->sz) || (j + b->kl < i) ||
+	    (j > i + b->ku)) {
+		return -EINVAL;
+	}
+
+	*ZSL_MTX_BAND_AT(b, i, j) = x;
+
+	return 0;
+}
+
+int
+zsl_mtx_band_mult_vec(struct zsl_mtx_band *b, struct zsl_vec *v,
+		      struct zsl_vec *w)
+{
+	size_t jmin, jmax;
+	zsl_real_t sum;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != b->sz) || (w->sz != b->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < b->sz; i++) {
+		jmin = (i > b->kl) ? i - b->kl : 0;
+		jmax = (i + b->ku < b->sz) ? i + b->ku : b->sz - 1;
+		sum = 0.0;
+		for (size_t j = jmin; j <= jmax; j++) {
+			sum += *ZSL_MTX_BAND_AT(b, i, j) * v->data[j];
+		}
+		w->data[i] = sum;
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_band_lu(struct zsl_mtx_band *b, size_t *piv)
+{
+	size_t n = b->sz;
+	size_t p, imax, jmax;
+	zsl_real_t max, x;
+	zsl_real_t *rk;
+	zsl_real_t *rp;
+	zsl_real_t *ri;
+
+	/* Clear the fill-in values, which must start out as zero. */
+	for (size_t i = 0; i < n; i++) {
+		memset(ZSL_MTX_BAND_AT(b, i, i + b->ku + 1), 0,
+		       b->kl * sizeof(zsl_real_t));
+	}
+
+	for (size_t k = 0; k < n; k++) {
+		imax = (k + b->kl < n) ? k + b->kl : n - 1;
+		jmax = (k + b->kl + b->ku < n) ? k + b->kl + b->ku : n - 1;
+
+		/* Find the pivot among the 'kl' values below the diagonal. */
+		p = k;
+		max = ZSL_ABS(*ZSL_MTX_BAND_AT(b, k, k));
+		for (size_t i = k + 1; i <= imax; i++) {
+			if (ZSL_ABS(*ZSL_MTX_BAND_AT(b, i, k)) > max) {
+				max = ZSL_ABS(*ZSL_MTX_BAND_AT(b, i, k));
+				p = i;
+			}
+		}
+
+		/* Swap the pivot row into position 'k'. Columns k..jmax of
+		 * both rows are always within the stored band. */
+		piv[k] = p;
+		rk = ZSL_MTX_BAND_AT(b, k, k);
+		if (p != k) {
+			rp = ZSL_MTX_BAND_AT(b, p, k);
+			for (size_t j = 0; j <= jmax - k; j++) {
+				x = rk[j];
+				rk[j] = rp[j];
+				rp[j] = x;
+			}
+		}
+
+		if (rk[0] == 0.0) {
+			continue;
+		}
+
+		/* Eliminate column 'k' from the rows below. */
+		for (size_t i = k + 1; i <= imax; i++) {
+			ri = ZSL_MTX_BAND_AT(b, i, k);
+			ri[0] /= rk[0];
+			x = ri[0];
+			if (x == 0.0) {
+				continue;
+			}
+			for (size_t j = 1; j <= jmax - k; j++) {
+				ri[j] -= x * rk[j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_band_lu_solve(struct zsl_mtx_band *lu, size_t *piv,
+		      struct zsl_vec *b, struct zsl_vec *x)
+{
+	size_t n = lu->sz;
+	size_t imax, jmax;
+	zsl_real_t s, d;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Check for a singular matrix before modifying 'x'. */
+	for (size_t i = 0; i < n; i++) {
+		if (*ZSL_MTX_BAND_AT(lu, i, i) == 0.0) {
+			return -ESINGULAR;
+		}
+	}
+
+	if (x->data != b->data) {
+		memcpy(x->data, b->data, n * sizeof(zsl_real_t));
+	}
+
+	/* Forward substitution with the row swaps and unit L. */
+	for (size_t k = 0; k < n; k++) {
+		if (piv[k] != k) {
+			s = x->data[k];
+			x->data[k] = x->data[piv[k]];
+			x->data[piv[k]] = s;
+		}
+		imax = (k + lu->kl < n) ? k + lu->kl : n - 1;
+		for (size_t i = k + 1; i <= imax; i++) {
+			x->data[i] -= *ZSL_MTX_BAND_AT(lu, i, k) * x->data[k];
+		}
+	}
+
+	/* Back substitution with U, of bandwidth kl + ku. */
+	for (size_t i = n; i-- > 0;) {
+		jmax = (i + lu->kl + lu->ku < n) ? i + lu->kl + lu->ku : n - 1;
+		s = x->data[i];
+		for (size_t j = i + 1; j <= jmax; j++) {
+			s -= *ZSL_MTX_BAND_AT(lu, i, j) * x->data[j];
+		}
+		d = *ZSL_MTX_BAND_AT(lu, i, i);
+		x->data[i] = s / d;
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_tridiag_solve(struct zsl_vec *a, struct zsl_vec *b,
+		      struct zsl_vec *c, struct zsl_vec *d,
+		      struct zsl_vec *x)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_tridiag_solve_ws_size(b->sz));
+
+	return zsl_mtx_tridiag_solve_ws(a, b, c, d, x, &ws);
+}
+
+int
+zsl_mtx_tridiag_solve_ws(struct zsl_vec *a, struct zsl_vec *b,
+			 struct zsl_vec *c, struct zsl_vec *d,
+			 struct zsl_vec *x, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t n = b->sz;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t m;
+	zsl_real_t *cp;
+
+	if ((n == 0) || (a->sz != n - 1) || (c->sz != n - 1) ||
+	    (d->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+
+	/* 'cp' holds the modified super-diagonal, and the modified
+	 * right-hand side is built in 'x', which allows 'x' to be 'd'. */
+	cp = zsl_ws_alloc(ws, n * sizeof(zsl_real_t));
+	if (cp == NULL) {
+		return -ENOMEM;
+	}
+
+	m = b->data[0];
+	for (size_t i = 0; i < n; i++) {
+		if (i > 0) {
+			m = b->data[i] - a->data[i - 1] * cp[i - 1];
+		}
+		if (m == 0.0) {
+			rc = -ESINGULAR;
+			goto err;
+		}
+		cp[i] = (i < n - 1) ? c->data[i] / m : 0.0f;
+		x->data[i] = (i > 0) ?
+			     (d->data[i] - a->data[i - 1] * x->data[i - 1]) / m :
+			     d->data[0] / m;
+	}
+
+	for (size_t i = n - 1; i-- > 0;) {
+		x->data[i] -= cp[i] * x->data[i + 1];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_tridiag_solve_ws_size(size_t n)
+{
+	return ZSL_WS_REALS(n);
+}
+
+int
+zsl_mtx_balance(struct zsl_mtx *m, struct zsl_mtx *mout)
+{
+	int rc;
+	bool done = false;
+	zsl_real_t sum;
+	zsl_real_t row, row2;
+	zsl_real_t col, col2;
+
+	/* Make sure we have square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (mout->sz_rows != mout->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'mout' have the same shape. */
+	if (m->sz_rows != mout->sz_rows) {
+		return -EINVAL;
+	}
+	if (m->sz_cols != mout->sz_cols) {
+		return -EINVAL;
+	}
+#endif
+
+	rc = zsl_mtx_copy(mout, m);
+	if (rc) {
+		goto err;
+	}
+
+	while (!done) {
+		done = true;
+
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			/* Calculate sum of components of each row, column. */
+			for (size_t j = 0; j < m->sz_cols; j++) {
+				row += ZSL_ABS(mout->data[(i * m->sz_rows) +
+							  j]);
+				col += ZSL_ABS(mout->data[(j * m->sz_rows) +
+							  i]);
+			}
+
+			/* TODO: Extend with a check against epsilon? */
+			if (col != 0.0 && row != 0.0) {
+				row2 = row / 2.0;
+				col2 = 1.0;
+				sum = col + row;
+
+				while (col < row2) {
+					col2 *= 2.0;
+					col *= 4.0;
+				}
+
+				row2 = row * 2.0;
+
+				while (col > row2) {
+					col2 /= 2.0;
+					col /= 4.0;
+				}
+
+				if ((col + row) / col2 < 0.95 * sum) {
+					done = false;
+					row2 = 1.0 / col2;
+
+					for (int k = 0; k < m->sz_rows; k++) {
+						mout->data[(i * m->sz_rows) + k]
+							*= row2;
+						mout->data[(k * m->sz_rows) + i]
+							*= col2;
+					}
+				}
+			}
+
+			row = 0.0;
+			col = 0.0;
+		}
+	}
+
+err:
+	return rc;
+}
+
+int
+zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg)
+{
+	size_t size = m->sz_rows;
+
+	if (hessenberg == true) {
+		size--;
+	}
+
+	ZSL_VECTOR_DEF(v, size);
+	ZSL_VECTOR_DEF(v2, m->sz_rows);
+	ZSL_VECTOR_DEF(e1, size);
+
+	/* Create the e1 vector, i.e. the vector (1, 0, 0, ...). */
+	zsl_vec_init(&e1);
+	e1.data[0] = 1.0;
+
+	/* Get the first column of the input matrix. */
+	zsl_mtx_get_col(m, 0, v2.data);
+	if (hessenberg == true) {
+		zsl_vec_get_subset(&v2, 1, size, &v);
+	} else {
+		zsl_vec_copy(&v, &v2);
+	}
+
+	/* Change the 'sign' value according to the sign of the first
+	 * coefficient of the matrix. */
+	zsl_real_t sign = 1.0;
+	if (v.data[0] < 0) {
+		sign = -1.0;
+	}
+
+	/* Calculate the vector 'v' that will later be used to calculate the
+	 * Householder matrix. */
+	zsl_vec_scalar_mult(&e1, -sign * zsl_vec_norm(&v));
 
 	zsl_vec_add(&v, &e1, &v);
 
-	zsl_vec_scalar_div(&v, zsl_vec_norm(&v));
+	zsl_vec_scalar_div(&v, zsl_vec_norm(&v));
+
+	/* Calculate the H householder matrix by doing:
+	 * H = IDENTITY - 2 * v * v^t, writing it directly into 'h'. If
+	 * Hessenberg is set to true, 'H' is augmented to the size of 'm' with
+	 * a leading one on the diagonal. */
+	zsl_mtx_init(h, zsl_mtx_entry_fn_identity);
+	size_t d = h->sz_rows - size;
+	struct zsl_mtx hv;
+
+	zsl_mtx_view(h, &hv, d, d, size, size);
+	zsl_mtx_ger(-2.0, &v, &v, &hv);
+
+	return 0;
+}
+
+/*
+ * Generates the Householder reflector H = I - tau * v * v^T that maps the
+ * 'n' entries of 'x' (read with a stride of 'inc') onto beta * e1, with
+ * beta taking the sign of x[0]. x[0] is overwritten with beta and
+ * x[1..n-1] with v[1..n-1], v[0] = 1 being implicit. Returns tau, which is
+ * zero when the entries below x[0] are already negligible.
+ *
+ * Since beta has the same sign as x[0], v0 = x[0] - beta is obtained as
+ * -|x'|^2 / (x[0] + beta) to avoid cancellation, with x' = x[1..n-1]. The
+ * entries are scaled by their largest magnitude first, and v0 is never
+ * formed explicitly, so that tiny subdiagonals (as found late in the QR
+ * method) neither underflow nor produce a non-orthogonal H.
+ */
+static zsl_real_t
+zsl_mtx_hh_gen(zsl_real_t *x, size_t n, size_t inc)
+{
+	zsl_real_t s = 0.0;
+	zsl_real_t sigma = 0.0;
+	zsl_real_t alpha, xnorm, beta, r, d;
+
+	for (size_t i = 0; i < n; i++) {
+		if (ZSL_ABS(x[i * inc]) > s) {
+			s = ZSL_ABS(x[i * inc]);
+		}
+	}
+
+	if (s == 0.0) {
+		return 0.0;
+	}
+
+	alpha = x[0] / s;
+	for (size_t i = 1; i < n; i++) {
+		d = x[i * inc] / s;
+		sigma += d * d;
+	}
+
+	xnorm = ZSL_SQRT(sigma);
+	if (xnorm <= ZSL_EPSILON * ZSL_ABS(alpha)) {
+		return 0.0;
+	}
+
+	beta = ZSL_SQRT(alpha * alpha + sigma);
+	if (alpha < 0) {
+		beta = -beta;
+	}
+
+	/* v0 = -xnorm * r, with |r| <= 1. */
+	r = xnorm / (alpha + beta);
+	for (size_t i = 1; i < n; i++) {
+		x[i * inc] = -((x[i * inc] / s) / xnorm) / r;
+	}
+	x[0] = beta * s;
+
+	return r * xnorm / beta;
+}
+
+/*
+ * Applies H = I - tau * v * v^T from the left to the 'rows' x 'cols' block
+ * starting at 'a' (row stride 'ld'). v[0] = 1 is implicit, v[1..rows-1]
+ * are read from 'v' with a stride of 'inc'.
+ */
+struct zsl_mtx_hh_job {
+	const zsl_real_t *v;
+	size_t inc;
+	zsl_real_t tau;
+	zsl_real_t *a;
+	size_t ld;
+	size_t rows;
+};
+
+static int
+zsl_mtx_hh_apply_left_part(void *ctx, size_t start, size_t end)
+{
+	struct zsl_mtx_hh_job *job = ctx;
+	const zsl_real_t *v = job->v;
+	zsl_real_t *a = job->a;
+	size_t inc = job->inc;
+	size_t ld = job->ld;
+	zsl_real_t w;
+
+	for (size_t j = start; j < end; j++) {
+		w = a[j];
+		for (size_t i = 1; i < job->rows; i++) {
+			w += v[i * inc] * a[(i * ld) + j];
+		}
+		w *= job->tau;
+		a[j] -= w;
+		for (size_t i = 1; i < job->rows; i++) {
+			a[(i * ld) + j] -= w * v[i * inc];
+		}
+	}
+
+	return 0;
+}
+
+static void
+zsl_mtx_hh_apply_left(const zsl_real_t *v, size_t inc, zsl_real_t tau,
+		      zsl_real_t *a, size_t ld, size_t rows, size_t cols)
+{
+	struct zsl_mtx_hh_job job = {
+		.v = v,
+		.inc = inc,
+		.tau = tau,
+		.a = a,
+		.ld = ld,
+		.rows = rows
+	};
+
+	if (tau == 0.0) {
+		return;
+	}
+
+	/* Each column is updated independently, so the columns are split
+	 * across the thread pool. */
+	zsl_threads_for(cols, 2 * rows * cols, zsl_mtx_hh_apply_left_part,
+			&job);
+}
+
+/*
+ * Applies H = I - tau * v * v^T from the right to the 'rows' x 'cols' block
+ * starting at 'a' (row stride 'ld'). v has 'cols' entries, laid out as in
+ * zsl_mtx_hh_apply_left.
+ */
+static void
+zsl_mtx_hh_apply_right(const zsl_real_t *v, size_t inc, zsl_real_t tau,
+		       zsl_real_t *a, size_t ld, size_t rows, size_t cols)
+{
+	zsl_real_t w;
+	zsl_real_t *ar;
+
+	if (tau == 0.0) {
+		return;
+	}
+
+	for (size_t i = 0; i < rows; i++) {
+		ar = &a[i * ld];
+		w = ar[0];
+		for (size_t j = 1; j < cols; j++) {
+			w += v[j * inc] * ar[j];
+		}
+		w *= tau;
+		ar[0] -= w;
+		for (size_t j = 1; j < cols; j++) {
+			ar[j] -= w * v[j * inc];
+		}
+	}
+}
+
+/*
+ * Reduces the n x n matrix 'a' to Hessenberg form in place with two-sided
+ * reflections, H_c being built from column 'c' below the subdiagonal. If
+ * 'q' isn't NULL, it is multiplied from the right by each H_c.
+ */
+static void
+zsl_mtx_hess_reduce(zsl_real_t *a, size_t n, zsl_real_t *q)
+{
+	zsl_real_t tau;
+
+	for (size_t c = 0; (c + 2) < n; c++) {
+		zsl_real_t *x = &a[((c + 1) * n) + c];
+
+		tau = zsl_mtx_hh_gen(x, n - c - 1, n);
+		zsl_mtx_hh_apply_left(x, n, tau, x + 1, n, n - c - 1,
+				      n - c - 1);
+		zsl_mtx_hh_apply_right(x, n, tau, &a[c + 1], n, n,
+				       n - c - 1);
+		if (q != NULL) {
+			zsl_mtx_hh_apply_right(x, n, tau, &q[c + 1], n, n,
+					       n - c - 1);
+		}
+
+		for (size_t i = c + 2; i < n; i++) {
+			a[(i * n) + c] = 0.0;
+		}
+	}
+}
+
+int
+zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+	    bool hessenberg)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_qrd_ws_size(m->sz_rows, m->sz_cols));
+
+	return zsl_mtx_qrd_ws(m, q, r, hessenberg, &ws);
+}
+
+int
+zsl_mtx_qrd_ws(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+	       bool hessenberg, struct zsl_workspace *ws)
+{
+	size_t n = m->sz_rows;
+	size_t k = n < m->sz_cols ? n : m->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((q->sz_rows != n) || (q->sz_cols != n) ||
+	    (r->sz_rows != n) || (r->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+	if ((hessenberg == true) && (m->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_mtx_copy(r, m);
+	zsl_mtx_init(q, zsl_mtx_entry_fn_identity);
+
+	if (hessenberg == false) {
+		size_t mark = zsl_ws_mark(ws);
+		struct zsl_vec t;
+
+		if (zsl_ws_vec(ws, &t, k)) {
+			return -ENOMEM;
+		}
+
+		/* Factor in place, then expand Q from the stored reflectors
+		 * before clearing them out of the lower triangle of 'r'. */
+		zsl_mtx_qrd_compact(r, r, &t);
+		zsl_mtx_qrd_apply_q(r, &t, q);
+		zsl_ws_release(ws, mark);
+
+		for (size_t i = 1; i < n; i++) {
+			for (size_t j = 0; j < i && j < r->sz_cols; j++) {
+				r->data[(i * r->sz_cols) + j] = 0.0;
+			}
+		}
+
+		return 0;
+	}
+
+	zsl_mtx_hess_reduce(r->data, n, q->data);
+
+	return 0;
+}
+
+size_t
+zsl_mtx_qrd_ws_size(size_t m, size_t n)
+{
+	return ZSL_WS_REALS(m < n ? m : n);
+}
+
+int
+zsl_mtx_qrd_compact(struct zsl_mtx *m, struct zsl_mtx *qr,
+		    struct zsl_vec *tau)
+{
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	size_t k = rows < cols ? rows : cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((qr->sz_rows != rows) || (qr->sz_cols != cols) || (tau->sz != k)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (qr != m) {
+		zsl_mtx_copy(qr, m);
+	}
+
+	for (size_t c = 0; c < k; c++) {
+		zsl_real_t *x = &qr->data[(c * cols) + c];
+
+		tau->data[c] = zsl_mtx_hh_gen(x, rows - c, cols);
+		zsl_mtx_hh_apply_left(x, cols, tau->data[c], x + 1, cols,
+				      rows - c, cols - c - 1);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_apply_q(struct zsl_mtx *qr, struct zsl_vec *tau,
+		    struct zsl_mtx *b)
+{
+	size_t rows = qr->sz_rows;
+	size_t cols = qr->sz_cols;
+	size_t k = rows < cols ? rows : cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((b->sz_rows != rows) || (tau->sz != k)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Q = H_0 * H_1 * ... * H_(k-1), so the last reflector goes first. */
+	for (size_t c = k; c-- > 0;) {
+		zsl_mtx_hh_apply_left(&qr->data[(c * cols) + c], cols,
+				      tau->data[c], &b->data[c * b->sz_cols],
+				      b->sz_cols, rows - c, b->sz_cols);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_apply_qt(struct zsl_mtx *qr, struct zsl_vec *tau,
+		     struct zsl_mtx *b)
+{
+	size_t rows = qr->sz_rows;
+	size_t cols = qr->sz_cols;
+	size_t k = rows < cols ? rows : cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((b->sz_rows != rows) || (tau->sz != k)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t c = 0; c < k; c++) {
+		zsl_mtx_hh_apply_left(&qr->data[(c * cols) + c], cols,
+				      tau->data[c], &b->data[c * b->sz_cols],
+				      b->sz_cols, rows - c, b->sz_cols);
+	}
+
+	return 0;
+}
+
+/*
+ * Calculates the Givens rotation (c, s) that maps (a, b) onto (h, 0), with
+ * h = c * a + s * b and 0 = c * b - s * a, and returns h.
+ */
+static zsl_real_t
+zsl_mtx_givens(zsl_real_t a, zsl_real_t b, zsl_real_t *c, zsl_real_t *s)
+{
+	zsl_real_t h;
+
+	if (b == 0.0) {
+		*c = 1.0;
+		*s = 0.0;
+		return a;
+	}
+
+	h = ZSL_SQRT((a * a) + (b * b));
+	*c = a / h;
+	*s = b / h;
+
+	return h;
+}
+
+/*
+ * Applies the Givens rotation (c, s) to the 'n' pairs of values x[k * incx]
+ * and y[k * incy].
+ */
+static void
+zsl_mtx_givens_apply(zsl_real_t *x, size_t incx, zsl_real_t *y, size_t incy,
+		     size_t n, zsl_real_t c, zsl_real_t s)
+{
+	zsl_real_t t;
+
+	for (size_t k = 0; k < n; k++) {
+		t = x[k * incx];
+		x[k * incx] = (c * t) + (s * y[k * incy]);
+		y[k * incy] = (c * y[k * incy]) - (s * t);
+	}
+}
+
+/*
+ * Rotates the row 'w' of n values into the n x n upper triangular factor
+ * 'r' (with element (i, j) at r[i * rrs + j * rcs]), zeroing 'w'. The
+ * 'nrhs' values of 'wb' are rotated along with it into the contiguous
+ * n x nrhs matrix 'qtb', if not NULL.
+ */
+static void
+zsl_mtx_givens_add_row(zsl_real_t *r, size_t rrs, size_t rcs, size_t n,
+		       zsl_real_t *w, zsl_real_t *qtb, size_t nrhs,
+		       zsl_real_t *wb)
+{
+	zsl_real_t c, s;
+	zsl_real_t *rii;
+
+	for (size_t i = 0; i < n; i++) {
+		if (w[i] == 0.0) {
+			continue;
+		}
+		rii = &r[(i * rrs) + (i * rcs)];
+		*rii = zsl_mtx_givens(*rii, w[i], &c, &s);
+		w[i] = 0.0;
+		zsl_mtx_givens_apply(&rii[rcs], rcs, &w[i + 1], 1, n - i - 1,
+				     c, s);
+		if (qtb != NULL) {
+			zsl_mtx_givens_apply(&qtb[i * nrhs], 1, wb, 1, nrhs,
+					     c, s);
+		}
+	}
+}
+
+int
+zsl_mtx_qrd_update_row(struct zsl_mtx *r, struct zsl_vec *v)
+{
+	size_t n = r->sz_cols;
 
-	/* Calculate the H householder matrix by doing:
-	 * H = IDENTITY - 2 * v * v^t. */
-	zsl_mtx_from_arr(&mv, v.data);
-	zsl_mtx_trans(&mv, &mvt);
-	zsl_mtx_mult(&mv, &mvt, &vvt);
-	zsl_mtx_init(&id, zsl_mtx_entry_fn_identity);
-	zsl_mtx_scalar_mult_d(&vvt, -2);
-	zsl_mtx_add(&id, &vvt, &h2);
+	if (r->sz_rows < n) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != n) {
+		return -EINVAL;
+	}
+#endif
 
-	/* If Hessenberg set to true, augment the output to the size of 'm'.
-	 * If Hessenberg set to false, this line of code will do nothing but
-	 * copy the matrix 'h2' into the output matrix 'h', */
-	zsl_mtx_augm_diag(&h2, h);
+	zsl_mtx_givens_add_row(r->data, ZSL_MTX_ROW_STEP(r),
+			       ZSL_MTX_COL_STEP(r), n, v->data, NULL, 0, NULL);
 
 	return 0;
 }
 
 int
-zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
-	    bool hessenberg)
+zsl_mtx_qrd_downdate_row(struct zsl_mtx *r, struct zsl_vec *v)
 {
-	ZSL_MATRIX_DEF(r2, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(hess, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(h, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(h2, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(qt, m->sz_rows, m->sz_rows);
+	size_t n = r->sz_cols;
+	struct zsl_mtx rv;
 
-	zsl_mtx_init(&h, NULL);
-	zsl_mtx_init(&qt, zsl_mtx_entry_fn_identity);
-	zsl_mtx_copy(r, m);
+	if (r->sz_rows < n) {
+		return -EINVAL;
+	}
+
+	/* R^T * R = L * L^T with L = R^T, so removing the row is a Cholesky
+	 * downdate of a transposed view of the top n x n block of 'r'. */
+	zsl_mtx_view(r, &rv, 0, 0, n, n);
+	zsl_mtx_trans_view(&rv, &rv);
 
-	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
+	return zsl_mtx_cho_rank1(&rv, v, -1.0);
+}
 
-		/* Reduce the matrix by 'g' rows and columns each time. */
-		ZSL_MATRIX_DEF(mred, (m->sz_rows - g), (m->sz_cols - g));
-		ZSL_MATRIX_DEF(hred, (m->sz_rows - g), (m->sz_rows - g));
-		zsl_mtx_reduce_iter(r, &mred);
+int
+zsl_mtx_qrd_update(struct zsl_mtx *q, struct zsl_mtx *r, struct zsl_vec *u,
+		   struct zsl_vec *v)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_qrd_update_ws_size(q->sz_rows));
 
-		/* Calculate the reduced Householder matrix 'hred'. */
-		if (hessenberg == true) {
-			zsl_mtx_householder(&mred, &hred, true);
-		} else {
-			zsl_mtx_householder(&mred, &hred, false);
+	return zsl_mtx_qrd_update_ws(q, r, u, v, &ws);
+}
+
+int
+zsl_mtx_qrd_update_ws(struct zsl_mtx *q, struct zsl_mtx *r,
+		      struct zsl_vec *u, struct zsl_vec *v,
+		      struct zsl_workspace *ws)
+{
+	size_t m = q->sz_rows;
+	size_t n = r->sz_cols;
+	size_t qrs = ZSL_MTX_ROW_STEP(q);
+	size_t rcs = ZSL_MTX_COL_STEP(r);
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t c, s;
+	struct zsl_vec w;
+
+	if (m == 0) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((q->sz_cols != m) || (r->sz_rows != m) || (u->sz != m) ||
+	    (v->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (zsl_ws_vec(ws, &w, m)) {
+		return -ENOMEM;
+	}
+
+	/* w = Q^T * u, so that A + u * v^T = Q * (R + w * v^T). */
+	zsl_mtx_gemv(true, 1.0, q, u, 0.0, &w);
+
+	/* Zero w from the bottom up, which turns R into an upper Hessenberg
+	 * matrix, and the rank-1 term into a change of its first row. */
+	for (size_t k = m - 1; k > 0; k--) {
+		w.data[k - 1] = zsl_mtx_givens(w.data[k - 1], w.data[k], &c, &s);
+		w.data[k] = 0.0;
+		zsl_mtx_givens_apply(&ZSL_MTX_AT(r, k - 1, 0), rcs,
+				     &ZSL_MTX_AT(r, k, 0), rcs, n, c, s);
+		zsl_mtx_givens_apply(&ZSL_MTX_AT(q, 0, k - 1), qrs,
+				     &ZSL_MTX_AT(q, 0, k), qrs, m, c, s);
+	}
+	for (size_t j = 0; j < n; j++) {
+		ZSL_MTX_AT(r, 0, j) += w.data[0] * v->data[j];
+	}
+
+	/* Restore the upper triangular form of R. */
+	for (size_t k = 0; (k < n) && (k + 1 < m); k++) {
+		zsl_mtx_givens(ZSL_MTX_AT(r, k, k), ZSL_MTX_AT(r, k + 1, k),
+			       &c, &s);
+		zsl_mtx_givens_apply(&ZSL_MTX_AT(r, k, 0), rcs,
+				     &ZSL_MTX_AT(r, k + 1, 0), rcs, n, c, s);
+		ZSL_MTX_AT(r, k + 1, k) = 0.0;
+		zsl_mtx_givens_apply(&ZSL_MTX_AT(q, 0, k), qrs,
+				     &ZSL_MTX_AT(q, 0, k + 1), qrs, m, c, s);
+	}
+
+	zsl_ws_release(ws, mark);
+
+	return 0;
+}
+
+size_t
+zsl_mtx_qrd_update_ws_size(size_t m)
+{
+	return ZSL_WS_REALS(m);
+}
+
+int
+zsl_mtx_lstsq_init(struct zsl_mtx_lstsq *ls)
+{
+	zsl_mtx_init(&ls->r, NULL);
+	zsl_mtx_init(&ls->qtb, NULL);
+	zsl_vec_init(&ls->ssr);
+	ls->rows = 0;
+
+	return 0;
+}
+
+int
+zsl_mtx_lstsq_add(struct zsl_mtx_lstsq *ls, struct zsl_mtx *a,
+		  struct zsl_mtx *b)
+{
+	size_t n = ls->r.sz_rows;
+	size_t nrhs = ls->qtb.sz_cols;
+	zsl_real_t *w = ls->work.data;
+	zsl_real_t *wb = &ls->work.data[n];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((a->sz_cols != n) || (b->sz_cols != nrhs) ||
+	    (a->sz_rows != b->sz_rows) || (ls->work.sz < n + nrhs)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < a->sz_rows; k++) {
+		/* Take a copy of the new row, so 'a' and 'b' aren't modified. */
+		for (size_t j = 0; j < n; j++) {
+			w[j] = a->data[(k * ZSL_MTX_ROW_STEP(a)) +
+				       (j * ZSL_MTX_COL_STEP(a))];
+		}
+		for (size_t j = 0; j < nrhs; j++) {
+			wb[j] = b->data[(k * ZSL_MTX_ROW_STEP(b)) +
+					(j * ZSL_MTX_COL_STEP(b))];
 		}
 
-		/* Augment the Householder matrix to the input matrix size. */
-		zsl_mtx_augm_diag(&hred, &h);
-		zsl_mtx_mult(&h, r, &r2);
+		/* Zero the row one column at a time, rotating it against R
+		 * and Q^T * b. */
+		zsl_mtx_givens_add_row(ls->r.data, n, 1, n, w, ls->qtb.data,
+				       nrhs, wb);
 
-		/* Multiply this Householder matrix by the previous ones,
-		 * stacked in 'qt'. */
-		zsl_mtx_mult(&h, &qt, &h2);
-		zsl_mtx_copy(&qt, &h2);
-		if (hessenberg == true) {
-			zsl_mtx_mult(&r2, &h, &hess);
-			zsl_mtx_copy(r, &hess);
-		} else {
-			zsl_mtx_copy(r, &r2);
+		/* What's left of 'b' is orthogonal to the columns of 'A'. */
+		for (size_t j = 0; j < nrhs; j++) {
+			ls->ssr.data[j] += wb[j] * wb[j];
 		}
 	}
 
-	/* Calculate the 'q' matrix by transposing 'qt'. */
-	zsl_mtx_trans(&qt, q);
+	ls->rows += a->sz_rows;
 
 	return 0;
 }
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+int
+zsl_mtx_lstsq_solve(struct zsl_mtx_lstsq *ls, struct zsl_mtx *x,
+		    struct zsl_vec *res)
+{
+	size_t n = ls->r.sz_rows;
+	zsl_real_t d;
+	zsl_real_t dmax = 0.0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((res != NULL) && (res->sz != ls->qtb.sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Treat diagonal values that are negligible next to the largest one
+	 * as zero, since 'A' is then numerically rank deficient. */
+	for (size_t i = 0; i < n; i++) {
+		d = ZSL_ABS(ls->r.data[(i * n) + i]);
+		dmax = d > dmax ? d : dmax;
+	}
+	for (size_t i = 0; i < n; i++) {
+		d = ZSL_ABS(ls->r.data[(i * n) + i]);
+		if (d <= (zsl_real_t)n * ZSL_EPSILON * dmax) {
+			return -ESINGULAR;
+		}
+	}
+
+	if (res != NULL) {
+		for (size_t j = 0; j < res->sz; j++) {
+			res->data[j] = ZSL_SQRT(ls->ssr.data[j]);
+		}
+	}
+
+	return zsl_mtx_solve_upper(&ls->r, &ls->qtb, x, false);
+}
+
+int
+zsl_mtx_lstsq(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x,
+	      struct zsl_vec *res)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_lstsq_ws_size(a->sz_cols, b->sz_cols));
+
+	return zsl_mtx_lstsq_ws(a, b, x, res, &ws);
+}
+
+int
+zsl_mtx_lstsq_ws(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x,
+		 struct zsl_vec *res, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->sz_cols;
+	size_t nrhs = b->sz_cols;
+	size_t mark = zsl_ws_mark(ws);
+	struct zsl_mtx_lstsq ls;
+
+	if (zsl_ws_mtx(ws, &ls.r, n, n) || zsl_ws_mtx(ws, &ls.qtb, n, nrhs) ||
+	    zsl_ws_vec(ws, &ls.ssr, nrhs) ||
+	    zsl_ws_vec(ws, &ls.work, n + nrhs)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_mtx_lstsq_init(&ls);
+	rc = zsl_mtx_lstsq_add(&ls, a, b);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_mtx_lstsq_solve(&ls, x, res);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_lstsq_ws_size(size_t n, size_t nrhs)
+{
+	return ZSL_WS_REALS(n * n) + ZSL_WS_REALS(n * nrhs) +
+	       ZSL_WS_REALS(nrhs) + ZSL_WS_REALS(n + nrhs);
+}
+
+/* Degree of the diagonal Pade approximant used by zsl_mtx_expm. */
+#define ZSL_MTX_EXPM_PADE (6)
+
+int
+zsl_mtx_expm(struct zsl_mtx *m, struct zsl_mtx *e)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_expm_ws_size(m->sz_rows));
+
+	return zsl_mtx_expm_ws(m, e, &ws);
+}
+
+int
+zsl_mtx_expm_ws(struct zsl_mtx *m, struct zsl_mtx *e,
+		struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	size_t q = ZSL_MTX_EXPM_PADE;
+	size_t sq = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t *piv;
+	zsl_real_t nrm = 0.0;
+	zsl_real_t x, c;
+	struct zsl_mtx a, p, t, d, tmp;
+
+	if ((m->sz_rows != m->sz_cols) || (e->sz_rows != n) ||
+	    (e->sz_cols != n) || !ZSL_MTX_IS_CONTIG(e)) {
+		return -EINVAL;
+	}
+
+	piv = zsl_ws_alloc(ws, n * sizeof(size_t));
+	if ((piv == NULL) || zsl_ws_mtx(ws, &a, n, n) ||
+	    zsl_ws_mtx(ws, &p, n, n) || zsl_ws_mtx(ws, &t, n, n) ||
+	    zsl_ws_mtx(ws, &d, n, n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* Scale 'm' by 2^-sq so that its infinity norm is at most 0.5, for
+	 * which the [6/6] Pade approximant is accurate to full double
+	 * precision. */
+	zsl_mtx_copy(&a, m);
+	for (size_t i = 0; i < n; i++) {
+		x = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			x += ZSL_ABS(a.data[(i * n) + j]);
+		}
+		nrm = x > nrm ? x : nrm;
+	}
+	for (c = 1.0; nrm * c > 0.5f; c *= 0.5f) {
+		sq++;
+	}
+	zsl_mtx_scalar_mult_d(&a, c);
+
+	/* Sum the numerator N(A) into 'e' and the denominator D(A) = N(-A)
+	 * into 'd', using 'p' for the powers of A. */
+	zsl_mtx_init(e, zsl_mtx_entry_fn_identity);
+	zsl_mtx_init(&d, zsl_mtx_entry_fn_identity);
+	zsl_mtx_copy(&p, &a);
+	c = 1.0;
+	for (size_t k = 1; k <= q; k++) {
+		if (k > 1) {
+			zsl_mtx_mult(&a, &p, &t);
+			tmp = p;
+			p = t;
+			t = tmp;
+		}
+		c *= (zsl_real_t)(q - k + 1) / (zsl_real_t)(k * (2 * q - k + 1));
+		for (size_t g = 0; g < n * n; g++) {
+			x = c * p.data[g];
+			e->data[g] += x;
+			d.data[g] += (k & 1) ? -x : x;
+		}
+	}
+
+	/* exp(A) ~= D(A)^-1 * N(A). */
+	rc = zsl_mtx_lu(&d, &d, piv);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_mtx_lu_solve(&d, piv, e, e);
+	if (rc) {
+		goto err;
+	}
+
+	/* Undo the scaling by squaring the result 'sq' times. */
+	for (size_t k = 0; k < sq; k++) {
+		zsl_mtx_mult(e, e, &t);
+		zsl_mtx_copy(e, &t);
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_expm_ws_size(size_t n)
+{
+	return ZSL_WS_BYTES(n * sizeof(size_t)) + 4 * ZSL_WS_REALS(n * n);
+}
+
+int
+zsl_mtx_van_loan(struct zsl_mtx *a, struct zsl_mtx *q, zsl_real_t dt,
+		 struct zsl_mtx *ad, struct zsl_mtx *qd)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_van_loan_ws_size(a->sz_rows));
+
+	return zsl_mtx_van_loan_ws(a, q, dt, ad, qd, &ws);
+}
+
+int
+zsl_mtx_van_loan_ws(struct zsl_mtx *a, struct zsl_mtx *q, zsl_real_t dt,
+		    struct zsl_mtx *ad, struct zsl_mtx *qd,
+		    struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->sz_rows;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t x;
+	struct zsl_mtx mb, eb, g12, g22;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((a->sz_cols != n) || (q->sz_rows != n) || (q->sz_cols != n) ||
+	    (ad->sz_rows != n) || (ad->sz_cols != n) ||
+	    (qd->sz_rows != n) || (qd->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (!ZSL_MTX_IS_CONTIG(qd)) {
+		return -EINVAL;
+	}
+
+	if (zsl_ws_mtx(ws, &mb, 2 * n, 2 * n) ||
+	    zsl_ws_mtx(ws, &eb, 2 * n, 2 * n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* M = [ -A  Q ; 0  A^T ] * dt. */
+	zsl_mtx_init(&mb, NULL);
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			zsl_mtx_get(a, i, j, &x);
+			mb.data[(i * 2 * n) + j] = -x * dt;
+			mb.data[((n + j) * 2 * n) + n + i] = x * dt;
+			zsl_mtx_get(q, i, j, &x);
+			mb.data[(i * 2 * n) + n + j] = x * dt;
+		}
+	}
+
+	rc = zsl_mtx_expm_ws(&mb, &eb, ws);
+	if (rc) {
+		goto err;
+	}
+
+	/* exp(M) = [ .  G12 ; 0  G22 ], with Ad = G22^T and Qd = Ad * G12. */
+	zsl_mtx_view(&eb, &g12, 0, n, n, n);
+	zsl_mtx_view(&eb, &g22, n, n, n, n);
+	zsl_mtx_trans_view(&g22, &g22);
+	zsl_mtx_copy(ad, &g22);
+	zsl_mtx_mult(&g22, &g12, qd);
+
+	/* Remove the rounding asymmetry of Qd. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			x = 0.5f * (qd->data[(i * n) + j] +
+				   qd->data[(j * n) + i]);
+			qd->data[(i * n) + j] = x;
+			qd->data[(j * n) + i] = x;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_van_loan_ws_size(size_t n)
+{
+	return 2 * ZSL_WS_REALS(4 * n * n) + zsl_mtx_expm_ws_size(2 * n);
+}
+
 int
 zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter)
 {
 	int rc;
 
+	size_t n = m->sz_rows;
+
 	/* Use scratch memory to avoid stack overflow when these functions
 	 * are called recursively. */
 	#ifdef CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH
 	ZSL_QRD_SCRATCH_1_CLEAR;
-	struct zsl_mtx q = {
-		.sz_rows = m->sz_rows,
-		.sz_cols = m->sz_rows,
+	struct zsl_mtx qr = {
+		.sz_rows = n,
+		.sz_cols = n,
 		.data = scrd_1
 	};
-
-	ZSL_QRD_SCRATCH_2_CLEAR;
-	struct zsl_mtx r = {
-		.sz_rows = m->sz_rows,
-		.sz_cols = m->sz_rows,
-		.data = scrd_2
-	};
 	#else
-	/* Use stack ... this will get HUGE though!!! */
-	ZSL_MATRIX_DEF(q, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(r, m->sz_rows, m->sz_rows);
+	ZSL_MATRIX_DEF(qr, n, n);
 	#endif
-
+	ZSL_VECTOR_DEF(tau, n);
 
 	/* Make a copy of 'm'. */
 	rc = zsl_mtx_copy(mout, m);
@@ -1281,165 +3596,483 @@ zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter)
 	}
 
 	for (size_t g = 1; g <= iter; g++) {
-		/* Perform the QR decomposition. */
-		zsl_mtx_qrd(mout, &q, &r, false);
+		/* Perform the QR decomposition in compact form. */
+		zsl_mtx_qrd_compact(mout, &qr, &tau);
 
 		/* Multiply the results of the QR decomposition together but
-		 * changing its order. */
-		zsl_mtx_mult(&r, &q, mout);
+		 * changing its order, applying the reflectors of Q to R from
+		 * the right rather than forming Q. */
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = 0; j < n; j++) {
+				mout->data[(i * n) + j] =
+					j < i ? 0.0f : qr.data[(i * n) + j];
+			}
+		}
+		for (size_t c = 0; c < n; c++) {
+			zsl_mtx_hh_apply_right(&qr.data[(c * n) + c], n,
+					       tau.data[c], &mout->data[c], n,
+					       n, n - c);
+		}
 	}
 
 	return 0;
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
-int
-zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter)
+/*
+ * Computes the eigenvalues of the n x n upper Hessenberg matrix 'h', which
+ * is destroyed, with the Francis implicit double-shift QR algorithm. The
+ * active block is split wherever a subdiagonal entry becomes negligible
+ * relative to its diagonal neighbours, so each eigenvalue (or complex
+ * conjugate pair) is deflated from the bottom as soon as it has converged.
+ * Pairs are stored with the positive imaginary part first.
+ *
+ * Returns -ENOCONVERGE if any eigenvalue needs more than 'iter' steps.
+ */
+static int
+zsl_mtx_hqr(zsl_real_t *h, size_t n, zsl_real_t *wr, zsl_real_t *wi,
+	    size_t iter)
 {
-	zsl_real_t diag;
-	zsl_real_t sdiag;
-	size_t real = 0;
+	zsl_real_t (*a)[n] = (zsl_real_t (*)[n])h;
+	zsl_real_t anorm = 0.0;
+	zsl_real_t t = 0.0;
+	zsl_real_t p = 0.0, q = 0.0, r = 0.0;
+	zsl_real_t s, u, v, w, x, y, z;
+	size_t its = 0;
+	int hi;
+	int l, m;
+
+	/* The row indices below are signed, since the active block shrinks
+	 * until its last row is -1. */
+	if (n > INT_MAX) {
+		return -EINVAL;
+	}
+	hi = (int)n - 1;
+
+	for (int i = 0; i <= hi; i++) {
+		for (int j = (i > 0 ? i - 1 : 0); j <= hi; j++) {
+			anorm += ZSL_ABS(a[i][j]);
+		}
+	}
+
+	while (hi >= 0) {
+		/* Look for a negligible subdiagonal entry to split at. */
+		for (l = hi; l > 0; l--) {
+			s = ZSL_ABS(a[l - 1][l - 1]) + ZSL_ABS(a[l][l]);
+			if (s == 0.0) {
+				s = anorm;
+			}
+			if (ZSL_ABS(a[l][l - 1]) <= ZSL_EPSILON * s) {
+				a[l][l - 1] = 0.0;
+				break;
+			}
+		}
+
+		x = a[hi][hi];
+		if (l == hi) {
+			/* A single real root has converged. */
+			wr[hi] = x + t;
+			wi[hi] = 0.0;
+			hi--;
+			its = 0;
+			continue;
+		}
+
+		y = a[hi - 1][hi - 1];
+		w = a[hi][hi - 1] * a[hi - 1][hi];
+		if (l == hi - 1) {
+			/* A 2x2 block has converged: two real roots or a
+			 * complex conjugate pair. */
+			p = 0.5f * (y - x);
+			q = p * p + w;
+			z = ZSL_SQRT(ZSL_ABS(q));
+			x += t;
+			if (q >= 0.0) {
+				z = p + (p < 0.0 ? -z : z);
+				wr[hi - 1] = wr[hi] = x + z;
+				if (z != 0.0) {
+					wr[hi] = x - w / z;
+				}
+				wi[hi - 1] = wi[hi] = 0.0;
+			} else {
+				wr[hi - 1] = wr[hi] = x + p;
+				wi[hi - 1] = z;
+				wi[hi] = -z;
+			}
+			hi -= 2;
+			its = 0;
+			continue;
+		}
+
+		if (its == iter) {
+			return -ENOCONVERGE;
+		}
+
+		/* Use an ad hoc shift now and then to break any cycle. */
+		if ((its == 10) || (its == 20)) {
+			t += x;
+			for (int i = 0; i <= hi; i++) {
+				a[i][i] -= x;
+			}
+			s = ZSL_ABS(a[hi][hi - 1]) + ZSL_ABS(a[hi - 1][hi - 2]);
+			x = y = 0.75f * s;
+			w = -0.4375f * s * s;
+		}
+		its++;
+
+		/* Find the first column of (H - k1 I)(H - k2 I), k1 and k2
+		 * being the eigenvalues of the trailing 2x2 block, starting
+		 * from the lowest row 'm' where two consecutive small
+		 * subdiagonal entries allow the bulge to start. */
+		for (m = hi - 2; m >= l; m--) {
+			z = a[m][m];
+			r = x - z;
+			s = y - z;
+			p = (r * s - w) / a[m + 1][m] + a[m][m + 1];
+			q = a[m + 1][m + 1] - z - r - s;
+			r = a[m + 2][m + 1];
+			s = ZSL_ABS(p) + ZSL_ABS(q) + ZSL_ABS(r);
+			p /= s;
+			q /= s;
+			r /= s;
+			if (m == l) {
+				break;
+			}
+			u = ZSL_ABS(a[m][m - 1]) * (ZSL_ABS(q) + ZSL_ABS(r));
+			v = ZSL_ABS(p) * (ZSL_ABS(a[m - 1][m - 1]) + ZSL_ABS(z) +
+					  ZSL_ABS(a[m + 1][m + 1]));
+			if (u <= ZSL_EPSILON * v) {
+				break;
+			}
+		}
+
+		for (int i = m + 2; i <= hi; i++) {
+			a[i][i - 2] = 0.0;
+			if (i != m + 2) {
+				a[i][i - 3] = 0.0;
+			}
+		}
+
+		/* Chase the bulge down the active block with 3x3 (2x2 on the
+		 * last row) Householder reflections. */
+		for (int k = m; k < hi; k++) {
+			bool last = (k == hi - 1);
+
+			if (k != m) {
+				p = a[k][k - 1];
+				q = a[k + 1][k - 1];
+				r = last ? 0.0f : a[k + 2][k - 1];
+				x = ZSL_ABS(p) + ZSL_ABS(q) + ZSL_ABS(r);
+				if (x == 0.0) {
+					continue;
+				}
+				p /= x;
+				q /= x;
+				r /= x;
+			}
+
+			s = ZSL_SQRT(p * p + q * q + r * r);
+			if (p < 0.0) {
+				s = -s;
+			}
+			if (s == 0.0) {
+				continue;
+			}
 
-	/* Epsilon is used to check 0 values in the subdiagonal, to determine
-	 * if any coimplekx values were found. Increasing the number of
-	 * iterations will move these values closer to 0, but when using
-	 * single-precision floats the numbers can still be quite large, so
-	 * we need to set a delta of +/- 0.001 in this case. */
+			if (k == m) {
+				if (l != m) {
+					a[k][k - 1] = -a[k][k - 1];
+				}
+			} else {
+				a[k][k - 1] = -s * x;
+			}
 
-	zsl_real_t epsilon = 1E-6;
+			p += s;
+			x = p / s;
+			y = q / s;
+			z = r / s;
+			q /= p;
+			r /= p;
+
+			/* Row transformation. */
+			for (int j = k; j <= hi; j++) {
+				p = a[k][j] + q * a[k + 1][j];
+				if (!last) {
+					p += r * a[k + 2][j];
+					a[k + 2][j] -= p * z;
+				}
+				a[k + 1][j] -= p * y;
+				a[k][j] -= p * x;
+			}
 
-	ZSL_MATRIX_DEF(mout, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(mtemp, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(mtemp2, m->sz_rows, m->sz_rows);
+			/* Column transformation. */
+			for (int i = l; i <= hi && i <= k + 3; i++) {
+				p = x * a[i][k] + y * a[i][k + 1];
+				if (!last) {
+					p += z * a[i][k + 2];
+					a[i][k + 2] -= p * r;
+				}
+				a[i][k + 1] -= p * q;
+				a[i][k] -= p;
+			}
+		}
+	}
 
-	/* Balance the matrix. */
-	zsl_mtx_balance(m, &mtemp);
+	return 0;
+}
 
-	/* Put the balanced matrix into hessenberg form. */
-	zsl_mtx_qrd(&mtemp, &mout, &mtemp2, true);
+int
+zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_eigenvalues_ws_size(m->sz_rows));
 
-	/* Calculate the upper triangular matrix by using the recursive QR
-	 * decomposition method. */
-	zsl_mtx_qrd_iter(&mtemp2, &mout, iter);
+	return zsl_mtx_eigenvalues_ws(m, v, iter, &ws);
+}
 
-	zsl_vec_init(v);
+int
+zsl_mtx_eigenvalues_ws(struct zsl_mtx *m, struct zsl_vec *v, size_t iter,
+		       struct zsl_workspace *ws)
+{
+	int rc;
+	size_t real = 0;
+	size_t mark = zsl_ws_mark(ws);
+	struct zsl_vec im;
 
 	/* If the matrix is symmetric, then it will always have real
 	 * eigenvalues, so treat this case appart. */
 	if (zsl_mtx_is_sym(m) == true) {
-		for (size_t g = 0; g < m->sz_rows; g++) {
-			zsl_mtx_get(&mout, g, g, &diag);
-			v->data[g] = diag;
+		rc = zsl_mtx_eigen_sym_ws(m, v, NULL, iter, ws);
+		if (rc == 0) {
+			zsl_vec_zte(v);
 		}
+		return rc;
+	}
 
-		return 0;
+	if (zsl_ws_vec(ws, &im, m->sz_rows)) {
+		return -ENOMEM;
+	}
+
+	/* Calculate the full set of eigenvalues, real or complex. */
+	rc = zsl_mtx_eigenvalues_cplx_ws(m, v, &im, iter, ws);
+	if (rc) {
+		goto err;
 	}
 
 	/*
-	 * If any value just below the diagonal is non-zero, it means that the
-	 * numbers above and to the right of the non-zero value are a pair of
-	 * complex values, a complex number and its conjugate.
-	 *
 	 * SVD will always return real numbers so this can be ignored, but if
 	 * you are calculating eigenvalues outside the SVD method, you may
 	 * get complex numbers, which will be indicated with the return error
 	 * code '-ECOMPLEXVAL'.
 	 *
 	 * If the imput matrix has complex eigenvalues, then these will be
-	 * ignored and the output vector will not include them.
-	 *
-	 * NOTE: The real and imaginary parts of the complex numbers are not
-	 * available. This only checks if there are any complex eigenvalues and
-	 * returns an appropriate error code to alert the user that there are
-	 * non-real eigenvalues present.
+	 * ignored and the output vector will not include them. Use
+	 * 'zsl_mtx_eigenvalues_cplx' to obtain their real and imaginary parts.
 	 */
-
-	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
-		/* Check if any element just below the diagonal isn't zero. */
-		zsl_mtx_get(&mout, g + 1, g, &sdiag);
-		if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
-			/* Skip two elements if the element below
-			 * is not zero. */
-			g++;
-		} else {
-			/* Get the diagonal element if the element below
-			 * is zero. */
-			zsl_mtx_get(&mout, g, g, &diag);
-			v->data[real] = diag;
+	for (size_t g = 0; g < m->sz_rows; g++) {
+		if (im.data[g] == 0.0) {
+			v->data[real] = v->data[g];
 			real++;
 		}
 	}
 
-
-	/* Since it's not possible to check the coefficient below the last
-	 * diagonal element, then check the element to its left. */
-	zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 2), &sdiag);
-	if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
-		/* Do nothing if the element to its left is not zero. */
-	} else {
-		/* Get the last diagonal element if the element to its left
-		 * is zero. */
-		zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 1), &diag);
-		v->data[real] = diag;
-		real++;
-	}
-
 	/* If the number of real eigenvalues ('real' coefficient) is less than
 	 * the matrix dimensions, then there must be complex eigenvalues. */
 	v->sz = real;
 	if (real != m->sz_rows) {
-		return -ECOMPLEXVAL;
+		rc = -ECOMPLEXVAL;
+		goto err;
 	}
 
 	/* Put the zeros to the end. */
 	zsl_vec_zte(v);
 
-	return 0;
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_eigenvalues_ws_size(size_t n)
+{
+	size_t sym = zsl_mtx_eigen_sym_ws_size(n);
+	size_t cplx = ZSL_WS_REALS(n) + zsl_mtx_eigenvalues_cplx_ws_size(n);
+
+	return sym > cplx ? sym : cplx;
 }
+
+int
+zsl_mtx_eigenvalues_cplx(struct zsl_mtx *m, struct zsl_vec *re,
+			 struct zsl_vec *im, size_t iter)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_eigenvalues_cplx_ws_size(m->sz_rows));
+
+	return zsl_mtx_eigenvalues_cplx_ws(m, re, im, iter, &ws);
+}
+
+int
+zsl_mtx_eigenvalues_cplx_ws(struct zsl_mtx *m, struct zsl_vec *re,
+			    struct zsl_vec *im, size_t iter,
+			    struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t mr, mi;
+	struct zsl_mtx h;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 're' and 'im' match its size. */
+	if ((m->sz_cols != n) || (re->sz != n) || (im->sz != n)) {
+		return -EINVAL;
+	}
 #endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+	if (zsl_ws_mtx(ws, &h, n, n)) {
+		return -ENOMEM;
+	}
+
+	/* Balance the matrix, and put it into hessenberg form. */
+	zsl_mtx_balance(m, &h);
+	zsl_mtx_hess_reduce(h.data, n, NULL);
+
+	rc = zsl_mtx_hqr(h.data, n, re->data, im->data, iter);
+	zsl_ws_release(ws, mark);
+	if (rc) {
+		return rc;
+	}
+
+	/* Sort the eigenvalues by decreasing modulus, which is the order
+	 * the unshifted QR method converges to. The sort is stable, so
+	 * conjugate pairs stay together. */
+	for (size_t i = 1; i < n; i++) {
+		mr = re->data[i];
+		mi = im->data[i];
+		size_t j = i;
+		while ((j > 0) &&
+		       ((re->data[j - 1] * re->data[j - 1] +
+			 im->data[j - 1] * im->data[j - 1]) <
+			(mr * mr + mi * mi))) {
+			re->data[j] = re->data[j - 1];
+			im->data[j] = im->data[j - 1];
+			j--;
+		}
+		re->data[j] = mr;
+		im->data[j] = mi;
+	}
+
+	return 0;
+}
+
+size_t
+zsl_mtx_eigenvalues_cplx_ws_size(size_t n)
+{
+	return ZSL_WS_REALS(n * n);
+}
+
 int
 zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
 		     bool orthonormal)
 {
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_eigenvectors_ws_size(m->sz_rows));
+
+	return zsl_mtx_eigenvectors_ws(m, mev, iter, orthonormal, &ws);
+}
+
+int
+zsl_mtx_eigenvectors_ws(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
+			bool orthonormal, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
 	size_t b = 0;           /* Total number of eigenvectors. */
 	size_t e_vals = 0;      /* Number of unique eigenvalues. */
 	size_t count = 0;       /* Number of eigenvectors for an eigenvalue. */
 	size_t ga = 0;
+	bool cplx;
 
-	zsl_real_t epsilon = 1E-6;
+	zsl_real_t epsilon = ZSL_MTX_ZERO_TOL;
 	zsl_real_t x;
 
 	/* The vector where all eigenvalues will be stored. */
-	ZSL_VECTOR_DEF(k, m->sz_rows);
+	struct zsl_vec k;
 	/* Temp vector to store column data. */
-	ZSL_VECTOR_DEF(f, m->sz_rows);
+	struct zsl_vec f;
 	/* The vector where all UNIQUE eigenvalues will be stored. */
-	ZSL_VECTOR_DEF(o, m->sz_rows);
+	struct zsl_vec o;
 	/* Temporary mxm identity matrix placeholder. */
-	ZSL_MATRIX_DEF(id, m->sz_rows, m->sz_rows);
+	struct zsl_mtx id;
 	/* 'm' minus the eigenvalues * the identity matrix (id). */
-	ZSL_MATRIX_DEF(mi, m->sz_rows, m->sz_rows);
+	struct zsl_mtx mi;
 	/* Placeholder for zsl_mtx_gauss_reduc calls (required param). */
-	ZSL_MATRIX_DEF(mid, m->sz_rows, m->sz_rows);
+	struct zsl_mtx mid;
 	/* Matrix containing all column eigenvectors for an eigenvalue. */
-	ZSL_MATRIX_DEF(evec, m->sz_rows, m->sz_rows);
+	struct zsl_mtx evec;
 	/* Matrix containing all column eigenvectors for an eigenvalue.
 	* Two matrices are required for the Gramm-Schmidt operation. */
-	ZSL_MATRIX_DEF(evec2, m->sz_rows, m->sz_rows);
+	struct zsl_mtx evec2;
 	/* Matrix containing all column eigenvectors. */
-	ZSL_MATRIX_DEF(mev2, m->sz_rows, m->sz_rows);
+	struct zsl_mtx mev2;
+
+	if (zsl_ws_vec(ws, &k, m->sz_rows)) {
+		return -ENOMEM;
+	}
+
+	/* Symmetric matrices always have a full set of orthonormal
+	 * eigenvectors, which are obtained together with the eigenvalues. */
+	if ((orthonormal == true) && (zsl_mtx_is_sym(m) == true)) {
+		rc = zsl_mtx_eigen_sym_ws(m, &k, mev, iter, ws);
+		zsl_ws_release(ws, mark);
+		if (rc) {
+			return rc;
+		}
+
+		/* Choose the sign of each eigenvector so that its last
+		 * non-negligible component is positive. */
+		for (size_t j = 0; j < mev->sz_cols; j++) {
+			x = 0.0;
+			for (size_t i = mev->sz_rows; i-- > 0;) {
+				x = mev->data[(i * mev->sz_cols) + j];
+				if ((x >= epsilon) || (x <= -epsilon)) {
+					break;
+				}
+			}
+			if (x >= 0.0) {
+				continue;
+			}
+			for (size_t i = 0; i < mev->sz_rows; i++) {
+				mev->data[(i * mev->sz_cols) + j] *= -1.0f;
+			}
+		}
+
+		return 0;
+	}
+
+	/* With complex eigenvalues, 'k' only holds the real ones, whose
+	 * eigenvectors are still calculated. Any other error is final. */
+	rc = zsl_mtx_eigenvalues_ws(m, &k, iter, ws);
+	cplx = (rc == -ECOMPLEXVAL);
+	if (rc && !cplx) {
+		goto err;
+	}
+	rc = 0;
+
+	if (zsl_ws_vec(ws, &f, m->sz_rows) ||
+	    zsl_ws_vec(ws, &o, m->sz_rows) ||
+	    zsl_ws_mtx(ws, &id, m->sz_rows, m->sz_rows) ||
+	    zsl_ws_mtx(ws, &mi, m->sz_rows, m->sz_rows) ||
+	    zsl_ws_mtx(ws, &mid, m->sz_rows, m->sz_rows) ||
+	    zsl_ws_mtx(ws, &evec, m->sz_rows, m->sz_rows) ||
+	    zsl_ws_mtx(ws, &evec2, m->sz_rows, m->sz_rows) ||
+	    zsl_ws_mtx(ws, &mev2, m->sz_rows, m->sz_rows)) {
+		rc = -ENOMEM;
+		goto err;
+	}
 
-	/* TODO: Check that we have a SQUARE matrix, etc. */
 	zsl_mtx_init(&mev2, NULL);
 	zsl_vec_init(&o);
-	zsl_mtx_eigenvalues(m, &k, iter);
 
 	/* Copy every non-zero eigenvalue ONCE in the 'o' vector to get rid of
 	 * repeated values. */
-	for (size_t q = 0; q < m->sz_rows; q++) {
+	for (size_t q = 0; q < k.sz; q++) {
 		if ((k.data[q] >= epsilon) || (k.data[q] <= -epsilon)) {
 			if (zsl_vec_contains(&o, k.data[q], epsilon) == 0) {
 				o.data[e_vals] = k.data[q];
@@ -1538,146 +4171,572 @@ zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
 	/* Checks if the number of eigenvectors is the same as the shape of
 	 * the input matrix. If the number of eigenvectors is less than
 	 * the number of columns in the input matrix 'm', this will be
-	 * indicated by EEIGENSIZE as a return code. */
+	 * indicated by EEIGENSIZE as a return code, or by ECOMPLEXVAL if
+	 * the missing ones belong to complex eigenvalues. */
 	if (b != m->sz_cols) {
-		return -EEIGENSIZE;
+		rc = cplx ? -ECOMPLEXVAL : -EEIGENSIZE;
 	}
 
-	return 0;
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_eigenvectors_ws_size(size_t n)
+{
+	size_t sym = zsl_mtx_eigen_sym_ws_size(n);
+	size_t gen = (ZSL_WS_REALS(n) * 2) + (ZSL_WS_REALS(n * n) * 6);
+	size_t eig = zsl_mtx_eigenvalues_ws_size(n);
+
+	if (sym < eig) {
+		sym = eig;
+	}
+	if (sym < gen) {
+		sym = gen;
+	}
+
+	return ZSL_WS_REALS(n) + sym;
+}
+
+int
+zsl_mtx_eigen_sym(struct zsl_mtx *m, struct zsl_vec *v, struct zsl_mtx *mev,
+		  size_t iter)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_eigen_sym_ws_size(m->sz_rows));
+
+	return zsl_mtx_eigen_sym_ws(m, v, mev, iter, &ws);
+}
+
+int
+zsl_mtx_eigen_sym_ws(struct zsl_mtx *m, struct zsl_vec *v, struct zsl_mtx *mev,
+		     size_t iter, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t n = m->sz_rows;
+	size_t mark = zsl_ws_mark(ws);
+	size_t l, k, i;
+	size_t its;
+	bool split;
+	zsl_real_t *d = v->data;
+	zsl_real_t *z = NULL;
+	zsl_real_t b, c, f, g, p, r, s, x;
+	struct zsl_mtx t;
+	struct zsl_vec e;
+
+	/* Make sure 'm' is square. */
+	if (m->sz_cols != m->sz_rows) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'v' and 'mev' match the size of 'm'. */
+	if (v->sz != n) {
+		return -EINVAL;
+	}
+	if ((mev != NULL) && ((mev->sz_rows != n) || (mev->sz_cols != n))) {
+		return -EINVAL;
+	}
+#endif
+
+	if (zsl_ws_mtx(ws, &t, n, n) || zsl_ws_vec(ws, &e, n)) {
+		zsl_ws_release(ws, mark);
+		return -ENOMEM;
+	}
+
+	/* Reduce 'm' to tridiagonal form, T = Q^T * m * Q, accumulating Q in
+	 * 'mev' when the eigenvectors are requested. */
+	zsl_mtx_copy(&t, m);
+	if (mev != NULL) {
+		zsl_mtx_init(mev, zsl_mtx_entry_fn_identity);
+		z = mev->data;
+	}
+	zsl_mtx_hess_reduce(t.data, n, z);
+
+	/* e[i] couples d[i] and d[i + 1]. */
+	for (i = 0; i < n; i++) {
+		d[i] = t.data[(i * n) + i];
+		e.data[i] = (i + 1 < n) ? t.data[((i + 1) * n) + i] : 0.0f;
+	}
+
+	/* Implicit QL with Wilkinson shifts, working from the top. Each pass
+	 * splits the tridiagonal matrix at the first negligible e[k] after
+	 * 'l', and d[l] is final once e[l] itself is negligible. */
+	for (l = 0; l < n; l++) {
+		its = 0;
+		for (;;) {
+			for (k = l; k + 1 < n; k++) {
+				x = ZSL_ABS(d[k]) + ZSL_ABS(d[k + 1]);
+				if (ZSL_ABS(e.data[k]) <= ZSL_EPSILON * x) {
+					break;
+				}
+			}
+			if (k == l) {
+				break;
+			}
+
+			if (its++ == iter) {
+				rc = -ENOCONVERGE;
+				goto err;
+			}
+
+			/* Shift by the eigenvalue of the leading 2x2 block
+			 * closest to d[l]. */
+			g = (d[l + 1] - d[l]) / (2.0f * e.data[l]);
+			r = ZSL_SQRT(g * g + 1.0f);
+			g = d[k] - d[l] + e.data[l] / (g + (g < 0.0 ? -r : r));
+
+			s = c = 1.0;
+			p = 0.0;
+			split = false;
+			for (i = k; i-- > l;) {
+				f = s * e.data[i];
+				b = c * e.data[i];
+				r = ZSL_SQRT(f * f + g * g);
+				e.data[i + 1] = r;
+				if (r == 0.0) {
+					/* Underflow, split here and retry. */
+					d[i + 1] -= p;
+					e.data[k] = 0.0;
+					split = true;
+					break;
+				}
+				s = f / r;
+				c = g / r;
+				g = d[i + 1] - p;
+				r = (d[i] - g) * s + 2.0f * c * b;
+				p = s * r;
+				d[i + 1] = g + p;
+				g = c * r - b;
+
+				/* Apply the plane rotation to the eigenvectors. */
+				for (size_t j = 0; z != NULL && j < n; j++) {
+					f = z[(j * n) + i + 1];
+					z[(j * n) + i + 1] = s * z[(j * n) + i] +
+							     c * f;
+					z[(j * n) + i] = c * z[(j * n) + i] - s * f;
+				}
+			}
+			if (split) {
+				continue;
+			}
+			d[l] -= p;
+			e.data[l] = g;
+			e.data[k] = 0.0;
+		}
+	}
+
+	/* Sort by decreasing modulus, as 'zsl_mtx_eigenvalues' does. */
+	for (i = 0; i + 1 < n; i++) {
+		k = i;
+		for (size_t j = i + 1; j < n; j++) {
+			if (ZSL_ABS(d[j]) > ZSL_ABS(d[k])) {
+				k = j;
+			}
+		}
+		if (k == i) {
+			continue;
+		}
+		x = d[i];
+		d[i] = d[k];
+		d[k] = x;
+		for (size_t j = 0; z != NULL && j < n; j++) {
+			x = z[(j * n) + i];
+			z[(j * n) + i] = z[(j * n) + k];
+			z[(j * n) + k] = x;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_eigen_sym_ws_size(size_t n)
+{
+	return ZSL_WS_REALS(n * n) + ZSL_WS_REALS(n);
+}
+
+/*
+ * Fills columns 'r' to 'cols - 1' of the 'rows' x 'cols' matrix 'a' (row
+ * stride 'ld') with unit vectors orthogonal to all previous columns, the
+ * first 'r' columns being orthonormal already. Candidates are taken from
+ * the standard basis and orthogonalised twice with Gram-Schmidt.
+ */
+static void
+zsl_mtx_orth_complete(zsl_real_t *a, size_t ld, size_t rows, size_t cols,
+		      size_t r)
+{
+	zsl_real_t d, nrm;
+	size_t cand = 0;
+
+	for (size_t j = r; j < cols; j++) {
+		for (; cand < rows; cand++) {
+			for (size_t i = 0; i < rows; i++) {
+				a[(i * ld) + j] = (i == cand) ? 1.0 : 0.0;
+			}
+
+			for (int pass = 0; pass < 2; pass++) {
+				for (size_t c = 0; c < j; c++) {
+					d = 0.0;
+					for (size_t i = 0; i < rows; i++) {
+						d += a[(i * ld) + c] *
+						     a[(i * ld) + j];
+					}
+					for (size_t i = 0; i < rows; i++) {
+						a[(i * ld) + j] -=
+							d * a[(i * ld) + c];
+					}
+				}
+			}
+
+			nrm = 0.0;
+			for (size_t i = 0; i < rows; i++) {
+				nrm += a[(i * ld) + j] * a[(i * ld) + j];
+			}
+			nrm = ZSL_SQRT(nrm);
+
+			/* Discard candidates mostly inside the current span. */
+			if (nrm > 0.5) {
+				for (size_t i = 0; i < rows; i++) {
+					a[(i * ld) + j] /= nrm;
+				}
+				cand++;
+				break;
+			}
+		}
+	}
 }
+
+int
+zsl_mtx_svd_thin(struct zsl_mtx *m, struct zsl_vec *s, struct zsl_mtx *u,
+		 struct zsl_mtx *v, zsl_real_t *work, size_t iter)
+{
+	bool tr = m->sz_rows < m->sz_cols;
+	size_t p = tr ? m->sz_cols : m->sz_rows;
+	size_t q = tr ? m->sz_rows : m->sz_cols;
+	struct zsl_mtx *wm = tr ? v : u;
+	struct zsl_mtx *zm = tr ? u : v;
+	zsl_real_t *w = (wm != NULL) ? wm->data : work;
+	zsl_real_t *z = (zm != NULL) ? zm->data : NULL;
+	zsl_real_t alpha, beta, gamma, zeta, t, c, sn, x, y, tol;
+	size_t r;
+	bool rotated = true;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the output shapes match the thin SVD of 'm'. */
+	if ((s->sz != q) ||
+	    ((u != NULL) && ((u->sz_rows != m->sz_rows) ||
+			     (u->sz_cols != q))) ||
+	    ((v != NULL) && ((v->sz_rows != m->sz_cols) ||
+			     (v->sz_cols != q)))) {
+		return -EINVAL;
+	}
 #endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+	/* 'u' and 'v' double as scratch, so they must be contiguous. 'm'
+	 * itself can be any view. */
+	if ((w == NULL) || ((u != NULL) && !ZSL_MTX_IS_CONTIG(u)) ||
+	    ((v != NULL) && !ZSL_MTX_IS_CONTIG(v))) {
+		return -EINVAL;
+	}
+
+	/* W is 'm', or its transpose when 'm' is wide, so that the columns
+	 * of the p x q matrix W are the ones being orthogonalised. */
+	for (size_t i = 0; i < p; i++) {
+		for (size_t j = 0; j < q; j++) {
+			w[(i * q) + j] = tr ? ZSL_MTX_AT(m, j, i) :
+				ZSL_MTX_AT(m, i, j);
+		}
+	}
+
+	if (z != NULL) {
+		for (size_t i = 0; i < q * q; i++) {
+			z[i] = (i % (q + 1) == 0) ? 1.0 : 0.0;
+		}
+	}
+
+	/* One-sided Jacobi: sweep over every pair of columns, rotating each
+	 * pair to make it orthogonal, until no rotation is needed. The
+	 * rotations are accumulated in Z. */
+	for (size_t sweep = 0; rotated; sweep++) {
+		if (sweep == iter) {
+			return -ENOCONVERGE;
+		}
+
+		rotated = false;
+		for (size_t i = 0; i + 1 < q; i++) {
+			for (size_t j = i + 1; j < q; j++) {
+				alpha = beta = gamma = 0.0;
+				for (size_t k = 0; k < p; k++) {
+					x = w[(k * q) + i];
+					y = w[(k * q) + j];
+					alpha += x * x;
+					beta += y * y;
+					gamma += x * y;
+				}
+
+				if (ZSL_ABS(gamma) <=
+				    ZSL_EPSILON * ZSL_SQRT(alpha * beta)) {
+					continue;
+				}
+				rotated = true;
+
+				zeta = (beta - alpha) / (2.0f * gamma);
+				t = 1.0f / (ZSL_ABS(zeta) +
+					   ZSL_SQRT(1.0f + zeta * zeta));
+				if (zeta < 0.0) {
+					t = -t;
+				}
+				c = 1.0f / ZSL_SQRT(1.0f + t * t);
+				sn = c * t;
+
+				for (size_t k = 0; k < p; k++) {
+					x = w[(k * q) + i];
+					y = w[(k * q) + j];
+					w[(k * q) + i] = c * x - sn * y;
+					w[(k * q) + j] = sn * x + c * y;
+				}
+				for (size_t k = 0; z != NULL && k < q; k++) {
+					x = z[(k * q) + i];
+					y = z[(k * q) + j];
+					z[(k * q) + i] = c * x - sn * y;
+					z[(k * q) + j] = sn * x + c * y;
+				}
+			}
+		}
+	}
+
+	/* The singular values are the column norms of W. */
+	for (size_t j = 0; j < q; j++) {
+		x = 0.0;
+		for (size_t k = 0; k < p; k++) {
+			x += w[(k * q) + j] * w[(k * q) + j];
+		}
+		s->data[j] = ZSL_SQRT(x);
+	}
+
+	/* Sort them in decreasing order, along with the vectors. */
+	for (size_t i = 0; i + 1 < q; i++) {
+		r = i;
+		for (size_t j = i + 1; j < q; j++) {
+			if (s->data[j] > s->data[r]) {
+				r = j;
+			}
+		}
+		if (r == i) {
+			continue;
+		}
+		x = s->data[i];
+		s->data[i] = s->data[r];
+		s->data[r] = x;
+		for (size_t k = 0; k < p; k++) {
+			x = w[(k * q) + i];
+			w[(k * q) + i] = w[(k * q) + r];
+			w[(k * q) + r] = x;
+		}
+		for (size_t k = 0; z != NULL && k < q; k++) {
+			x = z[(k * q) + i];
+			z[(k * q) + i] = z[(k * q) + r];
+			z[(k * q) + r] = x;
+		}
+	}
+
+	if (wm == NULL) {
+		return 0;
+	}
+
+	/* Normalise the columns of W to get the singular vectors, and
+	 * complete those of negligible singular values into an orthonormal
+	 * set. */
+	tol = (q > 0) ? ((zsl_real_t)p * ZSL_EPSILON * s->data[0]) : 0.0f;
+	for (r = 0; r < q && s->data[r] > tol; r++) {
+		for (size_t k = 0; k < p; k++) {
+			w[(k * q) + r] /= s->data[r];
+		}
+	}
+	zsl_mtx_orth_complete(w, q, p, q, r);
+
+	return 0;
+}
+
 int
 zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 	    struct zsl_mtx *v, size_t iter)
 {
-	ZSL_MATRIX_DEF(aat, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(upri, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(ata, m->sz_cols, m->sz_cols);
-	ZSL_MATRIX_DEF(at, m->sz_cols, m->sz_rows);
-	ZSL_VECTOR_DEF(ui, m->sz_rows);
-	ZSL_MATRIX_DEF(ui2, m->sz_cols, 1);
-	ZSL_MATRIX_DEF(ui3, m->sz_rows, 1);
-	ZSL_VECTOR_DEF(hu, m->sz_rows);
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_svd_ws_size(m->sz_rows, m->sz_cols));
 
-	zsl_real_t d;
-	size_t pu = 0;
-	size_t min = m->sz_cols;
-	zsl_real_t epsilon = 1E-6;
+	return zsl_mtx_svd_ws(m, u, e, v, iter, &ws);
+}
 
-	zsl_mtx_trans(m, &at);
+int
+zsl_mtx_svd_ws(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+	       struct zsl_mtx *v, size_t iter, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	size_t min = rows < cols ? rows : cols;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t x;
+	struct zsl_vec sv;
 
-	/* Calculate 'm' times 'm' transposed and viceversa. */
-	zsl_mtx_mult(m, &at, &aat);
-	zsl_mtx_mult(&at, m, &ata);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((u->sz_rows != rows) || (u->sz_cols != rows) ||
+	    (e->sz_rows != rows) || (e->sz_cols != cols) ||
+	    (v->sz_rows != cols) || (v->sz_cols != cols)) {
+		return -EINVAL;
+	}
+#endif
 
-	/* Set the value 'min' as the minimum of number of columns and number
-	 * of rows. */
-	if (m->sz_rows <= m->sz_cols) {
-		min = m->sz_rows;
+	/* 'u' and 'v' double as scratch for the thin SVD. */
+	if (!ZSL_MTX_IS_CONTIG(u) || !ZSL_MTX_IS_CONTIG(v)) {
+		return -EINVAL;
 	}
 
-	/* Calculate the eigenvalues of the square matrix 'm' times 'm'
-	 * transposed or the square matrix 'm' transposed times 'm', whichever
-	 * is smaller in dimensions. */
-	ZSL_VECTOR_DEF(ev, min);
-	if (min < m->sz_cols) {
-		zsl_mtx_eigenvalues(&aat, &ev, iter);
-	} else {
-		zsl_mtx_eigenvalues(&ata, &ev, iter);
+	if (zsl_ws_vec(ws, &sv, min)) {
+		return -ENOMEM;
 	}
 
-	/* Place the square root of these eigenvalues in the diagonal entries
-	 * of 'e', the sigma matrix. */
-	zsl_mtx_init(e, NULL);
-	for (size_t g = 0; g < min; g++) {
-		zsl_mtx_set(e, g, g, ZSL_SQRT(ev.data[g]));
-	}
-
-	/* Calculate the eigenvectors of 'm' times 'm' transposed and set them
-	 * as the columns of the 'v' matrix. */
-	zsl_mtx_eigenvectors(&ata, v, iter, true);
-	for (size_t i = 0; i < min; i++) {
-		zsl_mtx_get_col(v, i, ui.data);
-		zsl_mtx_from_arr(&ui2, ui.data);
-		zsl_mtx_get(e, i, i, &d);
-
-		/* Calculate the column vectors of 'u' by dividing these
-		 * eniegnvectors by the square root its eigenvalue and
-		 * multiplying them by the input matrix. */
-		zsl_mtx_mult(m, &ui2, &ui3);
-		if ((d >= 0.0 && d < epsilon) || (d <= 0.0 && d > -epsilon)) {
-			pu++;
-		} else {
-			zsl_mtx_scalar_mult_d(&ui3, (1 / d));
-			zsl_vec_from_arr(&ui, ui3.data);
-			zsl_mtx_set_col(u, i, ui.data);
+	/* Calculate the thin SVD in place, packed with 'min' columns in 'u'
+	 * and 'v', which are large enough to also serve as scratch. */
+	struct zsl_mtx ut = { .sz_rows = rows, .sz_cols = min, .data = u->data };
+	struct zsl_mtx vt = { .sz_rows = cols, .sz_cols = min, .data = v->data };
+
+	rc = zsl_mtx_svd_thin(m, &sv, &ut, &vt, NULL, iter);
+	if (rc) {
+		goto err;
+	}
+
+	/* Spread the rows back out to the full width, starting from the last
+	 * one so that nothing is overwritten before being moved. */
+	for (size_t i = rows; i-- > 0;) {
+		for (size_t j = min; j-- > 0;) {
+			u->data[(i * rows) + j] = u->data[(i * min) + j];
+		}
+	}
+	for (size_t i = cols; i-- > 0;) {
+		for (size_t j = min; j-- > 0;) {
+			v->data[(i * cols) + j] = v->data[(i * min) + j];
 		}
 	}
 
-	/* Expand the columns of 'u' into an orthonormal basis if there are
-	 * zero eigenvalues or if the number of columns in 'm' is less than the
-	 * number of rows. */
-	zsl_mtx_eigenvectors(&aat, &upri, iter, true);
-	for (size_t f = min - pu; f < m->sz_rows; f++) {
-		zsl_mtx_get_col(&upri, f, hu.data);
-		zsl_mtx_set_col(u, f, hu.data);
+	/* Expand the columns of 'u' and 'v' into an orthonormal basis if the
+	 * matrix isn't square. */
+	zsl_mtx_orth_complete(u->data, rows, rows, rows, min);
+	zsl_mtx_orth_complete(v->data, cols, cols, cols, min);
+
+	/* Choose the sign of each column of 'v' so that its last
+	 * non-negligible component is positive, flipping the matching
+	 * column of 'u' along with it. */
+	for (size_t j = 0; j < cols; j++) {
+		for (size_t i = cols; i-- > 0;) {
+			x = v->data[(i * cols) + j];
+			if ((x >= ZSL_MTX_ZERO_TOL) || (x <= -ZSL_MTX_ZERO_TOL)) {
+				break;
+			}
+		}
+		if (x >= 0.0) {
+			continue;
+		}
+		for (size_t i = 0; i < cols; i++) {
+			v->data[(i * cols) + j] *= -1.0f;
+		}
+		for (size_t i = 0; j < min && i < rows; i++) {
+			u->data[(i * rows) + j] *= -1.0f;
+		}
 	}
 
-	return 0;
+	/* Place the singular values in the diagonal entries of 'e', the
+	 * sigma matrix. */
+	zsl_mtx_init(e, NULL);
+	for (size_t g = 0; g < min; g++) {
+		zsl_mtx_set(e, g, g, sv.data[g]);
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_svd_ws_size(size_t m, size_t n)
+{
+	return ZSL_WS_REALS(m < n ? m : n);
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
 zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter)
 {
-	zsl_real_t x;
-	size_t min = m->sz_cols;
-	zsl_real_t epsilon = 1E-6;
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_pinv_ws_size(m->sz_rows, m->sz_cols));
+
+	return zsl_mtx_pinv_ws(m, pinv, iter, &ws);
+}
 
-	ZSL_MATRIX_DEF(u, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(e, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(v, m->sz_cols, m->sz_cols);
-	ZSL_MATRIX_DEF(et, m->sz_cols, m->sz_rows);
-	ZSL_MATRIX_DEF(ut, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(pas, m->sz_cols, m->sz_rows);
+int
+zsl_mtx_pinv_ws(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		struct zsl_workspace *ws)
+{
+	int rc;
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	size_t min = rows < cols ? rows : cols;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t tol;
+	struct zsl_vec sv;
+	struct zsl_mtx u, v;
 
-	/* Determine the SVD decomposition of 'm'. */
-	zsl_mtx_svd(m, &u, &e, &v, iter);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((pinv->sz_rows != cols) || (pinv->sz_cols != rows)) {
+		return -EINVAL;
+	}
+#endif
 
-	/* Transpose the 'u' matrix. */
-	zsl_mtx_trans(&u, &ut);
+	if (zsl_ws_vec(ws, &sv, min) || zsl_ws_mtx(ws, &u, rows, min) ||
+	    zsl_ws_mtx(ws, &v, cols, min)) {
+		rc = -ENOMEM;
+		goto err;
+	}
 
-	/* Set the value 'min' as the minimum of number of columns and number
-	 * of rows. */
-	if (m->sz_rows <= m->sz_cols) {
-		min = m->sz_rows;
+	/* Determine the thin SVD decomposition of 'm'. */
+	rc = zsl_mtx_svd_thin(m, &sv, &u, &v, NULL, iter);
+	if (rc) {
+		goto err;
 	}
 
+	/* Multiply 'v' times sigma (with inverted singular values) times 'u'
+	 * transposed, ignoring the negligible singular values. */
+	tol = (min > 0) ? ((zsl_real_t)(rows > cols ? rows : cols) *
+			   ZSL_EPSILON * sv.data[0]) : 0.0f;
 	for (size_t g = 0; g < min; g++) {
+		sv.data[g] = (sv.data[g] > tol) ? 1.0f / sv.data[g] : 0.0f;
+	}
 
-		/* Invert the diagonal values in 'e'. If a value is zero, do
-		 * nothing to it. */
-		zsl_mtx_get(&e, g, g, &x);
-		if ((x < epsilon) || (x > -epsilon)) {
-			x = 1 / x;
-			zsl_mtx_set(&e, g, g, x);
+	for (size_t i = 0; i < cols; i++) {
+		for (size_t g = 0; g < min; g++) {
+			v.data[(i * min) + g] *= sv.data[g];
 		}
 	}
 
-	/* Transpose the sigma matrix. */
-	zsl_mtx_trans(&e, &et);
+	/* 'u' is transposed in place as a view, so the product runs through
+	 * the blocked multiply kernel without copying it. */
+	zsl_mtx_trans_view(&u, &u);
+	rc = zsl_mtx_mult(&v, &u, pinv);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
 
-	/* Multiply 'u' (transposed) times sigma (transposed and with inverted
-	 * eigenvalues) times 'v'. */
-	zsl_mtx_mult(&v, &et, &pas);
-	zsl_mtx_mult(&pas, &ut, pinv);
+size_t
+zsl_mtx_pinv_ws_size(size_t m, size_t n)
+{
+	size_t min = m < n ? m : n;
 
-	return 0;
+	return ZSL_WS_REALS(min) + ZSL_WS_REALS(m * min) +
+	       ZSL_WS_REALS(n * min);
 }
-#endif
 
 int
 zsl_mtx_min(struct zsl_mtx *m, zsl_real_t *x)
@@ -1787,7 +4846,7 @@ zsl_mtx_is_sym(struct zsl_mtx *m)
 	zsl_real_t x;
 	zsl_real_t y;
 	zsl_real_t diff;
-	zsl_real_t epsilon = 1E-6;
+	zsl_real_t epsilon = ZSL_MTX_ZERO_TOL;
 
 	for (size_t i = 0; i < m->sz_rows; i++) {
 		for (size_t j = 0; j < m->sz_cols; j++) {
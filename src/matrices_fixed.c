@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The fixed-size functions are defined in matrices_fixed.h. Unless the
+ * matching inline option is enabled, they are compiled here exactly once.
+ */
+#define ZSL_FIXED_IMPL
+#include <zsl/matrices_fixed.h>
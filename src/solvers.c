@@ -0,0 +1,979 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/sparse.h>
+#include <zsl/workspace.h>
+#include <zsl/solvers.h>
+
+static int
+zsl_linop_mtx_apply(void *ctx, struct zsl_vec *x, struct zsl_vec *y)
+{
+	return zsl_mtx_gemv(false, 1.0, (struct zsl_mtx *)ctx, x, 0.0, y);
+}
+
+static int
+zsl_linop_spmtx_apply(void *ctx, struct zsl_vec *x, struct zsl_vec *y)
+{
+	return zsl_spmtx_mult_vec((struct zsl_spmtx *)ctx, x, y);
+}
+
+int
+zsl_linop_mtx(struct zsl_linop *op, struct zsl_mtx *m)
+{
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+
+	op->n = m->sz_rows;
+	op->apply = zsl_linop_mtx_apply;
+	op->ctx = m;
+
+	return 0;
+}
+
+int
+zsl_linop_spmtx(struct zsl_linop *op, struct zsl_spmtx *sp)
+{
+	if (sp->sz_rows != sp->sz_cols) {
+		return -EINVAL;
+	}
+
+	op->n = sp->sz_rows;
+	op->apply = zsl_linop_spmtx_apply;
+	op->ctx = sp;
+
+	return 0;
+}
+
+static int
+zsl_precond_jacobi_apply(void *ctx, struct zsl_vec *r, struct zsl_vec *z)
+{
+	struct zsl_vec *d = (struct zsl_vec *)ctx;
+
+	for (size_t i = 0; i < d->sz; i++) {
+		z->data[i] = d->data[i] * r->data[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_precond_jacobi_mtx(struct zsl_precond *pc, struct zsl_mtx *m,
+		       struct zsl_vec *d)
+{
+	zsl_real_t x;
+
+	if ((m->sz_rows != m->sz_cols) || (d->sz != m->sz_rows)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < d->sz; i++) {
+		zsl_mtx_get(m, i, i, &x);
+		if (x == 0.0) {
+			return -ESINGULAR;
+		}
+		d->data[i] = 1.0f / x;
+	}
+
+	pc->apply = zsl_precond_jacobi_apply;
+	pc->ctx = d;
+
+	return 0;
+}
+
+int
+zsl_precond_jacobi_spmtx(struct zsl_precond *pc, struct zsl_spmtx *sp,
+			 struct zsl_vec *d)
+{
+	zsl_real_t x;
+
+	if ((sp->sz_rows != sp->sz_cols) || (d->sz != sp->sz_rows)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < d->sz; i++) {
+		zsl_spmtx_get(sp, i, i, &x);
+		if (x == 0.0) {
+			return -ESINGULAR;
+		}
+		d->data[i] = 1.0f / x;
+	}
+
+	pc->apply = zsl_precond_jacobi_apply;
+	pc->ctx = d;
+
+	return 0;
+}
+
+/* Calculates 'z = (L * L^T)^-1 * r' with the IC(0) factor 'L'. */
+static int
+zsl_precond_ic0_apply(void *ctx, struct zsl_vec *r, struct zsl_vec *z)
+{
+	struct zsl_spmtx *l = (struct zsl_spmtx *)ctx;
+	size_t end;
+	zsl_real_t x;
+	int rc;
+
+	rc = zsl_spmtx_solve_lower(l, r, z, false);
+	if (rc) {
+		return rc;
+	}
+
+	/* Solve 'L^T * z = y' in place by back substitution, with row i of
+	 * 'L' being column i of 'L^T'. The diagonal is the last value of each
+	 * row. */
+	for (size_t i = l->sz_rows; i-- > 0;) {
+		end = l->row_ptr[i + 1] - 1;
+		z->data[i] /= l->data[end];
+		x = z->data[i];
+		for (size_t k = l->row_ptr[i]; k < end; k++) {
+			z->data[l->col_idx[k]] -= l->data[k] * x;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_precond_ic0(struct zsl_precond *pc, struct zsl_spmtx *sp,
+		struct zsl_spmtx *l)
+{
+	size_t n = sp->sz_rows;
+	size_t nnz = 0;
+	size_t *rp = l->row_ptr;
+	size_t *ci = l->col_idx;
+	zsl_real_t *d = l->data;
+	size_t beg, end, a, b, bend;
+	zsl_real_t s;
+
+	if ((sp->sz_rows != sp->sz_cols) || (l->sz_rows != n) ||
+	    (l->sz_cols != n)) {
+		return -EINVAL;
+	}
+
+	/* Copy the lower triangle of 'sp' into 'l'. */
+	for (size_t i = 0; i < n; i++) {
+		rp[i] = nnz;
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			if (sp->col_idx[k] > i) {
+				break;
+			}
+			if (nnz == l->max_nnz) {
+				zsl_spmtx_init(l);
+				return -ENOMEM;
+			}
+			ci[nnz] = sp->col_idx[k];
+			d[nnz] = sp->data[k];
+			nnz++;
+		}
+	}
+	rp[n] = nnz;
+	l->nnz = nnz;
+
+	/* Row-by-row Cholesky, restricted to the existing pattern. */
+	for (size_t i = 0; i < n; i++) {
+		beg = rp[i];
+		end = rp[i + 1];
+		if ((end == beg) || (ci[end - 1] != i)) {
+			return -ENOTPOSDEF;
+		}
+
+		for (size_t k = beg; k < end - 1; k++) {
+			/* s = sum of L(i, c) * L(j, c) for c < j, merging the
+			 * sorted columns of rows i and j. */
+			size_t j = ci[k];
+
+			s = 0.0;
+			a = beg;
+			b = rp[j];
+			bend = rp[j + 1] - 1;
+			while ((a < k) && (b < bend)) {
+				if (ci[a] == ci[b]) {
+					s += d[a++] * d[b++];
+				} else if (ci[a] < ci[b]) {
+					a++;
+				} else {
+					b++;
+				}
+			}
+			d[k] = (d[k] - s) / d[bend];
+		}
+
+		s = d[end - 1];
+		for (size_t k = beg; k < end - 1; k++) {
+			s -= d[k] * d[k];
+		}
+		if (s <= 0.0) {
+			return -ENOTPOSDEF;
+		}
+		d[end - 1] = ZSL_SQRT(s);
+	}
+
+	pc->apply = zsl_precond_ic0_apply;
+	pc->ctx = l;
+
+	return 0;
+}
+
+/* Calculates 'z = M^-1 * r', with M = I if there is no preconditioner. */
+static int
+zsl_solve_precond(struct zsl_precond *pc, struct zsl_vec *r, struct zsl_vec *z)
+{
+	if (pc == NULL) {
+		memcpy(z->data, r->data, r->sz * sizeof(zsl_real_t));
+		return 0;
+	}
+
+	return pc->apply(pc->ctx, r, z);
+}
+
+/* Records the current residual norm in the history, if there is room. */
+static void
+zsl_solve_log(struct zsl_solver_params *p, zsl_real_t res)
+{
+	p->res = res;
+	if ((p->hist != NULL) && (p->iter < p->hist_sz)) {
+		p->hist[p->iter] = res;
+	}
+}
+
+/*
+ * Calculates the initial residual 'r = b - A * x' and the convergence
+ * threshold. Returns 1 if 'x' already solves the system, 0 if iterations
+ * are required, or a negative error code.
+ */
+static int
+zsl_solve_start(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		struct zsl_vec *r, struct zsl_solver_params *p,
+		zsl_real_t *thr)
+{
+	int rc;
+	zsl_real_t bn = zsl_vec_norm(b);
+
+	p->iter = 0;
+
+	/* The solution of 'A * x = 0' is 'x = 0'. */
+	if (bn == 0.0) {
+		zsl_vec_init(x);
+		zsl_solve_log(p, 0.0);
+		return 1;
+	}
+
+	rc = a->apply(a->ctx, x, r);
+	if (rc) {
+		return rc;
+	}
+	zsl_vec_sub(b, r, r);
+
+	*thr = p->tol * bn;
+	zsl_solve_log(p, zsl_vec_norm(r));
+
+	return (p->res <= *thr) ? 1 : 0;
+}
+
+int
+zsl_solve_cg(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+	     struct zsl_precond *pc, struct zsl_solver_params *p)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_solve_cg_ws_size(a->n));
+
+	return zsl_solve_cg_ws(a, b, x, pc, p, &ws);
+}
+
+int
+zsl_solve_cg_ws(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		struct zsl_precond *pc, struct zsl_solver_params *p,
+		struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->n;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t thr, rz, rz1, dq, alpha, beta;
+	struct zsl_vec r, z, d, q;
+
+	if ((b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+
+	if (zsl_ws_vec(ws, &r, n) || zsl_ws_vec(ws, &z, n) ||
+	    zsl_ws_vec(ws, &d, n) || zsl_ws_vec(ws, &q, n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = zsl_solve_start(a, b, x, &r, p, &thr);
+	if (rc) {
+		rc = (rc == 1) ? 0 : rc;
+		goto err;
+	}
+
+	rc = zsl_solve_precond(pc, &r, &z);
+	if (rc) {
+		goto err;
+	}
+	zsl_vec_copy(&d, &z);
+	zsl_vec_dot(&r, &z, &rz);
+
+	while (true) {
+		if (p->iter == p->max_iter) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+
+		rc = a->apply(a->ctx, &d, &q);
+		if (rc) {
+			break;
+		}
+		zsl_vec_dot(&d, &q, &dq);
+		if (dq <= 0.0) {
+			rc = -ENOTPOSDEF;
+			break;
+		}
+
+		alpha = rz / dq;
+		zsl_vec_axpy(alpha, &d, x);
+		zsl_vec_axpy(-alpha, &q, &r);
+
+		p->iter++;
+		zsl_solve_log(p, zsl_vec_norm(&r));
+		if (p->res <= thr) {
+			rc = 0;
+			break;
+		}
+
+		rc = zsl_solve_precond(pc, &r, &z);
+		if (rc) {
+			break;
+		}
+		zsl_vec_dot(&r, &z, &rz1);
+		beta = rz1 / rz;
+		rz = rz1;
+
+		/* d = z + beta * d */
+		for (size_t i = 0; i < n; i++) {
+			d.data[i] = z.data[i] + beta * d.data[i];
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_solve_cg_ws_size(size_t n)
+{
+	return 4 * ZSL_WS_REALS(n);
+}
+
+int
+zsl_solve_bicgstab(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		   struct zsl_precond *pc, struct zsl_solver_params *p)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_solve_bicgstab_ws_size(a->n));
+
+	return zsl_solve_bicgstab_ws(a, b, x, pc, p, &ws);
+}
+
+int
+zsl_solve_bicgstab_ws(struct zsl_linop *a, struct zsl_vec *b,
+		      struct zsl_vec *x, struct zsl_precond *pc,
+		      struct zsl_solver_params *p, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->n;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t thr, rho, rho1, alpha, beta, omega, rv, tt, ts;
+	struct zsl_vec r, rh, pp, v, ph, sh, t;
+
+	if ((b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+
+	if (zsl_ws_vec(ws, &r, n) || zsl_ws_vec(ws, &rh, n) ||
+	    zsl_ws_vec(ws, &pp, n) || zsl_ws_vec(ws, &v, n) ||
+	    zsl_ws_vec(ws, &ph, n) || zsl_ws_vec(ws, &sh, n) ||
+	    zsl_ws_vec(ws, &t, n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = zsl_solve_start(a, b, x, &r, p, &thr);
+	if (rc) {
+		rc = (rc == 1) ? 0 : rc;
+		goto err;
+	}
+
+	zsl_vec_copy(&rh, &r);
+	zsl_vec_init(&pp);
+	zsl_vec_init(&v);
+	rho = 1.0;
+	alpha = 1.0;
+	omega = 1.0;
+
+	while (true) {
+		if (p->iter == p->max_iter) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+
+		/* A zero rho or omega means that the method has broken down. */
+		zsl_vec_dot(&rh, &r, &rho1);
+		if ((rho1 == 0.0) || (omega == 0.0)) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+
+		/* p = r + beta * (p - omega * v) */
+		beta = (rho1 / rho) * (alpha / omega);
+		for (size_t i = 0; i < n; i++) {
+			pp.data[i] = r.data[i] +
+				     beta * (pp.data[i] - omega * v.data[i]);
+		}
+
+		rc = zsl_solve_precond(pc, &pp, &ph);
+		if (rc) {
+			break;
+		}
+		rc = a->apply(a->ctx, &ph, &v);
+		if (rc) {
+			break;
+		}
+		zsl_vec_dot(&rh, &v, &rv);
+		if (rv == 0.0) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+		alpha = rho1 / rv;
+
+		/* 'r' now holds the intermediate residual 's'. */
+		zsl_vec_axpy(alpha, &ph, x);
+		zsl_vec_axpy(-alpha, &v, &r);
+
+		p->iter++;
+		zsl_solve_log(p, zsl_vec_norm(&r));
+		if (p->res <= thr) {
+			rc = 0;
+			break;
+		}
+
+		rc = zsl_solve_precond(pc, &r, &sh);
+		if (rc) {
+			break;
+		}
+		rc = a->apply(a->ctx, &sh, &t);
+		if (rc) {
+			break;
+		}
+		zsl_vec_dot(&t, &t, &tt);
+		zsl_vec_dot(&t, &r, &ts);
+		omega = (tt == 0.0) ? 0.0f : ts / tt;
+
+		zsl_vec_axpy(omega, &sh, x);
+		zsl_vec_axpy(-omega, &t, &r);
+
+		zsl_solve_log(p, zsl_vec_norm(&r));
+		if (p->res <= thr) {
+			rc = 0;
+			break;
+		}
+
+		rho = rho1;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_solve_bicgstab_ws_size(size_t n)
+{
+	return 7 * ZSL_WS_REALS(n);
+}
+
+int
+zsl_solve_gmres(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		struct zsl_precond *pc, struct zsl_solver_params *p)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_solve_gmres_ws_size(a->n, p->restart));
+
+	return zsl_solve_gmres_ws(a, b, x, pc, p, &ws);
+}
+
+int
+zsl_solve_gmres_ws(struct zsl_linop *a, struct zsl_vec *b, struct zsl_vec *x,
+		   struct zsl_precond *pc, struct zsl_solver_params *p,
+		   struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->n;
+	size_t m = p->restart;
+	size_t k;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t thr, beta, h, den, tmp;
+	zsl_real_t *hj;
+	struct zsl_mtx vm, hm;
+	struct zsl_vec cs, sn, g, w, z, vi;
+
+	if ((b->sz != n) || (x->sz != n) || (m == 0)) {
+		return -EINVAL;
+	}
+
+	/* The rows of 'vm' hold the Krylov basis vectors, and 'hm' the
+	 * Hessenberg matrix, reduced to upper triangular form by Givens
+	 * rotations as it is built. */
+	if (zsl_ws_mtx(ws, &vm, m + 1, n) || zsl_ws_mtx(ws, &hm, m + 1, m) ||
+	    zsl_ws_vec(ws, &cs, m) || zsl_ws_vec(ws, &sn, m) ||
+	    zsl_ws_vec(ws, &g, m + 1) || zsl_ws_vec(ws, &w, n) ||
+	    zsl_ws_vec(ws, &z, n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	vi.sz = n;
+
+	rc = zsl_solve_start(a, b, x, &w, p, &thr);
+	if (rc) {
+		rc = (rc == 1) ? 0 : rc;
+		goto err;
+	}
+
+	while (true) {
+		if (p->iter == p->max_iter) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+
+		/* v0 = r / |r|, g = |r| * e1 */
+		beta = p->res;
+		for (size_t i = 0; i < n; i++) {
+			vm.data[i] = w.data[i] / beta;
+		}
+		zsl_vec_init(&g);
+		g.data[0] = beta;
+
+		for (k = 0; (k < m) && (p->iter < p->max_iter);) {
+			/* w = A * M^-1 * v_k */
+			vi.data = &vm.data[k * n];
+			rc = zsl_solve_precond(pc, &vi, &z);
+			if (rc) {
+				goto err;
+			}
+			rc = a->apply(a->ctx, &z, &w);
+			if (rc) {
+				goto err;
+			}
+
+			/* Modified Gram-Schmidt against the basis so far. */
+			for (size_t i = 0; i <= k; i++) {
+				vi.data = &vm.data[i * n];
+				zsl_vec_dot(&w, &vi, &h);
+				hm.data[(i * m) + k] = h;
+				zsl_vec_axpy(-h, &vi, &w);
+			}
+			h = zsl_vec_norm(&w);
+			hm.data[((k + 1) * m) + k] = h;
+			if (h != 0.0) {
+				for (size_t i = 0; i < n; i++) {
+					vm.data[((k + 1) * n) + i] =
+						w.data[i] / h;
+				}
+			}
+
+			/* Apply the previous rotations to the new column,
+			 * then eliminate its subdiagonal value. */
+			for (size_t i = 0; i < k; i++) {
+				hj = &hm.data[(i * m) + k];
+				tmp = cs.data[i] * hj[0] + sn.data[i] * hj[m];
+				hj[m] = -sn.data[i] * hj[0] + cs.data[i] * hj[m];
+				hj[0] = tmp;
+			}
+			hj = &hm.data[(k * m) + k];
+			den = ZSL_SQRT(hj[0] * hj[0] + hj[m] * hj[m]);
+			cs.data[k] = (den == 0.0) ? 1.0f : hj[0] / den;
+			sn.data[k] = (den == 0.0) ? 0.0f : hj[m] / den;
+			hj[0] = den;
+			hj[m] = 0.0;
+			g.data[k + 1] = -sn.data[k] * g.data[k];
+			g.data[k] = cs.data[k] * g.data[k];
+
+			k++;
+			p->iter++;
+			zsl_solve_log(p, ZSL_ABS(g.data[k]));
+			if ((p->res <= thr) || (h == 0.0)) {
+				break;
+			}
+		}
+
+		/* Solve the k x k triangular system 'H * y = g' in place,
+		 * with a zero pivot (only possible if 'A' is singular)
+		 * dropping that direction. */
+		for (size_t i = k; i-- > 0;) {
+			tmp = g.data[i];
+			for (size_t j = i + 1; j < k; j++) {
+				tmp -= hm.data[(i * m) + j] * g.data[j];
+			}
+			h = hm.data[(i * m) + i];
+			g.data[i] = (h == 0.0) ? 0.0f : tmp / h;
+		}
+
+		/* x += M^-1 * V * y */
+		zsl_vec_init(&w);
+		for (size_t i = 0; i < k; i++) {
+			vi.data = &vm.data[i * n];
+			zsl_vec_axpy(g.data[i], &vi, &w);
+		}
+		rc = zsl_solve_precond(pc, &w, &z);
+		if (rc) {
+			break;
+		}
+		zsl_vec_add(x, &z, x);
+
+		/* Restart from the true residual, which also confirms the
+		 * estimate used to stop. */
+		rc = a->apply(a->ctx, x, &w);
+		if (rc) {
+			break;
+		}
+		zsl_vec_sub(b, &w, &w);
+		p->res = zsl_vec_norm(&w);
+		if (p->res <= thr) {
+			rc = 0;
+			break;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_solve_gmres_ws_size(size_t n, size_t restart)
+{
+	return ZSL_WS_REALS((restart + 1) * n) +
+	       ZSL_WS_REALS((restart + 1) * restart) +
+	       2 * ZSL_WS_REALS(restart) + ZSL_WS_REALS(restart + 1) +
+	       2 * ZSL_WS_REALS(n);
+}
+
+/*
+ * Mixed-precision solves. The factor of 'A' is calculated and applied in
+ * single precision, while the residual of each refinement step is
+ * accumulated in double precision from the original matrix.
+ */
+
+
+/*
+ * Replaces the n x n row-major float matrix 'f' with its packed LU factors,
+ * using partial pivoting. Row 'k' was swapped with row 'piv[k]' in step k.
+ */
+static int
+zsl_solve_lu_f(float *f, size_t n, size_t *piv)
+{
+	size_t p;
+	float t, big;
+
+	for (size_t k = 0; k < n; k++) {
+		p = k;
+		big = f[(k * n) + k] < 0.0f ? -f[(k * n) + k] : f[(k * n) + k];
+		for (size_t i = k + 1; i < n; i++) {
+			t = f[(i * n) + k] < 0.0f ? -f[(i * n) + k] :
+			    f[(i * n) + k];
+			if (t > big) {
+				big = t;
+				p = i;
+			}
+		}
+		if (big == 0.0f) {
+			return -ESINGULAR;
+		}
+
+		piv[k] = p;
+		if (p != k) {
+			for (size_t j = 0; j < n; j++) {
+				t = f[(k * n) + j];
+				f[(k * n) + j] = f[(p * n) + j];
+				f[(p * n) + j] = t;
+			}
+		}
+
+		for (size_t i = k + 1; i < n; i++) {
+			t = f[(i * n) + k] / f[(k * n) + k];
+			f[(i * n) + k] = t;
+			for (size_t j = k + 1; j < n; j++) {
+				f[(i * n) + j] -= t * f[(k * n) + j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Solves 'A * d = d' in place with the LU factors from zsl_solve_lu_f. */
+static void
+zsl_solve_lu_f_apply(const float *f, size_t n, const size_t *piv, float *d)
+{
+	float t;
+
+	for (size_t k = 0; k < n; k++) {
+		t = d[k];
+		d[k] = d[piv[k]];
+		d[piv[k]] = t;
+	}
+
+	for (size_t i = 1; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			d[i] -= f[(i * n) + j] * d[j];
+		}
+	}
+
+	for (size_t i = n; i-- > 0;) {
+		for (size_t j = i + 1; j < n; j++) {
+			d[i] -= f[(i * n) + j] * d[j];
+		}
+		d[i] /= f[(i * n) + i];
+	}
+}
+
+/*
+ * Replaces the lower triangle of the n x n row-major float matrix 'f' with
+ * its Cholesky factor L.
+ */
+static int
+zsl_solve_cho_f(float *f, size_t n)
+{
+	float s;
+
+	for (size_t j = 0; j < n; j++) {
+		s = f[(j * n) + j];
+		for (size_t k = 0; k < j; k++) {
+			s -= f[(j * n) + k] * f[(j * n) + k];
+		}
+		if (s <= 0.0f) {
+			return -ENOTPOSDEF;
+		}
+		s = sqrtf(s);
+		f[(j * n) + j] = s;
+
+		for (size_t i = j + 1; i < n; i++) {
+			float t = f[(i * n) + j];
+
+			for (size_t k = 0; k < j; k++) {
+				t -= f[(i * n) + k] * f[(j * n) + k];
+			}
+			f[(i * n) + j] = t / s;
+		}
+	}
+
+	return 0;
+}
+
+/* Solves 'A * d = d' in place with the factor from zsl_solve_cho_f. */
+static void
+zsl_solve_cho_f_apply(const float *f, size_t n, float *d)
+{
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			d[i] -= f[(i * n) + j] * d[j];
+		}
+		d[i] /= f[(i * n) + i];
+	}
+
+	for (size_t i = n; i-- > 0;) {
+		for (size_t j = i + 1; j < n; j++) {
+			d[i] -= f[(j * n) + i] * d[j];
+		}
+		d[i] /= f[(i * n) + i];
+	}
+}
+
+/*
+ * Refines 'x' until 'b - A * x' is small enough, with the float factor 'f'
+ * of 'a' (and pivots 'piv' for LU, or NULL for Cholesky). 'd' holds n floats.
+ */
+static int
+zsl_solve_refine(struct zsl_mtx *a, struct zsl_vec *b, struct zsl_vec *x,
+		 struct zsl_solver_params *p, const float *f,
+		 const size_t *piv, float *d)
+{
+	size_t n = b->sz;
+	double bn = 0.0;
+	double rn, prev, s;
+
+	for (size_t i = 0; i < n; i++) {
+		bn += (double)b->data[i] * (double)b->data[i];
+	}
+	bn = sqrt(bn);
+
+	p->iter = 0;
+	prev = HUGE_VAL;
+	zsl_vec_init(x);
+
+	while (true) {
+		/* r = b - A * x, with every product accumulated in double
+		 * precision, rounded to float for the correction solve. */
+		rn = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			s = (double)b->data[i];
+			for (size_t j = 0; j < n; j++) {
+				s -= (double)ZSL_MTX_AT(a, i, j) *
+				     (double)x->data[j];
+			}
+			rn += s * s;
+			d[i] = (float)s;
+		}
+		rn = sqrt(rn);
+		zsl_solve_log(p, (zsl_real_t)rn);
+
+		if (rn <= (double)p->tol * bn) {
+			return 0;
+		}
+
+		/* Refinement only converges while cond(A) is well below the
+		 * inverse of the float epsilon, so stop once it stalls. */
+		if ((p->iter == p->max_iter) || (rn >= prev)) {
+			return -ENOCONVERGE;
+		}
+		prev = rn;
+
+		if (piv != NULL) {
+			zsl_solve_lu_f_apply(f, n, piv, d);
+		} else {
+			zsl_solve_cho_f_apply(f, n, d);
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			x->data[i] += (zsl_real_t)d[i];
+		}
+
+		p->iter++;
+	}
+}
+
+/* Copies the n x n matrix 'a' into the row-major float matrix 'f'. */
+static void
+zsl_solve_to_f(struct zsl_mtx *a, float *f)
+{
+	size_t n = a->sz_rows;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			f[(i * n) + j] = (float)ZSL_MTX_AT(a, i, j);
+		}
+	}
+}
+
+int
+zsl_solve_lu_mixed(struct zsl_mtx *a, struct zsl_vec *b, struct zsl_vec *x,
+		   struct zsl_solver_params *p)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_solve_lu_mixed_ws_size(a->sz_rows));
+
+	return zsl_solve_lu_mixed_ws(a, b, x, p, &ws);
+}
+
+int
+zsl_solve_lu_mixed_ws(struct zsl_mtx *a, struct zsl_vec *b,
+		      struct zsl_vec *x, struct zsl_solver_params *p,
+		      struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->sz_rows;
+	size_t mark = zsl_ws_mark(ws);
+	float *f, *d;
+	size_t *piv;
+
+	if ((a->sz_cols != n) || (b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+
+	f = zsl_ws_alloc(ws, n * n * sizeof(float));
+	d = zsl_ws_alloc(ws, n * sizeof(float));
+	piv = zsl_ws_alloc(ws, n * sizeof(size_t));
+	if ((f == NULL) || (d == NULL) || (piv == NULL)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_solve_to_f(a, f);
+	rc = zsl_solve_lu_f(f, n, piv);
+	if (rc) {
+		goto err;
+	}
+
+	rc = zsl_solve_refine(a, b, x, p, f, piv, d);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_solve_lu_mixed_ws_size(size_t n)
+{
+	return ZSL_WS_BYTES(n * n * sizeof(float)) +
+	       ZSL_WS_BYTES(n * sizeof(float)) +
+	       ZSL_WS_BYTES(n * sizeof(size_t));
+}
+
+int
+zsl_solve_cho_mixed(struct zsl_mtx *a, struct zsl_vec *b, struct zsl_vec *x,
+		    struct zsl_solver_params *p)
+{
+	ZSL_WORKSPACE_DEF(ws, zsl_solve_cho_mixed_ws_size(a->sz_rows));
+
+	return zsl_solve_cho_mixed_ws(a, b, x, p, &ws);
+}
+
+int
+zsl_solve_cho_mixed_ws(struct zsl_mtx *a, struct zsl_vec *b,
+		       struct zsl_vec *x, struct zsl_solver_params *p,
+		       struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = a->sz_rows;
+	size_t mark = zsl_ws_mark(ws);
+	float *f, *d;
+
+	if ((a->sz_cols != n) || (b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+
+	f = zsl_ws_alloc(ws, n * n * sizeof(float));
+	d = zsl_ws_alloc(ws, n * sizeof(float));
+	if ((f == NULL) || (d == NULL)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_solve_to_f(a, f);
+	rc = zsl_solve_cho_f(f, n);
+	if (rc) {
+		goto err;
+	}
+
+	rc = zsl_solve_refine(a, b, x, p, f, NULL, d);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_solve_cho_mixed_ws_size(size_t n)
+{
+	return ZSL_WS_BYTES(n * n * sizeof(float)) +
+	       ZSL_WS_BYTES(n * sizeof(float));
+}
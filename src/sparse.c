@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/sparse.h>
+
+int
+zsl_spmtx_init(struct zsl_spmtx *sp)
+{
+	memset(sp->row_ptr, 0, (sp->sz_rows + 1) * sizeof(size_t));
+	sp->nnz = 0;
+
+	return 0;
+}
+
+int
+zsl_spcoo_init(struct zsl_spcoo *coo)
+{
+	coo->nnz = 0;
+
+	return 0;
+}
+
+int
+zsl_spcoo_add(struct zsl_spcoo *coo, size_t i, size_t j, zsl_real_t x)
+{
+	if ((i >= coo->sz_rows) || (j >= coo->sz_cols)) {
+		return -EINVAL;
+	}
+
+	if (coo->nnz == coo->max_nnz) {
+		return -ENOMEM;
+	}
+
+	coo->row_idx[coo->nnz] = i;
+	coo->col_idx[coo->nnz] = j;
+	coo->data[coo->nnz] = x;
+	coo->nnz++;
+
+	return 0;
+}
+
+int
+zsl_spmtx_from_coo(struct zsl_spcoo *coo, struct zsl_spmtx *sp)
+{
+	size_t *rp = sp->row_ptr;
+	size_t rows = sp->sz_rows;
+	size_t beg, end, dst, k, c;
+	zsl_real_t x;
+
+	if ((coo->sz_rows != sp->sz_rows) || (coo->sz_cols != sp->sz_cols)) {
+		return -EINVAL;
+	}
+
+	if (coo->nnz > sp->max_nnz) {
+		return -ENOMEM;
+	}
+
+	/* Count the triplets in each row, so that rp[i + 1] ends up holding
+	 * the start of row i. */
+	memset(rp, 0, (rows + 1) * sizeof(size_t));
+	for (k = 0; k < coo->nnz; k++) {
+		rp[coo->row_idx[k] + 1]++;
+	}
+	for (size_t i = 0, sum = 0; i <= rows; i++) {
+		c = rp[i];
+		rp[i] = sum;
+		sum += c;
+	}
+
+	/* Scatter the triplets, advancing rp[i + 1] to the end of row i. */
+	for (k = 0; k < coo->nnz; k++) {
+		dst = rp[coo->row_idx[k] + 1]++;
+		sp->col_idx[dst] = coo->col_idx[k];
+		sp->data[dst] = coo->data[k];
+	}
+
+	/* Sort each row by column, and sum any duplicates while compacting
+	 * the rows towards the start of the arrays. */
+	dst = 0;
+	beg = 0;
+	for (size_t i = 0; i < rows; i++) {
+		end = rp[i + 1];
+		for (k = beg + 1; k < end; k++) {
+			c = sp->col_idx[k];
+			x = sp->data[k];
+			size_t g = k;
+			while ((g > beg) && (sp->col_idx[g - 1] > c)) {
+				sp->col_idx[g] = sp->col_idx[g - 1];
+				sp->data[g] = sp->data[g - 1];
+				g--;
+			}
+			sp->col_idx[g] = c;
+			sp->data[g] = x;
+		}
+
+		rp[i] = dst;
+		for (k = beg; k < end; k++) {
+			if ((dst > rp[i]) && (sp->col_idx[dst - 1] ==
+					      sp->col_idx[k])) {
+				sp->data[dst - 1] += sp->data[k];
+				continue;
+			}
+			sp->col_idx[dst] = sp->col_idx[k];
+			sp->data[dst] = sp->data[k];
+			dst++;
+		}
+		beg = end;
+	}
+	rp[rows] = dst;
+	sp->nnz = dst;
+
+	return 0;
+}
+
+int
+zsl_spmtx_from_mtx(struct zsl_mtx *m, struct zsl_spmtx *sp, zsl_real_t tol)
+{
+	size_t nnz = 0;
+	zsl_real_t x;
+
+	if ((m->sz_rows != sp->sz_rows) || (m->sz_cols != sp->sz_cols)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		sp->row_ptr[i] = nnz;
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			x = ZSL_MTX_AT(m, i, j);
+			if (ZSL_ABS(x) <= tol) {
+				continue;
+			}
+			if (nnz == sp->max_nnz) {
+				zsl_spmtx_init(sp);
+				return -ENOMEM;
+			}
+			sp->col_idx[nnz] = j;
+			sp->data[nnz] = x;
+			nnz++;
+		}
+	}
+	sp->row_ptr[m->sz_rows] = nnz;
+	sp->nnz = nnz;
+
+	return 0;
+}
+
+int
+zsl_spmtx_to_mtx(struct zsl_spmtx *sp, struct zsl_mtx *m)
+{
+	if ((m->sz_rows != sp->sz_rows) || (m->sz_cols != sp->sz_cols)) {
+		return -EINVAL;
+	}
+
+	zsl_mtx_init(m, NULL);
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			ZSL_MTX_AT(m, i, sp->col_idx[k]) = sp->data[k];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_get(struct zsl_spmtx *sp, size_t i, size_t j, zsl_real_t *x)
+{
+	size_t lo, hi, mid;
+
+	if ((i >= sp->sz_rows) || (j >= sp->sz_cols)) {
+		return -EINVAL;
+	}
+
+	/* Binary search for column j in row i. */
+	lo = sp->row_ptr[i];
+	hi = sp->row_ptr[i + 1];
+	while (lo < hi) {
+		mid = lo + ((hi - lo) / 2);
+		if (sp->col_idx[mid] < j) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	*x = ((lo < sp->row_ptr[i + 1]) && (sp->col_idx[lo] == j)) ?
+	     sp->data[lo] : 0.0f;
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult_vec(struct zsl_spmtx *sp, struct zsl_vec *v, struct zsl_vec *w)
+{
+	zsl_real_t sum;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != sp->sz_cols) || (w->sz != sp->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		sum = 0.0;
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			sum += sp->data[k] * v->data[sp->col_idx[k]];
+		}
+		w->data[i] = sum;
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult_trans_vec(struct zsl_spmtx *sp, struct zsl_vec *v,
+			 struct zsl_vec *w)
+{
+	zsl_real_t x;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != sp->sz_rows) || (w->sz != sp->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_vec_init(w);
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		x = v->data[i];
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			w->data[sp->col_idx[k]] += sp->data[k] * x;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult_mtx(struct zsl_spmtx *sp, struct zsl_mtx *mb,
+		   struct zsl_mtx *mc)
+{
+	size_t c = mb->sz_cols;
+	size_t bcs = ZSL_MTX_COL_STEP(mb);
+	size_t ccs = ZSL_MTX_COL_STEP(mc);
+	zsl_real_t s;
+	zsl_real_t *ci;
+	zsl_real_t *br;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mb->sz_rows != sp->sz_cols) || (mc->sz_rows != sp->sz_rows) ||
+	    (mc->sz_cols != c)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Each stored value scales a row of 'mb' into a row of 'mc'. */
+	zsl_mtx_init(mc, NULL);
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		ci = &ZSL_MTX_AT(mc, i, 0);
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			s = sp->data[k];
+			br = &ZSL_MTX_AT(mb, sp->col_idx[k], 0);
+			for (size_t j = 0; j < c; j++) {
+				ci[j * ccs] += s * br[j * bcs];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_trans(struct zsl_spmtx *sp, struct zsl_spmtx *st)
+{
+	size_t *rp = st->row_ptr;
+	size_t rows = st->sz_rows;
+	size_t dst, c;
+
+	if ((st->sz_rows != sp->sz_cols) || (st->sz_cols != sp->sz_rows)) {
+		return -EINVAL;
+	}
+
+	if (sp->nnz > st->max_nnz) {
+		return -ENOMEM;
+	}
+
+	/* Same counting sort as zsl_spmtx_from_coo, keyed on the column.
+	 * Walking 'sp' row by row keeps the columns of 'st' sorted. */
+	memset(rp, 0, (rows + 1) * sizeof(size_t));
+	for (size_t k = 0; k < sp->nnz; k++) {
+		rp[sp->col_idx[k] + 1]++;
+	}
+	for (size_t i = 0, sum = 0; i <= rows; i++) {
+		c = rp[i];
+		rp[i] = sum;
+		sum += c;
+	}
+
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			dst = rp[sp->col_idx[k] + 1]++;
+			st->col_idx[dst] = i;
+			st->data[dst] = sp->data[k];
+		}
+	}
+	st->nnz = sp->nnz;
+
+	return 0;
+}
+
+/*
+ * Solves the sparse triangular system 't * x = b', reading only the values
+ * below ('lower' true) or above the diagonal of each row.
+ */
+static int
+zsl_spmtx_tri_solve(struct zsl_spmtx *t, struct zsl_vec *b, struct zsl_vec *x,
+		    bool lower, bool unit)
+{
+	size_t n = t->sz_rows;
+	size_t i, col;
+	zsl_real_t sum, d;
+
+	if (t->sz_rows != t->sz_cols) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Check for zero or missing diagonal values before modifying 'x'. */
+	for (i = 0; unit == false && i < n; i++) {
+		zsl_spmtx_get(t, i, i, &d);
+		if (d == 0.0) {
+			return -ESINGULAR;
+		}
+	}
+
+	for (size_t g = 0; g < n; g++) {
+		i = lower ? g : n - 1 - g;
+		sum = b->data[i];
+		d = 1.0;
+		for (size_t k = t->row_ptr[i]; k < t->row_ptr[i + 1]; k++) {
+			col = t->col_idx[k];
+			if (col == i) {
+				d = t->data[k];
+			} else if ((col < i) == lower) {
+				sum -= t->data[k] * x->data[col];
+			}
+		}
+		x->data[i] = unit ? sum : sum / d;
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_solve_lower(struct zsl_spmtx *l, struct zsl_vec *b,
+		      struct zsl_vec *x, bool unit)
+{
+	return zsl_spmtx_tri_solve(l, b, x, true, unit);
+}
+
+int
+zsl_spmtx_solve_upper(struct zsl_spmtx *u, struct zsl_vec *b,
+		      struct zsl_vec *x, bool unit)
+{
+	return zsl_spmtx_tri_solve(u, b, x, false, unit);
+}
@@ -18,6 +18,33 @@ int zsl_sta_mean(struct zsl_vec *v, zsl_real_t *m)
 	return 0;
 }
 
+int zsl_sta_mean_half(struct zsl_vec_half *v, zsl_real_t *m)
+{
+	zsl_real_t x[ZSL_HALF_BLOCK];
+	zsl_real_t sum = 0.0;
+	size_t n;
+	int rc;
+
+	if (v->sz == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < v->sz; i += ZSL_HALF_BLOCK) {
+		n = v->sz - i < ZSL_HALF_BLOCK ? v->sz - i : ZSL_HALF_BLOCK;
+		rc = zsl_half_unpack(&v->data[i], x, n, v->fmt);
+		if (rc) {
+			return rc;
+		}
+		for (size_t k = 0; k < n; k++) {
+			sum += x[k];
+		}
+	}
+
+	*m = sum / (zsl_real_t)v->sz;
+
+	return 0;
+}
+
 int zsl_sta_demean(struct zsl_vec *v, struct zsl_vec *w)
 {
 	zsl_real_t m;
@@ -150,6 +177,40 @@ int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var)
 	return 0;
 }
 
+int zsl_sta_var_half(struct zsl_vec_half *v, zsl_real_t *var)
+{
+	zsl_real_t x[ZSL_HALF_BLOCK];
+	zsl_real_t m;
+	zsl_real_t sum = 0.0;
+	size_t n;
+	int rc;
+
+	if (v->sz < 2) {
+		return -EINVAL;
+	}
+
+	rc = zsl_sta_mean_half(v, &m);
+	if (rc) {
+		return rc;
+	}
+
+	/* Second pass, on the deviations, to avoid cancellation. */
+	for (size_t i = 0; i < v->sz; i += ZSL_HALF_BLOCK) {
+		n = v->sz - i < ZSL_HALF_BLOCK ? v->sz - i : ZSL_HALF_BLOCK;
+		rc = zsl_half_unpack(&v->data[i], x, n, v->fmt);
+		if (rc) {
+			return rc;
+		}
+		for (size_t k = 0; k < n; k++) {
+			sum += (x[k] - m) * (x[k] - m);
+		}
+	}
+
+	*var = sum / (zsl_real_t)(v->sz - 1);
+
+	return 0;
+}
+
 int zsl_sta_sta_dev(struct zsl_vec *v, zsl_real_t *s)
 {
 	zsl_real_t var;
@@ -243,6 +304,74 @@ int zsl_sta_linear_reg(struct zsl_vec *v, struct zsl_vec *w,
 	return 0;
 }
 
+int zsl_sta_rls_init(struct zsl_sta_rls *rls, zsl_real_t lambda,
+		     zsl_real_t delta)
+{
+	size_t n = rls->theta.sz;
+
+	if ((lambda <= 0.0) || (lambda > 1.0) || (delta <= 0.0)) {
+		return -EINVAL;
+	}
+
+	rls->lambda = lambda;
+	zsl_vec_init(&rls->theta);
+	zsl_mtx_lstsq_init(&rls->ls);
+
+	/* Start from R = I / sqrt(delta), i.e. P = R^-1 * R^-T = delta * I. */
+	for (size_t i = 0; i < n; i++) {
+		rls->ls.r.data[(i * n) + i] = 1.0f / ZSL_SQRT(delta);
+	}
+
+	return 0;
+}
+
+int zsl_sta_rls_update(struct zsl_sta_rls *rls, struct zsl_vec *phi,
+		       zsl_real_t y, zsl_real_t *e)
+{
+	int rc;
+	zsl_real_t d;
+
+	struct zsl_mtx a = {
+		.sz_rows = 1,
+		.sz_cols = phi->sz,
+		.data = phi->data
+	};
+	struct zsl_mtx b = {
+		.sz_rows = 1,
+		.sz_cols = 1,
+		.data = &y
+	};
+	struct zsl_mtx x = {
+		.sz_rows = rls->theta.sz,
+		.sz_cols = 1,
+		.data = rls->theta.data
+	};
+
+	if (phi->sz != rls->theta.sz) {
+		return -EINVAL;
+	}
+
+	if (e != NULL) {
+		zsl_vec_dot(phi, &rls->theta, &d);
+		*e = y - d;
+	}
+
+	/* Weigh down the past, then rotate the new sample into R. */
+	if (rls->lambda != 1.0) {
+		d = ZSL_SQRT(rls->lambda);
+		zsl_mtx_scalar_mult_d(&rls->ls.r, d);
+		zsl_mtx_scalar_mult_d(&rls->ls.qtb, d);
+		zsl_vec_scalar_mult(&rls->ls.ssr, rls->lambda);
+	}
+
+	rc = zsl_mtx_lstsq_add(&rls->ls, &a, &b);
+	if (rc) {
+		return rc;
+	}
+
+	return zsl_mtx_lstsq_solve(&rls->ls, &x, NULL);
+}
+
 int zsl_sta_abs_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
 {
 	*err = ZSL_ABS(*val - *exp_val);
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#if CONFIG_ZSL_THREADS && !defined(__ZEPHYR__) && defined(__linux__)
+/* Needed for pthread_setaffinity_np. */
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/threads.h>
+
+#if CONFIG_ZSL_THREADS
+#ifdef __ZEPHYR__
+#include <kernel.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+static size_t zsl_threads_min_ops = CONFIG_ZSL_THREADS_MIN_OPS;
+
+void
+zsl_threads_set_min_ops(size_t ops)
+{
+	zsl_threads_min_ops = ops;
+}
+
+size_t
+zsl_threads_get_min_ops(void)
+{
+	return zsl_threads_min_ops;
+}
+
+#if CONFIG_ZSL_THREADS
+
+/* Number of worker threads, which excludes the calling thread. */
+#define ZSL_THREADS_WORKERS (CONFIG_ZSL_THREADS_MAX - 1)
+
+/*
+ * The operation being run by the pool. Its 'n' indices are split into
+ * 'parts' ranges, which the caller and the workers claim one at a time
+ * until none are left. Every field is protected by the pool lock.
+ */
+static struct {
+	zsl_threads_fn_t fn;
+	void *ctx;
+	size_t n;
+	size_t parts;
+	/* The next range to be claimed. */
+	size_t next;
+	/* The number of ranges that haven't finished yet. */
+	size_t pending;
+	/* The first non-zero value returned by 'fn'. */
+	int rc;
+} zsl_threads_job;
+
+/* Threads in use, including the caller. Changed while holding both locks. */
+static size_t zsl_threads_count = CONFIG_ZSL_THREADS_MAX;
+
+/* Number of workers started so far. Workers are never stopped. */
+static size_t zsl_threads_started;
+
+/* CPU mask of each worker, 0 meaning any CPU. */
+static uint32_t zsl_threads_cpus[ZSL_THREADS_WORKERS];
+
+/*
+ * Backend primitives. 'busy' is held by the one thread using the pool, and
+ * the pool lock protects the job and the worker state.
+ */
+static bool zsl_threads_acquire(bool wait);
+static void zsl_threads_release(void);
+static void zsl_threads_lock(void);
+static void zsl_threads_unlock(void);
+static void zsl_threads_spawn(size_t workers);
+static int zsl_threads_pin(size_t idx);
+static void zsl_threads_post(size_t workers);
+static void zsl_threads_signal_done(void);
+static void zsl_threads_wait_done(void);
+
+/*
+ * Claims and runs ranges of the current job until none are left. Called, and
+ * returns, with the pool lock held.
+ */
+static void
+zsl_threads_work(void)
+{
+	size_t part, start, end;
+	zsl_threads_fn_t fn;
+	void *ctx;
+	int rc;
+
+	while (zsl_threads_job.next < zsl_threads_job.parts) {
+		part = zsl_threads_job.next++;
+		start = (zsl_threads_job.n * part) / zsl_threads_job.parts;
+		end = (zsl_threads_job.n * (part + 1)) / zsl_threads_job.parts;
+		fn = zsl_threads_job.fn;
+		ctx = zsl_threads_job.ctx;
+
+		zsl_threads_unlock();
+		rc = fn(ctx, start, end);
+		zsl_threads_lock();
+
+		if ((rc != 0) && (zsl_threads_job.rc == 0)) {
+			zsl_threads_job.rc = rc;
+		}
+		if (--zsl_threads_job.pending == 0) {
+			zsl_threads_signal_done();
+		}
+	}
+}
+
+#ifdef __ZEPHYR__
+
+/*
+ * Zephyr backend: one work queue per worker, with a work item submitted to
+ * each participating queue for every job.
+ */
+
+static struct k_work_q zsl_threads_wq[ZSL_THREADS_WORKERS];
+static struct k_work zsl_threads_wk[ZSL_THREADS_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(zsl_threads_stacks, ZSL_THREADS_WORKERS,
+				   CONFIG_ZSL_THREADS_STACK_SIZE);
+static K_MUTEX_DEFINE(zsl_threads_mtx);
+/* A semaphore rather than a mutex, since k_mutex is recursive. */
+static K_SEM_DEFINE(zsl_threads_busy, 1, 1);
+static K_SEM_DEFINE(zsl_threads_done, 0, 1);
+
+static void
+zsl_threads_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zsl_threads_lock();
+	zsl_threads_work();
+	zsl_threads_unlock();
+}
+
+static bool
+zsl_threads_acquire(bool wait)
+{
+	return k_sem_take(&zsl_threads_busy,
+			  wait ? K_FOREVER : K_NO_WAIT) == 0;
+}
+
+static void
+zsl_threads_release(void)
+{
+	k_sem_give(&zsl_threads_busy);
+}
+
+static void
+zsl_threads_lock(void)
+{
+	k_mutex_lock(&zsl_threads_mtx, K_FOREVER);
+}
+
+static void
+zsl_threads_unlock(void)
+{
+	k_mutex_unlock(&zsl_threads_mtx);
+}
+
+static void
+zsl_threads_spawn(size_t workers)
+{
+	for (; zsl_threads_started < workers; zsl_threads_started++) {
+		size_t i = zsl_threads_started;
+
+		k_work_init(&zsl_threads_wk[i], zsl_threads_handler);
+		k_work_q_start(&zsl_threads_wq[i], zsl_threads_stacks[i],
+			       K_THREAD_STACK_SIZEOF(zsl_threads_stacks[i]),
+			       CONFIG_ZSL_THREADS_PRIORITY);
+		k_thread_name_set(&zsl_threads_wq[i].thread, "zsl_threads");
+		zsl_threads_pin(i);
+	}
+}
+
+static int
+zsl_threads_pin(size_t idx)
+{
+#if CONFIG_SCHED_CPU_MASK
+	k_tid_t tid = &zsl_threads_wq[idx].thread;
+	uint32_t mask = zsl_threads_cpus[idx];
+	int rc;
+
+	/* Only allowed while the queue is idle, i.e. not runnable. */
+	if (mask == 0) {
+		return k_thread_cpu_mask_enable_all(tid);
+	}
+
+	rc = k_thread_cpu_mask_clear(tid);
+	for (int cpu = 0; (rc == 0) && (cpu < CONFIG_MP_NUM_CPUS); cpu++) {
+		if (mask & (1u << cpu)) {
+			rc = k_thread_cpu_mask_enable(tid, cpu);
+		}
+	}
+
+	return rc;
+#else
+	ARG_UNUSED(idx);
+
+	return -ENOSYS;
+#endif
+}
+
+static void
+zsl_threads_post(size_t workers)
+{
+	for (size_t i = 0; i < workers; i++) {
+		k_work_submit_to_queue(&zsl_threads_wq[i], &zsl_threads_wk[i]);
+	}
+}
+
+static void
+zsl_threads_signal_done(void)
+{
+	k_sem_give(&zsl_threads_done);
+}
+
+static void
+zsl_threads_wait_done(void)
+{
+	/* The last range to finish gives the semaphore exactly once. */
+	zsl_threads_unlock();
+	k_sem_take(&zsl_threads_done, K_FOREVER);
+	zsl_threads_lock();
+}
+
+#else
+
+/*
+ * POSIX backend: workers sleep on a condition variable and wake up whenever
+ * the job generation changes.
+ */
+
+static pthread_mutex_t zsl_threads_mtx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t zsl_threads_busy = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t zsl_threads_start_cv = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t zsl_threads_done_cv = PTHREAD_COND_INITIALIZER;
+static pthread_t zsl_threads_tid[ZSL_THREADS_WORKERS];
+static unsigned int zsl_threads_gen;
+
+static void *
+zsl_threads_worker(void *arg)
+{
+	size_t idx = (size_t)(uintptr_t)arg;
+	unsigned int seen = 0;
+
+	zsl_threads_lock();
+	for (;;) {
+		while (zsl_threads_gen == seen) {
+			pthread_cond_wait(&zsl_threads_start_cv,
+					  &zsl_threads_mtx);
+		}
+		seen = zsl_threads_gen;
+
+		/* Workers beyond the current thread count stay idle. */
+		if ((idx + 1) < zsl_threads_count) {
+			zsl_threads_work();
+		}
+	}
+
+	return NULL;
+}
+
+static bool
+zsl_threads_acquire(bool wait)
+{
+	if (wait) {
+		return pthread_mutex_lock(&zsl_threads_busy) == 0;
+	}
+
+	return pthread_mutex_trylock(&zsl_threads_busy) == 0;
+}
+
+static void
+zsl_threads_release(void)
+{
+	pthread_mutex_unlock(&zsl_threads_busy);
+}
+
+static void
+zsl_threads_lock(void)
+{
+	pthread_mutex_lock(&zsl_threads_mtx);
+}
+
+static void
+zsl_threads_unlock(void)
+{
+	pthread_mutex_unlock(&zsl_threads_mtx);
+}
+
+static void
+zsl_threads_spawn(size_t workers)
+{
+	pthread_attr_t attr;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	/* A worker that fails to start leaves its ranges to the others. */
+	while (zsl_threads_started < workers) {
+		size_t i = zsl_threads_started;
+
+		if (pthread_create(&zsl_threads_tid[i], &attr,
+				   zsl_threads_worker, (void *)(uintptr_t)i)) {
+			break;
+		}
+		zsl_threads_started++;
+		zsl_threads_pin(i);
+	}
+
+	pthread_attr_destroy(&attr);
+}
+
+static int
+zsl_threads_pin(size_t idx)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	uint32_t mask = zsl_threads_cpus[idx];
+
+	CPU_ZERO(&set);
+	for (int cpu = 0; cpu < 32; cpu++) {
+		if ((mask == 0) || (mask & (1u << cpu))) {
+			CPU_SET(cpu, &set);
+		}
+	}
+
+	return -pthread_setaffinity_np(zsl_threads_tid[idx], sizeof(set),
+				       &set);
+#else
+	(void)idx;
+
+	return -ENOSYS;
+#endif
+}
+
+static void
+zsl_threads_post(size_t workers)
+{
+	(void)workers;
+
+	zsl_threads_gen++;
+	pthread_cond_broadcast(&zsl_threads_start_cv);
+}
+
+static void
+zsl_threads_signal_done(void)
+{
+	pthread_cond_signal(&zsl_threads_done_cv);
+}
+
+static void
+zsl_threads_wait_done(void)
+{
+	while (zsl_threads_job.pending > 0) {
+		pthread_cond_wait(&zsl_threads_done_cv, &zsl_threads_mtx);
+	}
+}
+
+#endif /* __ZEPHYR__ */
+
+int
+zsl_threads_set_count(size_t count)
+{
+	if ((count < 1) || (count > CONFIG_ZSL_THREADS_MAX)) {
+		return -EINVAL;
+	}
+
+	zsl_threads_acquire(true);
+	zsl_threads_lock();
+	zsl_threads_count = count;
+	zsl_threads_unlock();
+	zsl_threads_release();
+
+	return 0;
+}
+
+size_t
+zsl_threads_get_count(void)
+{
+	return zsl_threads_count;
+}
+
+int
+zsl_threads_set_affinity(size_t idx, uint32_t cpu_mask)
+{
+	int rc = 0;
+
+	if (idx >= ZSL_THREADS_WORKERS) {
+		return -EINVAL;
+	}
+
+	/* Wait until the pool is idle, so the worker isn't mid-job. */
+	zsl_threads_acquire(true);
+	zsl_threads_lock();
+	zsl_threads_cpus[idx] = cpu_mask;
+	if (idx < zsl_threads_started) {
+		rc = zsl_threads_pin(idx);
+	}
+	zsl_threads_unlock();
+	zsl_threads_release();
+
+	return rc;
+}
+
+int
+zsl_threads_for(size_t n, size_t ops, zsl_threads_fn_t fn, void *ctx)
+{
+	size_t parts;
+	int rc;
+
+	if ((ops < zsl_threads_min_ops) || (n < 2) ||
+	    !zsl_threads_acquire(false)) {
+		return fn(ctx, 0, n);
+	}
+
+	parts = zsl_threads_count < n ? zsl_threads_count : n;
+	if (parts < 2) {
+		zsl_threads_release();
+		return fn(ctx, 0, n);
+	}
+
+	zsl_threads_lock();
+	zsl_threads_spawn(parts - 1);
+
+	zsl_threads_job.fn = fn;
+	zsl_threads_job.ctx = ctx;
+	zsl_threads_job.n = n;
+	zsl_threads_job.parts = parts;
+	zsl_threads_job.next = 0;
+	zsl_threads_job.pending = parts;
+	zsl_threads_job.rc = 0;
+	zsl_threads_post(zsl_threads_started < (parts - 1) ?
+			 zsl_threads_started : (parts - 1));
+
+	/* The caller takes ranges too, then waits for the workers. */
+	zsl_threads_work();
+	zsl_threads_wait_done();
+	rc = zsl_threads_job.rc;
+
+	zsl_threads_unlock();
+	zsl_threads_release();
+
+	return rc;
+}
+
+#else
+
+int
+zsl_threads_set_count(size_t count)
+{
+	if (count < 1) {
+		return -EINVAL;
+	}
+
+	return count == 1 ? 0 : -ENOSYS;
+}
+
+size_t
+zsl_threads_get_count(void)
+{
+	return 1;
+}
+
+int
+zsl_threads_set_affinity(size_t idx, uint32_t cpu_mask)
+{
+	return -ENOSYS;
+}
+
+int
+zsl_threads_for(size_t n, size_t ops, zsl_threads_fn_t fn, void *ctx)
+{
+	return fn(ctx, 0, n);
+}
+
+#endif /* CONFIG_ZSL_THREADS */
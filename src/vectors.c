@@ -16,6 +16,11 @@
 #include <zsl/asm/arm/asm_arm_vectors.h>
 #endif
 
+/* Enable optimised x86-64 SIMD functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_vectors.h>
+#endif
+
 int zsl_vec_init(struct zsl_vec *v)
 {
 	memset(v->data, 0, v->sz * sizeof(zsl_real_t));
@@ -85,6 +90,7 @@ int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 }
 #endif
 
+#if !asm_vec_sub
 int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
@@ -100,6 +106,7 @@ int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 
 	return 0;
 }
+#endif
 
 int zsl_vec_neg(struct zsl_vec *v)
 {
@@ -178,6 +185,24 @@ int zsl_vec_scalar_div(struct zsl_vec *v, zsl_real_t s)
 }
 #endif
 
+#if !asm_vec_axpy
+int zsl_vec_axpy(zsl_real_t a, struct zsl_vec *x, struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure x and y are equal length. */
+	if (x->sz != y->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < x->sz; i++) {
+		y->data[i] += a * x->data[i];
+	}
+
+	return 0;
+}
+#endif
+
 zsl_real_t zsl_vec_dist(struct zsl_vec *v, struct zsl_vec *w)
 {
 	int rc = 0;
@@ -196,6 +221,7 @@ zsl_real_t zsl_vec_dist(struct zsl_vec *v, struct zsl_vec *w)
 	return zsl_vec_norm(&x);
 }
 
+#if !asm_vec_dot
 int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
 {
 	zsl_real_t res = 0.0;
@@ -215,6 +241,7 @@ int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
 
 	return 0;
 }
+#endif
 
 zsl_real_t zsl_vec_norm(struct zsl_vec *v)
 {
@@ -298,6 +325,7 @@ int zsl_vec_cross(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *c)
 	return 0;
 }
 
+#if !asm_vec_sum_of_sqrs
 zsl_real_t zsl_vec_sum_of_sqrs(struct zsl_vec *v)
 {
 	zsl_real_t dot = 0.0;
@@ -306,6 +334,7 @@ zsl_real_t zsl_vec_sum_of_sqrs(struct zsl_vec *v)
 
 	return dot;
 }
+#endif
 
 int zsl_vec_mean(struct zsl_vec **v, size_t n, struct zsl_vec *m)
 {
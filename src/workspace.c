@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/workspace.h>
+
+int
+zsl_ws_init(struct zsl_workspace *ws, void *buf, size_t sz)
+{
+	if ((uintptr_t)buf % ZSL_WS_ALIGN) {
+		return -EINVAL;
+	}
+
+	ws->data = buf;
+	ws->sz = sz;
+	ws->used = 0;
+
+	return 0;
+}
+
+void *
+zsl_ws_alloc(struct zsl_workspace *ws, size_t sz)
+{
+	void *p;
+
+	sz = ZSL_WS_BYTES(sz);
+	if (sz > ws->sz - ws->used) {
+		return NULL;
+	}
+
+	p = ws->data + ws->used;
+	ws->used += sz;
+
+	return p;
+}
+
+int
+zsl_ws_mtx(struct zsl_workspace *ws, struct zsl_mtx *m, size_t rows,
+	   size_t cols)
+{
+	zsl_real_t *data = zsl_ws_alloc(ws, rows * cols * sizeof(zsl_real_t));
+
+	if (data == NULL) {
+		return -ENOMEM;
+	}
+
+	m->sz_rows = rows;
+	m->sz_cols = cols;
+	m->data = data;
+	m->stride = 0;
+	m->trans = false;
+
+	return 0;
+}
+
+int
+zsl_ws_vec(struct zsl_workspace *ws, struct zsl_vec *v, size_t sz)
+{
+	zsl_real_t *data = zsl_ws_alloc(ws, sz * sizeof(zsl_real_t));
+
+	if (data == NULL) {
+		return -ENOMEM;
+	}
+
+	v->sz = sz;
+	v->data = data;
+
+	return 0;
+}
+
+size_t
+zsl_ws_mark(struct zsl_workspace *ws)
+{
+	return ws->used;
+}
+
+int
+zsl_ws_release(struct zsl_workspace *ws, size_t mark)
+{
+	if (mark > ws->used) {
+		return -EINVAL;
+	}
+
+	ws->used = mark;
+
+	return 0;
+}
+
+size_t
+zsl_ws_avail(struct zsl_workspace *ws)
+{
+	return ws->sz - ws->used;
+}
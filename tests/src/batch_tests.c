@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/batch.h>
+#include "floatcheck.h"
+#include "mtxcheck.h"
+
+void test_mtx_batch_mult(void)
+{
+	int rc;
+
+	ZSL_MTX_BATCH_DEF(ba, 3, 4, 9);
+	ZSL_MTX_BATCH_DEF(bb, 4, 2, 9);
+	ZSL_MTX_BATCH_DEF(bc, 3, 2, 9);
+	ZSL_MTX_BATCH_DEF(bt, 4, 3, 9);
+	ZSL_MTX_BATCH_DEF(bv, 4, 1, 9);
+	ZSL_MTX_BATCH_DEF(bw, 3, 1, 9);
+	ZSL_MATRIX_DEF(a, 3, 4);
+	ZSL_MATRIX_DEF(b, 4, 2);
+	ZSL_MATRIX_DEF(c, 3, 2);
+	ZSL_MATRIX_DEF(cref, 3, 2);
+	ZSL_MATRIX_DEF(t, 4, 3);
+	ZSL_MATRIX_DEF(tref, 4, 3);
+	ZSL_MATRIX_DEF(v, 4, 1);
+	ZSL_MATRIX_DEF(w, 3, 1);
+	ZSL_MATRIX_DEF(wref, 3, 1);
+
+	zsl_mtx_batch_init(&ba);
+	zsl_mtx_batch_init(&bb);
+	zsl_mtx_batch_init(&bv);
+	for (size_t k = 0; k < ba.count; k++) {
+		mtx_fill_test(&a, k);
+		mtx_fill_test(&b, k);
+		mtx_fill_test(&v, k);
+		zsl_mtx_batch_set(&ba, k, &a);
+		zsl_mtx_batch_set(&bb, k, &b);
+		zsl_mtx_batch_set(&bv, k, &v);
+	}
+
+	rc = zsl_mtx_batch_mult(&ba, &bb, &bc);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_batch_mult_vec(&ba, &bv, &bw);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_batch_trans(&ba, &bt);
+	zassert_equal(rc, 0, NULL);
+
+	/* Each slot must match the single-matrix functions. */
+	for (size_t k = 0; k < ba.count; k++) {
+		zsl_mtx_batch_get(&ba, k, &a);
+		zsl_mtx_batch_get(&bb, k, &b);
+		zsl_mtx_batch_get(&bv, k, &v);
+		zsl_mtx_mult(&a, &b, &cref);
+		zsl_mtx_mult(&a, &v, &wref);
+		zsl_mtx_trans(&a, &tref);
+
+		rc = zsl_mtx_batch_get(&bc, k, &c);
+		zassert_equal(rc, 0, NULL);
+		zassert_true(mtx_is_equal(&c, &cref, 1E-6), NULL);
+		zsl_mtx_batch_get(&bw, k, &w);
+		zassert_true(mtx_is_equal(&w, &wref, 1E-6), NULL);
+		zsl_mtx_batch_get(&bt, k, &t);
+		zassert_true(mtx_is_equal(&t, &tref, 1E-6), NULL);
+	}
+
+	/* Shape, count and slot mismatches are rejected. */
+	zassert_equal(zsl_mtx_batch_mult(&bb, &ba, &bc), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_batch_mult_vec(&ba, &bb, &bc), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_batch_trans(&ba, &bc), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_batch_set(&ba, 9, &a), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_batch_get(&ba, 0, &b), -EINVAL, NULL);
+	bc.count = 8;
+	zassert_equal(zsl_mtx_batch_mult(&ba, &bb, &bc), -EINVAL, NULL);
+}
+
+void test_mtx_batch_inv(void)
+{
+	int rc;
+	zsl_real_t d[7];
+	zsl_real_t dref;
+
+	ZSL_MTX_BATCH_DEF(b2, 2, 2, 7);
+	ZSL_MTX_BATCH_DEF(i2, 2, 2, 7);
+	ZSL_MTX_BATCH_DEF(b3, 3, 3, 7);
+	ZSL_MTX_BATCH_DEF(i3, 3, 3, 7);
+	ZSL_MTX_BATCH_DEF(b4, 4, 4, 7);
+	ZSL_MTX_BATCH_DEF(i4, 4, 4, 7);
+	ZSL_MTX_BATCH_DEF(b5, 5, 5, 7);
+	ZSL_MATRIX_DEF(m2, 2, 2);
+	ZSL_MATRIX_DEF(m3, 3, 3);
+	ZSL_MATRIX_DEF(m4, 4, 4);
+	ZSL_MATRIX_DEF(m, 4, 4);
+	ZSL_MATRIX_DEF(mi, 4, 4);
+	ZSL_MATRIX_DEF(mref, 4, 4);
+	ZSL_MATRIX_DEF(p, 4, 4);
+
+	struct zsl_mtx_batch *bs[3] = { &b2, &b3, &b4 };
+	struct zsl_mtx_batch *is[3] = { &i2, &i3, &i4 };
+	struct zsl_mtx *ms[3] = { &m2, &m3, &m4 };
+
+	for (size_t s = 0; s < 3; s++) {
+		zsl_mtx_batch_init(bs[s]);
+		for (size_t k = 0; k < bs[s]->count; k++) {
+			mtx_fill_test(ms[s], k);
+			zsl_mtx_batch_set(bs[s], k, ms[s]);
+		}
+
+		/* Make the last matrix of the batch singular. */
+		zsl_mtx_init(ms[s], NULL);
+		zsl_mtx_batch_set(bs[s], 6, ms[s]);
+
+		rc = zsl_mtx_batch_deter(bs[s], d);
+		zassert_equal(rc, 0, NULL);
+		rc = zsl_mtx_batch_inv(bs[s], is[s]);
+		zassert_equal(rc, 0, NULL);
+
+		m.sz_rows = m.sz_cols = ms[s]->sz_rows;
+		mi.sz_rows = mi.sz_cols = ms[s]->sz_rows;
+		mref.sz_rows = mref.sz_cols = ms[s]->sz_rows;
+		p.sz_rows = p.sz_cols = ms[s]->sz_rows;
+
+		for (size_t k = 0; k < bs[s]->count; k++) {
+			zsl_mtx_batch_get(bs[s], k, &m);
+			zsl_mtx_batch_get(is[s], k, &mi);
+			zsl_mtx_deter(&m, &dref);
+			zassert_true(val_is_equal(d[k], dref,
+						  1E-5 * (1.0 + ZSL_ABS(dref))),
+				     NULL);
+
+			if (k == 6) {
+				/* Singular matrices give the identity. */
+				zassert_true(val_is_equal(d[k], 0.0, 1E-6),
+					     NULL);
+				zsl_mtx_init(&p, zsl_mtx_entry_fn_identity);
+				zassert_true(mtx_is_equal(&mi, &p, 1E-6), NULL);
+				continue;
+			}
+
+			zsl_mtx_inv(&m, &mref);
+			zassert_true(mtx_is_equal(&mi, &mref, 1E-6), NULL);
+		}
+	}
+
+	/* Only square 2x2, 3x3 and 4x4 matrices are supported. */
+	zassert_equal(zsl_mtx_batch_deter(&b5, d), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_batch_inv(&b5, &b5), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_batch_inv(&b3, &i4), -EINVAL, NULL);
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/fixedpoint.h>
+#include "floatcheck.h"
+
+void test_fixedpoint_conv(void)
+{
+	/* Round to nearest, with ties rounded up. */
+	zassert_equal(zsl_q15_from_real(0.5), 0x4000, NULL);
+	zassert_equal(zsl_q15_from_real(-0.25), -0x2000, NULL);
+	zassert_equal(zsl_q15_from_real(1.4 / 32768.0), 1, NULL);
+	zassert_equal(zsl_q15_from_real(1.6 / 32768.0), 2, NULL);
+	zassert_equal(zsl_q15_from_real(-1.5 / 32768.0), -1, NULL);
+	zassert_equal(zsl_q31_from_real(0.5), 0x40000000, NULL);
+	zassert_equal(zsl_q31_from_real(-0.125), -0x10000000, NULL);
+
+	/* Saturation, including values that only round up to 1.0. */
+	zassert_equal(zsl_q15_from_real(1.0), INT16_MAX, NULL);
+	zassert_equal(zsl_q15_from_real(0.99999), INT16_MAX, NULL);
+	zassert_equal(zsl_q15_from_real(-1.0), INT16_MIN, NULL);
+	zassert_equal(zsl_q15_from_real(-7.0), INT16_MIN, NULL);
+	zassert_equal(zsl_q31_from_real(3.0), INT32_MAX, NULL);
+	zassert_equal(zsl_q31_from_real(-3.0), INT32_MIN, NULL);
+	zassert_equal(zsl_q15_from_real(NAN), 0, NULL);
+	zassert_equal(zsl_q31_from_real(NAN), 0, NULL);
+
+	zassert_true(val_is_equal(zsl_q15_to_real(-0x4000), -0.5, 1E-9), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(0x20000000), 0.25, 1E-9),
+		     NULL);
+
+	/* Scalar products round, and -1.0 * -1.0 saturates. */
+	zassert_equal(zsl_q15_mult(0x4000, 0x4000), 0x2000, NULL);
+	zassert_equal(zsl_q15_mult(INT16_MIN, INT16_MIN), INT16_MAX, NULL);
+	zassert_equal(zsl_q15_mult(1, 0x4000), 1, NULL);
+	zassert_equal(zsl_q31_mult(INT32_MIN, INT32_MIN), INT32_MAX, NULL);
+	zassert_equal(zsl_q31_mult(0x40000000, -0x40000000), -0x20000000,
+		      NULL);
+}
+
+void test_fixedpoint_vec(void)
+{
+	int rc;
+	zsl_q15_t d15;
+	zsl_q31_t d31;
+	zsl_real_t a[9] = { 0.5, -0.5, 0.75, -0.75, 0.1, -0.2, 0.3, 0.9, -0.9 };
+	zsl_real_t b[9] = { 0.75, -0.75, -0.5, 0.5, 0.2, 0.4, -0.1, -0.3, 0.2 };
+
+	ZSL_VECTOR_DEF(va, 9);
+	ZSL_VECTOR_DEF(vb, 9);
+	ZSL_VECTOR_DEF(vc, 9);
+	ZSL_VEC_Q15_DEF(qa, 9);
+	ZSL_VEC_Q15_DEF(qb, 9);
+	ZSL_VEC_Q15_DEF(qc, 9);
+	ZSL_VEC_Q31_DEF(ra, 9);
+	ZSL_VEC_Q31_DEF(rb, 9);
+	ZSL_VEC_Q31_DEF(rc31, 9);
+	ZSL_VEC_Q15_DEF(qs, 3);
+
+	zsl_vec_from_arr(&va, a);
+	zsl_vec_from_arr(&vb, b);
+
+	rc = zsl_vec_q15_from_vec(&qa, &va);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_q15_from_vec(&qb, &vb);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_q31_from_vec(&ra, &va);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_q31_from_vec(&rb, &vb);
+	zassert_equal(rc, 0, NULL);
+
+	/* The first two sums saturate, the others don't. */
+	rc = zsl_vec_q15_add(&qa, &qb, &qc);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(qc.data[0], INT16_MAX, NULL);
+	zassert_equal(qc.data[1], INT16_MIN, NULL);
+	rc = zsl_vec_q15_to_vec(&qc, &vc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 2; i < 9; i++) {
+		zassert_true(val_is_equal(vc.data[i], a[i] + b[i], 1E-4), NULL);
+	}
+
+	rc = zsl_vec_q31_add(&ra, &rb, &rc31);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(rc31.data[0], INT32_MAX, NULL);
+	zassert_equal(rc31.data[1], INT32_MIN, NULL);
+	rc = zsl_vec_q31_to_vec(&rc31, &vc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 2; i < 9; i++) {
+		zassert_true(val_is_equal(vc.data[i], a[i] + b[i], 1E-6), NULL);
+	}
+
+	/* Elements 2 and 3 saturate. */
+	rc = zsl_vec_q15_sub(&qa, &qb, &qc);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(qc.data[2], INT16_MAX, NULL);
+	zassert_equal(qc.data[3], INT16_MIN, NULL);
+	zassert_equal(qc.data[8], INT16_MIN, NULL);
+	rc = zsl_vec_q31_sub(&ra, &rb, &rc31);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(rc31.data[2], INT32_MAX, NULL);
+	zassert_equal(rc31.data[3], INT32_MIN, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(rc31.data[4]), -0.1, 1E-6),
+		     NULL);
+
+	/* Dot products accumulate without intermediate saturation. */
+	rc = zsl_vec_q15_dot(&qa, &qb, &d15);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(zsl_q15_to_real(d15), -0.54, 1E-4), NULL);
+	rc = zsl_vec_q31_dot(&ra, &rb, &d31);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(d31), -0.54, 1E-6), NULL);
+
+	/* Sums beyond 1.0 saturate once, at the end. */
+	rc = zsl_vec_q15_dot(&qa, &qa, &d15);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(d15, INT16_MAX, NULL);
+	rc = zsl_vec_q31_dot(&ra, &ra, &d31);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(d31, INT32_MAX, NULL);
+
+	rc = zsl_vec_q31_scalar_mult(&ra, INT32_MIN);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ra.data[0], -0x40000000, NULL);
+	zassert_equal(ra.data[1], 0x40000000, NULL);
+	rc = zsl_vec_q15_scalar_mult(&qa, 0x4000);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(qa.data[0], 0x2000, NULL);
+
+	/* Size mismatches. */
+	rc = zsl_vec_q15_add(&qa, &qs, &qc);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_vec_q15_dot(&qa, &qs, &d15);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_vec_q15_from_vec(&qs, &va);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/*
+ * The Q31 accumulator is documented to hold 2^16 full-scale products. The
+ * buffer takes 256 KB, so the test is skipped on targets with less RAM.
+ */
+#define FXP_ACC_LIMIT (1 << 16)
+
+#if !defined(CONFIG_SRAM_SIZE) || (CONFIG_SRAM_SIZE >= 512)
+static zsl_q31_t fxp_acc_buf[FXP_ACC_LIMIT];
+#endif
+
+void test_fixedpoint_acc_limit(void)
+{
+#if !defined(CONFIG_SRAM_SIZE) || (CONFIG_SRAM_SIZE >= 512)
+	int rc;
+	zsl_q31_t d;
+	zsl_q31_t wd;
+	struct zsl_vec_q31 v = { .sz = FXP_ACC_LIMIT, .data = fxp_acc_buf };
+	struct zsl_vec_q31 w = { .sz = 1, .data = &wd };
+	struct zsl_mtx_q31 m = {
+		.sz_rows = 1,
+		.sz_cols = FXP_ACC_LIMIT,
+		.data = fxp_acc_buf
+	};
+
+	/*
+	 * Every product is INT32_MIN * INT32_MIN, the largest possible. The
+	 * sum must saturate to just below 1.0 rather than wrap around.
+	 */
+	for (size_t i = 0; i < FXP_ACC_LIMIT; i++) {
+		fxp_acc_buf[i] = INT32_MIN;
+	}
+
+	rc = zsl_vec_q31_dot(&v, &v, &d);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(d, INT32_MAX, NULL);
+
+	rc = zsl_mtx_q31_mult_vec(&m, &v, &w);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(wd, INT32_MAX, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_fixedpoint_mtx(void)
+{
+	int rc;
+	zsl_real_t x;
+	zsl_real_t a[6] = {
+		0.1, -0.2, 0.3,
+		0.4, 0.5, -0.6
+	};
+	zsl_real_t b[6] = {
+		0.25, -0.5,
+		0.125, 0.75,
+		-0.375, 0.0625
+	};
+
+	ZSL_MATRIX_DEF(ma, 2, 3);
+	ZSL_MATRIX_DEF(mb, 3, 2);
+	ZSL_MATRIX_DEF(mc, 2, 2);
+	ZSL_MATRIX_DEF(mr, 2, 2);
+	ZSL_MATRIX_DEF(mv, 3, 1);
+	ZSL_MATRIX_DEF(mw, 2, 1);
+	ZSL_MTX_Q15_DEF(qa, 2, 3);
+	ZSL_MTX_Q15_DEF(qb, 3, 2);
+	ZSL_MTX_Q15_DEF(qc, 2, 2);
+	ZSL_MTX_Q31_DEF(ra, 2, 3);
+	ZSL_MTX_Q31_DEF(rb, 3, 2);
+	ZSL_MTX_Q31_DEF(rc2, 2, 2);
+	ZSL_VEC_Q15_DEF(qv, 3);
+	ZSL_VEC_Q15_DEF(qw, 2);
+	ZSL_VEC_Q31_DEF(rv, 3);
+	ZSL_VEC_Q31_DEF(rw, 2);
+
+	zsl_mtx_from_arr(&ma, a);
+	zsl_mtx_from_arr(&mb, b);
+	rc = zsl_mtx_mult(&ma, &mb, &mr);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_q15_from_mtx(&qa, &ma);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q15_from_mtx(&qb, &mb);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q15_mult(&qa, &qb, &qc);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q15_to_mtx(&qc, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(mc.data[i], mr.data[i], 1E-4), NULL);
+	}
+
+	rc = zsl_mtx_q31_from_mtx(&ra, &ma);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_from_mtx(&rb, &mb);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_mult(&ra, &rb, &rc2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_to_mtx(&rc2, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(mc.data[i], mr.data[i], 1E-6), NULL);
+	}
+
+	/* Matrix-vector product, using the first column of 'b'. */
+	zsl_mtx_get_col(&mb, 0, mv.data);
+	zsl_mtx_mult(&ma, &mv, &mw);
+	for (size_t i = 0; i < 3; i++) {
+		qv.data[i] = qb.data[i * 2];
+		rv.data[i] = rb.data[i * 2];
+	}
+	rc = zsl_mtx_q15_mult_vec(&qa, &qv, &qw);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_mult_vec(&ra, &rv, &rw);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		zassert_true(val_is_equal(zsl_q15_to_real(qw.data[i]),
+					  mw.data[i], 1E-4), NULL);
+		zassert_true(val_is_equal(zsl_q31_to_real(rw.data[i]),
+					  mw.data[i], 1E-6), NULL);
+	}
+
+	/* Element-wise ops, where 'a' + 'a' saturates for -0.6. */
+	rc = zsl_mtx_q15_add(&qa, &qa, &qa);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(qa.data[5], INT16_MIN, NULL);
+	x = zsl_q15_to_real(qa.data[4]);
+	zassert_true(val_is_equal(x, 1.0, 1E-4), NULL);
+	rc = zsl_mtx_q31_sub(&ra, &ra, &ra);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_equal(ra.data[i], 0, NULL);
+	}
+
+	/* Shape mismatches. */
+	rc = zsl_mtx_q15_mult(&qa, &qa, &qc);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_q31_add(&ra, &rb, &ra);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_q31_mult_vec(&ra, &rw, &rv);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_fixedpoint_inv_3x3(void)
+{
+	int rc;
+	int shift;
+	zsl_real_t scale;
+	zsl_real_t amax;
+	zsl_real_t a[9] = {
+		0.50, -0.25, 0.10,
+		0.20, 0.40, -0.30,
+		-0.10, 0.05, 0.60
+	};
+	zsl_real_t s[9] = {
+		0.5, 0.25, 0.125,
+		0.25, 0.125, 0.0625,
+		0.125, -0.375, 0.25
+	};
+
+	ZSL_MATRIX_DEF(m, 3, 3);
+	ZSL_MATRIX_DEF(mi, 3, 3);
+	ZSL_MATRIX_DEF(mq, 3, 3);
+	ZSL_MTX_Q15_DEF(q15, 3, 3);
+	ZSL_MTX_Q31_DEF(q31, 3, 3);
+	ZSL_MTX_Q31_DEF(q31i, 3, 3);
+	ZSL_MTX_Q15_DEF(q15s, 2, 3);
+
+	zsl_mtx_from_arr(&m, a);
+	rc = zsl_mtx_inv_3x3(&m, &mi);
+	zassert_equal(rc, 0, NULL);
+
+	/* Q31, with a separate output. */
+	rc = zsl_mtx_q31_from_mtx(&q31, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_inv_3x3(&q31, &q31i, &shift);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_to_mtx(&q31i, &mq);
+	zassert_equal(rc, 0, NULL);
+	scale = (zsl_real_t)(1 << shift);
+	amax = 0.0;
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(mq.data[i] * scale, mi.data[i], 1E-5),
+			     NULL);
+		amax = ZSL_MAX(amax, ZSL_ABS(mq.data[i]));
+	}
+
+	/* The smallest shift is used, so the largest element is >= 0.5. */
+	zassert_true(amax >= 0.5, NULL);
+
+	/* Q15, in place. */
+	rc = zsl_mtx_q15_from_mtx(&q15, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q15_inv_3x3(&q15, &q15, &shift);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q15_to_mtx(&q15, &mq);
+	zassert_equal(rc, 0, NULL);
+	scale = (zsl_real_t)(1 << shift);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(mq.data[i] * scale, mi.data[i], 1E-3),
+			     NULL);
+	}
+
+	/* The first two rows are parallel, and exact in Q31. */
+	zsl_mtx_from_arr(&m, s);
+	rc = zsl_mtx_q31_from_mtx(&q31, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_inv_3x3(&q31, &q31i, &shift);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	rc = zsl_mtx_q15_inv_3x3(&q15s, &q15, &shift);
+	zassert_equal(rc, -EINVAL, NULL);
+}
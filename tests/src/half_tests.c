@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/statistics.h>
+#include <zsl/half.h>
+#include "floatcheck.h"
+
+/* Fills 'x' with values in [-2, 2), with a few digits of precision. */
+static void half_fill(zsl_real_t *x, size_t n, size_t seed)
+{
+	for (size_t i = 0; i < n; i++) {
+		x[i] = (zsl_real_t)((int)((i * 37 + seed * 11) % 400) - 200) /
+		       100.0;
+	}
+}
+
+void test_half_conv(void)
+{
+	zsl_half_t h;
+
+	/* fp16 reference encodings. */
+	zassert_equal(zsl_half_from_real(1.0, ZSL_HALF_FP16), 0x3C00, NULL);
+	zassert_equal(zsl_half_from_real(-2.0, ZSL_HALF_FP16), 0xC000, NULL);
+	zassert_equal(zsl_half_from_real(65504.0, ZSL_HALF_FP16), 0x7BFF, NULL);
+	zassert_equal(zsl_half_from_real(1.0 / 16777216.0, ZSL_HALF_FP16),
+		      0x0001, NULL);
+	zassert_equal(zsl_half_from_real(0.0, ZSL_HALF_FP16), 0x0000, NULL);
+
+	/* Round to nearest, with ties to even. */
+	zassert_equal(zsl_half_from_real(1.0 + 1.0 / 2048.0, ZSL_HALF_FP16),
+		      0x3C00, NULL);
+	zassert_equal(zsl_half_from_real(1.0 + 3.0 / 2048.0, ZSL_HALF_FP16),
+		      0x3C02, NULL);
+	zassert_equal(zsl_half_from_real(1.0 / 33554432.0, ZSL_HALF_FP16),
+		      0x0000, NULL);
+
+	/* Overflow, infinity and NaN. */
+	zassert_equal(zsl_half_from_real(65520.0, ZSL_HALF_FP16), 0x7C00, NULL);
+	zassert_equal(zsl_half_from_real(-1E6, ZSL_HALF_FP16), 0xFC00, NULL);
+	h = zsl_half_from_real(NAN, ZSL_HALF_FP16);
+	zassert_true(((h & 0x7C00) == 0x7C00) && (h & 0x3FF), NULL);
+	zassert_true(isnan(zsl_half_to_real(h, ZSL_HALF_FP16)), NULL);
+
+	/* Subnormals and normals unpack exactly. */
+	zassert_true(zsl_half_to_real(0x0001, ZSL_HALF_FP16) ==
+		     (zsl_real_t)(1.0 / 16777216.0), NULL);
+	zassert_true(zsl_half_to_real(0x03FF, ZSL_HALF_FP16) ==
+		     (zsl_real_t)(1023.0 / 16777216.0), NULL);
+	zassert_true(zsl_half_to_real(0x3555, ZSL_HALF_FP16) ==
+		     (zsl_real_t)(1365.0 / 4096.0), NULL);
+	zassert_true(isinf(zsl_half_to_real(0xFC00, ZSL_HALF_FP16)), NULL);
+
+	/* bf16 keeps the float range, with 8 significant bits. */
+	zassert_equal(zsl_half_from_real(1.0, ZSL_HALF_BF16), 0x3F80, NULL);
+	zassert_equal(zsl_half_from_real(-2.0, ZSL_HALF_BF16), 0xC000, NULL);
+	zassert_equal(zsl_half_from_real(1.0 + 1.0 / 256.0, ZSL_HALF_BF16),
+		      0x3F80, NULL);
+	zassert_equal(zsl_half_from_real(1.0 + 3.0 / 256.0, ZSL_HALF_BF16),
+		      0x3F82, NULL);
+	zassert_true(zsl_half_to_real(zsl_half_from_real(1E30, ZSL_HALF_BF16),
+				      ZSL_HALF_BF16) > 9.9E29, NULL);
+	h = zsl_half_from_real(NAN, ZSL_HALF_BF16);
+	zassert_true(isnan(zsl_half_to_real(h, ZSL_HALF_BF16)), NULL);
+}
+
+void test_half_pack(void)
+{
+	int rc;
+	zsl_real_t x[37];
+	zsl_half_t h[37];
+
+	ZSL_VECTOR_DEF(v, 37);
+	ZSL_VECTOR_DEF(w, 37);
+	ZSL_VEC_HALF_DEF(vf, 37, ZSL_HALF_FP16);
+	ZSL_VEC_HALF_DEF(vb, 37, ZSL_HALF_BF16);
+	ZSL_VEC_HALF_DEF(vs, 3, ZSL_HALF_FP16);
+	ZSL_MATRIX_DEF(m, 5, 7);
+	ZSL_MATRIX_DEF(mt, 7, 5);
+	ZSL_MATRIX_DEF(mu, 5, 7);
+	ZSL_MTX_HALF_DEF(mh, 5, 7, ZSL_HALF_BF16);
+
+	half_fill(v.data, 37, 1);
+
+	/* The array kernels must match the scalar conversions. */
+	rc = zsl_half_pack(v.data, h, 37, ZSL_HALF_FP16);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_equal(h[i], zsl_half_from_real(v.data[i],
+						       ZSL_HALF_FP16), NULL);
+	}
+	rc = zsl_half_unpack(h, x, 37, ZSL_HALF_FP16);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_true(x[i] == zsl_half_to_real(h[i], ZSL_HALF_FP16),
+			     NULL);
+	}
+	rc = zsl_half_pack(v.data, h, 37, (enum zsl_half_fmt)7);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Round trips, within half an ULP of each format. */
+	rc = zsl_vec_half_pack(&vf, &v);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_half_unpack(&vf, &w);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_true(val_is_equal(w.data[i], v.data[i], 1E-3), NULL);
+	}
+
+	rc = zsl_vec_half_pack(&vb, &v);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_half_unpack(&vb, &w);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_true(val_is_equal(w.data[i], v.data[i], 8E-3), NULL);
+	}
+
+	rc = zsl_vec_half_pack(&vs, &v);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Matrices, including a transposed view. */
+	half_fill(mt.data, 35, 2);
+	rc = zsl_mtx_trans_view(&mt, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_half_pack(&mh, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_half_unpack(&mh, &mu);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 7; j++) {
+			zassert_true(val_is_equal(mu.data[i * 7 + j],
+						  mt.data[j * 5 + i], 8E-3),
+				     NULL);
+		}
+	}
+}
+
+void test_half_kernels(void)
+{
+	int rc;
+	zsl_real_t d;
+	zsl_real_t dr;
+
+	ZSL_VECTOR_DEF(v, 70);
+	ZSL_VECTOR_DEF(w, 70);
+	ZSL_VECTOR_DEF(x, 40);
+	ZSL_VECTOR_DEF(y, 3);
+	ZSL_VECTOR_DEF(yr, 3);
+	ZSL_VEC_HALF_DEF(vh, 70, ZSL_HALF_FP16);
+	ZSL_VEC_HALF_DEF(wh, 70, ZSL_HALF_BF16);
+	ZSL_MATRIX_DEF(ma, 3, 70);
+	ZSL_MATRIX_DEF(mb, 70, 40);
+	ZSL_MATRIX_DEF(mc, 3, 40);
+	ZSL_MATRIX_DEF(mr, 3, 40);
+	ZSL_MTX_HALF_DEF(mah, 3, 70, ZSL_HALF_FP16);
+	ZSL_MTX_HALF_DEF(mbh, 70, 40, ZSL_HALF_BF16);
+
+	/*
+	 * The reference results use the unpacked values, so any difference is
+	 * down to the order of the sums alone.
+	 */
+	half_fill(v.data, 70, 3);
+	half_fill(w.data, 70, 4);
+	zsl_vec_half_pack(&vh, &v);
+	zsl_vec_half_pack(&wh, &w);
+	zsl_vec_half_unpack(&vh, &v);
+	zsl_vec_half_unpack(&wh, &w);
+
+	rc = zsl_vec_half_dot(&vh, &wh, &d);
+	zassert_equal(rc, 0, NULL);
+	zsl_vec_dot(&v, &w, &dr);
+	zassert_true(val_is_equal(d, dr, 1E-4), NULL);
+
+	/* Mixed formats in a single product. */
+	half_fill(ma.data, 3 * 70, 5);
+	half_fill(mb.data, 70 * 40, 6);
+	zsl_mtx_half_pack(&mah, &ma);
+	zsl_mtx_half_pack(&mbh, &mb);
+	zsl_mtx_half_unpack(&mah, &ma);
+	zsl_mtx_half_unpack(&mbh, &mb);
+
+	rc = zsl_mtx_half_mult(&mah, &mbh, &mc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&ma, &mb, &mr);
+	for (size_t i = 0; i < 3 * 40; i++) {
+		zassert_true(val_is_equal(mc.data[i], mr.data[i], 1E-3), NULL);
+	}
+
+	half_fill(x.data, 40, 7);
+	rc = zsl_mtx_half_mult_vec(&mah, &v, &y);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		struct zsl_vec row = { .sz = 70, .data = &ma.data[i * 70] };
+
+		zsl_vec_dot(&row, &v, &yr.data[i]);
+		zassert_true(val_is_equal(y.data[i], yr.data[i], 1E-4), NULL);
+	}
+
+	/* Size mismatches. */
+	rc = zsl_mtx_half_mult_vec(&mah, &x, &y);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_half_mult(&mbh, &mah, &mc);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_half_sta(void)
+{
+	int rc;
+	zsl_real_t m;
+	zsl_real_t mr;
+	zsl_real_t var;
+	zsl_real_t varr;
+
+	ZSL_VECTOR_DEF(v, 101);
+	ZSL_VEC_HALF_DEF(vh, 101, ZSL_HALF_FP16);
+	ZSL_VEC_HALF_DEF(vs, 1, ZSL_HALF_BF16);
+
+	/* An offset mean, to check the two-pass variance. */
+	half_fill(v.data, 101, 8);
+	for (size_t i = 0; i < 101; i++) {
+		v.data[i] += 100.0;
+	}
+	zsl_vec_half_pack(&vh, &v);
+	zsl_vec_half_unpack(&vh, &v);
+
+	rc = zsl_sta_mean_half(&vh, &m);
+	zassert_equal(rc, 0, NULL);
+	zsl_sta_mean(&v, &mr);
+	zassert_true(val_is_equal(m, mr, 1E-3), NULL);
+
+	rc = zsl_sta_var_half(&vh, &var);
+	zassert_equal(rc, 0, NULL);
+	zsl_sta_var(&v, &varr);
+	zassert_true(val_is_equal(var, varr, 1E-3), NULL);
+
+	vs.data[0] = zsl_half_from_real(1.0, ZSL_HALF_BF16);
+	rc = zsl_sta_mean_half(&vs, &m);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(m, 1.0, 1E-9), NULL);
+	rc = zsl_sta_var_half(&vs, &var);
+	zassert_equal(rc, -EINVAL, NULL);
+}
@@ -34,6 +34,8 @@ extern void test_matrix_set(void);
 extern void test_matrix_get_set_row(void);
 extern void test_matrix_get_set_col(void);
 extern void test_matrix_row_from_vec(void);
+extern void test_matrix_view(void);
+extern void test_matrix_view_ops(void);
 extern void test_matrix_unary_op(void);
 extern void test_matrix_unary_func(void);
 extern void test_matrix_binary_op(void);
@@ -46,9 +48,17 @@ extern void test_matrix_sub(void);
 extern void test_matrix_sub_d(void);
 extern void test_matrix_mult_sq(void);
 extern void test_matrix_mult_rect(void);
+extern void test_matrix_mult_kernels(void);
+extern void test_matrix_mult_trans_a(void);
+extern void test_matrix_mult_trans_b(void);
+extern void test_matrix_gemm(void);
+extern void test_matrix_gemv_ger(void);
+extern void test_matrix_syrk(void);
 extern void test_matrix_scalar_mult_d(void);
+extern void test_matrix_elem_ops_long(void);
 extern void test_matrix_scalar_mult_row_d(void);
 extern void test_matrix_trans(void);
+extern void test_matrix_trans_view(void);
 extern void test_matrix_adjoint_3x3(void);
 extern void test_matrix_adjoint(void);
 extern void test_matrix_reduce(void);
@@ -56,6 +66,7 @@ extern void test_matrix_reduce_iter(void);
 extern void test_matrix_augm_diag(void);
 extern void test_matrix_deter_3x3(void);
 extern void test_matrix_deter(void);
+extern void test_matrix_deter_ws(void);
 extern void test_matrix_gauss_elim(void);
 extern void test_matrix_gauss_elim_d(void);
 extern void test_matrix_gauss_reduc(void);
@@ -66,11 +77,41 @@ extern void test_matrix_norm_elem(void);
 extern void test_matrix_norm_elem_d(void);
 extern void test_matrix_inv_3x3(void);
 extern void test_matrix_inv(void);
+extern void test_matrix_lu(void);
+extern void test_matrix_lu_deter(void);
+extern void test_matrix_lu_solve(void);
+extern void test_matrix_lu_inv(void);
+extern void test_matrix_cholesky(void);
+extern void test_matrix_ldl(void);
+extern void test_matrix_solve_tri(void);
+extern void test_matrix_cho_solve(void);
+extern void test_matrix_cho_update(void);
+extern void test_matrix_band_lu(void);
+extern void test_matrix_tridiag_solve(void);
 extern void test_matrix_balance(void);
 extern void test_matrix_householder_sq(void);
 extern void test_matrix_householder_rect(void);
 extern void test_matrix_qrd(void);
 extern void test_matrix_qrd_hess(void);
+extern void test_matrix_qrd_compact(void);
+extern void test_matrix_qrd_apply_q(void);
+extern void test_matrix_qrd_apply_qt(void);
+extern void test_matrix_lstsq(void);
+extern void test_matrix_qrd_update(void);
+extern void test_matrix_expm(void);
+extern void test_matrix_van_loan(void);
+extern void test_matrix_eigen_sym(void);
+extern void test_matrix_svd_thin(void);
+extern void test_matrix_svd_thin_large(void);
+extern void test_matrix_qrd_iter(void);
+extern void test_matrix_eigenvalues(void);
+extern void test_matrix_eigenvalues_cplx(void);
+extern void test_matrix_eigenvectors(void);
+extern void test_matrix_svd(void);
+extern void test_matrix_pinv(void);
+extern void test_matrix_svd_ws(void);
+extern void test_matrix_pinv_ws(void);
+extern void test_matrix_svd_view(void);
 extern void test_matrix_min(void);
 extern void test_matrix_max(void);
 extern void test_matrix_min_idx(void);
@@ -78,15 +119,38 @@ extern void test_matrix_max_idx(void);
 extern void test_matrix_is_equal(void);
 extern void test_matrix_is_notneg(void);
 extern void test_matrix_is_sym(void);
-
-/* Test for functions that only work with double-precision floats. */
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
-extern void test_matrix_qrd_iter(void);
-extern void test_matrix_eigenvalues(void);
-extern void test_matrix_eigenvectors(void);
-extern void test_matrix_svd(void);
-extern void test_matrix_pinv(void);
-#endif
+extern void test_ws_init(void);
+extern void test_ws_alloc(void);
+extern void test_ws_mtx_vec(void);
+extern void test_ws_release(void);
+extern void test_threads_count(void);
+extern void test_threads_for(void);
+extern void test_threads_mtx(void);
+extern void test_fixedpoint_conv(void);
+extern void test_fixedpoint_vec(void);
+extern void test_fixedpoint_acc_limit(void);
+extern void test_fixedpoint_mtx(void);
+extern void test_fixedpoint_inv_3x3(void);
+extern void test_half_conv(void);
+extern void test_half_pack(void);
+extern void test_half_kernels(void);
+extern void test_half_sta(void);
+extern void test_spmtx_from_coo(void);
+extern void test_spmtx_from_mtx(void);
+extern void test_spmtx_mult(void);
+extern void test_spmtx_trans(void);
+extern void test_spmtx_solve_tri(void);
+extern void test_mtx_batch_mult(void);
+extern void test_mtx_batch_inv(void);
+extern void test_mtxf_2x2(void);
+extern void test_mtxf_3x3(void);
+extern void test_mtxf_4x4(void);
+extern void test_mtxf_6x6(void);
+extern void test_mtxf_from_mtx(void);
+extern void test_vecf_ops(void);
+extern void test_solve_cg(void);
+extern void test_solve_bicgstab_gmres(void);
+extern void test_solve_mixed(void);
 
 extern void test_vector_init(void);
 extern void test_vector_from_arr(void);
@@ -99,6 +163,7 @@ extern void test_vector_sum(void);
 extern void test_vector_scalar_add(void);
 extern void test_vector_scalar_mult(void);
 extern void test_vector_scalar_div(void);
+extern void test_vector_axpy(void);
 extern void test_vector_dist(void);
 extern void test_vector_dot(void);
 extern void test_vector_norm(void);
@@ -106,6 +171,7 @@ extern void test_vector_project(void);
 extern void test_vector_to_unit(void);
 extern void test_vector_cross(void);
 extern void test_vector_sum_of_sqrs(void);
+extern void test_vector_long_ops(void);
 extern void test_vector_mean(void);
 extern void test_vector_ar_mean(void);
 extern void test_vector_rev(void);
@@ -300,6 +366,7 @@ extern void test_sta_standard_deviation(void);
 extern void test_sta_covariance(void);
 extern void test_sta_covariance_matrix(void);
 extern void test_sta_linear_regression(void);
+extern void test_sta_rls(void);
 extern void test_sta_absolute_error(void);
 extern void test_sta_relative_error(void);
 
@@ -371,6 +438,8 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_get_set_row),
 			 ztest_unit_test(test_matrix_get_set_col),
 			 ztest_unit_test(test_matrix_row_from_vec),
+			 ztest_unit_test(test_matrix_view),
+			 ztest_unit_test(test_matrix_view_ops),
 			 ztest_unit_test(test_matrix_unary_op),
 			 ztest_unit_test(test_matrix_unary_func),
 			 ztest_unit_test(test_matrix_binary_op),
@@ -383,9 +452,17 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_sub_d),
 			 ztest_unit_test(test_matrix_mult_sq),
 			 ztest_unit_test(test_matrix_mult_rect),
+			 ztest_unit_test(test_matrix_mult_kernels),
+			 ztest_unit_test(test_matrix_mult_trans_a),
+			 ztest_unit_test(test_matrix_mult_trans_b),
+			 ztest_unit_test(test_matrix_gemm),
+			 ztest_unit_test(test_matrix_gemv_ger),
+			 ztest_unit_test(test_matrix_syrk),
 			 ztest_unit_test(test_matrix_scalar_mult_d),
+			 ztest_unit_test(test_matrix_elem_ops_long),
 			 ztest_unit_test(test_matrix_scalar_mult_row_d),
 			 ztest_unit_test(test_matrix_trans),
+			 ztest_unit_test(test_matrix_trans_view),
 			 ztest_unit_test(test_matrix_adjoint_3x3),
 			 ztest_unit_test(test_matrix_adjoint),
 			 ztest_unit_test(test_matrix_reduce),
@@ -393,6 +470,7 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_augm_diag),
 			 ztest_unit_test(test_matrix_deter_3x3),
 			 ztest_unit_test(test_matrix_deter),
+			 ztest_unit_test(test_matrix_deter_ws),
 			 ztest_unit_test(test_matrix_gauss_elim),
 			 ztest_unit_test(test_matrix_gauss_elim_d),
 			 ztest_unit_test(test_matrix_gauss_reduc),
@@ -403,11 +481,41 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_norm_elem_d),
 			 ztest_unit_test(test_matrix_inv_3x3),
 			 ztest_unit_test(test_matrix_inv),
+			 ztest_unit_test(test_matrix_lu),
+			 ztest_unit_test(test_matrix_lu_deter),
+			 ztest_unit_test(test_matrix_lu_solve),
+			 ztest_unit_test(test_matrix_lu_inv),
+			 ztest_unit_test(test_matrix_cholesky),
+			 ztest_unit_test(test_matrix_ldl),
+			 ztest_unit_test(test_matrix_solve_tri),
+			 ztest_unit_test(test_matrix_cho_solve),
+			 ztest_unit_test(test_matrix_cho_update),
+			 ztest_unit_test(test_matrix_band_lu),
+			 ztest_unit_test(test_matrix_tridiag_solve),
 			 ztest_unit_test(test_matrix_balance),
 			 ztest_unit_test(test_matrix_householder_sq),
 			 ztest_unit_test(test_matrix_householder_rect),
 			 ztest_unit_test(test_matrix_qrd),
 			 ztest_unit_test(test_matrix_qrd_hess),
+			 ztest_unit_test(test_matrix_qrd_compact),
+			 ztest_unit_test(test_matrix_qrd_apply_q),
+			 ztest_unit_test(test_matrix_qrd_apply_qt),
+			 ztest_unit_test(test_matrix_lstsq),
+			 ztest_unit_test(test_matrix_qrd_update),
+			 ztest_unit_test(test_matrix_expm),
+			 ztest_unit_test(test_matrix_van_loan),
+			 ztest_unit_test(test_matrix_eigen_sym),
+			 ztest_unit_test(test_matrix_svd_thin),
+			 ztest_unit_test(test_matrix_svd_thin_large),
+			 ztest_unit_test(test_matrix_qrd_iter),
+			 ztest_unit_test(test_matrix_eigenvalues),
+			 ztest_unit_test(test_matrix_eigenvalues_cplx),
+			 ztest_unit_test(test_matrix_eigenvectors),
+			 ztest_unit_test(test_matrix_svd),
+			 ztest_unit_test(test_matrix_pinv),
+			 ztest_unit_test(test_matrix_svd_ws),
+			 ztest_unit_test(test_matrix_pinv_ws),
+			 ztest_unit_test(test_matrix_svd_view),
 			 ztest_unit_test(test_matrix_min),
 			 ztest_unit_test(test_matrix_max),
 			 ztest_unit_test(test_matrix_min_idx),
@@ -415,6 +523,38 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_is_equal),
 			 ztest_unit_test(test_matrix_is_notneg),
 			 ztest_unit_test(test_matrix_is_sym),
+			 ztest_unit_test(test_ws_init),
+			 ztest_unit_test(test_ws_alloc),
+			 ztest_unit_test(test_ws_mtx_vec),
+			 ztest_unit_test(test_ws_release),
+			 ztest_unit_test(test_threads_count),
+			 ztest_unit_test(test_threads_for),
+			 ztest_unit_test(test_threads_mtx),
+			 ztest_unit_test(test_fixedpoint_conv),
+			 ztest_unit_test(test_fixedpoint_vec),
+			 ztest_unit_test(test_fixedpoint_acc_limit),
+			 ztest_unit_test(test_fixedpoint_mtx),
+			 ztest_unit_test(test_fixedpoint_inv_3x3),
+			 ztest_unit_test(test_half_conv),
+			 ztest_unit_test(test_half_pack),
+			 ztest_unit_test(test_half_kernels),
+			 ztest_unit_test(test_half_sta),
+			 ztest_unit_test(test_spmtx_from_coo),
+			 ztest_unit_test(test_spmtx_from_mtx),
+			 ztest_unit_test(test_spmtx_mult),
+			 ztest_unit_test(test_spmtx_trans),
+			 ztest_unit_test(test_spmtx_solve_tri),
+			 ztest_unit_test(test_mtx_batch_mult),
+			 ztest_unit_test(test_mtx_batch_inv),
+			 ztest_unit_test(test_mtxf_2x2),
+			 ztest_unit_test(test_mtxf_3x3),
+			 ztest_unit_test(test_mtxf_4x4),
+			 ztest_unit_test(test_mtxf_6x6),
+			 ztest_unit_test(test_mtxf_from_mtx),
+			 ztest_unit_test(test_vecf_ops),
+			 ztest_unit_test(test_solve_cg),
+			 ztest_unit_test(test_solve_bicgstab_gmres),
+			 ztest_unit_test(test_solve_mixed),
 
 			 ztest_unit_test(test_vector_init),
 			 ztest_unit_test(test_vector_from_arr),
@@ -427,6 +567,7 @@ void test_main(void)
 			 ztest_unit_test(test_vector_scalar_add),
 			 ztest_unit_test(test_vector_scalar_mult),
 			 ztest_unit_test(test_vector_scalar_div),
+			 ztest_unit_test(test_vector_axpy),
 			 ztest_unit_test(test_vector_dist),
 			 ztest_unit_test(test_vector_dot),
 			 ztest_unit_test(test_vector_norm),
@@ -434,6 +575,7 @@ void test_main(void)
 			 ztest_unit_test(test_vector_to_unit),
 			 ztest_unit_test(test_vector_cross),
 			 ztest_unit_test(test_vector_sum_of_sqrs),
+			 ztest_unit_test(test_vector_long_ops),
 			 ztest_unit_test(test_vector_mean),
 			 ztest_unit_test(test_vector_ar_mean),
 			 ztest_unit_test(test_vector_rev),
@@ -628,6 +770,7 @@ void test_main(void)
 			 ztest_unit_test(test_sta_covariance),
 			 ztest_unit_test(test_sta_covariance_matrix),
 			 ztest_unit_test(test_sta_linear_regression),
+			 ztest_unit_test(test_sta_rls),
 			 ztest_unit_test(test_sta_absolute_error),
 			 ztest_unit_test(test_sta_relative_error),
 
@@ -668,17 +811,4 @@ void test_main(void)
 			 ztest_unit_test(test_quat_from_rot_mtx));
 
 	ztest_run_test_suite(zsl_tests);
-
-	/* Run test on functions that only exist w/double-precision floats. */
-	#ifndef CONFIG_ZSL_SINGLE_PRECISION
-	ztest_test_suite(zsl_tests_double,
-			 ztest_unit_test(test_matrix_qrd_iter),
-			 ztest_unit_test(test_matrix_eigenvalues),
-			 ztest_unit_test(test_matrix_eigenvectors),
-			 ztest_unit_test(test_matrix_svd),
-			 ztest_unit_test(test_matrix_pinv)
-			 );
-
-	ztest_run_test_suite(zsl_tests_double);
-	#endif
 }
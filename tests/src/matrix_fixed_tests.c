@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/matrices_fixed.h>
+#include "floatcheck.h"
+#include "mtxcheck.h"
+
+/*
+ * Checks the fixed-size functions of size 'n' against the dynamically sized
+ * matrix API, including calls where the output aliases an input.
+ */
+#define FIXED_CHECK_MTX(n)						     \
+	do {								     \
+		int rc;							     \
+		zsl_real_t d, df;					     \
+		struct zsl_mtx ## n fa, fb, fc, fi;			     \
+		struct zsl_vec ## n fv, fw;				     \
+		ZSL_MATRIX_DEF(ma, n, n);				     \
+		ZSL_MATRIX_DEF(mb, n, n);				     \
+		ZSL_MATRIX_DEF(mc, n, n);				     \
+		ZSL_MATRIX_DEF(mv, n, 1);				     \
+		ZSL_MATRIX_DEF(mw, n, 1);				     \
+									     \
+		mtx_fill_test(&ma, 1);					     \
+		mtx_fill_test(&mb, 4);					     \
+		for (size_t i = 0; i < n; i++) {			     \
+			mv.data[i] = (zsl_real_t)i - 1.5;		     \
+			fv.data[i] = mv.data[i];			     \
+		}							     \
+		rc = zsl_mtx ## n ## _from_mtx(&fa, &ma);		     \
+		zassert_equal(rc, 0, NULL);				     \
+		rc = zsl_mtx ## n ## _from_mtx(&fb, &mb);		     \
+		zassert_equal(rc, 0, NULL);				     \
+									     \
+		/* Addition and subtraction. */				     \
+		zsl_mtx_add(&ma, &mb, &mc);				     \
+		zsl_mtx ## n ## _add(&fa, &fb, &fc);			     \
+		zassert_true(arr_is_equal(fc.data, mc.data, n * n, 1E-6),  \
+			     NULL);					     \
+		zsl_mtx ## n ## _sub(&fc, &fb, &fc);			     \
+		zassert_true(arr_is_equal(fc.data, fa.data, n * n, 1E-6),  \
+			     NULL);					     \
+									     \
+		/* Scaling. */						     \
+		fc = fa;						     \
+		zsl_mtx ## n ## _scalar_mult(&fc, 2.5);			     \
+		zassert_true(val_is_equal(fc.data[n + 1],		     \
+					  2.5 * fa.data[n + 1], 1E-6), NULL);  \
+									     \
+		/* Multiplication, also in place. */			     \
+		zsl_mtx_mult(&ma, &mb, &mc);				     \
+		zsl_mtx ## n ## _mult(&fa, &fb, &fc);			     \
+		zassert_true(arr_is_equal(fc.data, mc.data, n * n, 1E-6),  \
+			     NULL);					     \
+		fc = fa;						     \
+		zsl_mtx ## n ## _mult(&fc, &fb, &fc);			     \
+		zassert_true(arr_is_equal(fc.data, mc.data, n * n, 1E-6),  \
+			     NULL);					     \
+									     \
+		/* Matrix-vector product. */				     \
+		zsl_mtx_mult(&ma, &mv, &mw);				     \
+		zsl_mtx ## n ## _mult_vec(&fa, &fv, &fw);		     \
+		zassert_true(arr_is_equal(fw.data, mw.data, n, 1E-6), NULL); \
+		zsl_mtx ## n ## _mult_vec(&fa, &fv, &fv);		     \
+		zassert_true(arr_is_equal(fv.data, mw.data, n, 1E-6), NULL); \
+									     \
+		/* Transpose, also in place. */				     \
+		zsl_mtx_trans(&ma, &mc);				     \
+		fc = fa;						     \
+		zsl_mtx ## n ## _trans(&fc, &fc);			     \
+		zassert_true(arr_is_equal(fc.data, mc.data, n * n, 1E-6),  \
+			     NULL);					     \
+									     \
+		/* Determinant and inverse. */				     \
+		rc = zsl_mtx_deter(&ma, &d);				     \
+		zassert_equal(rc, 0, NULL);				     \
+		df = zsl_mtx ## n ## _deter(&fa);			     \
+		zassert_true(val_is_equal(df / d, 1.0, 1E-5), NULL);	     \
+		rc = zsl_mtx ## n ## _inv(&fa, &fi);			     \
+		zassert_equal(rc, 0, NULL);				     \
+		zsl_mtx ## n ## _mult(&fa, &fi, &fc);			     \
+		zsl_mtx ## n ## _identity(&fb);				     \
+		zassert_true(arr_is_equal(fc.data, fb.data, n * n, 1E-5),  \
+			     NULL);					     \
+									     \
+		/* A singular matrix is rejected and leaves 'fi' alone. */     \
+		fc = fa;						     \
+		for (size_t j = 0; j < n; j++) {			     \
+			fc.data[n + j] = fc.data[j];			     \
+		}							     \
+		zassert_true(val_is_equal(zsl_mtx ## n ## _deter(&fc), 0.0,   \
+					  1E-6), NULL);			     \
+		fb = fi;						     \
+		rc = zsl_mtx ## n ## _inv(&fc, &fi);			     \
+		zassert_equal(rc, -ESINGULAR, NULL);			     \
+		zassert_true(arr_is_equal(fi.data, fb.data, n * n, 1E-6),  \
+			     NULL);					     \
+									     \
+		/* Round trip through the dynamic API. */		     \
+		rc = zsl_mtx ## n ## _to_mtx(&fa, &mc);			     \
+		zassert_equal(rc, 0, NULL);				     \
+		zassert_true(arr_is_equal(mc.data, ma.data, n * n, 1E-6),  \
+			     NULL);					     \
+	} while (0)
+
+void test_mtxf_2x2(void)
+{
+	FIXED_CHECK_MTX(2);
+}
+
+void test_mtxf_3x3(void)
+{
+	FIXED_CHECK_MTX(3);
+}
+
+void test_mtxf_4x4(void)
+{
+	FIXED_CHECK_MTX(4);
+}
+
+void test_mtxf_6x6(void)
+{
+	FIXED_CHECK_MTX(6);
+}
+
+void test_mtxf_from_mtx(void)
+{
+	int rc;
+	struct zsl_mtx3 f;
+	struct zsl_mtx t;
+
+	zsl_real_t a[9] = {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0,
+		7.0, 8.0, 9.0
+	};
+	zsl_real_t at[9] = {
+		1.0, 4.0, 7.0,
+		2.0, 5.0, 8.0,
+		3.0, 6.0, 9.0
+	};
+
+	ZSL_MATRIX_DEF(m, 3, 3);
+	ZSL_MATRIX_DEF(m4, 4, 4);
+
+	rc = zsl_mtx_from_arr(&m, a);
+	zassert_equal(rc, 0, NULL);
+
+	/* A transposed view is read in its logical layout. */
+	rc = zsl_mtx_trans_view(&m, &t);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx3_from_mtx(&f, &t);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(arr_is_equal(f.data, at, 9, 1E-6), NULL);
+
+	/* Shape mismatches are rejected. */
+	rc = zsl_mtx3_from_mtx(&f, &m4);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx3_to_mtx(&f, &m4);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_vecf_ops(void)
+{
+	int rc;
+	struct zsl_vec4 v = { { 1.0, -2.0, 3.0, 0.5 } };
+	struct zsl_vec4 w = { { 2.0, 1.0, -1.0, 4.0 } };
+	struct zsl_vec4 x;
+
+	ZSL_VECTOR_DEF(dv, 4);
+	ZSL_VECTOR_DEF(dw, 3);
+
+	zsl_vec4_add(&v, &w, &x);
+	zassert_true(val_is_equal(x.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[3], 4.5, 1E-6), NULL);
+
+	zsl_vec4_sub(&x, &w, &x);
+	zassert_true(arr_is_equal(x.data, v.data, 4, 1E-6), NULL);
+
+	zsl_vec4_scalar_mult(&x, -2.0);
+	zassert_true(val_is_equal(x.data[1], 4.0, 1E-6), NULL);
+
+	/* 2 - 2 - 3 + 2 */
+	zassert_true(val_is_equal(zsl_vec4_dot(&v, &w), -1.0, 1E-6), NULL);
+
+	rc = zsl_vec4_to_vec(&v, &dv);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec4_from_vec(&x, &dv);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(arr_is_equal(x.data, v.data, 4, 1E-6), NULL);
+
+	rc = zsl_vec4_to_vec(&v, &dw);
+	zassert_equal(rc, -EINVAL, NULL);
+}
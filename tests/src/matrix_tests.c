@@ -10,6 +10,14 @@
 #include <zsl/vectors.h>
 #include "floatcheck.h"
 
+/* Tolerance for the iterative eigenvalue and SVD tests, whose results carry
+ * fewer digits when built with single-precision floats. */
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+#define MTX_ITER_EPS(eps) (1E-4)
+#else
+#define MTX_ITER_EPS(eps) (eps)
+#endif
+
 /**
  * @brief zsl_mtx_init unit tests.
  *
@@ -358,6 +366,185 @@ void test_matrix_row_from_vec(void)
 	zassert_true(val_is_equal(v.data[2], 0.0, 1E-5), NULL);
 }
 
+void test_matrix_view(void)
+{
+	int rc;
+	zsl_real_t x;
+	zsl_real_t a[2 * 3] = {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0
+	};
+	zsl_real_t col[2];
+	struct zsl_mtx mv;
+	struct zsl_mtx mvv;
+
+	ZSL_MATRIX_DEF(m, 5, 6);
+	ZSL_MATRIX_DEF(mc, 2, 3);
+
+	/* Set every element to its row-major index. */
+	for (size_t i = 0; i < 5 * 6; i++) {
+		m.data[i] = (zsl_real_t)i;
+	}
+
+	/* 3x4 view starting at row 1, column 2. */
+	rc = zsl_mtx_view(&m, &mv, 1, 2, 3, 4);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(mv.sz_rows, 3, NULL);
+	zassert_equal(mv.sz_cols, 4, NULL);
+	zassert_equal(mv.stride, 6, NULL);
+
+	rc = zsl_mtx_get(&mv, 2, 1, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 21.0, 1E-6), NULL);
+	rc = zsl_mtx_get(&mv, 3, 0, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Writes through the view land in the parent. */
+	rc = zsl_mtx_set(&mv, 0, 0, -1.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(m.data[8], -1.0, 1E-6), NULL);
+
+	/* Views of views use the stride of the original parent. */
+	rc = zsl_mtx_view(&mv, &mvv, 1, 1, 2, 3);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(mvv.stride, 6, NULL);
+	rc = zsl_mtx_get(&mvv, 1, 2, &x);
+	zassert_true(val_is_equal(x, 23.0, 1E-6), NULL);
+
+	rc = zsl_mtx_from_arr(&mvv, a);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(m.data[15], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[17], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[18], 18.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[21], 4.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[23], 6.0, 1E-6), NULL);
+
+	rc = zsl_mtx_copy(&mc, &mvv);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 2 * 3; i++) {
+		zassert_true(val_is_equal(mc.data[i], a[i], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_get_col(&mvv, 1, col);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(col[0], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(col[1], 5.0, 1E-6), NULL);
+
+	/* Blocks that don't fit in the parent are rejected. */
+	rc = zsl_mtx_view(&m, &mv, 3, 0, 3, 1);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_view(&m, &mv, 0, 4, 1, 3);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_view_ops(void)
+{
+	int rc;
+	struct zsl_mtx va, vb, vc, vt;
+
+	ZSL_MATRIX_DEF(m, 9, 10);
+	ZSL_MATRIX_DEF(out, 9, 10);
+	ZSL_MATRIX_DEF(a, 5, 6);
+	ZSL_MATRIX_DEF(a2, 5, 6);
+	ZSL_MATRIX_DEF(b, 6, 5);
+	ZSL_MATRIX_DEF(c, 5, 5);
+	ZSL_MATRIX_DEF(cv, 5, 5);
+	ZSL_MATRIX_DEF(at, 6, 5);
+
+	for (size_t i = 0; i < 9 * 10; i++) {
+		m.data[i] = ZSL_SIN((zsl_real_t)i);
+	}
+	zsl_mtx_init(&out, NULL);
+
+	/* Products of two views into a view, against contiguous copies. */
+	zsl_mtx_view(&m, &va, 1, 2, 5, 6);
+	zsl_mtx_view(&m, &vb, 3, 0, 6, 5);
+	zsl_mtx_view(&out, &vc, 2, 3, 5, 5);
+	zsl_mtx_copy(&a, &va);
+	zsl_mtx_copy(&b, &vb);
+
+	rc = zsl_mtx_mult(&va, &vb, &vc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&a, &b, &c);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	/* Elements around the output view must be untouched. */
+	zassert_true(val_is_equal(out.data[(2 * 10) + 2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(out.data[(2 * 10) + 8], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(out.data[(7 * 10) + 3], 0.0, 1E-6), NULL);
+
+	rc = zsl_mtx_mult_trans_a(&va, &vb, &vc);
+	zassert_equal(rc, -EINVAL, NULL);
+	zsl_mtx_view(&m, &vt, 0, 0, 6, 5);
+	zsl_mtx_copy(&at, &vt);
+	rc = zsl_mtx_mult_trans_a(&vt, &vb, &vc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult_trans_a(&at, &b, &c);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	zsl_mtx_view(&m, &vt, 4, 4, 5, 6);
+	zsl_mtx_copy(&a2, &vt);
+	rc = zsl_mtx_mult_trans_b(&va, &vt, &vc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult_trans_b(&a, &a2, &c);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	/* Element-wise operations. */
+	zsl_mtx_view(&m, &va, 0, 1, 5, 5);
+	zsl_mtx_view(&m, &vb, 4, 4, 5, 5);
+	zsl_mtx_copy(&c, &va);
+	zsl_mtx_copy(&cv, &vb);
+	zsl_mtx_add_d(&c, &cv);
+	rc = zsl_mtx_add(&va, &vb, &vc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	zsl_mtx_copy(&c, &vc);
+	zsl_mtx_copy(&cv, &vb);
+	zsl_mtx_sub_d(&c, &cv);
+	rc = zsl_mtx_sub_d(&vc, &vb);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	rc = zsl_mtx_scalar_mult_d(&vc, 2.0);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_scalar_mult_d(&c, 2.0);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	rc = zsl_mtx_unary_op(&vc, ZSL_MTX_UNARY_OP_NEGATIVE);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_unary_op(&c, ZSL_MTX_UNARY_OP_NEGATIVE);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	rc = zsl_mtx_binary_op(&vc, &va, &vc, ZSL_MTX_BINARY_OP_MULT);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_copy(&cv, &va);
+	zsl_mtx_binary_op(&c, &cv, &c, ZSL_MTX_BINARY_OP_MULT);
+	zsl_mtx_copy(&cv, &vc);
+	zassert_true(zsl_mtx_is_equal(&c, &cv), NULL);
+
+	zassert_true(val_is_equal(out.data[(2 * 10) + 2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(out.data[(1 * 10) + 3], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(out.data[(7 * 10) + 3], 0.0, 1E-6), NULL);
+
+	/* Transpose from one view into another. */
+	zsl_mtx_view(&m, &va, 2, 1, 5, 6);
+	zsl_mtx_view(&out, &vt, 1, 2, 6, 5);
+	rc = zsl_mtx_trans(&va, &vt);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_copy(&a, &va);
+	zsl_mtx_trans(&a, &at);
+	zsl_mtx_copy(&b, &vt);
+	zassert_true(zsl_mtx_is_equal(&at, &b), NULL);
+}
+
 void test_matrix_unary_op(void)
 {
 	int rc;
@@ -859,6 +1046,345 @@ void test_matrix_mult_rect(void)
 	zassert_equal(mref.data[11], mc.data[11], NULL);
 }
 
+/**
+ * @brief zsl_mtx_mult unit tests across the dedicated and blocked kernels.
+ *
+ * This test verifies the zsl_mtx_mult function against a reference
+ * calculation for shapes handled by each of the internal kernels.
+ */
+void test_matrix_mult_kernels(void)
+{
+	int rc = 0;
+	zsl_real_t x;
+	zsl_real_t data_a[13 * 13];
+	zsl_real_t data_b[13 * 13];
+	zsl_real_t data_c[13 * 13];
+
+	/* Shapes as (rows a, cols a, cols b), covering the 4x4 and 6x6
+	 * kernels, and full and partial tiles in the blocked kernel. */
+	size_t shapes[6][3] = { { 4, 4, 4 },
+				{ 6, 6, 6 },
+				{ 8, 5, 8 },
+				{ 9, 7, 5 },
+				{ 5, 13, 6 },
+				{ 2, 3, 11 } };
+
+	struct zsl_mtx ma = { .data = data_a };
+	struct zsl_mtx mb = { .data = data_b };
+	struct zsl_mtx mc = { .data = data_c };
+
+	for (size_t t = 0; t < 6; t++) {
+		ma.sz_rows = shapes[t][0];
+		ma.sz_cols = shapes[t][1];
+		mb.sz_rows = shapes[t][1];
+		mb.sz_cols = shapes[t][2];
+		mc.sz_rows = shapes[t][0];
+		mc.sz_cols = shapes[t][2];
+
+		/* Fill the inputs with small, exactly representable values. */
+		for (size_t g = 0; g < ma.sz_rows * ma.sz_cols; g++) {
+			ma.data[g] = (zsl_real_t)((g * 7) % 11) - 5.0;
+		}
+		for (size_t g = 0; g < mb.sz_rows * mb.sz_cols; g++) {
+			mb.data[g] = (zsl_real_t)((g * 5) % 13) - 6.0;
+		}
+
+		rc = zsl_mtx_mult(&ma, &mb, &mc);
+		zassert_equal(rc, 0, NULL);
+
+		/* Compare against a naive i-j-k calculation. */
+		for (size_t i = 0; i < mc.sz_rows; i++) {
+			for (size_t j = 0; j < mc.sz_cols; j++) {
+				x = 0.0;
+				for (size_t k = 0; k < ma.sz_cols; k++) {
+					x += ma.data[(i * ma.sz_cols) + k] *
+					     mb.data[(k * mb.sz_cols) + j];
+				}
+				zassert_true(val_is_equal(
+					mc.data[(i * mc.sz_cols) + j], x, 1E-6),
+					NULL);
+			}
+		}
+	}
+}
+
+/**
+ * @brief zsl_mtx_mult_trans_a unit tests.
+ *
+ * This test verifies the zsl_mtx_mult_trans_a function.
+ */
+void test_matrix_mult_trans_a(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(mc, 2, 3);
+	ZSL_MATRIX_DEF(merr, 3, 3);
+
+	/* Input matrix a (4x2), transposed to 2x4. */
+	zsl_real_t data_a[8] = { 2.0, 3.0,
+				 1.0, 4.0,
+				 4.0, 3.0,
+				 3.0, 4.0 };
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = data_a
+	};
+
+	/* Input matrix b (4x3). */
+	zsl_real_t data_b[12] = { 1.0, 0.0, 2.0,
+				  0.0, 1.0, 1.0,
+				  2.0, 1.0, 0.0,
+				  1.0, 2.0, 1.0 };
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 3,
+		.data = data_b
+	};
+
+	/* Output reference matrix (2x3). */
+	zsl_real_t data_ref[6] = { 13.0, 11.0,  8.0,
+				   13.0, 15.0, 14.0 };
+
+	rc = zsl_mtx_mult_trans_a(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(mc.data[g], data_ref[g], 1E-6), NULL);
+	}
+
+	/* Attempt an invalid multiplication. */
+	rc = zsl_mtx_mult_trans_a(&ma, &mb, &merr);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_mtx_mult_trans_b unit tests.
+ *
+ * This test verifies the zsl_mtx_mult_trans_b function.
+ */
+void test_matrix_mult_trans_b(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(mc, 4, 3);
+	ZSL_MATRIX_DEF(merr, 4, 4);
+
+	/* Input matrix a (4x2). */
+	zsl_real_t data_a[8] = { 2.0, 3.0,
+				 1.0, 4.0,
+				 4.0, 3.0,
+				 3.0, 4.0 };
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = data_a
+	};
+
+	/* Input matrix b (3x2), transposed to 2x3. */
+	zsl_real_t data_b[6] = { 3.0, 2.0,
+				 1.0, 4.0,
+				 2.0, 2.0 };
+	struct zsl_mtx mb = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = data_b
+	};
+
+	/* Output reference matrix (4x3). */
+	zsl_real_t data_ref[12] = { 12.0, 14.0, 10.0,
+				    11.0, 17.0, 10.0,
+				    18.0, 16.0, 14.0,
+				    17.0, 19.0, 14.0 };
+
+	rc = zsl_mtx_mult_trans_b(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 12; g++) {
+		zassert_true(val_is_equal(mc.data[g], data_ref[g], 1E-6), NULL);
+	}
+
+	/* Attempt an invalid multiplication. */
+	rc = zsl_mtx_mult_trans_b(&ma, &mb, &merr);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_mtx_gemm unit tests.
+ *
+ * This test verifies every transpose combination of zsl_mtx_gemm against
+ * zsl_mtx_mult, with a shape large enough to use the tiled kernel.
+ */
+void test_matrix_gemm(void)
+{
+	int rc = 0;
+	zsl_real_t ref;
+
+	ZSL_MATRIX_DEF(ma, 6, 5);
+	ZSL_MATRIX_DEF(mat, 5, 6);
+	ZSL_MATRIX_DEF(mb, 5, 7);
+	ZSL_MATRIX_DEF(mbt, 7, 5);
+	ZSL_MATRIX_DEF(mab, 6, 7);
+	ZSL_MATRIX_DEF(mc0, 6, 7);
+	ZSL_MATRIX_DEF(mc, 6, 7);
+
+	for (size_t g = 0; g < 30; g++) {
+		ma.data[g] = (zsl_real_t)((g * 7) % 11) - 5.0;
+	}
+	for (size_t g = 0; g < 35; g++) {
+		mb.data[g] = (zsl_real_t)((g * 5) % 9) - 4.0;
+	}
+	for (size_t g = 0; g < 42; g++) {
+		mc0.data[g] = (zsl_real_t)(g % 4) - 1.5;
+	}
+	zsl_mtx_trans(&ma, &mat);
+	zsl_mtx_trans(&mb, &mbt);
+	zsl_mtx_mult(&ma, &mb, &mab);
+
+	struct zsl_mtx *as[2] = { &ma, &mat };
+	struct zsl_mtx *bs[2] = { &mb, &mbt };
+
+	/* mc = 2.0 * op(a) * op(b) - 0.5 * mc. */
+	for (size_t t = 0; t < 4; t++) {
+		zsl_mtx_copy(&mc, &mc0);
+		rc = zsl_mtx_gemm(t & 1, t & 2, 2.0, as[t & 1], bs[(t & 2) >> 1],
+				  -0.5, &mc);
+		zassert_equal(rc, 0, NULL);
+		for (size_t g = 0; g < 42; g++) {
+			ref = 2.0 * mab.data[g] - 0.5 * mc0.data[g];
+			zassert_true(val_is_equal(mc.data[g], ref, 1E-6), NULL);
+		}
+	}
+
+	/* With beta = 0.0, the initial contents of 'mc' are ignored. */
+	for (size_t g = 0; g < 42; g++) {
+		mc.data[g] = NAN;
+	}
+	rc = zsl_mtx_gemm(false, false, 1.0, &ma, &mb, 0.0, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 42; g++) {
+		zassert_true(val_is_equal(mc.data[g], mab.data[g], 1E-6), NULL);
+	}
+
+	/* Mismatched shapes are rejected. */
+	rc = zsl_mtx_gemm(true, false, 1.0, &ma, &mb, 0.0, &mc);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_gemm(false, false, 1.0, &ma, &mb, 0.0, &mab);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_gemm(false, false, 1.0, &ma, &mb, 0.0, &mbt);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_mtx_gemv and zsl_mtx_ger unit tests.
+ *
+ * This test verifies zsl_mtx_gemv with and without transposition, and the
+ * rank-1 update zsl_mtx_ger.
+ */
+void test_matrix_gemv_ger(void)
+{
+	int rc = 0;
+
+	ZSL_VECTOR_DEF(x3, 3);
+	ZSL_VECTOR_DEF(x2, 2);
+	ZSL_VECTOR_DEF(y2, 2);
+	ZSL_VECTOR_DEF(y3, 3);
+
+	zsl_real_t data_a[6] = { 1.0, 2.0, 3.0,
+				 4.0, 5.0, 6.0 };
+	struct zsl_mtx ma = {
+		.sz_rows = 2,
+		.sz_cols = 3,
+		.data = data_a
+	};
+
+	zsl_real_t data_x3[3] = { 1.0, -1.0, 2.0 };
+	zsl_real_t data_x2[2] = { 2.0, -1.0 };
+
+	zsl_vec_from_arr(&x3, data_x3);
+	zsl_vec_from_arr(&x2, data_x2);
+
+	/* y2 = 2 * A * x3 + 3 * y2, with y2 = { 1, 1 }: A * x3 = { 5, 11 }. */
+	y2.data[0] = 1.0;
+	y2.data[1] = 1.0;
+	rc = zsl_mtx_gemv(false, 2.0, &ma, &x3, 3.0, &y2);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y2.data[0], 13.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y2.data[1], 25.0, 1E-6), NULL);
+
+	/* y3 = A^T * x2 = { -2, -1, 0 }, ignoring the contents of y3. */
+	y3.data[0] = NAN;
+	y3.data[1] = NAN;
+	y3.data[2] = NAN;
+	rc = zsl_mtx_gemv(true, 1.0, &ma, &x2, 0.0, &y3);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y3.data[0], -2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y3.data[1], -1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y3.data[2], 0.0, 1E-6), NULL);
+
+	/* A = -1 * x2 * x3^T + A. */
+	rc = zsl_mtx_ger(-1.0, &x2, &x3, &ma);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ma.data[0], -1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ma.data[1], 4.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ma.data[2], -1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ma.data[3], 5.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ma.data[4], 4.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ma.data[5], 8.0, 1E-6), NULL);
+
+	/* Mismatched sizes are rejected. */
+	rc = zsl_mtx_gemv(true, 1.0, &ma, &x3, 0.0, &y3);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_ger(1.0, &x3, &x2, &ma);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_mtx_syrk unit tests.
+ *
+ * This test verifies zsl_mtx_syrk against zsl_mtx_mult_trans_a and
+ * zsl_mtx_mult_trans_b.
+ */
+void test_matrix_syrk(void)
+{
+	int rc = 0;
+	zsl_real_t ref;
+
+	ZSL_MATRIX_DEF(ma, 3, 4);
+	ZSL_MATRIX_DEF(maat, 3, 3);
+	ZSL_MATRIX_DEF(mata, 4, 4);
+	ZSL_MATRIX_DEF(mc3, 3, 3);
+	ZSL_MATRIX_DEF(mc4, 4, 4);
+
+	for (size_t g = 0; g < 12; g++) {
+		ma.data[g] = (zsl_real_t)((g * 5) % 7) - 3.0;
+	}
+	zsl_mtx_mult_trans_b(&ma, &ma, &maat);
+	zsl_mtx_mult_trans_a(&ma, &ma, &mata);
+
+	/* mc3 = 0.5 * A * A^T + 2 * I. */
+	zsl_mtx_init(&mc3, zsl_mtx_entry_fn_identity);
+	rc = zsl_mtx_syrk(false, 0.5, &ma, 2.0, &mc3);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			ref = 0.5 * maat.data[(i * 3) + j] + (i == j ? 2.0 : 0.0);
+			zassert_true(val_is_equal(mc3.data[(i * 3) + j], ref,
+						  1E-6), NULL);
+		}
+	}
+
+	/* mc4 = A^T * A. */
+	rc = zsl_mtx_syrk(true, 1.0, &ma, 0.0, &mc4);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 16; g++) {
+		zassert_true(val_is_equal(mc4.data[g], mata.data[g], 1E-6),
+			     NULL);
+	}
+
+	/* The output must be square and match the chosen product. */
+	rc = zsl_mtx_syrk(true, 1.0, &ma, 0.0, &mc3);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 /**
  * @brief zsl_mtx_scalar_mult_d unit tests.
  *
@@ -892,6 +1418,45 @@ void test_matrix_scalar_mult_d(void)
 	zassert_true(val_is_equal(m.data[7], 40.0, 1E-5), NULL);
 }
 
+void test_matrix_elem_ops_long(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(ma, 7, 9);
+	ZSL_MATRIX_DEF(mb, 7, 9);
+	ZSL_MATRIX_DEF(mc, 7, 9);
+
+	for (size_t i = 0; i < 63; i++) {
+		ma.data[i] = (zsl_real_t)i;
+		mb.data[i] = 0.25 * (zsl_real_t)i - 3.0;
+	}
+
+	rc = zsl_mtx_add(&ma, &mb, &mc);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 63; i++) {
+		zassert_true(val_is_equal(mc.data[i], 1.25 * i - 3.0, 1E-6),
+			     NULL);
+	}
+
+	rc = zsl_mtx_sub(&ma, &mb, &mc);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 63; i++) {
+		zassert_true(val_is_equal(mc.data[i], 0.75 * i + 3.0, 1E-6),
+			     NULL);
+	}
+
+	rc = zsl_mtx_scalar_mult_d(&mc, 2.0);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mtx_add_d(&mc, &mb);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mtx_sub_d(&mc, &ma);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 63; i++) {
+		zassert_true(val_is_equal(mc.data[i], 0.75 * i + 3.0, 1E-6),
+			     NULL);
+	}
+}
+
 void test_matrix_scalar_mult_row_d(void)
 {
 	int rc;
@@ -998,43 +1563,163 @@ void test_matrix_trans(void)
 	zassert_true(val_is_equal(mt.data[7], 4.0, 1E-5), NULL);
 }
 
-void test_matrix_adjoint_3x3(void)
+void test_matrix_trans_view(void)
 {
-	int rc = 0;
-
-	ZSL_MATRIX_DEF(mad, 3, 3);
-
-	/* Input matrix. */
-	zsl_real_t data[9] = {  2.0, -3.0,  1.0,
-			       -4.0,  4.0,  3.0,
-			        3.0,  4.0, -5.0 };
-				
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx mt, vt;
+
+	ZSL_MATRIX_DEF(ref, 3, 2);
+	ZSL_MATRIX_DEF(b, 3, 4);
+	ZSL_MATRIX_DEF(c, 2, 4);
+	ZSL_MATRIX_DEF(c2, 2, 4);
+	ZSL_MATRIX_DEF(ct, 4, 2);
+	ZSL_MATRIX_DEF(s, 3, 2);
+	ZSL_VECTOR_DEF(v, 2);
+	ZSL_VECTOR_DEF(w, 3);
+
+	zsl_real_t data[6] = { 1.0, 2.0, 3.0,
+			       4.0, 5.0, 6.0 };
 	struct zsl_mtx m = {
-		.sz_rows = 3,
+		.sz_rows = 2,
 		.sz_cols = 3,
 		.data = data
 	};
 
-	/* Init matrix 'mad'. */
-	rc = zsl_mtx_init(&mad, NULL);
+	for (size_t i = 0; i < 12; i++) {
+		b.data[i] = ZSL_SIN((zsl_real_t)i);
+	}
+
+	/* The view reads and writes through the buffer of 'm'. */
+	rc = zsl_mtx_trans_view(&m, &mt);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(mt.sz_rows, 3, NULL);
+	zassert_equal(mt.sz_cols, 2, NULL);
+	zassert_true(mt.data == m.data, NULL);
+	zsl_mtx_trans(&m, &ref);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			zsl_mtx_get(&mt, i, j, &x);
+			zassert_true(val_is_equal(x, ref.data[(i * 2) + j],
+						  1E-8), NULL);
+		}
+	}
+
+	rc = zsl_mtx_set(&mt, 2, 0, 10.0);
 	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(data[2], 10.0, 1E-8), NULL);
+	rc = zsl_mtx_set(&mt, 2, 2, 1.0);
+	zassert_equal(rc, -EINVAL, NULL);
+	data[2] = 3.0;
 
-	rc = zsl_mtx_adjoint_3x3(&m, &mad);
+	/* Copying the view gives the same matrix as zsl_mtx_trans. */
+	rc = zsl_mtx_copy(&s, &mt);
 	zassert_equal(rc, 0, NULL);
-	
-	/* Check the output. */
-	zassert_true(val_is_equal(mad.data[0], -32.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[1], -11.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[2], -13.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[3], -11.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[4], -13.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[5], -10.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[6], -28.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[7], -17.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[8], -4.0, 1E-6), NULL);
-}
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(s.data[g], ref.data[g], 1E-8), NULL);
+	}
 
-void test_matrix_adjoint(void)
+	/* Multiplying by the view matches multiplying by the copy. */
+	zsl_mtx_trans_view(&mt, &vt);
+	zassert_false(vt.trans, NULL);
+	zsl_mtx_trans_view(&s, &vt);
+	rc = zsl_mtx_mult(&vt, &b, &c);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&m, &b, &c2);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 8; g++) {
+		zassert_true(val_is_equal(c.data[g], c2.data[g], 1E-6), NULL);
+	}
+
+	/* Transposed output, and transposed operand flags on a view. */
+	zsl_mtx_trans_view(&ct, &vt);
+	rc = zsl_mtx_gemm(true, false, 1.0, &s, &b, 0.0, &vt);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zassert_true(val_is_equal(ct.data[(j * 2) + i],
+						  c2.data[(i * 4) + j], 1E-6),
+				     NULL);
+		}
+	}
+
+	/* Element-wise operations across layouts. */
+	rc = zsl_mtx_add(&mt, &s, &s);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_scalar_mult_d(&mt, 2.0);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			zsl_mtx_get(&mt, i, j, &x);
+			zassert_true(val_is_equal(x, s.data[(i * 2) + j],
+						  1E-6), NULL);
+		}
+	}
+
+	/* Matrix-vector products and rank-1 updates of the view. */
+	v.data[0] = 1.0;
+	v.data[1] = -1.0;
+	rc = zsl_mtx_gemv(false, 1.0, &mt, &v, 0.0, &w);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(w.data[i], s.data[i * 2] -
+					  s.data[(i * 2) + 1], 1E-6), NULL);
+	}
+	rc = zsl_mtx_ger(1.0, &w, &v, &mt);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(data[i], s.data[i * 2] + w.data[i],
+					  1E-6), NULL);
+	}
+
+	/* A block view of the transposed view, and an in-place transpose. */
+	rc = zsl_mtx_view(&mt, &vt, 1, 1, 2, 1);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_get(&vt, 1, 0, &x);
+	zassert_true(val_is_equal(x, data[5], 1E-8), NULL);
+	zsl_mtx_trans_view(&mt, &mt);
+	zassert_false(mt.trans, NULL);
+	zassert_equal(mt.sz_rows, 2, NULL);
+	zassert_true(ZSL_MTX_IS_CONTIG(&mt), NULL);
+}
+
+void test_matrix_adjoint_3x3(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(mad, 3, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[9] = {  2.0, -3.0,  1.0,
+			       -4.0,  4.0,  3.0,
+			        3.0,  4.0, -5.0 };
+				
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Init matrix 'mad'. */
+	rc = zsl_mtx_init(&mad, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_adjoint_3x3(&m, &mad);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Check the output. */
+	zassert_true(val_is_equal(mad.data[0], -32.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[1], -11.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[2], -13.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[3], -11.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[4], -13.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[5], -10.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[6], -28.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[7], -17.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[8], -4.0, 1E-6), NULL);
+}
+
+void test_matrix_adjoint(void)
 {
 	int rc = 0;
 
@@ -1317,7 +2002,50 @@ void test_matrix_deter(void)
 	zassert_equal(rc, 0, NULL);
 	
 	/* Check the output. */
-	zassert_equal(x, -509.0, NULL);
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(val_is_equal(x, -509.0, 1E-2), NULL);
+#else
+	zassert_true(val_is_equal(x, -509.0, 1E-6), NULL);
+#endif
+}
+
+void test_matrix_deter_ws(void)
+{
+	int rc = 0;
+	zsl_real_t x = 0.0;
+
+	/* Input matrix. */
+	zsl_real_t data[25] = {  2.0, -3.0,  1.0,  5.0,  7.0,
+				-4.0,  4.0,  3.0, -3.0, -4.0,
+				 5.0,  3.0,  0.0, -2.0, -1.0,
+				-2.0,  6.0,  1.0,  0.0,  8.0,
+				 3.0,  4.0, -5.0, -8.0, -9.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 5,
+		.data = data
+	};
+
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_deter_ws_size(5));
+
+	/* A workspace one byte short should be rejected. */
+	ws.sz = zsl_mtx_deter_ws_size(5) - 1;
+	rc = zsl_mtx_deter_ws(&m, &x, &ws);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* The exact size is enough, and is all released afterwards. */
+	ws.sz = zsl_mtx_deter_ws_size(5);
+	rc = zsl_mtx_deter_ws(&m, &x, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* Check the output. */
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(val_is_equal(x, -509.0, 1E-2), NULL);
+#else
+	zassert_true(val_is_equal(x, -509.0, 1E-6), NULL);
+#endif
 }
 
 void test_matrix_gauss_elim(void)
@@ -1771,166 +2499,777 @@ void test_matrix_inv(void)
 	zassert_true(zsl_mtx_is_equal(&mi, &mtst), NULL);
 }
 
-void test_matrix_balance(void)
+void test_matrix_lu(void)
 {
-	int rc;
-
-	ZSL_MATRIX_DEF(moa, 4, 4);
-	ZSL_MATRIX_DEF(mob, 4, 4);
+	int rc = 0;
+	size_t piv[3];
 
-	/* Input non-symmetric matrix. */
-	zsl_real_t data[16] = { 5.1, -3.2, 4.9, -8.1,
-				2.3, -4.1, -2.8, 0.2,
-				0.0, -7.7, 2.1, 0.0,
-				-0.7, 8.1, -5.5, 3.7 };
+	ZSL_MATRIX_DEF(lu, 3, 3);
 
-	struct zsl_mtx ma = {
-		.sz_rows = 4,
-		.sz_cols = 4,
+	/* Input matrix. */
+	zsl_real_t data[9] = {  2.0,  1.0,  1.0,
+				4.0, -6.0,  0.0,
+			       -2.0,  7.0,  2.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
 		.data = data
 	};
 
-	/* Input symmetric matrix. */
-	zsl_real_t datb[16] = { 5.1, 2.3, 0.0, -8.1,
-				2.3, -4.1, -2.8, 0.2,
-				0.0, -2.8, 2.1, -5.5,
-				-8.1, 0.2, -5.5, 3.7 };
+	/* Expected packed L and U factors. */
+	zsl_real_t dtst[9] = {  4.0, -6.0,  0.0,
+				0.5,  4.0,  1.0,
+			       -0.5,  1.0,  1.0 };
 
-	struct zsl_mtx mb = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = datb
-	};
+	rc = zsl_mtx_lu(&m, &lu, piv);
+	zassert_equal(rc, 0, NULL);
 
-	/* Expected output. */
-	zsl_real_t dt[16] = { 5.1, -1.6, 2.45, -8.1,
-			      4.6, -4.1, -2.8, 0.4,
-			      0.0, -7.7, 2.1, 0.0,
-			      -0.7, 4.05, -2.75, 3.7 };
+	/* Check the output. */
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(lu.data[g], dtst[g], 1E-6), NULL);
+	}
+	zassert_equal(piv[0], 1, NULL);
+	zassert_equal(piv[1], 1, NULL);
+	zassert_equal(piv[2], 2, NULL);
 
-	struct zsl_mtx mt = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = dt
-	};
+	/* The input matrix should be unmodified. */
+	zassert_true(val_is_equal(m.data[0], 2.0, 1E-6), NULL);
 
-	/* Init output matrices. */
-	rc = zsl_mtx_init(&moa, NULL);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&mob, NULL);
+	/* In-place decomposition. */
+	rc = zsl_mtx_lu(&m, &m, piv);
 	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(m.data[g], dtst[g], 1E-6), NULL);
+	}
 
-	/* Balance the input matrices. */
-	rc = zsl_mtx_balance(&ma, &moa);
+	/* Check for non-square matrix error. */
+	m.sz_cols = 2;
+	rc = zsl_mtx_lu(&m, &lu, piv);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_lu_deter(void)
+{
+	int rc = 0;
+	zsl_real_t x = 0.0;
+	size_t piv[5];
+
+	ZSL_MATRIX_DEF(lu, 5, 5);
+
+	/* Input matrix. */
+	zsl_real_t data[25] = {  2.0, -3.0,  1.0,  5.0,  7.0,
+				-4.0,  4.0,  3.0, -3.0, -4.0,
+				 5.0,  3.0,  0.0, -2.0, -1.0,
+				-2.0,  6.0,  1.0,  0.0,  8.0,
+				 3.0,  4.0, -5.0, -8.0, -9.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 5,
+		.data = data
+	};
+
+	rc = zsl_mtx_lu(&m, &lu, piv);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_balance(&mb, &mob);
+
+	rc = zsl_mtx_lu_deter(&lu, piv, &x);
 	zassert_equal(rc, 0, NULL);
 
 	/* Check the output. */
-	for (size_t g = 0; g < (ma.sz_rows * ma.sz_cols); g++) {
-		zassert_true(val_is_equal(moa.data[g], mt.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(mob.data[g], mb.data[g], 1E-6), NULL);
-	}
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(val_is_equal(x, -509.0, 1E-2), NULL);
+#else
+	zassert_true(val_is_equal(x, -509.0, 1E-6), NULL);
+#endif
 }
 
-void test_matrix_householder_sq(void)
+void test_matrix_lu_solve(void)
 {
-	int rc;
+	int rc = 0;
+	size_t piv[3];
 
-	ZSL_MATRIX_DEF(h, 3, 3);
+	ZSL_MATRIX_DEF(lu, 3, 3);
+	ZSL_MATRIX_DEF(x, 3, 2);
 
 	/* Input matrix. */
-	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
-			       2.0, 4.0, -2.0,
-			       0.0, 4.0, 2.0 };
-
+	zsl_real_t data[9] = {  2.0,  1.0,  1.0,
+				4.0, -6.0,  0.0,
+			       -2.0,  7.0,  2.0 };
 	struct zsl_mtx m = {
 		.sz_rows = 3,
 		.sz_cols = 3,
 		.data = data
 	};
 
-	/* Init matrix h. */
-	rc = zsl_mtx_init(&h, NULL);
-	zassert_equal(rc, 0, NULL);
+	/* Two right-hand side column vectors. */
+	zsl_real_t datb[6] = {  7.0, -1.0,
+			       -8.0, -4.0,
+			       18.0,  4.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = datb
+	};
 
-	/* Compute the Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, false);
-	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t dtst[9] = { 0.0, 1.0, 0.0,
-			       1.0, 0.0, 0.0,
-			       0.0, 0.0, 1.0 };
+	/* Expected solutions. */
+	zsl_real_t dtst[6] = { 1.0, -1.0,
+			       2.0,  0.0,
+			       3.0,  1.0 };
 
-	struct zsl_mtx mt = {
+	/* Singular input matrix. */
+	zsl_real_t dats[9] = { 1.0, 2.0, 3.0,
+			       2.0, 4.0, 6.0,
+			       1.0, 0.0, 1.0 };
+	struct zsl_mtx ms = {
 		.sz_rows = 3,
 		.sz_cols = 3,
-		.data = dtst
+		.data = dats
 	};
 
-	/* Check the output. */
-	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
-		zassert_true(val_is_equal(h.data[g], mt.data[g], 1E-6), NULL);
-	}
-	
-	/* Compute the Hessenberg-Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, true);
+	rc = zsl_mtx_lu(&m, &lu, piv);
 	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t dtsa[16] = { 1.0, 0.0, 0.0,
-				0.0, 1.0, 0.0,
-				0.0, 0.0, 1.0 };
 
-	struct zsl_mtx mt2 = {
-		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = dtsa
-	};
+	rc = zsl_mtx_lu_solve(&lu, piv, &b, &x);
+	zassert_equal(rc, 0, NULL);
 
 	/* Check the output. */
-	for (size_t g = 0; g < (h.sz_rows * h.sz_cols); g++) {
-		zassert_true(val_is_equal(h.data[g], mt2.data[g], 1E-6), NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(x.data[g], dtst[g], 1E-6), NULL);
 	}
+
+	/* Solve in place, overwriting 'b'. */
+	rc = zsl_mtx_lu_solve(&lu, piv, &b, &b);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(b.data[g], dtst[g], 1E-6), NULL);
+	}
+
+	/* Check for singular matrix error. */
+	rc = zsl_mtx_lu(&ms, &lu, piv);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_lu_solve(&lu, piv, &b, &x);
+	zassert_equal(rc, -ESINGULAR, NULL);
 }
 
-void test_matrix_householder_rect(void)
+void test_matrix_lu_inv(void)
 {
-	int rc;
+	int rc = 0;
+	size_t piv[4];
 
-	ZSL_MATRIX_DEF(h, 4, 4);
+	ZSL_MATRIX_DEF(lu, 4, 4);
+	ZSL_MATRIX_DEF(mi, 4, 4);
+	ZSL_MATRIX_DEF(mp, 4, 4);
 
 	/* Input matrix. */
-	zsl_real_t data[12] = { 1.0, -1.0, 4.0,
-				1.0, 4.0, -2.0,
-				1.0, 4.0, 2.0,
-				1.0, -1.0, 0.0 };
-
+	zsl_real_t data[16] = { 4.0,  3.0,  2.0,  1.0,
+				1.0,  0.0,  5.0, -2.0,
+				0.0, -3.0,  1.0,  2.0,
+				2.0,  1.0,  0.0,  3.0 };
 	struct zsl_mtx m = {
 		.sz_rows = 4,
-		.sz_cols = 3,
+		.sz_cols = 4,
 		.data = data
 	};
 
-	/* Init matrix h. */
-	rc = zsl_mtx_init(&h, NULL);
+	rc = zsl_mtx_lu(&m, &lu, piv);
 	zassert_equal(rc, 0, NULL);
 
-	/* Compute the Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, false);
+	rc = zsl_mtx_lu_inv(&lu, piv, &mi);
 	zassert_equal(rc, 0, NULL);
-	
+
+	/* Multiplying 'm' by its inverse should give an identity matrix. */
+	rc = zsl_mtx_mult(&m, &mi, &mp);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zassert_true(val_is_equal(mp.data[(i * 4) + j],
+						  i == j ? 1.0 : 0.0, 1E-6),
+				     NULL);
+		}
+	}
+}
+
+void test_matrix_cholesky(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(l, 3, 3);
+
+	/* Input symmetric positive-definite matrix. */
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
 	/* Expected output. */
-	zsl_real_t dtst[16] = { 0.5, 0.5, 0.5, 0.5,
-				0.5, 0.5, -0.5, -0.5,
-				0.5, -0.5, 0.5, -0.5,
-				0.5, -0.5, -0.5, 0.5 };
+	zsl_real_t a[9] = {  2.0, 0.0, 0.0,
+			     6.0, 1.0, 0.0,
+			    -8.0, 5.0, 3.0 };
 
-	struct zsl_mtx mt = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = dtst
+	/* Non positive-definite matrix. */
+	zsl_real_t data2[4] = { 1.0, 2.0,
+				2.0, 1.0 };
+	struct zsl_mtx m2 = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = data2
+	};
+
+	rc = zsl_mtx_cholesky(&m, &l);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(l.data[g], a[g], 1E-6), NULL);
+	}
+
+	/* In place. */
+	rc = zsl_mtx_cholesky(&m, &m);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(m.data[g], a[g], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_cholesky(&m2, &m2);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+}
+
+void test_matrix_ldl(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(ld, 3, 3);
+	ZSL_MATRIX_DEF(x, 3, 2);
+
+	/* Input symmetric positive-definite matrix. */
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Expected L below the diagonal, and D on it. */
+	zsl_real_t a[9] = {  4.0, 0.0, 0.0,
+			     3.0, 1.0, 0.0,
+			    -4.0, 5.0, 9.0 };
+
+	/* Right-hand sides for the solutions x0 = { 1, -1, 2 } and
+	 * x1 = { 2, 0, 1 }. */
+	zsl_real_t datb[6] = {  -40.0,  -8.0,
+			       -111.0, -19.0,
+				223.0,  66.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = datb
+	};
+	zsl_real_t sol[6] = { 1.0, 2.0, -1.0, 0.0, 2.0, 1.0 };
+
+	rc = zsl_mtx_ldl(&m, &ld);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(ld.data[g], a[g], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_ldl_solve(&ld, &b, &x);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(x.data[g], sol[g], 1E-4), NULL);
+	}
+}
+
+void test_matrix_solve_tri(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(x, 3, 1);
+
+	/* Only the relevant triangle of 't' should be used. */
+	zsl_real_t data[9] = { 2.0, 1.0, -1.0,
+			       6.0, 1.0,  4.0,
+			      -8.0, 5.0,  3.0 };
+	struct zsl_mtx t = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	zsl_real_t datb[3] = { 2.0, 5.0, 3.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 3,
+		.sz_cols = 1,
+		.data = datb
+	};
+
+	/* Lower: 2x = 2, 6x + y = 5, -8x + 5y + 3z = 3. */
+	rc = zsl_mtx_solve_lower(&t, &b, &x, false);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[1], -1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[2], 16.0 / 3.0, 1E-6), NULL);
+
+	/* Unit lower: x = 2, 6x + y = 5, -8x + 5y + z = 3. */
+	rc = zsl_mtx_solve_lower(&t, &b, &x, true);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[1], -7.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[2], 54.0, 1E-6), NULL);
+
+	/* Upper: 2x + y - z = 2, y + 4z = 5, 3z = 3. */
+	rc = zsl_mtx_solve_upper(&t, &b, &x, false);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[1], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[2], 1.0, 1E-6), NULL);
+
+	/* In place, with a zero on the diagonal. */
+	data[4] = 0.0;
+	rc = zsl_mtx_solve_upper(&t, &b, &b, false);
+	zassert_equal(rc, -ESINGULAR, NULL);
+	zassert_true(val_is_equal(datb[1], 5.0, 1E-6), NULL);
+}
+
+void test_matrix_cho_solve(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(l, 3, 3);
+	ZSL_MATRIX_DEF(x, 3, 2);
+
+	/* Input symmetric positive-definite matrix. */
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Right-hand sides for the solutions x0 = { 1, -1, 2 } and
+	 * x1 = { 2, 0, 1 }. */
+	zsl_real_t datb[6] = {  -40.0,  -8.0,
+			       -111.0, -19.0,
+				223.0,  66.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = datb
+	};
+	zsl_real_t sol[6] = { 1.0, 2.0, -1.0, 0.0, 2.0, 1.0 };
+
+	rc = zsl_mtx_cholesky(&m, &l);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_cho_solve(&l, &b, &x);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(x.data[g], sol[g], 1E-4), NULL);
+	}
+
+	/* In place. */
+	rc = zsl_mtx_cho_solve(&l, &b, &b);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(b.data[g], sol[g], 1E-4), NULL);
+	}
+}
+
+void test_matrix_cho_update(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(l, 3, 3);
+	ZSL_MATRIX_DEF(l2, 3, 3);
+	ZSL_VECTOR_DEF(v, 3);
+
+	/* Input symmetric positive-definite matrix. */
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* 'm' + v * v^T, with v = { 1, 2, 3 }. */
+	zsl_real_t data2[9] = {   5.0,  14.0, -13.0,
+				 14.0,  41.0, -37.0,
+				-13.0, -37.0, 107.0 };
+	struct zsl_mtx m2 = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data2
+	};
+
+	zsl_real_t a[9] = {  2.0, 0.0, 0.0,
+			     6.0, 1.0, 0.0,
+			    -8.0, 5.0, 3.0 };
+
+	rc = zsl_mtx_cholesky(&m, &l);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_cholesky(&m2, &l2);
+	zassert_equal(rc, 0, NULL);
+
+	/* Updating the factor of 'm' should give the factor of 'm2'. */
+	v.data[0] = 1.0;
+	v.data[1] = 2.0;
+	v.data[2] = 3.0;
+	rc = zsl_mtx_cho_update(&l, &v);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(l.data[g], l2.data[g], 1E-5), NULL);
+	}
+
+	/* And downdating it again should give back the factor of 'm'. */
+	v.data[0] = 1.0;
+	v.data[1] = 2.0;
+	v.data[2] = 3.0;
+	rc = zsl_mtx_cho_downdate(&l, &v);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(l.data[g], a[g], 1E-5), NULL);
+	}
+
+	/* Removing too much leaves a matrix that isn't positive definite. */
+	v.data[0] = 3.0;
+	v.data[1] = 0.0;
+	v.data[2] = 0.0;
+	rc = zsl_mtx_cho_downdate(&l, &v);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+
+	/* A factor with a zero on its diagonal can't be updated either. */
+	zsl_mtx_from_arr(&l, a);
+	l.data[4] = 0.0;
+	v.data[0] = 1.0;
+	v.data[1] = 2.0;
+	v.data[2] = 3.0;
+	rc = zsl_mtx_cho_update(&l, &v);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+}
+
+void test_matrix_band_lu(void)
+{
+	int rc;
+	size_t piv[5];
+	zsl_real_t x;
+
+	ZSL_MTX_BAND_DEF(bm, 5, 1, 2);
+	ZSL_MATRIX_DEF(lu, 5, 5);
+	ZSL_VECTOR_DEF(b, 5);
+	ZSL_VECTOR_DEF(w, 5);
+	ZSL_VECTOR_DEF(xb, 5);
+	ZSL_MATRIX_DEF(xd, 5, 1);
+	size_t dpiv[5];
+
+	/* Non-symmetric banded matrix with kl = 1, ku = 2, with a small
+	 * first diagonal value to force pivoting. */
+	zsl_real_t data[25] = { 0.1,  2.0, -1.0,  0.0,  0.0,
+				3.0,  1.0,  4.0,  2.0,  0.0,
+				0.0, -2.0,  5.0,  1.0,  3.0,
+				0.0,  0.0,  1.0, -3.0,  2.0,
+				0.0,  0.0,  0.0,  4.0,  6.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 5,
+		.data = data
+	};
+
+	zsl_real_t bdata[5] = { 1.0, -2.0, 3.0, 0.5, 4.0 };
+	struct zsl_mtx bd = {
+		.sz_rows = 5,
+		.sz_cols = 1,
+		.data = bdata
+	};
+
+	rc = zsl_mtx_band_init(&bm);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_band_from_mtx(&m, &bm);
+	zassert_equal(rc, 0, NULL);
+
+	/* Values outside the band read as zero, and can't be set. */
+	rc = zsl_mtx_band_get(&bm, 4, 0, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 0.0, 1E-8), NULL);
+	rc = zsl_mtx_band_get(&bm, 1, 3, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 2.0, 1E-8), NULL);
+	rc = zsl_mtx_band_set(&bm, 0, 3, 1.0);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_band_set(&bm, 2, 0, 1.0);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* The banded product matches the dense one. */
+	zsl_vec_from_arr(&b, bdata);
+	rc = zsl_mtx_band_mult_vec(&bm, &b, &w);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		x = 0.0;
+		for (size_t j = 0; j < 5; j++) {
+			x += data[i * 5 + j] * bdata[j];
+		}
+		zassert_true(val_is_equal(w.data[i], x, 1E-6), NULL);
+	}
+
+	/* Solve with the banded and the dense LU decompositions. */
+	rc = zsl_mtx_band_lu(&bm, piv);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_band_lu_solve(&bm, piv, &b, &xb);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_lu(&m, &lu, dpiv);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_lu_solve(&lu, dpiv, &bd, &xd);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(xb.data[i], xd.data[i], 1E-5), NULL);
+	}
+
+	/* The solution may overwrite the right-hand side. */
+	rc = zsl_mtx_band_lu_solve(&bm, piv, &b, &b);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(b.data[i], xd.data[i], 1E-5), NULL);
+	}
+
+	/* A singular banded matrix is reported by the solve. */
+	zsl_mtx_band_init(&bm);
+	for (size_t i = 0; i < 5; i++) {
+		zsl_mtx_band_set(&bm, i, i, (i == 3) ? 0.0 : 1.0);
+	}
+	rc = zsl_mtx_band_lu(&bm, piv);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_band_lu_solve(&bm, piv, &w, &xb);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* Size mismatch. */
+	rc = zsl_mtx_band_from_mtx(&lu, &bm);
+	zassert_equal(rc, 0, NULL);
+	lu.sz_rows = 4;
+	rc = zsl_mtx_band_from_mtx(&lu, &bm);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_tridiag_solve(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(a, 4);
+	ZSL_VECTOR_DEF(b, 5);
+	ZSL_VECTOR_DEF(c, 4);
+	ZSL_VECTOR_DEF(d, 5);
+	ZSL_VECTOR_DEF(x, 5);
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_tridiag_solve_ws_size(5));
+	ZSL_WORKSPACE_DEF(ws2, sizeof(zsl_real_t));
+
+	zsl_real_t adata[4] = { 1.0, -1.0, 2.0, 1.0 };
+	zsl_real_t bdata[5] = { 4.0, 5.0, 4.0, 6.0, 3.0 };
+	zsl_real_t cdata[4] = { 2.0, 1.0, -1.0, 1.0 };
+	/* The solution x = { 1, 2, 3, 4, 5 }. */
+	zsl_real_t xref[5] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+	zsl_real_t ddata[5] = { 8.0, 14.0, 6.0, 35.0, 19.0 };
+
+	zsl_vec_from_arr(&a, adata);
+	zsl_vec_from_arr(&b, bdata);
+	zsl_vec_from_arr(&c, cdata);
+	zsl_vec_from_arr(&d, ddata);
+
+	rc = zsl_mtx_tridiag_solve(&a, &b, &c, &d, &x);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(x.data[i], xref[i], 1E-5), NULL);
+	}
+
+	/* Solve in place from a workspace. */
+	rc = zsl_mtx_tridiag_solve_ws(&a, &b, &c, &d, &d, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(d.data[i], xref[i], 1E-5), NULL);
+	}
+
+	/* Workspace too small. */
+	zsl_vec_from_arr(&d, ddata);
+	rc = zsl_mtx_tridiag_solve_ws(&a, &b, &c, &d, &x, &ws2);
+	zassert_equal(rc, -ENOMEM, NULL);
+
+	/* Zero pivot. */
+	b.data[0] = 0.0;
+	rc = zsl_mtx_tridiag_solve(&a, &b, &c, &d, &x);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* Size mismatch. */
+	a.sz = 5;
+	rc = zsl_mtx_tridiag_solve(&a, &b, &c, &d, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_balance(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(moa, 4, 4);
+	ZSL_MATRIX_DEF(mob, 4, 4);
+
+	/* Input non-symmetric matrix. */
+	zsl_real_t data[16] = { 5.1, -3.2, 4.9, -8.1,
+				2.3, -4.1, -2.8, 0.2,
+				0.0, -7.7, 2.1, 0.0,
+				-0.7, 8.1, -5.5, 3.7 };
+
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input symmetric matrix. */
+	zsl_real_t datb[16] = { 5.1, 2.3, 0.0, -8.1,
+				2.3, -4.1, -2.8, 0.2,
+				0.0, -2.8, 2.1, -5.5,
+				-8.1, 0.2, -5.5, 3.7 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datb
+	};
+
+	/* Expected output. */
+	zsl_real_t dt[16] = { 5.1, -1.6, 2.45, -8.1,
+			      4.6, -4.1, -2.8, 0.4,
+			      0.0, -7.7, 2.1, 0.0,
+			      -0.7, 4.05, -2.75, 3.7 };
+
+	struct zsl_mtx mt = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = dt
+	};
+
+	/* Init output matrices. */
+	rc = zsl_mtx_init(&moa, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&mob, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Balance the input matrices. */
+	rc = zsl_mtx_balance(&ma, &moa);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_balance(&mb, &mob);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. */
+	for (size_t g = 0; g < (ma.sz_rows * ma.sz_cols); g++) {
+		zassert_true(val_is_equal(moa.data[g], mt.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(mob.data[g], mb.data[g], 1E-6), NULL);
+	}
+}
+
+void test_matrix_householder_sq(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(h, 3, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
+			       2.0, 4.0, -2.0,
+			       0.0, 4.0, 2.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Init matrix h. */
+	rc = zsl_mtx_init(&h, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Compute the Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, false);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtst[9] = { 0.0, 1.0, 0.0,
+			       1.0, 0.0, 0.0,
+			       0.0, 0.0, 1.0 };
+
+	struct zsl_mtx mt = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = dtst
+	};
+
+	/* Check the output. */
+	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
+		zassert_true(val_is_equal(h.data[g], mt.data[g], 1E-6), NULL);
+	}
+	
+	/* Compute the Hessenberg-Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, true);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtsa[16] = { 1.0, 0.0, 0.0,
+				0.0, 1.0, 0.0,
+				0.0, 0.0, 1.0 };
+
+	struct zsl_mtx mt2 = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = dtsa
+	};
+
+	/* Check the output. */
+	for (size_t g = 0; g < (h.sz_rows * h.sz_cols); g++) {
+		zassert_true(val_is_equal(h.data[g], mt2.data[g], 1E-6), NULL);
+	}
+}
+
+void test_matrix_householder_rect(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(h, 4, 4);
+
+	/* Input matrix. */
+	zsl_real_t data[12] = { 1.0, -1.0, 4.0,
+				1.0, 4.0, -2.0,
+				1.0, 4.0, 2.0,
+				1.0, -1.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Init matrix h. */
+	rc = zsl_mtx_init(&h, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Compute the Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, false);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtst[16] = { 0.5, 0.5, 0.5, 0.5,
+				0.5, 0.5, -0.5, -0.5,
+				0.5, -0.5, 0.5, -0.5,
+				0.5, -0.5, -0.5, 0.5 };
+
+	struct zsl_mtx mt = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = dtst
 	};
 
 	/* Check the output. */
@@ -2051,24 +3390,533 @@ void test_matrix_qrd_hess(void)
 		0.0000000000, -6.9114902923, 4.1365576515, 0.8655838518,
 		-0.0000000000, 0.0000000000, 0.3789195885, 2.5476528748 };
 
-	struct zsl_mtx hess = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = hdata
-	};
+	struct zsl_mtx hess = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = hdata
+	};
+
+	
+	/* Check the output. */
+	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+ 	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-4), NULL);
+#else
+	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-8), NULL);
+#endif
+	}
+}
+
+void test_matrix_qrd_compact(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(qr, 3, 3);
+	ZSL_MATRIX_DEF(q, 3, 3);
+	ZSL_VECTOR_DEF(tau, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
+			       2.0, 4.0, -2.0,
+			       0.0, 4.0, 2.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* The expected results for Q and R matrices for test purposes. */
+	zsl_real_t qdata[9] = { 0.0, 0.0, 1.0,
+				1.0, 0.0, 0.0,
+				0.0, 1.0, 0.0 };
+
+	zsl_real_t rdata[9] = { 2.0, 4.0, -2.0,
+				0.0, 4.0, 2.0,
+				0.0, 0.0, 4.0 };
+
+	/* Calculate the compact QR decomposition. */
+	rc = zsl_mtx_qrd_compact(&m, &qr, &tau);
+	zassert_equal(rc, 0, NULL);
+
+	/* The upper triangle should contain R. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = i; j < 3; j++) {
+			zassert_true(val_is_equal(qr.data[i * 3 + j],
+						  rdata[i * 3 + j], 1E-6), NULL);
+		}
+	}
+
+	/* Applying Q to the identity matrix should give Q. */
+	zsl_mtx_init(&q, zsl_mtx_entry_fn_identity);
+	rc = zsl_mtx_qrd_apply_q(&qr, &tau, &q);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(q.data[g], qdata[g], 1E-6), NULL);
+	}
+
+	/* In place decomposition. */
+	rc = zsl_mtx_qrd_compact(&m, &m, &tau);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &qr), NULL);
+
+	/* Wrong tau size. */
+	ZSL_VECTOR_DEF(tau2, 2);
+	rc = zsl_mtx_qrd_compact(&m, &qr, &tau2);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_qrd_apply_q(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(qr, 4, 3);
+	ZSL_MATRIX_DEF(b, 4, 3);
+	ZSL_VECTOR_DEF(tau, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0,
+				0.0, 3.0, 4.0,
+				4.0, 4.0, -3.0,
+				5.0, 3.0, -5.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	rc = zsl_mtx_qrd_compact(&m, &qr, &tau);
+	zassert_equal(rc, 0, NULL);
+
+	/* Q * R should give back the input matrix. */
+	zsl_mtx_init(&b, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = i; j < 3; j++) {
+			b.data[i * 3 + j] = qr.data[i * 3 + j];
+		}
+	}
+
+	rc = zsl_mtx_qrd_apply_q(&qr, &tau, &b);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 12; g++) {
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+		zassert_true(val_is_equal(b.data[g], data[g], 1E-4), NULL);
+#else
+		zassert_true(val_is_equal(b.data[g], data[g], 1E-8), NULL);
+#endif
+	}
+
+	/* Shape mismatch. */
+	ZSL_MATRIX_DEF(b2, 3, 3);
+	rc = zsl_mtx_qrd_apply_q(&qr, &tau, &b2);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_qrd_apply_qt(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(qr, 4, 3);
+	ZSL_MATRIX_DEF(b, 4, 3);
+	ZSL_VECTOR_DEF(tau, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0,
+				0.0, 3.0, 4.0,
+				4.0, 4.0, -3.0,
+				5.0, 3.0, -5.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	rc = zsl_mtx_qrd_compact(&m, &qr, &tau);
+	zassert_equal(rc, 0, NULL);
+
+	/* Q^T * m should give R, with zeros below the diagonal. */
+	rc = zsl_mtx_copy(&b, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qrd_apply_qt(&qr, &tau, &b);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zsl_real_t x = j < i ? 0.0 : qr.data[i * 3 + j];
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(b.data[i * 3 + j], x, 1E-4),
+				     NULL);
+#else
+			zassert_true(val_is_equal(b.data[i * 3 + j], x, 1E-8),
+				     NULL);
+#endif
+		}
+	}
+
+	/* The diagonal of R takes the sign of the leading entries. */
+	zassert_true(val_is_equal(qr.data[0], ZSL_SQRT(42.0), 1E-6), NULL);
+}
+
+void test_matrix_lstsq(void)
+{
+	int rc;
+	zsl_real_t t, e, r2;
+	struct zsl_mtx av, bv;
+
+	ZSL_MATRIX_DEF(a, 20, 3);
+	ZSL_MATRIX_DEF(b, 20, 2);
+	ZSL_MATRIX_DEF(x, 3, 2);
+	ZSL_MATRIX_DEF(x2, 3, 2);
+	ZSL_MATRIX_DEF(ax, 20, 2);
+	ZSL_MATRIX_DEF(grad, 3, 2);
+	ZSL_VECTOR_DEF(res, 2);
+	ZSL_VECTOR_DEF(res2, 2);
+	ZSL_MTX_LSTSQ_DEF(ls, 3, 2);
+
+	/* Fit y = 1.5 - 2 * t + 0.25 * t^2, exactly in the first column and
+	 * with a perturbation in the second. */
+	for (size_t i = 0; i < 20; i++) {
+		t = (zsl_real_t)i / 4.0;
+		e = 0.1 * ZSL_SIN((zsl_real_t)(3 * i));
+		a.data[(i * 3) + 0] = 1.0;
+		a.data[(i * 3) + 1] = t;
+		a.data[(i * 3) + 2] = t * t;
+		b.data[(i * 2) + 0] = 1.5 - (2.0 * t) + (0.25 * t * t);
+		b.data[(i * 2) + 1] = b.data[(i * 2) + 0] + e;
+	}
+
+	rc = zsl_mtx_lstsq(&a, &b, &x, &res);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 1.5, 1E-4), NULL);
+	zassert_true(val_is_equal(x.data[2], -2.0, 1E-4), NULL);
+	zassert_true(val_is_equal(x.data[4], 0.25, 1E-4), NULL);
+	zassert_true(val_is_equal(res.data[0], 0.0, 1E-4), NULL);
+
+	/* The residual of the second column is orthogonal to the columns of
+	 * 'a', and matches the reported norm. */
+	zsl_mtx_mult(&a, &x, &ax);
+	zsl_mtx_sub_d(&ax, &b);
+	zsl_mtx_mult_trans_a(&a, &ax, &grad);
+	r2 = 0.0;
+	for (size_t i = 0; i < 20; i++) {
+		r2 += ax.data[(i * 2) + 1] * ax.data[(i * 2) + 1];
+	}
+	zassert_true(val_is_equal(res.data[1], ZSL_SQRT(r2), 1E-4), NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(grad.data[(i * 2) + 1], 0.0, 1E-3),
+			     NULL);
+	}
+
+	/* Streaming the rows in chunks gives the same fit. */
+	rc = zsl_mtx_lstsq_init(&ls);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 20; i += 7) {
+		size_t k = (20 - i) < 7 ? 20 - i : 7;
+
+		zsl_mtx_view(&a, &av, i, 0, k, 3);
+		zsl_mtx_view(&b, &bv, i, 0, k, 2);
+		rc = zsl_mtx_lstsq_add(&ls, &av, &bv);
+		zassert_equal(rc, 0, NULL);
+	}
+	zassert_equal(ls.rows, 20, NULL);
+	rc = zsl_mtx_lstsq_solve(&ls, &x2, &res2);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 6; g++) {
+		zassert_true(val_is_equal(x.data[g], x2.data[g], 1E-4), NULL);
+	}
+	zassert_true(val_is_equal(res.data[1], res2.data[1], 1E-4), NULL);
+
+	/* Too few rows, or dependent columns, can't be solved. */
+	zsl_mtx_lstsq_init(&ls);
+	zsl_mtx_view(&a, &av, 0, 0, 2, 3);
+	zsl_mtx_view(&b, &bv, 0, 0, 2, 2);
+	zsl_mtx_lstsq_add(&ls, &av, &bv);
+	rc = zsl_mtx_lstsq_solve(&ls, &x2, NULL);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	for (size_t i = 0; i < 20; i++) {
+		a.data[(i * 3) + 2] = 2.0 * a.data[(i * 3) + 1];
+	}
+	rc = zsl_mtx_lstsq(&a, &b, &x, NULL);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* Size mismatch. */
+	b.sz_rows = 19;
+	rc = zsl_mtx_lstsq(&a, &b, &x, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_qrd_update(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx qv, rv, rrv;
+	struct zsl_mtx q0 = { .sz_rows = 0, .sz_cols = 0 };
+	struct zsl_mtx r0 = { .sz_rows = 0, .sz_cols = 3 };
+	struct zsl_vec u0 = { .sz = 0 };
+
+	ZSL_MATRIX_DEF(a, 5, 3);
+	ZSL_MATRIX_DEF(q, 5, 5);
+	ZSL_MATRIX_DEF(r, 5, 3);
+	ZSL_MATRIX_DEF(qp, 5, 7);
+	ZSL_MATRIX_DEF(rp, 3, 5);
+	ZSL_MATRIX_DEF(qr, 5, 3);
+	ZSL_MATRIX_DEF(qtq, 5, 5);
+	ZSL_MATRIX_DEF(rr, 3, 3);
+	ZSL_MATRIX_DEF(rrt, 3, 3);
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_qrd_update_ws_size(5));
+	ZSL_WORKSPACE_DEF(ws_small, 0);
+	ZSL_MATRIX_DEF(ata, 3, 3);
+	ZSL_MATRIX_DEF(rtr, 3, 3);
+	ZSL_VECTOR_DEF(u, 5);
+	ZSL_VECTOR_DEF(v, 3);
+	ZSL_VECTOR_DEF(row, 3);
+	ZSL_MTX_LSTSQ_DEF(ls, 3, 1);
+
+	for (size_t i = 0; i < 15; i++) {
+		a.data[i] = ZSL_COS(1.3 * (zsl_real_t)i) + ((i % 4) == 0);
+	}
+	for (size_t i = 0; i < 5; i++) {
+		u.data[i] = 0.5 - (0.2 * (zsl_real_t)i);
+	}
+	v.data[0] = 1.0;
+	v.data[1] = -2.0;
+	v.data[2] = 0.5;
+
+	/* Rank-1 update of the full decomposition. A copy is kept in a
+	 * column view of 'qp' and a transposed view of 'rp'. */
+	rc = zsl_mtx_qrd(&a, &q, &r, false);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_view(&qp, &qv, 0, 1, 5, 5);
+	zsl_mtx_trans_view(&rp, &rv);
+	zsl_mtx_copy(&qv, &q);
+	zsl_mtx_copy(&rv, &r);
+	rc = zsl_mtx_qrd_update(&q, &r, &u, &v);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&q, &r, &qr);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			x = a.data[(i * 3) + j] + (u.data[i] * v.data[j]);
+			zassert_true(val_is_equal(qr.data[(i * 3) + j], x, 1E-5),
+				     NULL);
+			if (i > j) {
+				zassert_true(val_is_equal(r.data[(i * 3) + j],
+							  0.0, 1E-8), NULL);
+			}
+		}
+	}
+	zsl_mtx_mult_trans_a(&q, &q, &qtq);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 5; j++) {
+			zassert_true(val_is_equal(qtq.data[(i * 5) + j],
+						  (i == j) ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+	}
+
+	/* The workspace variant gives the same result on strided views. */
+	rc = zsl_mtx_qrd_update_ws(&qv, &rv, &u, &v, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 5; j++) {
+			zsl_mtx_get(&qv, i, j, &x);
+			zassert_true(val_is_equal(x, q.data[(i * 5) + j], 1E-6),
+				     NULL);
+		}
+		for (size_t j = 0; j < 3; j++) {
+			zsl_mtx_get(&rv, i, j, &x);
+			zassert_true(val_is_equal(x, r.data[(i * 3) + j], 1E-6),
+				     NULL);
+		}
+	}
+
+	/* Too small a workspace, and an empty decomposition. */
+	rc = zsl_mtx_qrd_update_ws(&q, &r, &u, &v, &ws_small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	rc = zsl_mtx_qrd_update(&q0, &r0, &u0, &v);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Appending the rows of 'a' one at a time gives R^T * R = A^T * A,
+	 * and the same R when it is stored transposed. */
+	zsl_mtx_init(&rr, NULL);
+	zsl_mtx_init(&rrt, NULL);
+	zsl_mtx_trans_view(&rrt, &rrv);
+	for (size_t i = 0; i < 5; i++) {
+		zsl_mtx_get_row(&a, i, row.data);
+		rc = zsl_mtx_qrd_update_row(&rr, &row);
+		zassert_equal(rc, 0, NULL);
+		zsl_mtx_get_row(&a, i, row.data);
+		rc = zsl_mtx_qrd_update_row(&rrv, &row);
+		zassert_equal(rc, 0, NULL);
+	}
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zsl_mtx_get(&rrv, i, j, &x);
+			zassert_true(val_is_equal(x, rr.data[(i * 3) + j], 1E-6),
+				     NULL);
+		}
+	}
+	zsl_mtx_mult_trans_a(&a, &a, &ata);
+	zsl_mtx_mult_trans_a(&rr, &rr, &rtr);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(rtr.data[g], ata.data[g], 1E-5),
+			     NULL);
+	}
+
+	/* Removing the last row again matches a fit of the first four. */
+	zsl_mtx_get_row(&a, 4, row.data);
+	rc = zsl_mtx_qrd_downdate_row(&rr, &row);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_lstsq_init(&ls);
+	for (size_t i = 0; i < 4; i++) {
+		zsl_real_t zero = 0.0;
+		struct zsl_mtx ai;
+		struct zsl_mtx bi = {
+			.sz_rows = 1,
+			.sz_cols = 1,
+			.data = &zero
+		};
+
+		zsl_mtx_view(&a, &ai, i, 0, 1, 3);
+		zsl_mtx_lstsq_add(&ls, &ai, &bi);
+	}
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(rr.data[g], ls.r.data[g], 1E-5),
+			     NULL);
+	}
+
+	/* Removing a row that was never added breaks positive definiteness. */
+	row.data[0] = 10.0;
+	row.data[1] = 0.0;
+	row.data[2] = 0.0;
+	rc = zsl_mtx_qrd_downdate_row(&rr, &row);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+}
+
+void test_matrix_expm(void)
+{
+	int rc;
+	zsl_real_t e1 = ZSL_EXP(3.0);
+	zsl_real_t e2 = ZSL_EXP(6.0);
+
+	ZSL_MATRIX_DEF(m, 2, 2);
+	ZSL_MATRIX_DEF(e, 2, 2);
+	ZSL_MATRIX_DEF(m3, 3, 3);
+	ZSL_MATRIX_DEF(e3, 3, 3);
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_expm_ws_size(3));
+
+	/* exp([ 3 3 ; 0 6 ]) = [ e^3  e^6 - e^3 ; 0  e^6 ], which needs
+	 * several squarings. */
+	zsl_real_t a[4] = { 3.0, 3.0,
+			    0.0, 6.0 };
+	zsl_real_t ar[4] = { e1, e2 - e1,
+			     0.0, e2 };
+
+	/* Rotation generator, exp(t * [ 0 1 ; -1 0 ]). */
+	zsl_real_t r[4] = { 0.0, 1.2,
+			    -1.2, 0.0 };
+
+	/* Nilpotent matrix, for which the series is exact. */
+	zsl_real_t n[9] = { 0.0, 1.0, 2.0,
+			    0.0, 0.0, 3.0,
+			    0.0, 0.0, 0.0 };
+	zsl_real_t nr[9] = { 1.0, 1.0, 3.5,
+			     0.0, 1.0, 3.0,
+			     0.0, 0.0, 1.0 };
+
+	zsl_mtx_from_arr(&m, a);
+	rc = zsl_mtx_expm(&m, &e);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 4; g++) {
+		zassert_true(val_is_equal(e.data[g], ar[g],
+					  1E-5 * (1.0 + ZSL_ABS(ar[g]))), NULL);
+	}
+
+	/* In place. */
+	zsl_mtx_from_arr(&m, r);
+	rc = zsl_mtx_expm(&m, &m);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(m.data[0], ZSL_COS(1.2), 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[1], ZSL_SIN(1.2), 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[2], -ZSL_SIN(1.2), 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[3], ZSL_COS(1.2), 1E-6), NULL);
+
+	zsl_mtx_from_arr(&m3, n);
+	rc = zsl_mtx_expm_ws(&m3, &e3, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(e3.data[g], nr[g], 1E-6), NULL);
+	}
+
+	/* The exponential of zero is the identity. */
+	zsl_mtx_init(&m3, NULL);
+	rc = zsl_mtx_expm(&m3, &e3);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(e3.data[g], (g % 4) ? 0.0 : 1.0,
+					  1E-8), NULL);
+	}
+
+	/* Shape mismatch. */
+	rc = zsl_mtx_expm(&m3, &e);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_van_loan(void)
+{
+	int rc;
+	zsl_real_t dt = 0.1;
+	zsl_real_t qc = 2.0;
+
+	ZSL_MATRIX_DEF(a, 2, 2);
+	ZSL_MATRIX_DEF(q, 2, 2);
+	ZSL_MATRIX_DEF(ad, 2, 2);
+	ZSL_MATRIX_DEF(qd, 2, 2);
+	ZSL_MATRIX_DEF(a1, 1, 1);
+	ZSL_MATRIX_DEF(q1, 1, 1);
+	ZSL_MATRIX_DEF(ad1, 1, 1);
+	ZSL_MATRIX_DEF(qd1, 1, 1);
+
+	/* Constant velocity model, with white noise acceleration. */
+	zsl_mtx_init(&a, NULL);
+	zsl_mtx_init(&q, NULL);
+	a.data[1] = 1.0;
+	q.data[3] = qc;
+
+	rc = zsl_mtx_van_loan(&a, &q, dt, &ad, &qd);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ad.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ad.data[1], dt, 1E-6), NULL);
+	zassert_true(val_is_equal(ad.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ad.data[3], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(qd.data[0], qc * dt * dt * dt / 3.0, 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(qd.data[1], qc * dt * dt / 2.0, 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(qd.data[2], qc * dt * dt / 2.0, 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(qd.data[3], qc * dt, 1E-6), NULL);
+
+	/* First order decay, dx/dt = -3 * x + w. */
+	a1.data[0] = -3.0;
+	q1.data[0] = qc;
+	rc = zsl_mtx_van_loan(&a1, &q1, dt, &ad1, &qd1);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ad1.data[0], ZSL_EXP(-3.0 * dt), 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(qd1.data[0], qc *
+				  (1.0 - ZSL_EXP(-6.0 * dt)) / 6.0, 1E-6),
+		     NULL);
 
-	
-	/* Check the output. */
-	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
-#ifdef CONFIG_ZSL_SINGLE_PRECISION
- 	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-4), NULL);
-#else
-	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-8), NULL);
-#endif
-	}
+	/* Shape mismatch. */
+	rc = zsl_mtx_van_loan(&a, &q1, dt, &ad, &qd);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 void test_matrix_qrd_iter(void)
 {
 	int rc;
@@ -2099,21 +3947,19 @@ void test_matrix_qrd_iter(void)
 
 	/* Check if the output matrix is upper triangular and if it is similar
 	 * to the input matrix. */
-	zassert_true(val_is_equal(m2.data[4], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[8], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[9], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[12], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[13], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[14], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m2.data[4], 0.0, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(val_is_equal(m2.data[8], 0.0, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(val_is_equal(m2.data[9], 0.0, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(val_is_equal(m2.data[12], 0.0, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(val_is_equal(m2.data[13], 0.0, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(val_is_equal(m2.data[14], 0.0, MTX_ITER_EPS(1E-6)), NULL);
 
 	zsl_mtx_eigenvalues(&m, &v, 500);
 	zsl_mtx_eigenvalues(&m2, &v2, 500);
 
-	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-6), NULL);
+	zassert_true(zsl_vec_is_equal(&v, &v2, MTX_ITER_EPS(1E-6)), NULL);
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 void test_matrix_eigenvalues(void)
 {
 	int rc;
@@ -2196,13 +4042,87 @@ void test_matrix_eigenvalues(void)
 	zassert_equal(rc, 0, NULL);
 
 	/* Check the output. */
-	zassert_true(zsl_vec_is_equal(&va, &va2, 1E-6), NULL);
-	zassert_true(zsl_vec_is_equal(&vb, &vb2, 1E-6), NULL);
-	zassert_true(zsl_vec_is_equal(&vc, &vc2, 1E-6), NULL);
+	zassert_true(zsl_vec_is_equal(&va, &va2, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(zsl_vec_is_equal(&vb, &vb2, MTX_ITER_EPS(1E-6)), NULL);
+	zassert_true(zsl_vec_is_equal(&vc, &vc2, MTX_ITER_EPS(1E-6)), NULL);
+}
+
+void test_matrix_eigenvalues_cplx(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(re, 4);
+	ZSL_VECTOR_DEF(im, 4);
+	ZSL_VECTOR_DEF(re10, 10);
+	ZSL_VECTOR_DEF(im10, 10);
+	ZSL_MATRIX_DEF(mt, 10, 10);
+
+	/* Input complex-eigenvalue matrix. */
+	zsl_real_t datb[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				9.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datb
+	};
+
+	rc = zsl_mtx_eigenvalues_cplx(&mb, &re, &im, 30);
+	zassert_equal(rc, 0, NULL);
+
+	/* A complex conjugate pair first, then the two real eigenvalues. */
+	zassert_true(val_is_equal(re.data[0], 3.5462835043038980,
+				  MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(im.data[0], 0.5984246354075555,
+				  MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(re.data[1], 3.5462835043038980,
+				  MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(im.data[1], -0.5984246354075555,
+				  MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(re.data[2], -3.0925670086078010,
+				  MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(im.data[2], 0.0, MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(re.data[3], -1.0, MTX_ITER_EPS(1E-8)), NULL);
+	zassert_true(val_is_equal(im.data[3], 0.0, MTX_ITER_EPS(1E-8)), NULL);
+
+	/* 10x10 tridiagonal Toeplitz matrix with 2 on the diagonal, 4 above
+	 * and -1 below it, whose eigenvalues are 2 +/- 4i*cos(k*pi/11). */
+	zsl_mtx_init(&mt, NULL);
+	for (size_t i = 0; i < 10; i++) {
+		mt.data[i * 10 + i] = 2.0;
+		if (i > 0) {
+			mt.data[i * 10 + i - 1] = -1.0;
+			mt.data[(i - 1) * 10 + i] = 4.0;
+		}
+	}
+
+	rc = zsl_mtx_eigenvalues_cplx(&mt, &re10, &im10, 30);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t k = 0; k < 5; k++) {
+		zsl_real_t x = 4.0 * ZSL_COS((k + 1) * ZSL_PI / 11.0);
+
+		zassert_true(val_is_equal(re10.data[2 * k], 2.0,
+					  MTX_ITER_EPS(1E-8)), NULL);
+		zassert_true(val_is_equal(re10.data[2 * k + 1], 2.0,
+					  MTX_ITER_EPS(1E-8)), NULL);
+		zassert_true(val_is_equal(im10.data[2 * k], x,
+					  MTX_ITER_EPS(1E-8)), NULL);
+		zassert_true(val_is_equal(im10.data[2 * k + 1], -x,
+					  MTX_ITER_EPS(1E-8)), NULL);
+	}
+
+	/* Not enough iterations. */
+	rc = zsl_mtx_eigenvalues_cplx(&mb, &re, &im, 0);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+
+	/* Output vectors of the wrong size. */
+	rc = zsl_mtx_eigenvalues_cplx(&mb, &re10, &im, 30);
+	zassert_equal(rc, -EINVAL, NULL);
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 void test_matrix_eigenvectors(void)
 {
 	int rc;
@@ -2281,7 +4201,7 @@ void test_matrix_eigenvectors(void)
 	rc = zsl_mtx_eigenvectors(&ma, &va, 1500, false);
 	zassert_equal(rc, 0, NULL);
 	rc = zsl_mtx_eigenvectors(&mb, &vb, 1500, false);
-	zassert_equal(rc, -EEIGENSIZE, NULL);
+	zassert_equal(rc, -ECOMPLEXVAL, NULL);
 	rc = zsl_mtx_eigenvectors(&mc, &vc, 1500, false);
 	zassert_equal(rc, -EEIGENSIZE, NULL);
 	rc = zsl_mtx_eigenvectors(&md, &vd, 1500, false);
@@ -2300,8 +4220,9 @@ void test_matrix_eigenvectors(void)
 			    2.4608606125, -0.0000000055,
 			    1.0000000000, 1.0000000000 };
 
+	/* Eigenvectors follow the eigenvalues by decreasing modulus (3, 1). */
 	zsl_real_t c[8] = { 1.0, 1.0,
-			    0.0, 1.0,
+			    1.0, 0.0,
 			    0.0, 0.0,
 			    0.0, 0.0 };
 
@@ -2320,23 +4241,27 @@ void test_matrix_eigenvectors(void)
 
 	/* Check the output. */
 	for (size_t g = 0; g < (va.sz_rows * va.sz_cols); g++) {
-		zassert_true(val_is_equal(va.data[g], va2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(va.data[g], va2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
 	}
 
 	for (size_t g = 0; g < (vb.sz_rows * vb.sz_cols); g++) {
-		zassert_true(val_is_equal(vb.data[g], vb2.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(vc.data[g], vc2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(vb.data[g], vb2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
+		zassert_true(val_is_equal(vc.data[g], vc2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
 	}
 	
 	for (size_t g = 0; g < (vd.sz_rows * vd.sz_cols); g++) {
-		zassert_true(val_is_equal(vd.data[g], vd2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(vd.data[g], vd2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
 	}
 
 	/* Calculate the eigenvectors of 'ma', 'mb' and 'mc' orthonormalised. */
 	rc = zsl_mtx_eigenvectors(&ma, &va, 1500, true);
 	zassert_equal(rc, 0, NULL);
 	rc = zsl_mtx_eigenvectors(&mb, &vb, 1500, true);
-	zassert_equal(rc, -EEIGENSIZE, NULL);
+	zassert_equal(rc, -ECOMPLEXVAL, NULL);
 	rc = zsl_mtx_eigenvectors(&mc, &vc, 1500, true);
 	zassert_equal(rc, -EEIGENSIZE, NULL);
 	rc = zsl_mtx_eigenvectors(&md, &vd, 1500, true);
@@ -2356,8 +4281,8 @@ void test_matrix_eigenvectors(void)
 			     0.7695023535, -0.0000000045,
 			     0.3126964402, 0.8164965782 };
 
-	zsl_real_t c2[8] = { 1.0, 0.7071067812,
-			     0.0, 0.7071067812,
+	zsl_real_t c2[8] = { 0.7071067812, 1.0,
+			     0.7071067812, 0.0,
 			     0.0, 0.0,
 			     0.0, 0.0 };
 
@@ -2376,21 +4301,240 @@ void test_matrix_eigenvectors(void)
 
 	/* Check the output. */
 	for (size_t g = 0; g < (va.sz_rows * va.sz_cols); g++) {
-		zassert_true(val_is_equal(va.data[g], va2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(va.data[g], va2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
 	}
 	
 	for (size_t g = 0; g < (vb.sz_rows * vb.sz_cols); g++) {
-		zassert_true(val_is_equal(vb.data[g], vb2.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(vc.data[g], vc2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(vb.data[g], vb2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
+		zassert_true(val_is_equal(vc.data[g], vc2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
 	}
 	
 	for (size_t g = 0; g < (vd.sz_rows * vd.sz_cols); g++) {
-		zassert_true(val_is_equal(vd.data[g], vd2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(vd.data[g], vd2.data[g],
+					  MTX_ITER_EPS(1E-6)), NULL);
+	}
+
+	/* Unconverged eigenvalues are reported, not hidden. */
+	rc = zsl_mtx_eigenvectors(&ma, &va, 1, false);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+}
+
+void test_matrix_eigen_sym(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(v2, 4);
+	ZSL_MATRIX_DEF(mev, 4, 4);
+	ZSL_MATRIX_DEF(av, 4, 4);
+	ZSL_MATRIX_DEF(vtv, 4, 4);
+
+	/* Input symmetric matrix. */
+	zsl_real_t data[16] = { 1.0, 2.0, 4.0, 0.0,
+				2.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 5.0,
+				0.0, -2.0, 5.0, -1.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Expected output. */
+	zsl_real_t ev[4] = { -9.2890349032381003, 7.4199113544017665,
+			     2.7935849909013921, -0.9244614420638188 };
+
+	rc = zsl_mtx_eigen_sym(&m, &v, &mev, 30);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t g = 0; g < 4; g++) {
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+		zassert_true(val_is_equal(v.data[g], ev[g], 1E-4), NULL);
+#else
+		zassert_true(val_is_equal(v.data[g], ev[g], 1E-8), NULL);
+#endif
+	}
+
+	/* m * mev should be equal to mev * diag(v). */
+	zsl_mtx_mult(&m, &mev, &av);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			x = mev.data[i * 4 + j] * v.data[j];
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(av.data[i * 4 + j], x, 1E-4),
+				     NULL);
+#else
+			zassert_true(val_is_equal(av.data[i * 4 + j], x, 1E-8),
+				     NULL);
+#endif
+		}
+	}
+
+	/* The eigenvectors should be orthonormal. */
+	zsl_mtx_mult_trans_a(&mev, &mev, &vtv);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			x = (i == j) ? 1.0 : 0.0;
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(vtv.data[i * 4 + j], x, 1E-5),
+				     NULL);
+#else
+			zassert_true(val_is_equal(vtv.data[i * 4 + j], x, 1E-10),
+				     NULL);
+#endif
+		}
+	}
+
+	/* Eigenvalues only. */
+	rc = zsl_mtx_eigen_sym(&m, &v2, NULL, 30);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-6), NULL);
+
+	/* Output vector of the wrong size. */
+	ZSL_VECTOR_DEF(v3, 3);
+	rc = zsl_mtx_eigen_sym(&m, &v3, NULL, 30);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Non-square input matrix. */
+	ZSL_MATRIX_DEF(mr, 4, 3);
+	rc = zsl_mtx_eigen_sym(&mr, &v2, NULL, 30);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_svd_thin(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_VECTOR_DEF(s, 3);
+	ZSL_VECTOR_DEF(s2, 3);
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(v, 4, 3);
+	zsl_real_t work[12];
+
+	/* Input matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Expected singular values. */
+	zsl_real_t sv[3] = { 6.8246886030, 5.3940011894, 0.5730415692 };
+
+	rc = zsl_mtx_svd_thin(&m, &s, &u, &v, NULL, 30);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t g = 0; g < 3; g++) {
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+		zassert_true(val_is_equal(s.data[g], sv[g], 1E-4), NULL);
+#else
+		zassert_true(val_is_equal(s.data[g], sv[g], 1E-8), NULL);
+#endif
+	}
+
+	/* u * diag(s) * v^T should give back 'm'. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			x = 0.0;
+			for (size_t g = 0; g < 3; g++) {
+				x += u.data[i * 3 + g] * s.data[g] *
+				     v.data[j * 3 + g];
+			}
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(x, data[i * 4 + j], 1E-4),
+				     NULL);
+#else
+			zassert_true(val_is_equal(x, data[i * 4 + j], 1E-10),
+				     NULL);
+#endif
+		}
 	}
+
+	/* Singular values only, using the scratch buffer. */
+	rc = zsl_mtx_svd_thin(&m, &s2, NULL, NULL, work, 30);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&s, &s2, 1E-6), NULL);
+
+	/* No room to work in. */
+	rc = zsl_mtx_svd_thin(&m, &s2, &u, NULL, NULL, 30);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Wrong output shape. */
+	rc = zsl_mtx_svd_thin(&m, &s2, &u, &u, NULL, 30);
+	zassert_equal(rc, -EINVAL, NULL);
 }
+
+void test_matrix_svd_thin_large(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(m, 24, 20);
+	ZSL_VECTOR_DEF(s, 20);
+	ZSL_MATRIX_DEF(u, 24, 20);
+	ZSL_MATRIX_DEF(v, 20, 20);
+
+	/* A dense, well-conditioned 24x20 input matrix. */
+	for (size_t i = 0; i < 24; i++) {
+		for (size_t j = 0; j < 20; j++) {
+			m.data[i * 20 + j] = ZSL_SIN((zsl_real_t)(i * 20 + j)) +
+					     (i == j ? 4.0 : 0.0);
+		}
+	}
+
+	rc = zsl_mtx_svd_thin(&m, &s, &u, &v, NULL, 30);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t g = 1; g < 20; g++) {
+		zassert_true(s.data[g - 1] >= s.data[g], NULL);
+	}
+
+	/* u * diag(s) * v^T should give back 'm'. */
+	for (size_t i = 0; i < 24; i++) {
+		for (size_t j = 0; j < 20; j++) {
+			x = 0.0;
+			for (size_t g = 0; g < 20; g++) {
+				x += u.data[i * 20 + g] * s.data[g] *
+				     v.data[j * 20 + g];
+			}
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(x, m.data[i * 20 + j], 1E-4),
+				     NULL);
+#else
+			zassert_true(val_is_equal(x, m.data[i * 20 + j], 1E-10),
+				     NULL);
+#endif
+		}
+	}
+
+	/* The columns of 'u' should be orthonormal. */
+	for (size_t a = 0; a < 20; a++) {
+		for (size_t b = 0; b < 20; b++) {
+			x = 0.0;
+			for (size_t i = 0; i < 24; i++) {
+				x += u.data[i * 20 + a] * u.data[i * 20 + b];
+			}
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(x, a == b ? 1.0 : 0.0, 1E-4),
+				     NULL);
+#else
+			zassert_true(val_is_equal(x, a == b ? 1.0 : 0.0, 1E-10),
+				     NULL);
 #endif
+		}
+	}
+}
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 void test_matrix_svd(void)
 {
 	int rc;
@@ -2449,21 +4593,22 @@ void test_matrix_svd(void)
 
 	/* Check the output. */
 	for (size_t g = 0; g < (u.sz_rows * u.sz_cols); g++) {
-		zassert_true(val_is_equal(u.data[g], u2.data[g], 1E-8), NULL);
+		zassert_true(val_is_equal(u.data[g], u2.data[g],
+					  MTX_ITER_EPS(1E-8)), NULL);
 	}
 
 	for (size_t g = 0; g < (e.sz_rows * e.sz_cols); g++) {
-		zassert_true(val_is_equal(e.data[g], e2.data[g], 1E-8), NULL);
+		zassert_true(val_is_equal(e.data[g], e2.data[g],
+					  MTX_ITER_EPS(1E-8)), NULL);
 	}
 
 	for (size_t g = 0; g < (v.sz_rows * v.sz_cols); g++) {
-		zassert_true(val_is_equal(v.data[g], v2.data[g], 1E-8), NULL);
+		zassert_true(val_is_equal(v.data[g], v2.data[g],
+					  MTX_ITER_EPS(1E-8)), NULL);
 	}
 }
-#endif
 
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 void test_matrix_pinv(void)
 {
 	int rc;
@@ -2504,11 +4649,170 @@ void test_matrix_pinv(void)
 
 	/* Check the output. */
 	for (size_t g = 0; g < (pinv.sz_rows * pinv.sz_cols); g++) {
-		zassert_true(val_is_equal(pinv.data[g], pinv2.data[g], 1E-8),
-			     NULL);
+		zassert_true(val_is_equal(pinv.data[g], pinv2.data[g],
+					  MTX_ITER_EPS(1E-8)), NULL);
 	}
 }
-#endif
+
+void test_matrix_svd_ws(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(e, 3, 4);
+	ZSL_MATRIX_DEF(v, 4, 4);
+
+	ZSL_MATRIX_DEF(u2, 3, 3);
+	ZSL_MATRIX_DEF(e2, 3, 4);
+	ZSL_MATRIX_DEF(v2, 4, 4);
+
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Only the singular values need scratch memory. */
+	zassert_equal(zsl_mtx_svd_ws_size(3, 4), ZSL_WS_REALS(3), NULL);
+	zassert_equal(zsl_mtx_svd_ws_size(4, 3), ZSL_WS_REALS(3), NULL);
+
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_svd_ws_size(3, 4));
+
+	ws.sz = zsl_mtx_svd_ws_size(3, 4) - ZSL_WS_ALIGN;
+	rc = zsl_mtx_svd_ws(&m, &u, &e, &v, 1500, &ws);
+	zassert_equal(rc, -ENOMEM, NULL);
+
+	ws.sz = zsl_mtx_svd_ws_size(3, 4);
+	rc = zsl_mtx_svd_ws(&m, &u, &e, &v, 1500, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* The results must match those of 'zsl_mtx_svd'. */
+	rc = zsl_mtx_svd(&m, &u2, &e2, &v2, 1500);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t g = 0; g < (u.sz_rows * u.sz_cols); g++) {
+		zassert_true(val_is_equal(u.data[g], u2.data[g],
+					  MTX_ITER_EPS(1E-12)), NULL);
+	}
+
+	for (size_t g = 0; g < (e.sz_rows * e.sz_cols); g++) {
+		zassert_true(val_is_equal(e.data[g], e2.data[g],
+					  MTX_ITER_EPS(1E-12)), NULL);
+	}
+
+	for (size_t g = 0; g < (v.sz_rows * v.sz_cols); g++) {
+		zassert_true(val_is_equal(v.data[g], v2.data[g],
+					  MTX_ITER_EPS(1E-12)), NULL);
+	}
+}
+
+void test_matrix_pinv_ws(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(pinv, 4, 3);
+	ZSL_MATRIX_DEF(pinv2, 4, 3);
+
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* The same workspace can serve several calls in turn. */
+	ZSL_WORKSPACE_DEF(ws, zsl_mtx_pinv_ws_size(3, 4));
+
+	for (int i = 0; i < 2; i++) {
+		rc = zsl_mtx_pinv_ws(&m, &pinv, 1500, &ws);
+		zassert_equal(rc, 0, NULL);
+		zassert_equal(ws.used, 0, NULL);
+	}
+
+	rc = zsl_mtx_pinv(&m, &pinv2, 1500);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t g = 0; g < (pinv.sz_rows * pinv.sz_cols); g++) {
+		zassert_true(val_is_equal(pinv.data[g], pinv2.data[g],
+					  MTX_ITER_EPS(1E-12)), NULL);
+	}
+
+	/* Too small a workspace must fail cleanly. */
+	ws.sz = ZSL_WS_REALS(3);
+	rc = zsl_mtx_pinv_ws(&m, &pinv, 1500, &ws);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(ws.used, 0, NULL);
+}
+
+void test_matrix_svd_view(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx mt, ut;
+
+	ZSL_MATRIX_DEF(u, 4, 4);
+	ZSL_MATRIX_DEF(e, 4, 3);
+	ZSL_MATRIX_DEF(v, 3, 3);
+	ZSL_MATRIX_DEF(ue, 4, 3);
+	ZSL_MATRIX_DEF(usv, 4, 3);
+	ZSL_MATRIX_DEF(pinv, 4, 3);
+	ZSL_MATRIX_DEF(pinvt, 3, 4);
+
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* The SVD of a transposed view decomposes m^T, not m. */
+	zsl_mtx_trans_view(&m, &mt);
+	rc = zsl_mtx_svd(&mt, &u, &e, &v, 1500);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&u, &e, &ue);
+	zsl_mtx_trans_view(&v, &v);
+	zsl_mtx_mult(&ue, &v, &usv);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zassert_true(val_is_equal(usv.data[(i * 3) + j],
+						  data[(j * 4) + i],
+						  MTX_ITER_EPS(1E-8)), NULL);
+		}
+	}
+
+	/* pinv(m^T) = pinv(m)^T. */
+	rc = zsl_mtx_pinv(&mt, &pinvt, 1500);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_pinv(&m, &pinv, 1500);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zsl_mtx_get(&pinvt, j, i, &x);
+			zassert_true(val_is_equal(x, pinv.data[(i * 3) + j],
+						  MTX_ITER_EPS(1E-8)), NULL);
+		}
+	}
+
+	/* 'u' and 'v' are used as scratch, so they can't be views. */
+	zsl_mtx_trans_view(&u, &ut);
+	zsl_mtx_trans_view(&v, &v);
+	rc = zsl_mtx_svd(&mt, &ut, &e, &v, 1500);
+	zassert_equal(rc, -EINVAL, NULL);
+}
 
 void test_matrix_min(void)
 {
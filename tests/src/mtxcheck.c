@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "floatcheck.h"
+#include "mtxcheck.h"
+
+void
+mtx_fill_test(struct zsl_mtx *m, size_t seed)
+{
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			m->data[(i * m->sz_cols) + j] =
+				(zsl_real_t)(((i + 2) * (j + 3) + seed) % 7) - 3.0;
+		}
+		if (m->sz_rows == m->sz_cols) {
+			m->data[(i * m->sz_cols) + i] += 9.0;
+		}
+	}
+}
+
+bool
+arr_is_equal(const zsl_real_t *a, const zsl_real_t *b, size_t n,
+	     zsl_real_t epsilon)
+{
+	for (size_t e = 0; e < n; e++) {
+		if (!val_is_equal(a[e], b[e], epsilon)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+mtx_is_equal(struct zsl_mtx *ma, struct zsl_mtx *mb, zsl_real_t epsilon)
+{
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols)) {
+		return false;
+	}
+
+	return arr_is_equal(ma->data, mb->data, ma->sz_rows * ma->sz_cols,
+			    epsilon);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Helper functions to build and compare test matrices.
+ *
+ * This file contains helpers shared by the matrix test suites.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_MTXCHECK_H_
+#define ZEPHYR_INCLUDE_ZSL_MTXCHECK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Fills 'm' with a deterministic, non-symmetric test matrix. Square matrices
+ * get a dominant diagonal, so that they are well conditioned.
+ *
+ * @param m         The matrix to fill
+ * @param seed      Selects one of seven different fill patterns
+ */
+void mtx_fill_test(struct zsl_mtx *m, size_t seed);
+
+/**
+ * Checks if two arrays of zsl_real_t are equal, element by element, with a
+ * +/- margin of 'epsilon'.
+ *
+ * @param a         The values to check
+ * @param b         The values to compare against
+ * @param n         The number of values in 'a' and 'b'
+ * @param epsilon   The +/- margin for equality
+ *
+ * @return  True if all values in 'a' are equal to those in 'b', otherwise
+ *          false.
+ */
+bool arr_is_equal(const zsl_real_t *a, const zsl_real_t *b, size_t n,
+		  zsl_real_t epsilon);
+
+/**
+ * Checks if two contiguous matrices have the same shape, and are equal
+ * element by element with a +/- margin of 'epsilon'.
+ *
+ * @param ma        The matrix to check
+ * @param mb        The matrix to compare against
+ * @param epsilon   The +/- margin for equality
+ *
+ * @return  True if 'ma' is equal to 'mb', otherwise false.
+ */
+bool mtx_is_equal(struct zsl_mtx *ma, struct zsl_mtx *mb, zsl_real_t epsilon);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_MTXCHECK_H_ */
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/sparse.h>
+#include <zsl/solvers.h>
+#include "floatcheck.h"
+
+#define SOLVER_N (20)
+
+/* Builds the SPD tridiagonal matrix tridiag(-1, d, -1) of size SOLVER_N. */
+static void solver_poisson(struct zsl_spmtx *sp, zsl_real_t d)
+{
+	ZSL_SPCOO_DEF(coo, SOLVER_N, SOLVER_N, 3 * SOLVER_N);
+
+	zsl_spcoo_init(&coo);
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		zsl_spcoo_add(&coo, i, i, d);
+		if (i > 0) {
+			zsl_spcoo_add(&coo, i, i - 1, -1.0);
+		}
+		if (i + 1 < SOLVER_N) {
+			zsl_spcoo_add(&coo, i, i + 1, -1.0);
+		}
+	}
+	zsl_spmtx_from_coo(&coo, sp);
+}
+
+/* Returns |b - A * x| / |b|. */
+static zsl_real_t solver_rel_res(struct zsl_linop *a, struct zsl_vec *b,
+				 struct zsl_vec *x)
+{
+	ZSL_VECTOR_DEF(r, SOLVER_N);
+
+	a->apply(a->ctx, x, &r);
+	zsl_vec_sub(b, &r, &r);
+
+	return zsl_vec_norm(&r) / zsl_vec_norm(b);
+}
+
+/* Computes 'y = A * x' for tridiag(-1.5, 4, -0.5) without storing 'A'. */
+static int solver_convdiff(void *ctx, struct zsl_vec *x, struct zsl_vec *y)
+{
+	size_t n = x->sz;
+
+	for (size_t i = 0; i < n; i++) {
+		y->data[i] = 4.0 * x->data[i];
+		if (i > 0) {
+			y->data[i] -= 1.5 * x->data[i - 1];
+		}
+		if (i + 1 < n) {
+			y->data[i] -= 0.5 * x->data[i + 1];
+		}
+	}
+
+	return 0;
+}
+
+void test_solve_cg(void)
+{
+	int rc;
+	zsl_real_t hist[SOLVER_N + 1];
+	size_t it_none;
+	size_t it_jac;
+	struct zsl_linop a;
+	struct zsl_precond jac;
+	struct zsl_precond ic;
+	struct zsl_solver_params p = {
+		.tol = 1E-5,
+		.max_iter = 4 * SOLVER_N,
+		.hist = hist,
+		.hist_sz = SOLVER_N + 1,
+	};
+
+	ZSL_SPMTX_DEF(sp, SOLVER_N, SOLVER_N, 3 * SOLVER_N);
+	ZSL_SPMTX_DEF(l, SOLVER_N, SOLVER_N, 2 * SOLVER_N);
+	ZSL_SPMTX_DEF(lsmall, SOLVER_N, SOLVER_N, SOLVER_N);
+	ZSL_VECTOR_DEF(b, SOLVER_N);
+	ZSL_VECTOR_DEF(x, SOLVER_N);
+	ZSL_VECTOR_DEF(d, SOLVER_N);
+	ZSL_VECTOR_DEF(e, SOLVER_N - 1);
+
+	solver_poisson(&sp, 2.5);
+	zassert_equal(zsl_linop_spmtx(&a, &sp), 0, NULL);
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		b.data[i] = (zsl_real_t)(i % 3) - 0.5;
+	}
+
+	/* Unpreconditioned. */
+	zsl_vec_init(&x);
+	rc = zsl_solve_cg(&a, &b, &x, NULL, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(solver_rel_res(&a, &b, &x) < 1E-4, NULL);
+	zassert_true(p.iter > 1, NULL);
+	zassert_true(val_is_equal(hist[0], zsl_vec_norm(&b), 1E-5), NULL);
+	zassert_true(val_is_equal(hist[p.iter], p.res, 1E-9), NULL);
+	it_none = p.iter;
+
+	/* Jacobi: the diagonal is constant, so this doesn't change much. */
+	zassert_equal(zsl_precond_jacobi_spmtx(&jac, &sp, &d), 0, NULL);
+	zassert_equal(zsl_precond_jacobi_spmtx(&jac, &sp, &e), -EINVAL, NULL);
+	zsl_vec_init(&x);
+	rc = zsl_solve_cg(&a, &b, &x, &jac, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(solver_rel_res(&a, &b, &x) < 1E-4, NULL);
+	it_jac = p.iter;
+	zassert_true(it_jac <= it_none + 1, NULL);
+
+	/* IC(0) of a tridiagonal matrix is its exact Cholesky factor. */
+	zassert_equal(zsl_precond_ic0(&ic, &sp, &lsmall), -ENOMEM, NULL);
+	zassert_equal(zsl_precond_ic0(&ic, &sp, &l), 0, NULL);
+	zassert_equal(l.nnz, 2 * SOLVER_N - 1, NULL);
+	zsl_vec_init(&x);
+	rc = zsl_solve_cg(&a, &b, &x, &ic, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(p.iter <= 2, NULL);
+	zassert_true(solver_rel_res(&a, &b, &x) < 1E-4, NULL);
+
+	/* Running out of iterations is reported. */
+	p.max_iter = 2;
+	zsl_vec_init(&x);
+	rc = zsl_solve_cg(&a, &b, &x, NULL, &p);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	zassert_equal(p.iter, 2, NULL);
+
+	/* An indefinite matrix is detected. */
+	solver_poisson(&sp, -2.5);
+	p.max_iter = 4 * SOLVER_N;
+	zsl_vec_init(&x);
+	rc = zsl_solve_cg(&a, &b, &x, NULL, &p);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+	zassert_equal(zsl_precond_ic0(&ic, &sp, &l), -ENOTPOSDEF, NULL);
+
+	/* A zero right-hand side gives a zero solution. */
+	zsl_vec_init(&b);
+	x.data[0] = 1.0;
+	rc = zsl_solve_cg(&a, &b, &x, NULL, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(p.iter, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 0.0, 1E-9), NULL);
+}
+
+void test_solve_bicgstab_gmres(void)
+{
+	int rc;
+	zsl_real_t hist[SOLVER_N + 1];
+	struct zsl_linop a;
+	struct zsl_linop am;
+	struct zsl_precond jac;
+	struct zsl_solver_params p = {
+		.tol = 1E-5,
+		.max_iter = 4 * SOLVER_N,
+		.restart = 5,
+		.hist = hist,
+		.hist_sz = SOLVER_N + 1,
+	};
+
+	ZSL_MATRIX_DEF(m, SOLVER_N, SOLVER_N);
+	ZSL_MATRIX_DEF(mr, SOLVER_N, SOLVER_N + 1);
+	ZSL_VECTOR_DEF(b, SOLVER_N);
+	ZSL_VECTOR_DEF(x, SOLVER_N);
+	ZSL_VECTOR_DEF(d, SOLVER_N);
+
+	/* The non-symmetric operator, as a callback and as a dense matrix. */
+	a.n = SOLVER_N;
+	a.apply = solver_convdiff;
+	a.ctx = NULL;
+	zsl_mtx_init(&m, NULL);
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		zsl_mtx_set(&m, i, i, 4.0);
+		if (i > 0) {
+			zsl_mtx_set(&m, i, i - 1, -1.5);
+		}
+		if (i + 1 < SOLVER_N) {
+			zsl_mtx_set(&m, i, i + 1, -0.5);
+		}
+		b.data[i] = 1.0 + (zsl_real_t)i / SOLVER_N;
+	}
+	zassert_equal(zsl_linop_mtx(&am, &mr), -EINVAL, NULL);
+	zassert_equal(zsl_linop_mtx(&am, &m), 0, NULL);
+	zassert_equal(zsl_precond_jacobi_mtx(&jac, &m, &d), 0, NULL);
+
+	zsl_vec_init(&x);
+	rc = zsl_solve_bicgstab(&a, &b, &x, NULL, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(solver_rel_res(&am, &b, &x) < 1E-4, NULL);
+
+	zsl_vec_init(&x);
+	rc = zsl_solve_bicgstab(&am, &b, &x, &jac, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(solver_rel_res(&a, &b, &x) < 1E-4, NULL);
+
+	/* Restarted GMRES, with and without a preconditioner. */
+	zsl_vec_init(&x);
+	rc = zsl_solve_gmres(&a, &b, &x, NULL, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(solver_rel_res(&am, &b, &x) < 1E-4, NULL);
+	zassert_true(p.iter > p.restart, NULL);
+	zassert_true(val_is_equal(hist[0], zsl_vec_norm(&b), 1E-5), NULL);
+	for (size_t i = 1; i <= p.iter && i < p.hist_sz; i++) {
+		/* GMRES minimises the residual, so it never grows within a
+		 * cycle. */
+		if (i % p.restart != 0) {
+			zassert_true(hist[i] <= hist[i - 1] * (1.0 + 1E-5),
+				     NULL);
+		}
+	}
+
+	zsl_vec_init(&x);
+	rc = zsl_solve_gmres(&am, &b, &x, &jac, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(solver_rel_res(&a, &b, &x) < 1E-4, NULL);
+
+	/* A full-length GMRES cycle solves the system exactly. */
+	p.restart = SOLVER_N;
+	zsl_vec_init(&x);
+	rc = zsl_solve_gmres(&am, &b, &x, NULL, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(p.iter <= SOLVER_N, NULL);
+
+	p.restart = 0;
+	zassert_equal(zsl_solve_gmres(&am, &b, &x, NULL, &p), -EINVAL, NULL);
+}
+
+void test_solve_mixed(void)
+{
+	int rc;
+	zsl_real_t x0;
+	zsl_real_t hist[8];
+	struct zsl_solver_params p = {
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+		.tol = 1E-6,
+#else
+		.tol = 1E-14,
+#endif
+		.max_iter = 7,
+		.hist = hist,
+		.hist_sz = 8,
+	};
+
+	ZSL_MATRIX_DEF(m, SOLVER_N, SOLVER_N);
+	ZSL_MATRIX_DEF(spd, SOLVER_N, SOLVER_N);
+	ZSL_MATRIX_DEF(h, 10, 10);
+	ZSL_VECTOR_DEF(b, SOLVER_N);
+	ZSL_VECTOR_DEF(x, SOLVER_N);
+	ZSL_VECTOR_DEF(bh, 10);
+	ZSL_VECTOR_DEF(xh, 10);
+
+	/* A dense non-symmetric matrix, an SPD matrix, and 'b' chosen so that
+	 * x[i] = 1 + 1/(i + 1) solves both systems. */
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		for (size_t j = 0; j < SOLVER_N; j++) {
+			zsl_mtx_set(&m, i, j, 1.0 / (1.0 + i + 2.0 * j) +
+				    (i == j ? 2.0 : 0.0));
+			zsl_mtx_set(&spd, i, j, 1.0 / (1.0 + i + j) +
+				    (i == j ? 1.0 : 0.0));
+		}
+	}
+
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		b.data[i] = 0.0;
+		for (size_t j = 0; j < SOLVER_N; j++) {
+			b.data[i] += m.data[(i * SOLVER_N) + j] *
+				     (1.0 + 1.0 / (j + 1.0));
+		}
+	}
+
+	rc = zsl_solve_lu_mixed(&m, &b, &x, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(p.iter > 0, NULL);
+	zassert_true(hist[p.iter] < hist[0], NULL);
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		x0 = 1.0 + 1.0 / (i + 1.0);
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+		zassert_true(val_is_equal(x.data[i], x0, 1E-5), NULL);
+#else
+		zassert_true(val_is_equal(x.data[i], x0, 1E-12), NULL);
+#endif
+	}
+
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		b.data[i] = 0.0;
+		for (size_t j = 0; j < SOLVER_N; j++) {
+			b.data[i] += spd.data[(i * SOLVER_N) + j] *
+				     (1.0 + 1.0 / (j + 1.0));
+		}
+	}
+
+	rc = zsl_solve_cho_mixed(&spd, &b, &x, &p);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < SOLVER_N; i++) {
+		x0 = 1.0 + 1.0 / (i + 1.0);
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+		zassert_true(val_is_equal(x.data[i], x0, 1E-5), NULL);
+#else
+		zassert_true(val_is_equal(x.data[i], x0, 1E-12), NULL);
+#endif
+	}
+
+	/* 'm' isn't symmetric positive definite once negated. */
+	zsl_mtx_scalar_mult_d(&m, -1.0);
+	rc = zsl_solve_cho_mixed(&m, &b, &x, &p);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+
+	/* The 10x10 Hilbert matrix is far too ill-conditioned for a float
+	 * factor, so the refinement must give up. */
+	for (size_t i = 0; i < 10; i++) {
+		for (size_t j = 0; j < 10; j++) {
+			zsl_mtx_set(&h, i, j, 1.0 / (1.0 + i + j));
+		}
+		bh.data[i] = 1.0;
+	}
+	rc = zsl_solve_lu_mixed(&h, &bh, &xh, &p);
+	zassert_true((rc == -ENOCONVERGE) || (rc == -ESINGULAR), NULL);
+
+	zsl_mtx_init(&h, NULL);
+	rc = zsl_solve_lu_mixed(&h, &bh, &xh, &p);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	zassert_equal(zsl_solve_lu_mixed(&m, &bh, &x, &p), -EINVAL, NULL);
+}
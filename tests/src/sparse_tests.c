@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/sparse.h>
+#include "floatcheck.h"
+
+/* A 4x5 test matrix with 8 non-zero values. */
+static zsl_real_t sp_dense[4 * 5] = {
+	2.0, 0.0, 0.0, -1.0, 0.0,
+	0.0, 3.0, 0.0, 0.0, 0.0,
+	1.0, 0.0, 4.0, 0.0, 0.5,
+	0.0, 0.0, -2.0, 0.0, 6.0
+};
+
+void test_spmtx_from_coo(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_SPCOO_DEF(coo, 4, 5, 10);
+	ZSL_SPMTX_DEF(sp, 4, 5, 10);
+	ZSL_SPMTX_DEF(small, 4, 5, 4);
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_MATRIX_DEF(mref, 4, 5);
+
+	zsl_spcoo_init(&coo);
+	zsl_spmtx_init(&sp);
+	zsl_mtx_from_arr(&mref, sp_dense);
+
+	/* Add the triplets out of order, splitting two values in halves. */
+	zassert_equal(zsl_spcoo_add(&coo, 3, 4, 6.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 2, 2, 2.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 0, 3, -1.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 2, 4, 0.5), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 1, 1, 3.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 2, 0, 1.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 3, 2, -1.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 0, 0, 2.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 2, 2, 2.0), 0, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 3, 2, -1.0), 0, NULL);
+
+	/* Out of bounds and full lists are rejected. */
+	zassert_equal(zsl_spcoo_add(&coo, 4, 0, 1.0), -EINVAL, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 0, 5, 1.0), -EINVAL, NULL);
+	zassert_equal(zsl_spcoo_add(&coo, 0, 1, 1.0), -ENOMEM, NULL);
+
+	rc = zsl_spmtx_from_coo(&coo, &sp);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(sp.nnz, 8, NULL);
+	zassert_equal(sp.row_ptr[4], 8, NULL);
+
+	/* Columns must be sorted in each row. */
+	for (size_t i = 0; i < sp.sz_rows; i++) {
+		for (size_t k = sp.row_ptr[i] + 1; k < sp.row_ptr[i + 1]; k++) {
+			zassert_true(sp.col_idx[k - 1] < sp.col_idx[k], NULL);
+		}
+	}
+
+	rc = zsl_spmtx_to_mtx(&sp, &m);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mref), NULL);
+
+	rc = zsl_spmtx_get(&sp, 2, 2, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 4.0, 1E-6), NULL);
+	rc = zsl_spmtx_get(&sp, 1, 3, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 0.0, 1E-6), NULL);
+	rc = zsl_spmtx_get(&sp, 4, 0, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Not enough room for the triplets. */
+	zsl_spmtx_init(&small);
+	rc = zsl_spmtx_from_coo(&coo, &small);
+	zassert_equal(rc, -ENOMEM, NULL);
+}
+
+void test_spmtx_from_mtx(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx mv;
+
+	ZSL_SPMTX_DEF(sp, 4, 5, 8);
+	ZSL_SPMTX_DEF(small, 4, 5, 7);
+	ZSL_SPMTX_DEF(wrong, 5, 4, 8);
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_MATRIX_DEF(mref, 4, 5);
+	ZSL_MATRIX_DEF(mt, 5, 4);
+
+	zsl_spmtx_init(&sp);
+	zsl_mtx_from_arr(&mref, sp_dense);
+
+	rc = zsl_spmtx_from_mtx(&mref, &sp, 0.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(sp.nnz, 8, NULL);
+
+	rc = zsl_spmtx_to_mtx(&sp, &m);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mref), NULL);
+
+	/* Both directions work on a transposed view. */
+	zsl_mtx_trans_view(&mt, &mv);
+	rc = zsl_spmtx_to_mtx(&sp, &mv);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 5; j++) {
+			x = mt.data[(j * 4) + i];
+			zassert_true(val_is_equal(x, sp_dense[(i * 5) + j],
+						  1E-6), NULL);
+		}
+	}
+	zsl_spmtx_init(&sp);
+	rc = zsl_spmtx_from_mtx(&mv, &sp, 0.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(sp.nnz, 8, NULL);
+	rc = zsl_spmtx_to_mtx(&sp, &m);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mref), NULL);
+
+	/* Values at or below the tolerance are dropped. */
+	rc = zsl_spmtx_from_mtx(&mref, &sp, 1.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(sp.nnz, 5, NULL);
+
+	zsl_spmtx_init(&small);
+	rc = zsl_spmtx_from_mtx(&mref, &small, 0.0);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(small.nnz, 0, NULL);
+
+	zsl_spmtx_init(&wrong);
+	rc = zsl_spmtx_from_mtx(&mref, &wrong, 0.0);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_spmtx_mult(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx mbv, mcv;
+	zsl_real_t a[5] = { 1.0, -2.0, 0.5, 3.0, -1.0 };
+	zsl_real_t b[4] = { 0.5, 1.0, -1.0, 2.0 };
+
+	ZSL_SPMTX_DEF(sp, 4, 5, 8);
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_MATRIX_DEF(mb, 5, 3);
+	ZSL_MATRIX_DEF(mc, 4, 3);
+	ZSL_MATRIX_DEF(mref, 4, 3);
+	ZSL_MATRIX_DEF(mbt, 3, 5);
+	ZSL_MATRIX_DEF(mct, 3, 4);
+	ZSL_VECTOR_DEF(v, 5);
+	ZSL_VECTOR_DEF(w, 4);
+	ZSL_VECTOR_DEF(wt, 5);
+	ZSL_VECTOR_DEF(u, 4);
+
+	zsl_spmtx_init(&sp);
+	zsl_mtx_from_arr(&m, sp_dense);
+	zsl_spmtx_from_mtx(&m, &sp, 0.0);
+
+	/* w = sp * v, checked against the dense product. */
+	zsl_vec_from_arr(&v, a);
+	rc = zsl_spmtx_mult_vec(&sp, &v, &w);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zsl_real_t sum = 0.0;
+		for (size_t j = 0; j < 5; j++) {
+			sum += sp_dense[(i * 5) + j] * a[j];
+		}
+		zassert_true(val_is_equal(w.data[i], sum, 1E-6), NULL);
+	}
+
+	/* wt = sp^T * u. */
+	zsl_vec_from_arr(&u, b);
+	rc = zsl_spmtx_mult_trans_vec(&sp, &u, &wt);
+	zassert_equal(rc, 0, NULL);
+	for (size_t j = 0; j < 5; j++) {
+		zsl_real_t sum = 0.0;
+		for (size_t i = 0; i < 4; i++) {
+			sum += sp_dense[(i * 5) + j] * b[i];
+		}
+		zassert_true(val_is_equal(wt.data[j], sum, 1E-6), NULL);
+	}
+
+	/* mc = sp * mb. */
+	for (size_t i = 0; i < 15; i++) {
+		mb.data[i] = (zsl_real_t)i - 7.0;
+	}
+	rc = zsl_spmtx_mult_mtx(&sp, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&m, &mb, &mref);
+	zassert_true(zsl_mtx_is_equal(&mc, &mref), NULL);
+
+	/* The same product with 'mb' and 'mc' as transposed views. */
+	zsl_mtx_trans(&mb, &mbt);
+	zsl_mtx_trans_view(&mbt, &mbv);
+	zsl_mtx_trans_view(&mct, &mcv);
+	rc = zsl_spmtx_mult_mtx(&sp, &mbv, &mcv);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zsl_mtx_get(&mcv, i, j, &x);
+			zassert_true(val_is_equal(x, mref.data[(i * 3) + j],
+						  1E-6), NULL);
+		}
+	}
+
+	/* Wrong sizes. */
+	rc = zsl_spmtx_mult_vec(&sp, &w, &v);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_spmtx_mult_mtx(&sp, &mc, &mb);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_spmtx_trans(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_SPMTX_DEF(sp, 4, 5, 8);
+	ZSL_SPMTX_DEF(st, 5, 4, 8);
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_MATRIX_DEF(mt, 5, 4);
+	ZSL_MATRIX_DEF(mref, 5, 4);
+
+	zsl_spmtx_init(&sp);
+	zsl_spmtx_init(&st);
+	zsl_mtx_from_arr(&m, sp_dense);
+	zsl_spmtx_from_mtx(&m, &sp, 0.0);
+
+	rc = zsl_spmtx_trans(&sp, &st);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(st.nnz, 8, NULL);
+
+	zsl_spmtx_to_mtx(&st, &mt);
+	zsl_mtx_trans(&m, &mref);
+	zassert_true(zsl_mtx_is_equal(&mt, &mref), NULL);
+
+	/* Binary search relies on the columns being sorted. */
+	zsl_spmtx_get(&st, 4, 3, &x);
+	zassert_true(val_is_equal(x, 6.0, 1E-6), NULL);
+	zsl_spmtx_get(&st, 0, 2, &x);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+
+	rc = zsl_spmtx_trans(&sp, &sp);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_spmtx_solve_tri(void)
+{
+	int rc;
+	zsl_real_t a[5 * 5] = {
+		4.0, 0.0, 0.0, 0.0, 0.0,
+		1.0, 2.0, 0.0, 0.0, 0.0,
+		0.0, 0.0, 5.0, 0.0, 0.0,
+		-1.0, 0.0, 3.0, 1.0, 0.0,
+		0.0, 2.0, 0.0, -1.0, 3.0
+	};
+	zsl_real_t b[5] = { 4.0, -3.0, 10.0, 2.0, 1.0 };
+
+	ZSL_SPMTX_DEF(l, 5, 5, 10);
+	ZSL_SPMTX_DEF(u, 5, 5, 10);
+	ZSL_SPMTX_DEF(s, 5, 5, 10);
+	ZSL_MATRIX_DEF(m, 5, 5);
+	ZSL_MATRIX_DEF(mt, 5, 5);
+	ZSL_VECTOR_DEF(vb, 5);
+	ZSL_VECTOR_DEF(x, 5);
+	ZSL_VECTOR_DEF(r, 5);
+
+	zsl_spmtx_init(&l);
+	zsl_spmtx_init(&u);
+	zsl_mtx_from_arr(&m, a);
+	zsl_spmtx_from_mtx(&m, &l, 0.0);
+	zsl_mtx_trans(&m, &mt);
+	zsl_spmtx_from_mtx(&mt, &u, 0.0);
+	zsl_vec_from_arr(&vb, b);
+
+	/* l * x = b. */
+	rc = zsl_spmtx_solve_lower(&l, &vb, &x, false);
+	zassert_equal(rc, 0, NULL);
+	zsl_spmtx_mult_vec(&l, &x, &r);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(r.data[i], b[i], 1E-5), NULL);
+	}
+
+	/* u * x = b, in place. */
+	zsl_vec_from_arr(&x, b);
+	rc = zsl_spmtx_solve_upper(&u, &x, &x, false);
+	zassert_equal(rc, 0, NULL);
+	zsl_spmtx_mult_vec(&u, &x, &r);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(r.data[i], b[i], 1E-5), NULL);
+	}
+
+	/* Unit diagonal: the stored diagonal is ignored. */
+	rc = zsl_spmtx_solve_lower(&l, &vb, &x, true);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 4.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.data[1], -7.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.data[3], -24.0, 1E-5), NULL);
+
+	/* A missing diagonal value makes the system singular. */
+	m.data[(2 * 5) + 2] = 0.0;
+	zsl_spmtx_init(&s);
+	zsl_spmtx_from_mtx(&m, &s, 0.0);
+	rc = zsl_spmtx_solve_lower(&s, &vb, &x, false);
+	zassert_equal(rc, -ESINGULAR, NULL);
+	rc = zsl_spmtx_solve_lower(&s, &vb, &x, true);
+	zassert_equal(rc, 0, NULL);
+}
@@ -360,6 +360,56 @@ void test_sta_linear_regression(void)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+void test_sta_rls(void)
+{
+	int rc;
+	zsl_real_t y, e;
+
+	ZSL_STA_RLS_DEF(rls, 3);
+	ZSL_VECTOR_DEF(phi, 3);
+	ZSL_VECTOR_DEF(phi2, 2);
+
+	/* Track y = 2.0 - 0.5 * sin(i) + 3.0 * cos(0.7 * i). */
+	rc = zsl_sta_rls_init(&rls, 1.0, 1E6);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 50; i++) {
+		phi.data[0] = 1.0;
+		phi.data[1] = ZSL_SIN((zsl_real_t)i);
+		phi.data[2] = ZSL_COS(0.7 * (zsl_real_t)i);
+		y = 2.0 - (0.5 * phi.data[1]) + (3.0 * phi.data[2]);
+		rc = zsl_sta_rls_update(&rls, &phi, y, &e);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(val_is_equal(rls.theta.data[0], 2.0, 1E-3), NULL);
+	zassert_true(val_is_equal(rls.theta.data[1], -0.5, 1E-3), NULL);
+	zassert_true(val_is_equal(rls.theta.data[2], 3.0, 1E-3), NULL);
+	zassert_true(val_is_equal(e, 0.0, 1E-3), NULL);
+
+	/* With a forgetting factor, the estimates follow a change in the
+	 * offset. */
+	rc = zsl_sta_rls_init(&rls, 0.9, 1E6);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 200; i++) {
+		phi.data[0] = 1.0;
+		phi.data[1] = ZSL_SIN((zsl_real_t)i);
+		phi.data[2] = ZSL_COS(0.7 * (zsl_real_t)i);
+		y = (i < 100 ? 2.0 : 4.0) - (0.5 * phi.data[1]) +
+		    (3.0 * phi.data[2]);
+		rc = zsl_sta_rls_update(&rls, &phi, y, NULL);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(val_is_equal(rls.theta.data[0], 4.0, 1E-3), NULL);
+	zassert_true(val_is_equal(rls.theta.data[1], -0.5, 1E-3), NULL);
+
+	/* Invalid arguments. */
+	rc = zsl_sta_rls_init(&rls, 0.0, 1E6);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_rls_init(&rls, 1.0, -1.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_rls_update(&rls, &phi2, 1.0, NULL);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_sta_absolute_error(void)
 {
 	int rc;
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/threads.h>
+#include "floatcheck.h"
+
+void test_threads_count(void)
+{
+	int rc;
+
+	zassert_equal(zsl_threads_set_count(0), -EINVAL, NULL);
+	zassert_not_equal(zsl_threads_set_count(CONFIG_ZSL_THREADS_MAX + 1),
+			  0, NULL);
+
+	rc = zsl_threads_set_count(1);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_threads_get_count(), 1, NULL);
+
+	rc = zsl_threads_set_count(CONFIG_ZSL_THREADS_MAX);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_threads_get_count(), CONFIG_ZSL_THREADS_MAX, NULL);
+}
+
+/* Marks every index in a range as visited, counting repeat visits. */
+static int
+test_threads_mark(void *ctx, size_t start, size_t end)
+{
+	uint8_t *hits = ctx;
+
+	for (size_t i = start; i < end; i++) {
+		hits[i]++;
+	}
+
+	return 0;
+}
+
+static int
+test_threads_fail(void *ctx, size_t start, size_t end)
+{
+	return -EDOM;
+}
+
+void test_threads_for(void)
+{
+	int rc;
+	uint8_t hits[37] = { 0 };
+	size_t min_ops = zsl_threads_get_min_ops();
+
+	/* Force the split, even for a tiny range. */
+	zsl_threads_set_min_ops(0);
+	zassert_equal(zsl_threads_get_min_ops(), 0, NULL);
+
+	/* Every index must be visited exactly once. */
+	rc = zsl_threads_for(37, 37, test_threads_mark, hits);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_equal(hits[i], 1, NULL);
+	}
+
+	/* Errors from any range are passed back to the caller. */
+	rc = zsl_threads_for(37, 37, test_threads_fail, NULL);
+	zassert_equal(rc, -EDOM, NULL);
+
+	zsl_threads_set_min_ops(min_ops);
+}
+
+void test_threads_mtx(void)
+{
+	int rc;
+	size_t min_ops = zsl_threads_get_min_ops();
+
+	ZSL_MATRIX_DEF(ma, 24, 24);
+	ZSL_MATRIX_DEF(mb, 24, 24);
+	ZSL_MATRIX_DEF(mc, 24, 24);
+	ZSL_MATRIX_DEF(q, 24, 24);
+	ZSL_MATRIX_DEF(r, 24, 24);
+	ZSL_MATRIX_DEF(ms, 24, 24);
+	ZSL_MATRIX_DEF(qs, 24, 24);
+	ZSL_MATRIX_DEF(rs, 24, 24);
+
+	for (size_t i = 0; i < 24 * 24; i++) {
+		ma.data[i] = (zsl_real_t)((i * 7) % 13) - 6.0;
+		mb.data[i] = (zsl_real_t)((i * 5) % 11) * 0.25;
+	}
+
+	/* Serial reference results. */
+	zsl_threads_set_count(1);
+	rc = zsl_mtx_mult(&ma, &mb, &ms);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_binary_op(&ms, &ma, &ms, ZSL_MTX_BINARY_OP_SUB);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_unary_op(&ms, ZSL_MTX_UNARY_OP_NEGATIVE);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qrd(&ma, &qs, &rs, false);
+	zassert_equal(rc, 0, NULL);
+
+	/* The same operations split across every available thread. */
+	zsl_threads_set_count(CONFIG_ZSL_THREADS_MAX);
+	zsl_threads_set_min_ops(0);
+	rc = zsl_mtx_mult(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_binary_op(&mc, &ma, &mc, ZSL_MTX_BINARY_OP_SUB);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_unary_op(&mc, ZSL_MTX_UNARY_OP_NEGATIVE);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qrd(&ma, &q, &r, false);
+	zassert_equal(rc, 0, NULL);
+	zsl_threads_set_min_ops(min_ops);
+
+	for (size_t i = 0; i < 24 * 24; i++) {
+		zassert_true(val_is_equal(mc.data[i], ms.data[i], 1E-6), NULL);
+		zassert_true(val_is_equal(q.data[i], qs.data[i], 1E-6), NULL);
+		zassert_true(val_is_equal(r.data[i], rs.data[i], 1E-6), NULL);
+	}
+}
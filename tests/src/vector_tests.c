@@ -322,6 +322,33 @@ void test_vector_scalar_div(void)
 	zassert_true(val_is_equal(v.data[3], -0.2307692307, 1E-6), NULL);
 }
 
+void test_vector_axpy(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(x, 4);
+	ZSL_VECTOR_DEF(y, 4);
+	ZSL_VECTOR_DEF(z, 3);
+
+	zsl_real_t xi[4] = { 1.0, -2.0, 0.5, 4.0 };
+	zsl_real_t yi[4] = { 3.0, 1.0, -1.0, 0.0 };
+
+	zsl_vec_from_arr(&x, xi);
+	zsl_vec_from_arr(&y, yi);
+
+	/* y = -2 * x + y. */
+	rc = zsl_vec_axpy(-2.0, &x, &y);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(y.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y.data[1], 5.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y.data[2], -2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y.data[3], -8.0, 1E-6), NULL);
+
+	/* Vectors of different lengths are rejected. */
+	rc = zsl_vec_axpy(1.0, &x, &z);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_vector_dist(void)
 {
 	int rc;
@@ -538,6 +565,69 @@ void test_vector_sum_of_sqrs(void)
 	zassert_true(val_is_equal(sum, 16.41, 1E-6), NULL);
 }
 
+void test_vector_long_ops(void)
+{
+	int rc;
+	zsl_real_t d;
+	zsl_real_t e;
+
+	ZSL_VECTOR_DEF(v, 37);
+	ZSL_VECTOR_DEF(w, 37);
+	ZSL_VECTOR_DEF(x, 37);
+
+	/* Check every length up to 37 so that optimised implementations get
+	 * tested with and without leftover elements. */
+	for (size_t n = 1; n <= 37; n++) {
+		v.sz = n;
+		w.sz = n;
+		x.sz = n;
+		for (size_t i = 0; i < n; i++) {
+			v.data[i] = (zsl_real_t)(i + 1);
+			w.data[i] = 0.5 * (zsl_real_t)i;
+		}
+
+		rc = zsl_vec_add(&v, &w, &x);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < n; i++) {
+			zassert_true(val_is_equal(x.data[i], 1.5 * i + 1.0,
+						  1E-6), NULL);
+		}
+
+		rc = zsl_vec_sub(&v, &w, &x);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < n; i++) {
+			zassert_true(val_is_equal(x.data[i], 0.5 * i + 1.0,
+						  1E-6), NULL);
+		}
+
+		/* 0.5 * sum(i^2 + i) for i = 0 .. n - 1. */
+		rc = zsl_vec_dot(&v, &w, &d);
+		zassert_true(rc == 0, NULL);
+		e = 0.5 * ((zsl_real_t)((n - 1) * n * (2 * n - 1)) / 6.0 +
+			   (zsl_real_t)(n * (n - 1)) / 2.0);
+		zassert_true(val_is_equal(d, e, 1E-6), NULL);
+
+		/* sum(i^2) for i = 1 .. n. */
+		e = (zsl_real_t)(n * (n + 1) * (2 * n + 1)) / 6.0;
+		zassert_true(val_is_equal(zsl_vec_sum_of_sqrs(&v), e, 1E-6),
+			     NULL);
+		zassert_true(val_is_equal(zsl_vec_norm(&v), ZSL_SQRT(e), 1E-6),
+			     NULL);
+
+		rc = zsl_vec_scalar_mult(&v, 2.0);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_vec_scalar_add(&v, -1.0);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_vec_scalar_div(&v, 4.0);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < n; i++) {
+			zassert_true(val_is_equal(v.data[i],
+						  (2.0 * i + 1.0) / 4.0, 1E-6),
+				     NULL);
+		}
+	}
+}
+
 void test_vector_mean(void)
 {
 	int rc;
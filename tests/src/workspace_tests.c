@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/workspace.h>
+
+void test_ws_init(void)
+{
+	int rc;
+	uint64_t buf[4];
+	struct zsl_workspace ws;
+
+	rc = zsl_ws_init(&ws, buf, sizeof(buf));
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.sz, sizeof(buf), NULL);
+	zassert_equal(zsl_ws_avail(&ws), sizeof(buf), NULL);
+
+	/* Misaligned memory blocks should be rejected. */
+	rc = zsl_ws_init(&ws, (uint8_t *)buf + 1, sizeof(buf) - 1);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_ws_alloc(void)
+{
+	uint8_t *a, *b, *c;
+
+	ZSL_WORKSPACE_DEF(ws, 32);
+
+	zassert_equal(zsl_ws_avail(&ws), 32, NULL);
+
+	/* Every allocation is rounded up to the workspace alignment. */
+	a = zsl_ws_alloc(&ws, 3);
+	zassert_not_null(a, NULL);
+	b = zsl_ws_alloc(&ws, 16);
+	zassert_not_null(b, NULL);
+	zassert_equal(b - a, ZSL_WS_ALIGN, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 32 - ZSL_WS_ALIGN - 16, NULL);
+
+	/* Running out of memory returns NULL and leaves the workspace as is. */
+	c = zsl_ws_alloc(&ws, 16);
+	zassert_is_null(c, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 32 - ZSL_WS_ALIGN - 16, NULL);
+}
+
+void test_ws_mtx_vec(void)
+{
+	int rc;
+	struct zsl_mtx m;
+	struct zsl_vec v;
+
+	ZSL_WORKSPACE_DEF(ws, ZSL_WS_REALS(3 * 4) + ZSL_WS_REALS(5));
+
+	rc = zsl_ws_mtx(&ws, &m, 3, 4);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(m.sz_rows, 3, NULL);
+	zassert_equal(m.sz_cols, 4, NULL);
+	rc = zsl_mtx_init(&m, zsl_mtx_entry_fn_identity);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_ws_vec(&ws, &v, 5);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(v.sz, 5, NULL);
+	rc = zsl_vec_init(&v);
+	zassert_equal(rc, 0, NULL);
+
+	/* The two blocks must not overlap. */
+	zassert_true((uint8_t *)v.data >= (uint8_t *)(m.data + 12), NULL);
+
+	/* The workspace is full now. */
+	rc = zsl_ws_vec(&ws, &v, 1);
+	zassert_equal(rc, -ENOMEM, NULL);
+	rc = zsl_ws_mtx(&ws, &m, 1, 1);
+	zassert_equal(rc, -ENOMEM, NULL);
+}
+
+void test_ws_release(void)
+{
+	int rc;
+	size_t mark;
+	void *a, *b;
+
+	ZSL_WORKSPACE_DEF(ws, 64);
+
+	zsl_ws_alloc(&ws, 8);
+	mark = zsl_ws_mark(&ws);
+	zassert_equal(mark, 8, NULL);
+
+	a = zsl_ws_alloc(&ws, 40);
+	zassert_not_null(a, NULL);
+
+	/* Releasing back to the mark makes the same memory available again. */
+	rc = zsl_ws_release(&ws, mark);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 56, NULL);
+	b = zsl_ws_alloc(&ws, 40);
+	zassert_equal(a, b, NULL);
+
+	/* A mark past the current allocation is invalid. */
+	rc = zsl_ws_release(&ws, 60);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	rc = zsl_ws_release(&ws, 0);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 64, NULL);
+}